@@ -0,0 +1,66 @@
+// What the thrown blade's swept test costs per tick as a map gets denser: the sweep alone, and
+// the sweep plus the hit test against 64 to 1024 live notes, bombs and walls, with the blade
+// spinning at 2000 deg/s through the first rows.
+
+#include "physics/blade-sweep.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace TrickSaber::Math;
+
+static constexpr float TICK = 1.0f / 90.0f;
+static constexpr float BLADE_START = 0.0f;
+static constexpr float BLADE_END = 1.0f;
+static constexpr float BLADE_RADIUS = 0.01f;
+
+// count objects in four lanes and three layers, rows every 0.25 m from 1 m ahead, moving
+// towards the player at 18 m/s; every eighth is a wall.
+static void DenseMap(CutTargets& targets, int count) {
+    targets.Clear();
+    float const step = 18.0f * TICK;
+    for (int n = 0; n < count; n++) {
+        int row = n / 12;
+        Vec3 center = {-0.9f + 0.6f * static_cast<float>(n % 4), 0.5f + 0.5f * static_cast<float>(n / 4 % 3), 1.0f + 0.25f * static_cast<float>(row)};
+        if (n % 8 == 7) {
+            targets.AddBox(nullptr, center, Identity(), {0.25f, 0.5f, 0.5f}, {0.0f, 0.0f, -step});
+        } else {
+            targets.AddSphere(nullptr, n % 8 == 3 ? CutTargetKind::Bomb : CutTargetKind::Note, center, {0.0f, 0.0f, -step}, 0.3f);
+        }
+    }
+}
+
+static void Sweep(int tick, CutTargets const& targets, BladeSweep& sweep) {
+    float const turn = 2000.0f * TICK;
+    Quat from = AngleAxis(turn * static_cast<float>(tick % 11), Up());
+    SweepBlade({0.0f, 1.0f, 1.5f}, from, {0.02f, 1.0f, 1.52f}, AngleAxis(turn, Up()) * from, BLADE_START, BLADE_END, BLADE_RADIUS,
+               targets.maxMove, sweep);
+}
+
+static void BM_SweepBlade(benchmark::State& bench) {
+    static CutTargets targets;
+    static BladeSweep sweep;
+    DenseMap(targets, static_cast<int>(bench.range(0)));
+    int tick = 0;
+    for (auto _ : bench) {
+        Sweep(tick++, targets, sweep);
+        benchmark::DoNotOptimize(sweep.samples);
+    }
+}
+
+static void BM_SweepAndFindHits(benchmark::State& bench) {
+    static CutTargets targets;
+    static BladeSweep sweep;
+    static BladeHit hits[MAX_CUT_TARGETS];
+    DenseMap(targets, static_cast<int>(bench.range(0)));
+    int tick = 0;
+    int found = 0;
+    for (auto _ : bench) {
+        Sweep(tick++, targets, sweep);
+        found += FindBladeHits(sweep, targets, hits, MAX_CUT_TARGETS);
+        benchmark::DoNotOptimize(found);
+    }
+    bench.counters["hits"] = benchmark::Counter(found, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_SweepBlade)->RangeMultiplier(2)->Range(64, 1024);
+BENCHMARK(BM_SweepAndFindHits)->RangeMultiplier(2)->Range(64, 1024);
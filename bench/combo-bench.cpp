@@ -0,0 +1,52 @@
+// ComboScheduler::Tick() per live sequence, with 4096 running across 64 schedulers: combos
+// whose wait is not yet met, and combos resumed on every tick.
+
+#include "combo/library.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Combo;
+
+static constexpr int SCHEDULERS = 64;
+
+// Resumes on every tick for as long as it runs.
+static Sequence EveryTickCombo(ComboContext& ctx) {
+    for (;;) {
+        ctx.actions ^= Input::ActionBit(Input::Spin);
+        co_await ctx.NextTick();
+    }
+}
+
+static void RunSequences(benchmark::State& bench, ComboFn fn) {
+    auto schedulers = std::make_unique<ComboScheduler[]>(SCHEDULERS);
+    for (int s = 0; s < SCHEDULERS; s++) {
+        for (int slot = 0; slot < Saber::MAX_SABERS; slot++) {
+            schedulers[s].Start(slot, fn);
+        }
+    }
+    uint32_t held = Input::ActionBit(Input::Combo);
+    float now = 0.0f;
+    for (auto _ : bench) {
+        for (int s = 0; s < SCHEDULERS; s++) {
+            for (int slot = 0; slot < Saber::MAX_SABERS; slot++) {
+                benchmark::DoNotOptimize(schedulers[s].Tick(slot, now, held, 0, Saber::SaberInteractionState::Held));
+            }
+        }
+        now += 1.0f / 90.0f;
+    }
+    int64_t sequences = static_cast<int64_t>(SCHEDULERS) * Saber::MAX_SABERS;
+    bench.SetItemsProcessed(bench.iterations() * sequences);
+    // Seconds per live sequence per tick, printed with an SI prefix (n)
+    bench.counters["sequence"] = benchmark::Counter(static_cast<double>(bench.iterations() * sequences),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+// Reverse Spin held past its wind-up: every tick only checks the release wait.
+static void BM_WaitingSequences(benchmark::State& bench) { RunSequences(bench, GetCombo(ReverseSpin)); }
+static void BM_ResumedSequences(benchmark::State& bench) { RunSequences(bench, EveryTickCombo); }
+
+BENCHMARK(BM_WaitingSequences);
+BENCHMARK(BM_ResumedSequences);
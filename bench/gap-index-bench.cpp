@@ -0,0 +1,65 @@
+// The beatmap gap index's build on maps from a typical one to a marathon past any ranked map,
+// and one query per hand per tick while the song plays and after seeking somewhere random
+// each time.
+
+#include "beatmap/gap-index.hpp"
+#include "support/generated-maps.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace TrickSaber::Beatmap;
+using TrickSaber::Test::GenerateMap;
+using TrickSaber::Test::MapRandom;
+using TrickSaber::Test::SongLength;
+
+static constexpr float TICK = 1.0f / 90.0f;
+
+// Objects, and objects a second: typical, long ranked, dense ranked and a marathon.
+static void MapSizes(benchmark::internal::Benchmark* bench) {
+    bench->Args({1200, 6})->Args({5000, 10})->Args({8000, 12})->Args({40000, 20});
+}
+
+static std::vector<TimelineItem> Map(benchmark::State const& bench) {
+    MapRandom random(static_cast<uint32_t>(bench.range(0)));
+    return GenerateMap(random, static_cast<int>(bench.range(0)), static_cast<float>(bench.range(1)));
+}
+
+static void BM_GapIndexBuild(benchmark::State& bench) {
+    std::vector<TimelineItem> items = Map(bench);
+    for (auto _ : bench) {
+        GapIndex index = BuildGapIndex(items);
+        benchmark::DoNotOptimize(index.windows[0].data());
+    }
+}
+
+static void BM_GapIndexQueryPlaying(benchmark::State& bench) {
+    std::vector<TimelineItem> items = Map(bench);
+    GapIndex index = BuildGapIndex(items);
+    GapCursor cursor;
+    int ticks = static_cast<int>(SongLength(items) / TICK);
+    int i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(TimeUntilNextCut(index, cursor, i & 1, static_cast<float>(i % ticks) * TICK));
+        i++;
+    }
+}
+
+static void BM_GapIndexQueryAfterSeek(benchmark::State& bench) {
+    std::vector<TimelineItem> items = Map(bench);
+    GapIndex index = BuildGapIndex(items);
+    GapCursor cursor;
+    MapRandom random(5);
+    std::vector<float> seeks(4096);
+    for (float& seek : seeks) seek = random.Next(0.0f, SongLength(items));
+    int i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(TimeUntilNextCut(index, cursor, i & 1, seeks[i & 4095]));
+        i++;
+    }
+}
+
+BENCHMARK(BM_GapIndexBuild)->Apply(MapSizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GapIndexQueryPlaying)->Apply(MapSizes);
+BENCHMARK(BM_GapIndexQueryAfterSeek)->Apply(MapSizes);
@@ -0,0 +1,27 @@
+// What the performance panel's bookkeeping adds to a hook: one histogram record, and a
+// scoped timer around nothing (two clock reads plus the record).
+
+#include "perf/timers.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace TrickSaber::Perf;
+
+static void BM_HistogramRecord(benchmark::State& bench) {
+    LatencyHistogram histogram;
+    uint64_t ns = 1500;
+    for (auto _ : bench) {
+        histogram.Record(ns);
+        ns = ns * 7 % 100003 + 200;
+    }
+    benchmark::DoNotOptimize(histogram.Percentile(0.99));
+}
+
+static void BM_ScopedTimer(benchmark::State& bench) {
+    for (auto _ : bench) {
+        ScopedTimer timer(Metric::FixedUpdateHook);
+    }
+}
+
+BENCHMARK(BM_HistogramRecord);
+BENCHMARK(BM_ScopedTimer);
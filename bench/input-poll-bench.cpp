@@ -0,0 +1,136 @@
+// Per-tick input cost for both hands: the single poll into each controller's raw mask plus the
+// compiled bindings (Input::PollInput), against the per-action polling the hook did before, one
+// OVRInput::Get per bound action with the config index run through GetOVRButtonForConfig's
+// switch every time and a last-frame bool for the edge. Bindings are 2 actions per hand (throw
+// and spin) or all 4. The per-action polling ran inside each saber's logic, so it is also run
+// for 4 sabers per hand; the single poll is per hand whatever the saber count. Buttons come
+// from Facade::heldButtons, scripted per tick.
+//
+// The facade's OVRInput::Get is a plain read; on device each is an il2cpp call, so "gets" (per
+// tick) is the count that matters there.
+
+#include "facade.hpp"
+#include "input/hand-input.hpp"
+#include "saber/trick-machine.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace TrickSaber;
+using GlobalNamespace::OVRInput;
+
+static constexpr int PATTERN_TICKS = 256;
+
+// The action buttons by config index: throw on the trigger, spin on A/X, combo on the grip,
+// next preset on B/Y.
+static constexpr int ACTION_BUTTONS[Input::ActionCount] = {3, 1, 4, 2};
+
+// GetOVRButtonForConfig as the hook called it, per action per tick.
+[[gnu::noinline]] static OVRInput::Button ButtonForConfig(int configuredButtonIndex, bool isLeftController) {
+    if (configuredButtonIndex == 0) return OVRInput::Button::None;
+    if (isLeftController) {
+        switch (configuredButtonIndex) {
+            case 1: return OVRInput::Button::One;
+            case 2: return OVRInput::Button::Two;
+            case 3: return OVRInput::Button::PrimaryIndexTrigger;
+            case 4: return OVRInput::Button::PrimaryHandTrigger;
+            default: return OVRInput::Button::None;
+        }
+    } else {
+        switch (configuredButtonIndex) {
+            case 1: return OVRInput::Button::One;
+            case 2: return OVRInput::Button::Two;
+            case 3: return OVRInput::Button::PrimaryIndexTrigger;
+            case 4: return OVRInput::Button::PrimaryHandTrigger;
+            default: return OVRInput::Button::None;
+        }
+    }
+}
+
+// Held OVR buttons per tick for one controller: each button toggles at its own period, so
+// presses, releases and chords all turn up.
+static unsigned ScriptedButtons(int tick, int hand) {
+    unsigned held = 0;
+    int t = tick + hand * 17;
+    if ((t / 11) % 2) held |= static_cast<unsigned>(OVRInput::Button::One);
+    if ((t / 23) % 2) held |= static_cast<unsigned>(OVRInput::Button::Two);
+    if ((t / 7) % 3 == 0) held |= static_cast<unsigned>(OVRInput::Button::PrimaryIndexTrigger);
+    if ((t / 31) % 2) held |= static_cast<unsigned>(OVRInput::Button::PrimaryHandTrigger);
+    return held;
+}
+
+static void SetButtons(int tick) {
+    for (int h = 0; h < Config::HandCount; h++) {
+        Facade::heldButtons[static_cast<unsigned>(Input::HandController(static_cast<Config::Hand>(h)))] = ScriptedButtons(tick, h);
+    }
+}
+
+static void Report(benchmark::State& bench, Facade::Counts const& before) {
+    bench.counters["gets"] = static_cast<double>((Facade::counts - before).Of(Facade::Call::InputGet)) / static_cast<double>(bench.iterations());
+    // Seconds per tick, printed with an SI prefix (n)
+    bench.counters["tick"] = benchmark::Counter(static_cast<double>(bench.iterations()),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+static void BM_PerActionPoll(benchmark::State& bench) {
+    int actions = static_cast<int>(bench.range(0));
+    int sabers = static_cast<int>(bench.range(1)) * Config::HandCount;
+    bool lastFrame[Saber::MAX_SABERS][Input::ActionCount] = {};
+    Facade::Counts before = Facade::counts;
+    int tick = 0;
+    for (auto _ : bench) {
+        SetButtons(tick);
+        for (int i = 0; i < sabers; i++) {
+            int h = i % Config::HandCount;
+            bool isLeft = h == Config::Left;
+            auto controller = Input::HandController(static_cast<Config::Hand>(h));
+            uint32_t pressed = 0;
+            for (int a = 0; a < actions; a++) {
+                int index = ACTION_BUTTONS[a];
+                bool held = index > 0 && OVRInput::Get(ButtonForConfig(index, isLeft), controller);
+                if (held && !lastFrame[i][a]) {
+                    pressed |= 1u << a;
+                }
+                lastFrame[i][a] = held;
+            }
+            benchmark::DoNotOptimize(pressed);
+        }
+        tick = (tick + 1) % PATTERN_TICKS;
+    }
+    Report(bench, before);
+}
+
+static void BM_SinglePoll(benchmark::State& bench) {
+    int actions = static_cast<int>(bench.range(0));
+    Config::Snapshot config = {};
+    for (int h = 0; h < Config::HandCount; h++) {
+        // As the snapshot compiles them: the bindings, then one poll entry per distinct button
+        Config::HandSettings& hand = config.hands[h];
+        uint32_t used = 0;
+        for (int a = 0; a < actions; a++) {
+            hand.bindings[a] = Input::CompileBinding(ACTION_BUTTONS[a], 0, false);
+            used |= hand.bindings[a].mask;
+        }
+        for (int index = 1; index <= Input::BUTTON_COUNT; index++) {
+            if (used & Input::ButtonBitForConfig(index)) {
+                hand.pollButtons[hand.pollCount] = ButtonForConfig(index, h == Config::Left);
+                hand.pollBits[hand.pollCount] = Input::ButtonBitForConfig(index);
+                hand.pollCount++;
+            }
+        }
+    }
+    Input::HandInput input;
+    Facade::Counts before = Facade::counts;
+    float now = 0.0f;
+    int tick = 0;
+    for (auto _ : bench) {
+        SetButtons(tick);
+        Input::PollInput(input, config, now);
+        now += 1.0f / 90.0f;
+        benchmark::DoNotOptimize(input.pressed);
+        tick = (tick + 1) % PATTERN_TICKS;
+    }
+    Report(bench, before);
+}
+
+BENCHMARK(BM_PerActionPoll)->Args({2, 1})->Args({Input::ActionCount, 1})->Args({Input::ActionCount, 4});
+BENCHMARK(BM_SinglePoll)->Arg(2)->Arg(Input::ActionCount);
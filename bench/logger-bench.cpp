@@ -0,0 +1,77 @@
+// Hook-side cost of logging a throw: Log::Emit(), which pushes a record into the hook log's ring
+// for the flush thread, against the synchronous getLogger().info() the tick used to call. The
+// host paper facade only counts lines, so the synchronous path here also does what paper does
+// behind that call on device: format the line and write it out, one unbuffered write per line
+// as a logcat write is.
+//
+// BM_HookLogEmit pushes in bursts well inside the ring with the flush thread running, and waits
+// untimed for it to drain between them, so every push lands in the ring rather than as a drop.
+
+#include "facade.hpp"
+#include "logger.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using namespace TrickSaber;
+
+static constexpr int BURST = 512;  // Records between drains; the ring holds 1024
+static constexpr int BURSTS = 40;
+
+// Waits for the flush thread to format every record pushed since linesBefore.
+static void WaitForDrain(uint64_t linesBefore, uint64_t pushed) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (Facade::LinesLogged(Facade::LogLine::Info) - linesBefore < pushed && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+static void BM_HookLogEmit(benchmark::State& bench) {
+    Log::Start();
+    uint64_t lines = Facade::LinesLogged(Facade::LogLine::Info);
+    uint64_t dropped = Log::DroppedRecords();
+    uint64_t pushed = 0;
+    for (auto _ : bench) {
+        int slot = static_cast<int>(pushed & 1);
+        Log::Emit<Log::Level::Info>(Log::Event::ThrowInitiated, slot, slot, 4.2f);
+        if (++pushed % BURST == 0) {
+            bench.PauseTiming();
+            WaitForDrain(lines, pushed - (Log::DroppedRecords() - dropped));
+            bench.ResumeTiming();
+        }
+    }
+    bench.counters["dropped"] = static_cast<double>(Log::DroppedRecords() - dropped);
+}
+
+// What paper does for getLogger().info() on device, after the facade counts the call.
+static std::FILE* Sink() {
+    static std::FILE* sink = [] {
+        std::FILE* file = std::fopen("/dev/null", "w");
+        if (file) std::setvbuf(file, nullptr, _IONBF, 0);
+        return file;
+    }();
+    return sink;
+}
+
+static void BM_SynchronousInfo(benchmark::State& bench) {
+    std::FILE* sink = Sink();
+    if (!sink) {
+        bench.SkipWithError("could not open /dev/null");
+        return;
+    }
+    char line[128];
+    int k = 0;
+    for (auto _ : bench) {
+        char const* side = k & 1 ? "Right" : "Left";
+        getLogger().info("[TS] [FixedUpdate] [{} Saber {}] Throw Initiated ({:.2f} m/s)", side, k & 1, 4.2f);
+        std::snprintf(line, sizeof(line), "[TS] [FixedUpdate] [%s Saber %d] Throw Initiated (%.2f m/s)\n", side, k & 1, 4.2f);
+        std::fputs(line, sink);
+        k++;
+    }
+}
+
+BENCHMARK(BM_HookLogEmit)->Iterations(BURST * BURSTS);
+BENCHMARK(BM_SynchronousInfo);
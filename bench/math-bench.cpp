@@ -0,0 +1,150 @@
+// The native math kernels (physics/math.hpp) against Unity's formulas in float
+// (test/support/unity-math.hpp), one op at a time and as one saber's FixedUpdate math: the held
+// spin's AngleAxis and product, a rotated axis, a return Slerp and a normalized throw direction.
+// The Unity side is called out of line, as every op was an il2cpp call before; the difference
+// between BM_SaberTickMath and BM_SaberTickMathUnity is the math's share of the ns per tick saved. The
+// codegen invoke overhead on top of that only exists on device.
+
+#include "physics/math.hpp"
+#include "support/unity-math.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+using namespace TrickSaber::Math;
+namespace Unity = TrickSaber::Test::Unity;
+
+using UVec3 = Unity::Vector3<float>;
+using UQuat = Unity::Quaternion<float>;
+
+// One out-of-line call per op, standing in for the il2cpp call each one used to be.
+[[gnu::noinline]] static UQuat CallMultiply(UQuat a, UQuat b) { return Unity::Multiply(a, b); }
+[[gnu::noinline]] static UVec3 CallRotate(UQuat q, UVec3 v) { return Unity::Rotate(q, v); }
+[[gnu::noinline]] static UQuat CallAngleAxis(float angle, UVec3 axis) { return Unity::AngleAxis(angle, axis); }
+[[gnu::noinline]] static UQuat CallSlerp(UQuat a, UQuat b, float t) { return Unity::Slerp(a, b, t); }
+[[gnu::noinline]] static UVec3 CallNormalized(UVec3 v) { return Unity::Normalized(v); }
+
+static constexpr int INPUTS = 1024;
+
+struct Inputs {
+    std::vector<Quat> rotations;
+    std::vector<Vec3> vectors;
+
+    Inputs() {
+        std::mt19937 random(7);
+        std::normal_distribution<float> d;
+        for (int n = 0; n < INPUTS; n++) {
+            rotations.push_back(Normalized(Quat{d(random), d(random), d(random), d(random)}));
+            vectors.push_back({d(random), d(random), d(random)});
+        }
+    }
+};
+
+static Inputs const& Data() {
+    static Inputs const inputs;
+    return inputs;
+}
+
+static void BM_QuatProduct(benchmark::State& bench) {
+    Inputs const& in = Data();
+    int i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(in.rotations[i] * in.rotations[(i + 1) % INPUTS]);
+        i = (i + 1) % INPUTS;
+    }
+}
+
+static void BM_QuatProductUnity(benchmark::State& bench) {
+    Inputs const& in = Data();
+    int i = 0;
+    for (auto _ : bench) {
+        UQuat a = Unity::From<float>(in.rotations[i]);
+        UQuat b = Unity::From<float>(in.rotations[(i + 1) % INPUTS]);
+        benchmark::DoNotOptimize(CallMultiply(a, b));
+        i = (i + 1) % INPUTS;
+    }
+}
+
+static void BM_RotateVector(benchmark::State& bench) {
+    Inputs const& in = Data();
+    int i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(in.rotations[i] * in.vectors[i]);
+        i = (i + 1) % INPUTS;
+    }
+}
+
+static void BM_RotateVectorUnity(benchmark::State& bench) {
+    Inputs const& in = Data();
+    int i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(CallRotate(Unity::From<float>(in.rotations[i]), Unity::From<float>(in.vectors[i])));
+        i = (i + 1) % INPUTS;
+    }
+}
+
+static void BM_Slerp(benchmark::State& bench) {
+    Inputs const& in = Data();
+    int i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(Slerp(in.rotations[i], in.rotations[(i + 1) % INPUTS], static_cast<float>(i) / INPUTS));
+        i = (i + 1) % INPUTS;
+    }
+}
+
+static void BM_SlerpUnity(benchmark::State& bench) {
+    Inputs const& in = Data();
+    int i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(CallSlerp(Unity::From<float>(in.rotations[i]), Unity::From<float>(in.rotations[(i + 1) % INPUTS]),
+                                           static_cast<float>(i) / INPUTS));
+        i = (i + 1) % INPUTS;
+    }
+}
+
+// One saber's math in a FixedUpdate that spins, points, returns and throws.
+static void BM_SaberTickMath(benchmark::State& bench) {
+    Inputs const& in = Data();
+    int i = 0;
+    for (auto _ : bench) {
+        Quat spin = AngleAxis(static_cast<float>(i), in.vectors[i]) * in.rotations[i];
+        Vec3 axis = spin * Forward();
+        Quat back = Slerp(spin, in.rotations[(i + 1) % INPUTS], static_cast<float>(i) / INPUTS);
+        Vec3 direction = Normalized(in.vectors[(i + 1) % INPUTS]);
+        benchmark::DoNotOptimize(axis);
+        benchmark::DoNotOptimize(back);
+        benchmark::DoNotOptimize(direction);
+        i = (i + 1) % INPUTS;
+    }
+    bench.counters["tick"] = benchmark::Counter(static_cast<double>(bench.iterations()),
+                                                benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+static void BM_SaberTickMathUnity(benchmark::State& bench) {
+    Inputs const& in = Data();
+    int i = 0;
+    for (auto _ : bench) {
+        UQuat held = Unity::From<float>(in.rotations[i]);
+        UQuat spin = CallMultiply(CallAngleAxis(static_cast<float>(i), Unity::From<float>(in.vectors[i])), held);
+        UVec3 axis = CallRotate(spin, {0.0f, 0.0f, 1.0f});
+        UQuat back = CallSlerp(spin, Unity::From<float>(in.rotations[(i + 1) % INPUTS]), static_cast<float>(i) / INPUTS);
+        UVec3 direction = CallNormalized(Unity::From<float>(in.vectors[(i + 1) % INPUTS]));
+        benchmark::DoNotOptimize(axis);
+        benchmark::DoNotOptimize(back);
+        benchmark::DoNotOptimize(direction);
+        i = (i + 1) % INPUTS;
+    }
+    bench.counters["tick"] = benchmark::Counter(static_cast<double>(bench.iterations()),
+                                                benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+BENCHMARK(BM_QuatProduct);
+BENCHMARK(BM_QuatProductUnity);
+BENCHMARK(BM_RotateVector);
+BENCHMARK(BM_RotateVectorUnity);
+BENCHMARK(BM_Slerp);
+BENCHMARK(BM_SlerpUnity);
+BENCHMARK(BM_SaberTickMath);
+BENCHMARK(BM_SaberTickMathUnity);
@@ -0,0 +1,52 @@
+// A preset switch with a full store: copying a record out of the 256 mapped ones, clamping it
+// and publishing it. The snapshot build from the values (settings/snapshot.cpp) needs
+// config-utils and is left out.
+
+#include "settings/preset-format.hpp"
+#include "settings/preset-limits.hpp"
+#include "settings/snapshot-slots.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace TrickSaber::Presets;
+
+static void BM_PresetSwitch(benchmark::State& bench) {
+    char path[] = "/tmp/preset-bench-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0 || ftruncate(fd, FILE_BYTES) != 0) {
+        bench.SkipWithError("could not create the store");
+        return;
+    }
+    void* mapping = mmap(nullptr, FILE_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    unlink(path);
+    auto* header = static_cast<PresetFileHeader*>(mapping);
+    *header = MakeHeader();
+    for (int i = 0; i < MAX_PRESETS; i++) {
+        PresetRecord& record = Records(header)[i];
+        SetName(record, "preset");
+        record.values = {};
+        record.values.LeftSaberSpinSpeed = record.values.RightSaberSpinSpeed = 100.0f + i;
+        record.values.LeftSaberReturnDuration = record.values.RightSaberReturnDuration = 0.2f;
+    }
+    header->count = MAX_PRESETS;
+
+    TrickSaber::Config::SnapshotSlots<PresetValues> published;
+    int index = 0;
+    for (auto _ : bench) {
+        PresetValues values = Records(header)[index].values;
+        ClampValues(values);
+        published.Publish([&](PresetValues& slot, uint32_t) { slot = values; });
+        header->active = index;
+        index = (index + 97) % MAX_PRESETS;
+    }
+    benchmark::DoNotOptimize(published.Acquire()->LeftSaberSpinSpeed);
+    munmap(mapping, FILE_BYTES);
+}
+
+BENCHMARK(BM_PresetSwitch);
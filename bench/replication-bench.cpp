@@ -0,0 +1,80 @@
+// Replication stream (replication/stream.hpp) encode and decode throughput under trick spam
+// (test/support/replication-spam.hpp), for 2 sabers and the stream's limit, at a 30 and a
+// 90 Hz pose rate. Encode runs every 90 Hz tick, as the sender would; decode runs every packet
+// that came out of it. Both report ns per packet, and encode the bytes per second per saber
+// the stream needs on the sender's clock.
+
+#include "support/replication-spam.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Replication;
+using namespace TrickSaber::Test;
+
+static constexpr float SECONDS = 10.0f;
+
+static void BM_ReplicationEncode(benchmark::State& bench) {
+    int sabers = static_cast<int>(bench.range(0));
+    int rate = static_cast<int>(bench.range(1));
+    std::vector<TickFrames> const ticks = SpamTicks(sabers, SECONDS);
+    uint8_t packet[MAX_PACKET_BYTES];
+    auto encoder = std::make_unique<StreamEncoder>();
+    encoder->SetRate(rate);
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    size_t t = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(encoder->Encode(ticks[t].time, ticks[t].frames, ticks[t].count, packet));
+        if (++t == ticks.size()) {
+            // The spam's clock starts over, so the stream does too
+            packets += encoder->Stats().packets;
+            bytes += encoder->Stats().bytes;
+            encoder = std::make_unique<StreamEncoder>();
+            encoder->SetRate(rate);
+            t = 0;
+        }
+    }
+    packets += encoder->Stats().packets;
+    bytes += encoder->Stats().bytes;
+    double senderSeconds = static_cast<double>(bench.iterations()) / TICK_RATE;
+    bench.counters["packet"] = benchmark::Counter(static_cast<double>(packets), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    bench.counters["B/s/saber"] = static_cast<double>(bytes) / senderSeconds / sabers;
+}
+
+static void BM_ReplicationDecode(benchmark::State& bench) {
+    int sabers = static_cast<int>(bench.range(0));
+    int rate = static_cast<int>(bench.range(1));
+    std::vector<TickFrames> const ticks = SpamTicks(sabers, SECONDS);
+    std::vector<uint8_t> stream(ticks.size() * MAX_PACKET_BYTES);
+    std::vector<int> sizes;
+    {
+        StreamEncoder encoder;
+        encoder.SetRate(rate);
+        for (TickFrames const& tick : ticks) {
+            int size = encoder.Encode(tick.time, tick.frames, tick.count, &stream[sizes.size() * MAX_PACKET_BYTES]);
+            if (size > 0) {
+                sizes.push_back(size);
+            }
+        }
+    }
+    auto peer = std::make_unique<RemotePeer>();
+    size_t p = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(Decode(&stream[p * MAX_PACKET_BYTES], sizes[p], *peer));
+        if (++p == sizes.size()) {
+            peer->Clear();
+            p = 0;
+        }
+    }
+    if (peer->stats.malformed > 0) {
+        bench.SkipWithError("malformed packet");
+    }
+    bench.counters["packet"] = benchmark::Counter(static_cast<double>(bench.iterations()), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+BENCHMARK(BM_ReplicationEncode)->Args({2, 30})->Args({MAX_REPLICATED_SABERS, 30})->Args({MAX_REPLICATED_SABERS, 90});
+BENCHMARK(BM_ReplicationDecode)->Args({2, 30})->Args({MAX_REPLICATED_SABERS, 30})->Args({MAX_REPLICATED_SABERS, 90});
@@ -0,0 +1,92 @@
+// Cost of one return pose with the Lerp / Slerp the trick machine used before paths, with a
+// baked path, and with a different path every call, and of leading the return's target.
+
+#include "physics/return-path.hpp"
+#include "saber/trick-machine.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Math;
+
+static constexpr float RETURN_DURATION = 0.2f;
+static constexpr int STEPS = 1024;  // Return progress wraps every STEPS calls
+
+// A return from a spinning throw's pose half a second out.
+struct ReturnFixture {
+    ThrowTrajectory trajectory{{0.7f, 1.5f, 2.1f}, Identity(), Zero(), {0.0f, 0.0f, 20.0f}};
+    Vec3 release;
+    Quat releaseRotation;
+    Quat handRotation = AngleAxis(15.0f, Up());
+
+    ReturnFixture() { trajectory.Evaluate(0.5f, release, releaseRotation); }
+
+    void Pose(ReturnPath const& path, int i, Vec3& position, Quat& rotation) const {
+        float t = static_cast<float>(i % STEPS) / STEPS;
+        Saber::ReturnPose(path, trajectory, release, releaseRotation, 0.5f + t * RETURN_DURATION, t, {0.2f, 1.2f, 0.3f + t},
+                          handRotation, position, rotation);
+    }
+};
+
+// The return pose before paths: straight at constant speed into the current hand position.
+static void BM_ReturnPoseLerp(benchmark::State& bench) {
+    ReturnFixture fixture;
+    int i = 0;
+    for (auto _ : bench) {
+        float t = static_cast<float>(i++ % STEPS) / STEPS;
+        Vec3 position = Lerp(fixture.release, {0.2f, 1.2f, 0.3f + t}, t);
+        Quat rotation = Slerp(fixture.trajectory.RotationAt(0.5f + t * RETURN_DURATION), fixture.handRotation, t * t * t);
+        benchmark::DoNotOptimize(position);
+        benchmark::DoNotOptimize(rotation);
+    }
+}
+
+static void BM_ReturnPoseBaked(benchmark::State& bench) {
+    ReturnFixture fixture;
+    ReturnPath const& path = ReturnPathFor(static_cast<uint8_t>(bench.range(0)));
+    int i = 0;
+    for (auto _ : bench) {
+        Vec3 position;
+        Quat rotation;
+        fixture.Pose(path, i++, position, rotation);
+        benchmark::DoNotOptimize(position);
+        benchmark::DoNotOptimize(rotation);
+    }
+}
+
+static void BM_ReturnPoseEachStyle(benchmark::State& bench) {
+    ReturnFixture fixture;
+    constexpr int CURVES = static_cast<int>(ReturnCurve::Count);
+    constexpr int EASINGS = static_cast<int>(ReturnEasing::Count);
+    constexpr int STYLES = CURVES * EASINGS;
+    ReturnPath const* paths[STYLES];
+    for (int style = 0; style < STYLES; style++) {
+        paths[style] = &ReturnPathFor(ReturnStyle(static_cast<ReturnCurve>(style / EASINGS), static_cast<ReturnEasing>(style % EASINGS)));
+    }
+    int i = 0;
+    for (auto _ : bench) {
+        Vec3 position;
+        Quat rotation;
+        fixture.Pose(*paths[i % STYLES], i, position, rotation);
+        i++;
+        benchmark::DoNotOptimize(position);
+        benchmark::DoNotOptimize(rotation);
+    }
+}
+
+static void BM_PredictReturnTarget(benchmark::State& bench) {
+    int i = 0;
+    for (auto _ : bench) {
+        float t = static_cast<float>(i++ % STEPS) / STEPS;
+        Vec3 aim = PredictReturnTarget({0.2f, 1.2f, 0.3f}, {t, 0.5f, -t}, (1.0f - t) * RETURN_DURATION);
+        benchmark::DoNotOptimize(aim);
+    }
+}
+
+BENCHMARK(BM_ReturnPoseLerp);
+// Straight linear, the default, and curl in-out, the most involved
+BENCHMARK(BM_ReturnPoseBaked)
+        ->Arg(DEFAULT_RETURN_STYLE)
+        ->Arg(ReturnStyle(ReturnCurve::Curl, ReturnEasing::EaseInOut));
+BENCHMARK(BM_ReturnPoseEachStyle);
+BENCHMARK(BM_PredictReturnTarget);
@@ -0,0 +1,63 @@
+// UI-thread cost of one settings change: rewriting the whole config file on every step the way
+// config-utils did, against handing the values to a SaveWorker (settings/save-worker.hpp).
+
+#include "settings/config-values.hpp"
+#include "settings/save-worker.hpp"
+#include "support/json-writer.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+using namespace TrickSaber::Config;
+
+static char const* const KEYS[] = {
+#define TRICKSABER_KEY(name, type) #name,
+    TRICKSABER_CONFIG_FIELDS(TRICKSABER_KEY)
+#undef TRICKSABER_KEY
+};
+
+static std::string Render(ConfigValues const& values) {
+    TrickSaber::Test::JsonWriter writer;
+    WriteConfigJson(writer, values, KEYS);
+    return writer.Text();
+}
+
+static std::string TempDir() {
+    char pattern[] = "/tmp/save-worker-bench-XXXXXX";
+    return mkdtemp(pattern);
+}
+
+static void BM_WriteEveryChange(benchmark::State& bench) {
+    std::string dir = TempDir();
+    std::string path = dir + "/config.json";
+    ConfigValues values = {};
+    for (auto _ : bench) {
+        values.LeftSaberSpinSpeed += 50.0f;
+        WriteFileAtomically(path, Render(values));
+    }
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
+
+static void BM_HandToSaveWorker(benchmark::State& bench) {
+    std::string dir = TempDir();
+    std::string path = dir + "/config.json";
+    ConfigValues values = {};
+    {
+        SaveWorker<ConfigValues> worker;
+        worker.Start(path, Render);
+        for (auto _ : bench) {
+            values.LeftSaberSpinSpeed += 50.0f;
+            worker.Changed(values);
+        }
+        bench.counters["files"] = static_cast<double>(worker.Stats().writes);
+    }
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
+
+BENCHMARK(BM_WriteEveryChange);
+BENCHMARK(BM_HandToSaveWorker);
@@ -0,0 +1,95 @@
+// Per-tick cost of the saber state store's slot loop as the saber count grows from 2 to 64
+// (extra sabers from custom-saber or multi-saber mods). One tick is what FixedUpdate runs for
+// every slot: the handle validation, the hand reads, the hand samples and TickTrick() for each
+// ready saber. Half the sabers follow each hand of the BothHands scenario
+// (test/support/trick-scenarios.hpp); the store's handles are the host transforms
+// (tools/budget/facade), so a Unity call costs what a plain read does here.
+
+#include "saber/state-store.hpp"
+#include "saber/transform-icalls.hpp"
+#include "support/trick-scenarios.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Test;
+using Saber::SaberStateStore;
+
+namespace {
+
+    struct Sabers {
+        std::unique_ptr<SaberStateStore> store = std::make_unique<SaberStateStore>();
+        std::unique_ptr<UnityEngine::Transform> hands[Config::HandCount];
+        std::vector<std::unique_ptr<UnityEngine::Transform>> transforms;
+        std::vector<HostSaber> sabers;
+        std::vector<EventCounts> events;
+        Config::HandTuning tuning = DefaultTuning();
+
+        explicit Sabers(int count) : sabers(count), events(count) {
+            for (auto& hand : hands) {
+                hand.reset(UnityEngine::Transform::Create());
+            }
+            for (int n = 0; n < count; n++) {
+                UnityEngine::Transform* hand = hands[n % Config::HandCount].get();
+                transforms.emplace_back(UnityEngine::Transform::Create(hand));
+                int slot = store->FindOrAdd(transforms.back().get());
+                auto& cold = store->cold[slot];
+                cold.hand = static_cast<Config::Hand>(n % Config::HandCount);
+                cold.restPose = {{0.0f, 0.0f, 0.05f}, AngleAxis(-10.0f, Right()), {1.0f, 1.0f, 1.0f}};
+                cold.originalParent = hand;
+                cold.handTransform = hand;
+                store->attached |= SaberStateStore::Bit(slot);
+                sabers[slot].localPosition = cold.restPose.position;
+                sabers[slot].localRotation = cold.restPose.rotation;
+            }
+        }
+
+        void Tick(ScenarioTick const& tick, uint64_t timeNs) {
+            SaberStateStore& s = *store;
+            for (int h = 0; h < Config::HandCount; h++) {
+                hands[h]->localPosition = tick.hands[h].position;
+                hands[h]->localRotation = tick.hands[h].rotation;
+            }
+            s.ValidateHandles();
+            for (int i = 0; i < s.count; i++) {
+                if (s.handAlive & SaberStateStore::Bit(i)) {
+                    s.handPosition[i] = Saber::WorldPosition(s.cold[i].handTransform.ptr());
+                }
+            }
+            Saber::PushHandSamples(s, timeNs);
+            for (int i = 0; i < s.count; i++) {
+                if (s.Ready(i)) {
+                    HostTrickIO io{sabers[i], tick.hands[s.cold[i].hand], events[i]};
+                    Saber::TickTrick(s, i, s.cold[i].restPose, tuning, tick.deltaTime, io);
+                }
+            }
+        }
+    };
+
+}  // namespace
+
+static void BM_SlotLoop(benchmark::State& bench) {
+    int count = static_cast<int>(bench.range(0));
+    Sabers sabers(count);
+    Scenario const scenario = BothHands(16);
+    uint64_t timeNs = 0;
+    size_t k = 0;
+    for (auto _ : bench) {
+        timeNs += static_cast<uint64_t>(static_cast<double>(scenario[k].deltaTime) * 1e9);
+        sabers.Tick(scenario[k], timeNs);
+        benchmark::DoNotOptimize(sabers.sabers.data());
+        if (++k == scenario.size()) {
+            k = 0;
+        }
+    }
+    // Seconds per tick and per saber, printed with an SI prefix (n)
+    bench.counters["tick"] = benchmark::Counter(static_cast<double>(bench.iterations()),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    bench.counters["saber"] = benchmark::Counter(static_cast<double>(bench.iterations()) * count,
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+BENCHMARK(BM_SlotLoop)->RangeMultiplier(2)->Range(2, Saber::MAX_SABERS);
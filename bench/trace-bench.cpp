@@ -0,0 +1,48 @@
+// What a trace point costs: a span around a trivial loop body with no capture running, with one
+// running, and the loop alone, which is also what TS_TRACE=0 builds run since the macros leave
+// nothing.
+
+#include "perf/trace.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace TrickSaber;
+using Trace::Span;
+
+static void BM_LoopAlone(benchmark::State& bench) {
+    uint32_t i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(i++);
+    }
+}
+
+static void BM_TraceSpanIdle(benchmark::State& bench) {
+    uint32_t i = 0;
+    for (auto _ : bench) {
+        TS_TRACE_SCOPE(Span::SaberTick, i & 7);
+        benchmark::DoNotOptimize(i++);
+    }
+}
+
+static void BM_TraceSpanCapturing(benchmark::State& bench) {
+    // Two events per span; restart the capture before the thread's buffer fills
+    constexpr uint32_t PER_CAPTURE = Trace::THREAD_CAPACITY / 2;
+    uint32_t i = 0;
+    Trace::Start();
+    for (auto _ : bench) {
+        if (i % PER_CAPTURE == PER_CAPTURE - 1) {
+            bench.PauseTiming();
+            Trace::Stop();
+            Trace::Start();
+            bench.ResumeTiming();
+        }
+        TS_TRACE_SCOPE(Span::SaberTick, i & 7);
+        benchmark::DoNotOptimize(i++);
+    }
+    Trace::Stop();
+    bench.counters["dropped"] = static_cast<double>(Trace::Dropped());
+}
+
+BENCHMARK(BM_LoopAlone);
+BENCHMARK(BM_TraceSpanIdle);
+BENCHMARK(BM_TraceSpanCapturing);
@@ -0,0 +1,40 @@
+// Cost of one thrown-saber pose from the closed form, against one step of the incremental
+// update it replaced (the two transform reads that step also needed are not counted).
+
+#include "physics/trajectory.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace TrickSaber::Math;
+
+static ThrowTrajectory SpinningThrow() {
+    return ThrowTrajectory({0.3f, 1.2f, 0.4f}, Identity(), {2.0f, 3.0f, -8.0f}, {0.7f, 34.0f, 0.3f});
+}
+
+static void BM_ClosedFormPose(benchmark::State& bench) {
+    ThrowTrajectory trajectory = SpinningThrow();
+    float t = 0.0f;
+    for (auto _ : bench) {
+        Vec3 position;
+        Quat rotation;
+        trajectory.Evaluate(t, position, rotation);
+        benchmark::DoNotOptimize(position);
+        benchmark::DoNotOptimize(rotation);
+        t += 1.0f / 90.0f;
+    }
+}
+
+static void BM_IncrementalStep(benchmark::State& bench) {
+    ThrowTrajectory trajectory = SpinningThrow();
+    Vec3 position = trajectory.Origin();
+    Quat rotation = trajectory.OriginRotation();
+    for (auto _ : bench) {
+        rotation = FromAngularVelocity(trajectory.AngularVelocity(), 1.0f / 90.0f) * rotation;
+        position = position + trajectory.Velocity() * (1.0f / 90.0f);
+        benchmark::DoNotOptimize(position);
+        benchmark::DoNotOptimize(rotation);
+    }
+}
+
+BENCHMARK(BM_ClosedFormPose);
+BENCHMARK(BM_IncrementalStep);
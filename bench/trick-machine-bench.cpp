@@ -0,0 +1,38 @@
+// ns/tick and ticks/sec for two sabers through the trick state machine, per synthetic scenario
+// (test/support/trick-scenarios.hpp). One tick is the hand samples plus TickTrick() for both.
+
+#include "support/trick-scenarios.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace TrickSaber::Test;
+
+static void RunScenario(benchmark::State& bench, Scenario const& scenario) {
+    ScenarioRun run;
+    size_t k = 0;
+    for (auto _ : bench) {
+        run.Tick(scenario[k]);
+        benchmark::DoNotOptimize(run.sabers);
+        if (++k == scenario.size()) {
+            k = 0;
+        }
+    }
+    bench.counters["ticks/s"] = benchmark::Counter(static_cast<double>(bench.iterations()), benchmark::Counter::kIsRate);
+    // Seconds per tick, printed with an SI prefix (n)
+    bench.counters["tick"] = benchmark::Counter(static_cast<double>(bench.iterations()),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+static void BM_Flicks(benchmark::State& bench) { RunScenario(bench, Flicks(16)); }
+static void BM_LongHolds(benchmark::State& bench) { RunScenario(bench, LongHolds(2)); }
+static void BM_ThrowRecallSpam(benchmark::State& bench) { RunScenario(bench, ThrowRecallSpam(1000)); }
+static void BM_ZeroDeltaTime(benchmark::State& bench) { RunScenario(bench, TinyDeltaTime(16, 0.0f)); }
+static void BM_TinyDeltaTime(benchmark::State& bench) { RunScenario(bench, TinyDeltaTime(16, 1e-6f)); }
+static void BM_BothHands(benchmark::State& bench) { RunScenario(bench, BothHands(16)); }
+
+BENCHMARK(BM_Flicks);
+BENCHMARK(BM_LongHolds);
+BENCHMARK(BM_ThrowRecallSpam);
+BENCHMARK(BM_ZeroDeltaTime);
+BENCHMARK(BM_TinyDeltaTime);
+BENCHMARK(BM_BothHands);
@@ -0,0 +1,36 @@
+// Cost of a release velocity estimate over a full MotionHistory: the plain fit, and the
+// peak search over the last 60 ms that "Peak Throw Velocity" uses.
+
+#include "physics/velocity-estimator.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+using namespace TrickSaber::Math;
+
+static MotionHistory FullHistory() {
+    MotionHistory history;
+    for (int k = 0; k < MotionHistory::CAPACITY; k++) {
+        double t = k / 90.0;
+        history.Push(static_cast<uint64_t>(t * 1e9), {0.3f * static_cast<float>(std::sin(9.4 * t)), 1.2f, 0.3f});
+    }
+    return history;
+}
+
+static void BM_LinearVelocity(benchmark::State& bench) {
+    MotionHistory history = FullHistory();
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(history.LinearVelocity(0.05f));
+    }
+}
+
+static void BM_PeakLinearVelocity(benchmark::State& bench) {
+    MotionHistory history = FullHistory();
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(history.PeakLinearVelocity(0.05f, 0.06f));
+    }
+}
+
+BENCHMARK(BM_LinearVelocity);
+BENCHMARK(BM_PeakLinearVelocity);
@@ -0,0 +1,45 @@
+include_guard()
+
+message("Compiling with Google Benchmark")
+
+# Google Benchmark: the installed package if there is one, else fetched
+find_package(benchmark CONFIG QUIET)
+if(NOT benchmark_FOUND)
+    include(FetchContent)
+    FetchContent_Declare(
+        googlebenchmark
+        URL https://github.com/google/benchmark/archive/refs/tags/v1.7.1.zip
+    )
+
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+    FetchContent_MakeAvailable(googlebenchmark)
+endif()
+
+enable_testing()
+
+# Run at end to link with project
+cmake_language(DEFER DIRECTORY ${CMAKE_SOURCE_DIR} CALL _setup_benchmark_project())
+
+function(_setup_benchmark_project)
+    # recursively get all src files
+    RECURSE_FILES(cpp_bench_file_list ${CMAKE_CURRENT_SOURCE_DIR}/bench/*.cpp)
+
+    add_executable(
+        ${PROJECT_NAME}_bench
+        ${cpp_bench_file_list}
+    )
+    target_link_libraries(
+        ${PROJECT_NAME}_bench
+        PRIVATE ${PROJECT_NAME}_host
+        benchmark::benchmark_main
+    )
+
+    target_include_directories(${PROJECT_NAME}_bench PRIVATE ${INCLUDE_DIR})
+    target_include_directories(${PROJECT_NAME}_bench PRIVATE ${CMAKE_CURRENT_SOURCE_DIR}/test)
+    target_include_directories(${PROJECT_NAME}_bench PRIVATE ${CMAKE_CURRENT_SOURCE_DIR}/bench)
+
+    # A short run under ctest so a benchmark that breaks fails the build; run the binary
+    # itself for real numbers.
+    add_test(NAME ${PROJECT_NAME}_bench COMMAND ${PROJECT_NAME}_bench --benchmark_min_time=0.01)
+endfunction(_setup_benchmark_project)
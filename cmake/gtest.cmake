@@ -2,16 +2,19 @@ include_guard()
 
 message("Compiling with GTest")
 
-# GTest
-include(FetchContent)
-FetchContent_Declare(
-    googletest
-    URL https://github.com/google/googletest/archive/03597a01ee50ed33e9dfd640b249b4be3799d395.zip
-)
+# GTest: the installed package if there is one, else fetched
+find_package(GTest CONFIG QUIET)
+if(NOT GTest_FOUND)
+    include(FetchContent)
+    FetchContent_Declare(
+        googletest
+        URL https://github.com/google/googletest/archive/03597a01ee50ed33e9dfd640b249b4be3799d395.zip
+    )
 
-# For Windows: Prevent overriding the parent project's compiler/linker settings
-set(gtest_force_shared_crt ON CACHE BOOL "" FORCE)
-FetchContent_MakeAvailable(googletest)
+    # For Windows: Prevent overriding the parent project's compiler/linker settings
+    set(gtest_force_shared_crt ON CACHE BOOL "" FORCE)
+    FetchContent_MakeAvailable(googletest)
+endif()
 
 enable_testing()
 
@@ -28,9 +31,10 @@ function(_setup_gtest_project)
         ${cpp_test_file_list}
         ${c_test_file_list}
     )
+    # The host library (cmake/host.cmake); the mod itself only links on device
     target_link_libraries(
         ${PROJECT_NAME}_test
-        PRIVATE ${PROJECT_NAME}
+        PRIVATE ${PROJECT_NAME}_host
         GTest::gtest_main
     )
 
@@ -40,4 +44,12 @@ function(_setup_gtest_project)
 
     include(GoogleTest)
     gtest_discover_tests(${PROJECT_NAME}_test)
+
+    # The math suite again on the portable path, which the main binary's SIMD build skips
+    add_executable(${PROJECT_NAME}_math_scalar_test ${CMAKE_CURRENT_SOURCE_DIR}/test/physics/math-test.cpp)
+    target_compile_definitions(${PROJECT_NAME}_math_scalar_test PRIVATE TS_MATH_SCALAR=1)
+    target_link_libraries(${PROJECT_NAME}_math_scalar_test PRIVATE GTest::gtest_main)
+    target_include_directories(${PROJECT_NAME}_math_scalar_test PRIVATE ${INCLUDE_DIR})
+    target_include_directories(${PROJECT_NAME}_math_scalar_test PRIVATE ${CMAKE_CURRENT_SOURCE_DIR}/test)
+    gtest_discover_tests(${PROJECT_NAME}_math_scalar_test TEST_PREFIX Scalar.)
 endfunction(_setup_gtest_project)
@@ -0,0 +1,47 @@
+include_guard()
+
+# Host build (QUEST off): the mod's Unity-free sources as a static library, compiled against
+# the counting stand-ins in tools/budget/facade, with the gtest suite, the google-benchmark
+# suite and the host tools. Nothing here needs the NDK or qpm dependencies.
+#   cmake -S . -B build-host -DQUEST=OFF && cmake --build build-host && ctest --test-dir build-host
+
+message("Host build: tests, benchmarks and tools")
+
+set(FACADE_DIR ${CMAKE_CURRENT_SOURCE_DIR}/tools/budget/facade)
+
+find_package(Threads REQUIRED)
+
+add_library(
+    ${PROJECT_NAME}_host
+    STATIC
+    ${SOURCE_DIR}/logger.cpp
+    ${SOURCE_DIR}/beatmap/gap-index.cpp
+    ${SOURCE_DIR}/combo/library.cpp
+    ${SOURCE_DIR}/combo/scheduler.cpp
+    ${SOURCE_DIR}/input/bindings.cpp
+    ${SOURCE_DIR}/input/hand-input.cpp
+    ${SOURCE_DIR}/perf/timers.cpp
+    ${SOURCE_DIR}/perf/trace.cpp
+    ${SOURCE_DIR}/physics/blade-sweep.cpp
+    ${SOURCE_DIR}/physics/return-path.cpp
+    ${SOURCE_DIR}/physics/velocity-estimator.cpp
+    ${SOURCE_DIR}/replication/remote-saber.cpp
+    ${SOURCE_DIR}/replication/stream.cpp
+    ${SOURCE_DIR}/saber/pose-writer.cpp
+    ${SOURCE_DIR}/saber/state-store.cpp
+    ${SOURCE_DIR}/saber/thrown-cuts.cpp
+    ${SOURCE_DIR}/saber/tick-pipeline.cpp
+    ${SOURCE_DIR}/saber/trick-machine.cpp
+    ${SOURCE_DIR}/settings/save-worker.cpp
+)
+# facade first, so its headers stand in for the game's
+target_include_directories(${PROJECT_NAME}_host BEFORE PUBLIC ${FACADE_DIR})
+target_include_directories(${PROJECT_NAME}_host PUBLIC ${INCLUDE_DIR})
+target_link_libraries(${PROJECT_NAME}_host PUBLIC Threads::Threads)
+
+include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/gtest.cmake)
+include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/benchmark.cmake)
+
+# The report tools build with the tree; each one's CMakeLists.txt says what it measures.
+add_subdirectory(${CMAKE_CURRENT_SOURCE_DIR}/tools/perf)
+add_subdirectory(${CMAKE_CURRENT_SOURCE_DIR}/tools/recording)
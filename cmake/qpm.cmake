@@ -29,5 +29,9 @@ set(COMPILE_ID ${CMAKE_PROJECT_NAME})
 # TODO: Setup qpm extern from toolchain
 cmake_language(DEFER DIRECTORY ${CMAKE_SOURCE_DIR} CALL _setup_qpm_project())
 function(_setup_qpm_project)
+    # The host build (QUEST off) uses no qpm dependencies
+    if(NOT QUEST)
+        return()
+    endif()
     include(${CMAKE_CURRENT_SOURCE_DIR}/extern.cmake)
 endfunction(_setup_qpm_project)
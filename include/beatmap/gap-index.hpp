@@ -0,0 +1,70 @@
+#pragma once
+
+// Per-hand free windows of a level: the stretches where a hand has nothing to cut, each with
+// when it starts, how long it lasts and when that hand's next required cut comes. Built once
+// per level from the beatmap's timeline, on a worker thread; the tick asks how long a hand
+// has until its next cut, which is amortized O(1) while song time runs forward and a binary
+// search after a seek or restart.
+//
+// A hand is busy at each of its notes (chain links included) and from the head to the tail
+// of each of its arcs and chains; the windows are the gaps between. Bombs and walls need no
+// cut, so they do not close a window.
+//
+// Pure C++ with no Unity types, so host tools can build and query it.
+
+#include <cstdint>
+#include <vector>
+
+namespace TrickSaber::Beatmap {
+
+    constexpr int HAND_COUNT = 2;  // Config::Left, Config::Right
+
+    enum class TimelineKind : uint8_t { Note, Bomb, Obstacle, Slider };
+
+    // One beatmap object, in song seconds. hand is the hand that cuts it, -1 for none.
+    struct TimelineItem {
+        float time;
+        float endTime;  // Tail of a slider, end of a wall; time for everything else
+        TimelineKind kind;
+        int8_t hand;
+    };
+
+    struct FreeWindow {
+        float start;    // -INFINITY for the one before a hand's first cut
+        float length;   // INFINITY for the one after its last
+        float nextCut;  // start + length, exact at the ends
+    };
+
+    struct GapIndex {
+        std::vector<FreeWindow> windows[HAND_COUNT];  // By start, non-overlapping
+        uint32_t generation = 0;                      // Build it came from; see StartGapIndexBuild()
+    };
+
+    // Sorts a copy of the items' busy intervals per hand and merges them into windows.
+    GapIndex BuildGapIndex(std::vector<TimelineItem> const& items);
+
+    // Where the last query for each hand landed.
+    struct GapCursor {
+        int window[HAND_COUNT] = {0, 0};  // First window whose nextCut is after the last query
+    };
+
+    // Seconds from songTime to the hand's next required cut: 0 while the hand is busy, and
+    // INFINITY once it has nothing left to cut.
+    float TimeUntilNextCut(GapIndex const& index, GapCursor& cursor, int hand, float songTime);
+
+    // --- One index per level, built off the main thread ---
+    // Main thread. Hands the items to a new worker and forgets the current index; a build
+    // still running for an earlier level is discarded when it finishes.
+    void StartGapIndexBuild(std::vector<TimelineItem> items);
+
+    // Main thread. The index for the current level once its build has finished, else null.
+    // Picking up a new index resets cursor.
+    GapIndex const* CurrentGapIndex(GapCursor& cursor);
+
+    // Main thread. Forgets the current index and any build in flight.
+    void ClearGapIndex();
+
+    // Nanoseconds the last finished build took on its worker.
+    uint64_t LastGapIndexBuildNs();
+
+}  // namespace TrickSaber::Beatmap
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "combo/scheduler.hpp"
+
+namespace TrickSaber::Combo {
+
+    // Built-in combos, indexed by the per-hand Combo config value.
+    enum ComboId : int { SpinThrow = 0, DoubleThrow = 1, ReverseSpin = 2, ComboCount = 3 };
+
+    char const* ComboName(int id);
+
+    // nullptr for an out-of-range id.
+    ComboFn GetCombo(int id);
+
+}  // namespace TrickSaber::Combo
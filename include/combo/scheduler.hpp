@@ -0,0 +1,71 @@
+#pragma once
+
+// Runs at most one combo per saber slot. Each running combo gets a runner from a fixed pool
+// with its own arena, so starting one never allocates, and a saber slot maps to its runner by
+// index so slots can be compacted without moving live coroutine frames.
+
+#include "combo/sequence.hpp"
+#include "settings/tuning.hpp"
+
+#include <cstdint>
+
+namespace TrickSaber::Combo {
+
+    using ComboFn = Sequence (*)(ComboContext&);
+
+    static_assert(Saber::MAX_SABERS <= 64, "free runners are tracked in a 64-bit mask");
+
+    class ComboScheduler {
+    public:
+        ComboScheduler();
+
+        // Claims a runner for fn on slot; its body starts on the slot's next Tick(). Returns false
+        // if the slot already runs a combo or the combo's frame does not fit in the arena.
+        bool Start(int slot, ComboFn fn);
+
+        void Cancel(int slot);
+        void CancelAll();
+        bool Running(int slot) const { return runnerForSlot[slot] >= 0; }
+        int ActiveCount() const { return activeCount; }
+
+        // The running combo's context, for reading its outputs outside Tick(); nullptr if none.
+        ComboContext const* Context(int slot) const {
+            return runnerForSlot[slot] >= 0 ? &runners[runnerForSlot[slot]].context : nullptr;
+        }
+
+        // After SaberStateStore::Remove() moved slot from into slot to. Cancel to's combo first.
+        void MoveSlot(int from, int to);
+
+        // Refreshes the slot's inputs and resumes its combo once if what it waits for has
+        // happened. Returns the context whose outputs drive the slot this tick, or nullptr when
+        // no combo runs on it, including one that just finished.
+        ComboContext const* Tick(int slot, float now, uint32_t handActions, uint32_t handPressed, Saber::SaberInteractionState state);
+
+    private:
+        struct Runner {
+            ComboContext context;
+            Sequence sequence;
+        };
+
+        void Free(int slot);
+
+        Runner runners[Saber::MAX_SABERS];
+        int8_t runnerForSlot[Saber::MAX_SABERS];
+        uint64_t freeRunners;
+        int activeCount = 0;
+    };
+
+    // Tuning the machine runs with while a combo drives the saber: both actions count as bound
+    // and the spin direction flips when the combo asks for a counter-spin.
+    inline Config::HandTuning ComboTuning(Config::HandTuning tuning, bool reverseSpin) {
+        tuning.throwBound = true;
+        tuning.spinBound = true;
+        if (reverseSpin) {
+            tuning.spinDirection = -tuning.spinDirection;
+            tuning.spinDegPerSec = -tuning.spinDegPerSec;
+            tuning.spinRadPerSec = -tuning.spinRadPerSec;
+        }
+        return tuning;
+    }
+
+}  // namespace TrickSaber::Combo
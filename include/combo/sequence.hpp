@@ -0,0 +1,160 @@
+#pragma once
+
+// Scripted trick combos as C++20 coroutines. A combo is a function taking its context first,
+//
+//   Sequence MyCombo(ComboContext& ctx) {
+//       ctx.Hold(Input::Spin);
+//       co_await ctx.Seconds(0.4f);
+//       ctx.Release(Input::Spin);
+//   }
+//
+// that drives one saber by holding and releasing the same actions the player's buttons do,
+// suspending on ticks, durations, the player's input edges or the saber's state in between.
+// The trick machine sees those actions in place of the hand's, so every transition still goes
+// through TickTrick().
+//
+// Frames are placed in the context's fixed arena, never the heap; a coroutine returning
+// Sequence that does not take a ComboContext& first does not compile. ComboScheduler
+// (combo/scheduler.hpp) owns the contexts and resumes each sequence at most once per tick,
+// and only when its wait is satisfied.
+
+#include "input/bindings.hpp"
+#include "saber/trick-machine.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+
+namespace TrickSaber::Combo {
+
+    // Room for one combo's coroutine frame. The compiler sizes frames from the combo's locals;
+    // one that does not fit fails to start instead of allocating.
+    constexpr std::size_t ARENA_BYTES = 512;
+
+    class ComboArena {
+    public:
+        void* Allocate(std::size_t size) {
+            constexpr std::size_t align = alignof(std::max_align_t);
+            std::size_t aligned = (size + align - 1) & ~(align - 1);
+            if (aligned > ARENA_BYTES - used) {
+                return nullptr;
+            }
+            void* p = buffer + used;
+            used += aligned;
+            return p;
+        }
+
+        // Frees everything at once; only valid once the frames in it are destroyed.
+        void Rewind() { used = 0; }
+        std::size_t Used() const { return used; }
+
+    private:
+        alignas(std::max_align_t) std::byte buffer[ARENA_BYTES];
+        std::size_t used = 0;
+    };
+
+    enum class WaitKind : uint8_t { None, Ticks, Until, Pressed, Released, State };
+
+    // What a suspended sequence is waiting for; checked by the scheduler without resuming it.
+    struct Wait {
+        WaitKind kind = WaitKind::None;
+        Saber::SaberInteractionState state = Saber::SaberInteractionState::Held;
+        uint32_t mask = 0;
+        int ticks = 0;
+        float until = 0.0f;
+    };
+
+    class Sequence {
+    public:
+        struct promise_type;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Sequence() = default;
+        explicit Sequence(Handle handle) : handle(handle) {}
+        Sequence(Sequence&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+        Sequence& operator=(Sequence&& other) noexcept {
+            if (this != &other) {
+                Reset();
+                handle = other.handle;
+                other.handle = nullptr;
+            }
+            return *this;
+        }
+        Sequence(Sequence const&) = delete;
+        Sequence& operator=(Sequence const&) = delete;
+        ~Sequence() { Reset(); }
+
+        bool Valid() const { return static_cast<bool>(handle); }
+        bool Done() const { return !handle || handle.done(); }
+        void Resume() { handle.resume(); }
+        Wait& Waiting();
+
+        void Reset() {
+            if (handle) {
+                handle.destroy();
+                handle = nullptr;
+            }
+        }
+
+    private:
+        Handle handle;
+    };
+
+    // Returned by the ComboContext wait helpers; stores the condition in the promise and suspends.
+    struct WaitFor {
+        Wait wait;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(Sequence::Handle handle) const noexcept;
+        void await_resume() const noexcept {}
+    };
+
+    // One saber's view of a running combo.
+    struct ComboContext {
+        // --- Inputs, refreshed by the scheduler every tick ---
+        float now = 0.0f;
+        uint32_t handActions = 0;   // The player's action bits on this saber's hand
+        uint32_t handPressed = 0;   // Of those, the ones that went down this tick
+        Saber::SaberInteractionState state = Saber::SaberInteractionState::Held;
+
+        // --- Outputs, read by the tick in place of the hand's actions ---
+        uint32_t actions = 0;
+        bool reverseSpin = false;
+
+        void Hold(Input::Action action) { actions |= Input::ActionBit(action); }
+        void Release(Input::Action action) { actions &= ~Input::ActionBit(action); }
+
+        WaitFor NextTick() const { return Ticks(1); }
+        WaitFor Ticks(int count) const { return {{WaitKind::Ticks, {}, 0, count, 0.0f}}; }
+        WaitFor Seconds(float seconds) const { return {{WaitKind::Until, {}, 0, 0, now + seconds}}; }
+        WaitFor UntilPressed(Input::Action action) const { return {{WaitKind::Pressed, {}, Input::ActionBit(action), 0, 0.0f}}; }
+        WaitFor UntilReleased(Input::Action action) const { return {{WaitKind::Released, {}, Input::ActionBit(action), 0, 0.0f}}; }
+        WaitFor UntilState(Saber::SaberInteractionState target) const { return {{WaitKind::State, target, 0, 0, 0.0f}}; }
+
+        ComboArena arena;
+    };
+
+    struct Sequence::promise_type {
+        Wait wait;
+
+        static void* operator new(std::size_t size, ComboContext& context) noexcept { return context.arena.Allocate(size); }
+        static void operator delete(void*, std::size_t) noexcept {}  // The arena is rewound when the runner is freed
+        static Sequence get_return_object_on_allocation_failure() noexcept { return Sequence(); }
+
+        Sequence get_return_object() noexcept { return Sequence(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    inline Wait& Sequence::Waiting() {
+        return handle.promise().wait;
+    }
+
+    inline void WaitFor::await_suspend(Sequence::Handle handle) const noexcept {
+        handle.promise().wait = wait;
+    }
+
+}  // namespace TrickSaber::Combo
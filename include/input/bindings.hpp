@@ -0,0 +1,75 @@
+#pragma once
+
+// Button bindings compiled from config into per-hand tables, and the per-tick tracker
+// that turns one raw button mask per controller into action states. Pure C++ so the
+// semantics are the same on device and in host tools.
+
+#include <cstdint>
+
+namespace TrickSaber::Input {
+
+    // Raw button bits, one per config button index (index - 1).
+    enum ButtonBit : uint32_t {
+        ButtonOne = 1u << 0,     // A / X
+        ButtonTwo = 1u << 1,     // B / Y
+        IndexTrigger = 1u << 2,
+        HandTrigger = 1u << 3,
+    };
+    constexpr int BUTTON_COUNT = 4;
+
+    enum Action : int { Throw = 0, Spin = 1, Combo = 2, NextPreset = 3, ActionCount = 4 };
+
+    constexpr uint32_t ActionBit(Action action) { return 1u << action; }
+
+    // Second press of a double-tap binding must start within this long of the first.
+    constexpr float DOUBLE_TAP_WINDOW = 0.3f;
+
+    // An action is held while every button in mask is held (a chord when more than one).
+    // With doubleTap it only engages on the second press of the chord within DOUBLE_TAP_WINDOW,
+    // and stays engaged until the chord is released.
+    struct Binding {
+        uint32_t mask = 0;
+        bool doubleTap = false;
+    };
+
+    // Config button index (0 none, 1..BUTTON_COUNT) to its raw bit.
+    constexpr uint32_t ButtonBitForConfig(int configuredButtonIndex) {
+        return configuredButtonIndex > 0 && configuredButtonIndex <= BUTTON_COUNT ? 1u << (configuredButtonIndex - 1) : 0u;
+    }
+
+    // A chord button without a main button is ignored, so "None" always means unbound.
+    constexpr Binding CompileBinding(int button, int chordButton, bool doubleTap) {
+        uint32_t mask = ButtonBitForConfig(button);
+        if (mask != 0) {
+            mask |= ButtonBitForConfig(chordButton);
+        }
+        return {mask, doubleTap && mask != 0};
+    }
+
+    class InputTracker {
+    public:
+        InputTracker() {
+            for (float& time : lastChordPress) {
+                time = -1e9f;
+            }
+        }
+
+        // Takes this tick's raw button mask and returns the active action bits.
+        uint32_t Update(uint32_t buttons, float now, Binding const* bindings);
+
+        uint32_t Buttons() const { return current; }
+        uint32_t PressedEdges() const { return current & (current ^ previous); }
+        uint32_t ReleasedEdges() const { return previous & (current ^ previous); }
+        uint32_t Actions() const { return actions; }
+
+        void Reset() { *this = InputTracker(); }
+
+    private:
+        uint32_t current = 0;
+        uint32_t previous = 0;
+        uint32_t actions = 0;
+        uint32_t chordHeld = 0;  // per action, chord fully held last tick
+        float lastChordPress[ActionCount];
+    };
+
+}  // namespace TrickSaber::Input
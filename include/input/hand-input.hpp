@@ -0,0 +1,27 @@
+#pragma once
+
+#include "input/bindings.hpp"
+#include "settings/snapshot.hpp"
+
+#include <cstdint>
+
+namespace TrickSaber::Input {
+
+    // One input poll per controller per tick.
+    // Each distinct bound button is read once into the hand's raw mask, which the hand's tracker
+    // resolves into action bits for every saber on that hand. inputPollNs is when the poll ran,
+    // which is where edge-to-write latency starts.
+    struct HandInput {
+        InputTracker tracker[Config::HandCount];
+        uint32_t actions[Config::HandCount] = {0, 0};
+        uint32_t pressed[Config::HandCount] = {0, 0};   // Actions that went down this tick
+        uint32_t recorded[Config::HandCount] = {0, 0};  // Recording::BUTTON_* bits the sabers ran with
+        uint64_t inputPollNs = 0;
+    };
+
+    GlobalNamespace::OVRInput::Controller HandController(Config::Hand hand);
+
+    // The tick's only OVRInput calls: config.hands[h].pollCount per hand.
+    void PollInput(HandInput& input, Config::Snapshot const& config, float now);
+
+}  // namespace TrickSaber::Input
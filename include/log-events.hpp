@@ -0,0 +1,29 @@
+#pragma once
+
+// Event and level ids for the hook-path event log. Kept free of paper/scotland2 includes
+// so the trick state machine can name them in host builds.
+
+#include <cstdint>
+
+namespace TrickSaber::Log {
+
+    enum class Level : uint8_t { Debug = 0, Info = 1, Warn = 2, Error = 3 };
+
+    enum class Event : uint8_t {
+        ThrowInitiated,
+        GentleThrow,
+        StraightThrow,
+        NormalThrow,
+        RecallInitiated,
+        SpinActivated,
+        SpinDeactivated,
+        Reparented,
+        ReturnedToHand,
+        SaberInvalid,
+        NoteCut,
+        BombHit,
+        ObstacleHit,
+        AutoRecall,
+    };
+
+}  // namespace TrickSaber::Log
@@ -2,8 +2,54 @@
 
 #include "scotland2/shared/loader.hpp"
 #include "paper2_scotland2/shared/logger.hpp"
+#include "log-events.hpp"
+#include "perf/trace.hpp"
 
+#include <cstdint>
 
 inline modloader::ModInfo modInfo = {MOD_ID, VERSION, 0};
 
-Paper::ConstLoggerContext<12UL> getLogger();
\ No newline at end of file
+Paper::ConstLoggerContext<12UL> getLogger();
+
+// Hook-path event log. The tick pushes fixed-size binary records into a lock-free
+// single-producer ring; a background thread formats them and hands them to getLogger().
+// Producer side must be the Unity main thread (all hooks run there).
+#ifndef TS_HOOK_LOG_LEVEL
+    #define TS_HOOK_LOG_LEVEL 1
+#endif
+
+namespace TrickSaber::Log {
+
+    struct Record {
+        uint64_t timestampNs;
+        Event event;
+        Level level;
+        uint8_t slot;
+        uint8_t hand;
+        float values[4];
+    };
+    static_assert(sizeof(Record) == 32, "keep records two per cache line");
+
+    // Starts the background flush thread. Records pushed before this are kept until it runs.
+    void Start();
+
+    void Push(Level level, Event event, int slot, int hand, float a = 0.0f, float b = 0.0f, float c = 0.0f, float d = 0.0f);
+
+    // Records lost because the ring was full when the hook tried to push.
+    uint64_t DroppedRecords();
+
+    inline float FirstValue() { return 0.0f; }
+    template <typename T, typename... Rest>
+    inline float FirstValue(T first, Rest...) { return static_cast<float>(first); }
+
+    // Compiles to nothing when L is below TS_HOOK_LOG_LEVEL. Every event is also an instant
+    // in a running trace capture, whatever its level.
+    template <Level L, typename... Args>
+    inline void Emit(Event event, int slot, int hand, Args... values) {
+        TS_TRACE_INSTANT(event, slot, hand, FirstValue(values...));
+        if constexpr (static_cast<int>(L) >= TS_HOOK_LOG_LEVEL) {
+            Push(L, event, slot, hand, static_cast<float>(values)...);
+        }
+    }
+
+}  // namespace TrickSaber::Log
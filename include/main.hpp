@@ -6,12 +6,26 @@
 #include "GlobalNamespace/Saber.hpp"
 #include "GlobalNamespace/SaberType.hpp"
 #include "GlobalNamespace/MainMenuViewController.hpp"
+#include "GlobalNamespace/NoteController.hpp"
+#include "GlobalNamespace/NoteData.hpp"
+#include "GlobalNamespace/ObstacleController.hpp"
+#include "GlobalNamespace/CuttableBySaber.hpp"
+#include "GlobalNamespace/BeatmapCallbacksController.hpp"
+#include "GlobalNamespace/IReadonlyBeatmapData.hpp"
+#include "GlobalNamespace/BeatmapDataItem.hpp"
+#include "GlobalNamespace/SliderData.hpp"
+#include "GlobalNamespace/ObstacleData.hpp"
+#include "GlobalNamespace/ColorType.hpp"
+#include "GlobalNamespace/AudioTimeSyncController.hpp"
+#include "System/Collections/Generic/LinkedList_1.hpp"
+#include "System/Collections/Generic/LinkedListNode_1.hpp"
 
 #include "UnityEngine/Transform.hpp"
 #include "UnityEngine/GameObject.hpp"
 #include "UnityEngine/Time.hpp"
 #include "UnityEngine/Vector3.hpp"
 #include "UnityEngine/Quaternion.hpp"
+#include "UnityEngine/Bounds.hpp"
 #include "UnityEngine/Rigidbody.hpp"
 #include "UnityEngine/Mathf.hpp"
 
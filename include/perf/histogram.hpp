@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+
+namespace TrickSaber::Perf {
+
+    // Fixed-memory log-linear histogram of nanosecond samples. Values below 2^SUB_BITS get
+    // exact buckets; above that every power of two is split into 2^SUB_BITS linear buckets,
+    // so any recorded value is off by at most 1/2^SUB_BITS (~6%). Record() never allocates.
+    class LatencyHistogram {
+    public:
+        static constexpr int SUB_BITS = 4;
+        static constexpr int SUB_COUNT = 1 << SUB_BITS;
+        static constexpr int MAX_EXPONENT = 35;  // ~34 s, anything above is clamped
+        static constexpr int BUCKET_COUNT = (MAX_EXPONENT - SUB_BITS + 2) * SUB_COUNT;
+
+        static int BucketIndex(uint64_t ns) {
+            if (ns < SUB_COUNT) {
+                return static_cast<int>(ns);
+            }
+            int exponent = 63 - __builtin_clzll(ns);
+            if (exponent > MAX_EXPONENT) {
+                return BUCKET_COUNT - 1;
+            }
+            int sub = static_cast<int>((ns >> (exponent - SUB_BITS)) & (SUB_COUNT - 1));
+            return (exponent - SUB_BITS + 1) * SUB_COUNT + sub;
+        }
+
+        // Smallest value that lands in bucket index.
+        static uint64_t BucketLowerBound(int index) {
+            if (index < SUB_COUNT) {
+                return static_cast<uint64_t>(index);
+            }
+            int exponent = index / SUB_COUNT + SUB_BITS - 1;
+            uint64_t sub = static_cast<uint64_t>(index % SUB_COUNT);
+            return (uint64_t(1) << exponent) + (sub << (exponent - SUB_BITS));
+        }
+
+        static uint64_t BucketWidth(int index) {
+            if (index < SUB_COUNT) {
+                return 1;
+            }
+            int exponent = index / SUB_COUNT + SUB_BITS - 1;
+            return uint64_t(1) << (exponent - SUB_BITS);
+        }
+
+        void Record(uint64_t ns) {
+            counts[BucketIndex(ns)]++;
+            total++;
+            max = std::max(max, ns);
+        }
+
+        // Value at quantile q in [0, 1], reported as the middle of the bucket it falls in.
+        uint64_t Percentile(double q) const {
+            if (total == 0) {
+                return 0;
+            }
+            uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+            uint64_t seen = 0;
+            for (int i = 0; i < BUCKET_COUNT; i++) {
+                seen += counts[i];
+                if (seen >= rank) {
+                    return std::min(BucketLowerBound(i) + BucketWidth(i) / 2, max);
+                }
+            }
+            return max;
+        }
+
+        uint64_t Count() const { return total; }
+        uint64_t Max() const { return max; }
+
+        void Reset() {
+            std::fill(std::begin(counts), std::end(counts), 0u);
+            total = 0;
+            max = 0;
+        }
+
+    private:
+        uint32_t counts[BUCKET_COUNT] = {};
+        uint64_t total = 0;
+        uint64_t max = 0;
+    };
+
+}  // namespace TrickSaber::Perf
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "perf/histogram.hpp"
+
+#include <cstdint>
+#include <string>
+#include <time.h>
+
+namespace TrickSaber::Perf {
+
+    enum class Metric : int {
+        FixedUpdateHook,
+        SaberInitHook,
+        MainMenuDidActivateHook,
+        SaberHeldTick,
+        SaberThrownTick,
+        SaberReturningTick,
+        ButtonEdgeToWrite,
+        SaberRenderUpdateHook,
+        ComboTick,
+        PresetSwitch,
+        SettingChange,
+        BladeSweep,
+        BeatmapRead,
+        TickFinish,
+        TickLatency,
+        TransformICall,       // ns per call, from the startup self-test
+        TransformWrapper,
+        Count,
+    };
+
+    // Values counted once per tick, reported as the latest and the largest seen.
+    enum class Counter : int {
+        LivenessChecks,
+        InlineTickSabers,
+        PoseWritesIssued,  // Per second, over the pose writer's last one-second window
+        PoseWritesElided,
+        Count,
+    };
+
+    void SetCounter(Counter counter, uint64_t value);
+
+    inline uint64_t NowNs() {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    LatencyHistogram& Histogram(Metric metric);
+
+    inline void Record(Metric metric, uint64_t ns) {
+        Histogram(metric).Record(ns);
+    }
+
+    // Times the enclosing scope into one histogram.
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Metric metric) : metric(metric), start(NowNs()) {}
+        ~ScopedTimer() { Record(metric, NowNs() - start); }
+
+        ScopedTimer(ScopedTimer const&) = delete;
+        ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+    private:
+        Metric metric;
+        uint64_t start;
+    };
+
+    void ResetAll();
+
+    // One line per metric with count, p50/p99/p99.9 and max in microseconds.
+    std::string FormatSummary();
+
+}  // namespace TrickSaber::Perf
@@ -0,0 +1,128 @@
+#pragma once
+
+// Opt-in timeline tracing: begin/end spans around the hooks and their phases, and instant
+// events for every hook-path log event (throws, recalls, spins), dumped as Chrome trace JSON
+// that chrome://tracing and ui.perfetto.dev open as-is. The histograms in perf/timers.hpp say
+// how slow a tick is; a trace shows what a particular slow tick was doing.
+//
+// Each thread that records gets its own fixed buffer the first time it does, so recording is
+// a relaxed load of the capture flag, a clock read and a store, with no locks or atomics shared
+// between threads. While no capture runs a span costs the flag load and a branch. With
+// TS_TRACE=0 the TS_TRACE_* macros compile to nothing.
+//
+// Pure C++ (no Unity or paper types) so host tools can record and dump traces.
+
+#include "log-events.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#ifndef TS_TRACE
+    #define TS_TRACE 1
+#endif
+
+namespace TrickSaber::Trace {
+
+    enum class Span : uint8_t {
+        FixedUpdate,
+        ValidateHandles,
+        HandVelocity,
+        InputPoll,
+        SaberTick,
+        StateApply,
+        PoseWrite,
+        Record,
+        RenderUpdate,
+        SaberInit,
+        MainMenu,
+        BladeSweep,
+        TickApply,
+        Count,
+    };
+
+    char const* SpanName(Span span);
+
+    enum class Phase : uint8_t { Begin, End, Instant };
+
+    struct TraceEvent {
+        uint64_t timestampNs;
+        Phase phase;
+        uint8_t id;     // Span, or Log::Event for instants
+        int8_t slot;    // Saber slot, -1 for none
+        uint8_t hand;
+        float value;
+    };
+    static_assert(sizeof(TraceEvent) == 16);
+
+    constexpr int MAX_THREADS = 4;
+    constexpr uint32_t THREAD_CAPACITY = 1 << 16;  // Events per thread per capture, ~20 s of ticks
+
+    extern std::atomic<bool> capturing;
+
+    // Main thread. Start clears the buffers of every thread that has recorded; false, with
+    // nothing started, while the previous capture is still being written out.
+    bool Start();
+    void Stop();
+    inline bool Capturing() { return capturing.load(std::memory_order_relaxed); }
+
+    // Events not recorded because a buffer was full or more than MAX_THREADS threads recorded.
+    uint64_t Dropped();
+    int EventCount();
+
+    // Slow path of the calls below; only reached while capturing.
+    void Push(Phase phase, uint8_t id, int slot, int hand, float value);
+
+    inline void Begin(Span span, int slot = -1) {
+        if (Capturing()) {
+            Push(Phase::Begin, static_cast<uint8_t>(span), slot, 0, 0.0f);
+        }
+    }
+
+    inline void End(Span span, int slot = -1) {
+        if (Capturing()) {
+            Push(Phase::End, static_cast<uint8_t>(span), slot, 0, 0.0f);
+        }
+    }
+
+    inline void Instant(Log::Event event, int slot, int hand, float value = 0.0f) {
+        if (Capturing()) {
+            Push(Phase::Instant, static_cast<uint8_t>(event), slot, hand, value);
+        }
+    }
+
+    // A span over the enclosing scope.
+    class Scope {
+    public:
+        explicit Scope(Span span, int slot = -1) : span(span), slot(static_cast<int8_t>(slot)) { Begin(span, slot); }
+        ~Scope() { End(span, slot); }
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+    private:
+        Span span;
+        int8_t slot;
+    };
+
+    // Writes the last capture as Chrome trace JSON; call after Stop(). Spans cut off by the
+    // capture's start or end are dropped or closed at the thread's last event, so every "B"
+    // has its "E". Returns the number of trace events written, or -1 on a write error.
+    int WriteChromeJson(std::FILE* file);
+
+    // Stops the capture and writes it to <mod data dir>/traces/ from a background thread.
+    // Returns the file's path, or empty if there was nothing to write or a write is running.
+    std::string StopAndSave();
+
+}  // namespace TrickSaber::Trace
+
+#if TS_TRACE
+    #define TS_TRACE_CONCAT_(a, b) a##b
+    #define TS_TRACE_CONCAT(a, b) TS_TRACE_CONCAT_(a, b)
+    #define TS_TRACE_SCOPE(...) ::TrickSaber::Trace::Scope TS_TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
+    #define TS_TRACE_INSTANT(...) ::TrickSaber::Trace::Instant(__VA_ARGS__)
+#else
+    #define TS_TRACE_SCOPE(...) ((void)0)
+    #define TS_TRACE_INSTANT(...) ((void)0)
+#endif
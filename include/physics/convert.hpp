@@ -0,0 +1,19 @@
+#pragma once
+
+#include "UnityEngine/Quaternion.hpp"
+#include "UnityEngine/Vector3.hpp"
+#include "physics/math.hpp"
+
+// Conversions between the Unity value types and the native math types.
+// Both sides are plain float fields, so these are just member copies.
+namespace TrickSaber::Math {
+
+    inline Vec3 FromUnity(UnityEngine::Vector3 const& v) { return {v.x, v.y, v.z}; }
+
+    inline Quat FromUnity(UnityEngine::Quaternion const& q) { return {q.x, q.y, q.z, q.w}; }
+
+    inline UnityEngine::Vector3 ToUnity(Vec3 v) { return UnityEngine::Vector3(v.x, v.y, v.z); }
+
+    inline UnityEngine::Quaternion ToUnity(Quat q) { return UnityEngine::Quaternion(q.x, q.y, q.z, q.w); }
+
+}  // namespace TrickSaber::Math
@@ -0,0 +1,191 @@
+#pragma once
+
+// Header-only native vector/quaternion math for the FixedUpdate hot path.
+// Mirrors the UnityEngine::Vector3 / Quaternion formulas so results match the
+// il2cpp versions, without going through the codegen invoke machinery.
+
+#include <algorithm>
+#include <cmath>
+
+// TS_MATH_SCALAR forces the portable path, so the host tests can check it next to the SIMD one.
+#if defined(TS_MATH_SCALAR)
+#elif defined(__aarch64__)
+    #include <arm_neon.h>
+    #define TS_MATH_NEON 1
+#elif defined(__SSE__) || defined(__x86_64__)
+    #include <xmmintrin.h>
+    #define TS_MATH_SSE 1
+#endif
+
+namespace TrickSaber::Math {
+
+    constexpr float PI = 3.14159265358979323846f;
+    constexpr float DEG2RAD = PI / 180.0f;
+    constexpr float RAD2DEG = 180.0f / PI;
+
+    struct Vec3 {
+        float x, y, z;
+    };
+
+    struct alignas(16) Quat {
+        float x, y, z, w;
+    };
+
+    constexpr Vec3 Zero() { return {0.0f, 0.0f, 0.0f}; }
+    constexpr Vec3 Right() { return {1.0f, 0.0f, 0.0f}; }
+    constexpr Vec3 Up() { return {0.0f, 1.0f, 0.0f}; }
+    constexpr Vec3 Forward() { return {0.0f, 0.0f, 1.0f}; }
+    constexpr Quat Identity() { return {0.0f, 0.0f, 0.0f, 1.0f}; }
+
+    // --- Vec3 ---
+    // Three lanes are not worth a vector register; these stay scalar and the
+    // compiler folds them into whatever surrounds them.
+    inline Vec3 operator+(Vec3 a, Vec3 b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+    inline Vec3 operator-(Vec3 a, Vec3 b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+    inline Vec3 operator-(Vec3 a) { return {-a.x, -a.y, -a.z}; }
+    inline Vec3 operator*(Vec3 a, float s) { return {a.x * s, a.y * s, a.z * s}; }
+    inline Vec3 operator*(float s, Vec3 a) { return a * s; }
+    inline Vec3 operator/(Vec3 a, float s) { return {a.x / s, a.y / s, a.z / s}; }
+
+    inline float Dot(Vec3 a, Vec3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+    inline Vec3 Cross(Vec3 a, Vec3 b) {
+        return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    }
+
+    inline float SqrMagnitude(Vec3 v) { return Dot(v, v); }
+    inline float Magnitude(Vec3 v) { return std::sqrt(Dot(v, v)); }
+
+    // Same cutoff as Vector3.Normalize: tiny vectors become zero instead of NaN.
+    inline Vec3 Normalized(Vec3 v) {
+        float mag = Magnitude(v);
+        return mag > 1e-5f ? v / mag : Zero();
+    }
+
+    inline Vec3 Lerp(Vec3 a, Vec3 b, float t) {
+        t = std::clamp(t, 0.0f, 1.0f);
+        return a + (b - a) * t;
+    }
+
+    // --- Quat ---
+    inline float Dot(Quat a, Quat b) {
+#if defined(TS_MATH_NEON)
+        return vaddvq_f32(vmulq_f32(vld1q_f32(&a.x), vld1q_f32(&b.x)));
+#else
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+#endif
+    }
+
+    // Hamilton product, same operand order as Quaternion.operator*.
+    inline Quat operator*(Quat a, Quat b) {
+#if defined(TS_MATH_NEON)
+        float32x4_t bv = vld1q_f32(&b.x);
+        // Lane patterns of b for each term, sign flips applied per lane.
+        static float const s1[4] = {1.0f, -1.0f, 1.0f, -1.0f};
+        static float const s2[4] = {1.0f, 1.0f, -1.0f, -1.0f};
+        static float const s3[4] = {-1.0f, 1.0f, 1.0f, -1.0f};
+        float32x4_t b1 = {b.w, b.z, b.y, b.x};
+        float32x4_t b2 = {b.z, b.w, b.x, b.y};
+        float32x4_t b3 = {b.y, b.x, b.w, b.z};
+        float32x4_t r = vmulq_n_f32(bv, a.w);
+        r = vfmaq_f32(r, vmulq_f32(b1, vld1q_f32(s1)), vdupq_n_f32(a.x));
+        r = vfmaq_f32(r, vmulq_f32(b2, vld1q_f32(s2)), vdupq_n_f32(a.y));
+        r = vfmaq_f32(r, vmulq_f32(b3, vld1q_f32(s3)), vdupq_n_f32(a.z));
+        Quat out;
+        vst1q_f32(&out.x, r);
+        return out;
+#elif defined(TS_MATH_SSE)
+        __m128 bv = _mm_load_ps(&b.x);
+        __m128 b1 = _mm_shuffle_ps(bv, bv, _MM_SHUFFLE(0, 1, 2, 3));  // w z y x
+        __m128 b2 = _mm_shuffle_ps(bv, bv, _MM_SHUFFLE(1, 0, 3, 2));  // z w x y
+        __m128 b3 = _mm_shuffle_ps(bv, bv, _MM_SHUFFLE(2, 3, 0, 1));  // y x w z
+        __m128 r = _mm_mul_ps(bv, _mm_set1_ps(a.w));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(b1, _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f)), _mm_set1_ps(a.x)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(b2, _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f)), _mm_set1_ps(a.y)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(b3, _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f)), _mm_set1_ps(a.z)));
+        Quat out;
+        _mm_store_ps(&out.x, r);
+        return out;
+#else
+        return {
+            a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
+            a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+        };
+#endif
+    }
+
+    // Rotates v by q (Quaternion * Vector3), using the two-cross-product form.
+    inline Vec3 operator*(Quat q, Vec3 v) {
+        Vec3 u = {q.x, q.y, q.z};
+        Vec3 t = Cross(u, v) * 2.0f;
+        return v + t * q.w + Cross(u, t);
+    }
+
+    inline Quat Inverse(Quat q) { return {-q.x, -q.y, -q.z, q.w}; }
+
+    inline Quat Normalized(Quat q) {
+        float mag = std::sqrt(Dot(q, q));
+        if (mag < 1e-6f) {
+            return Identity();
+        }
+        float inv = 1.0f / mag;
+        return {q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+    }
+
+    // Angle in degrees like Quaternion.AngleAxis; axis does not need to be normalized.
+    inline Quat AngleAxis(float angleDeg, Vec3 axis) {
+        Vec3 n = Normalized(axis);
+        float half = angleDeg * DEG2RAD * 0.5f;
+        float s = std::sin(half);
+        return {n.x * s, n.y * s, n.z * s, std::cos(half)};
+    }
+
+    // Rotation for angular velocity omega (rad/s) applied over dt seconds.
+    inline Quat FromAngularVelocity(Vec3 omega, float dt) {
+        float mag = Magnitude(omega);
+        if (mag < 1e-6f) {
+            return Identity();
+        }
+        float half = mag * dt * 0.5f;
+        float s = std::sin(half) / mag;
+        return {omega.x * s, omega.y * s, omega.z * s, std::cos(half)};
+    }
+
+    // Inverse of FromAngularVelocity(omega, 1): axis * angle in radians, shortest path.
+    inline Vec3 ToRotationVector(Quat q) {
+        if (q.w < 0.0f) {
+            q = {-q.x, -q.y, -q.z, -q.w};
+        }
+        Vec3 v = {q.x, q.y, q.z};
+        float sinHalf = Magnitude(v);
+        if (sinHalf < 1e-6f) {
+            return v * 2.0f;  // small-angle limit
+        }
+        return v * (2.0f * std::atan2(sinHalf, q.w) / sinHalf);
+    }
+
+    // Spherical interpolation with t clamped to [0, 1], shortest path, like Quaternion.Slerp.
+    inline Quat Slerp(Quat a, Quat b, float t) {
+        t = std::clamp(t, 0.0f, 1.0f);
+        float cosTheta = Dot(a, b);
+        if (cosTheta < 0.0f) {
+            b = {-b.x, -b.y, -b.z, -b.w};
+            cosTheta = -cosTheta;
+        }
+        float wa, wb;
+        if (cosTheta > 0.9995f) {
+            // Nearly parallel, fall back to nlerp to avoid dividing by sin(~0).
+            wa = 1.0f - t;
+            wb = t;
+        } else {
+            float theta = std::acos(cosTheta);
+            float invSin = 1.0f / std::sin(theta);
+            wa = std::sin((1.0f - t) * theta) * invSin;
+            wb = std::sin(t * theta) * invSin;
+        }
+        return Normalized(Quat{a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb, a.w * wa + b.w * wb});
+    }
+
+}  // namespace TrickSaber::Math
@@ -0,0 +1,69 @@
+#pragma once
+
+// Shapes and timing of a saber's flight back to the hand. A return path is a cubic Bézier
+// from where the recall started to the hand, with its two control points given relative to
+// the start-to-hand offset D: so far along D, so far sideways (Up x D) and so far up, all in
+// units of |D|. Whatever D is on a given tick, the path point at progress t is then
+//     start + D * along(t) + (Up x D) * side(t) + Up * |D| * up(t)
+// and those three weights, with the easing applied to t first, only depend on the chosen
+// curve and easing. They are baked into a small table once, so evaluating a return is one
+// table lookup and a few multiply-adds, with no branches on the curve or easing.
+//
+// The hand target itself is led by the hand's velocity over the time left, so the saber
+// heads for where the hand will be at the catch instead of chasing where it is now. The
+// lead shrinks to nothing as the return ends, so the last pose is exactly in the hand.
+
+#include "physics/math.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace TrickSaber::Math {
+
+    enum class ReturnCurve : uint8_t { Straight, Arc, Curl, Count };
+    enum class ReturnEasing : uint8_t { Linear, EaseIn, EaseOut, EaseInOut, Count };
+
+    constexpr int RETURN_PATH_SEGMENTS = 32;
+    constexpr float MAX_RETURN_LEAD = 0.3f;  // metres the target may be led by hand velocity
+
+    // Curve and easing in one byte, as configs and the replication stream carry them.
+    constexpr uint8_t ReturnStyle(ReturnCurve curve, ReturnEasing easing) {
+        return static_cast<uint8_t>(static_cast<int>(curve) | static_cast<int>(easing) << 4);
+    }
+    constexpr uint8_t DEFAULT_RETURN_STYLE = ReturnStyle(ReturnCurve::Straight, ReturnEasing::Linear);
+
+    struct ReturnPath {
+        // Per table entry, evenly spaced over progress 0..1: the weights above, and the eased
+        // progress itself for blending the rotation.
+        float along[RETURN_PATH_SEGMENTS + 1];
+        float side[RETURN_PATH_SEGMENTS + 1];
+        float up[RETURN_PATH_SEGMENTS + 1];
+        float eased[RETURN_PATH_SEGMENTS + 1];
+
+        // Path point and eased progress at t (clamped to 0..1), interpolated between entries.
+        void Sample(Vec3 start, Vec3 target, float t, Vec3& position, float& progress) const {
+            float x = std::clamp(t, 0.0f, 1.0f) * RETURN_PATH_SEGMENTS;
+            int i = std::min(static_cast<int>(x), RETURN_PATH_SEGMENTS - 1);
+            float f = x - static_cast<float>(i);
+            Vec3 offset = target - start;
+            Vec3 sideways = Cross(Up(), offset);
+            position = start + offset * (along[i] + (along[i + 1] - along[i]) * f) +
+                       sideways * (side[i] + (side[i + 1] - side[i]) * f) +
+                       Up() * (Magnitude(offset) * (up[i] + (up[i + 1] - up[i]) * f));
+            progress = eased[i] + (eased[i + 1] - eased[i]) * f;
+        }
+    };
+
+    // The baked path for a style byte; unknown curves or easings fall back to the default.
+    // Every style is baked on the first call, which the config snapshot makes on load.
+    ReturnPath const& ReturnPathFor(uint8_t style);
+
+    // Where to aim a return that ends in remaining seconds: the hand target led by the
+    // hand's velocity, at most MAX_RETURN_LEAD away.
+    inline Vec3 PredictReturnTarget(Vec3 target, Vec3 handVelocity, float remaining) {
+        Vec3 lead = handVelocity * std::max(remaining, 0.0f);
+        float length = Magnitude(lead);
+        return target + lead * std::min(1.0f, MAX_RETURN_LEAD / std::max(length, 1e-6f));
+    }
+
+}  // namespace TrickSaber::Math
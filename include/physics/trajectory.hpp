@@ -0,0 +1,59 @@
+#pragma once
+
+// Closed-form flight for a thrown saber. Flight is constant linear plus constant angular
+// velocity, so the pose is a pure function of time since release:
+//     position(t) = p0 + v t
+//     rotation(t) = exp(w t) q0
+// Evaluating it never reads the transform and never accumulates error, however long the throw.
+
+#include "physics/math.hpp"
+
+#include <cmath>
+
+namespace TrickSaber::Math {
+
+    class ThrowTrajectory {
+    public:
+        ThrowTrajectory() = default;
+
+        ThrowTrajectory(Vec3 releasePosition, Quat releaseRotation, Vec3 velocity, Vec3 angularVelocity)
+            : origin(releasePosition), originRotation(releaseRotation), velocity(velocity), angularVelocity(angularVelocity) {
+            angularSpeed = Magnitude(angularVelocity);
+            axis = angularSpeed > 1e-6f ? angularVelocity / angularSpeed : Zero();
+        }
+
+        Vec3 PositionAt(float t) const { return origin + velocity * t; }
+
+        Quat RotationAt(float t) const {
+            if (angularSpeed <= 1e-6f) {
+                return originRotation;
+            }
+            // The angle is formed in double so minute-long throws at thousands of deg/s keep
+            // full float precision in sin/cos.
+            double half = std::fmod(static_cast<double>(angularSpeed) * t * 0.5, 2.0 * 3.14159265358979323846);
+            float s = static_cast<float>(std::sin(half));
+            Quat spin = {axis.x * s, axis.y * s, axis.z * s, static_cast<float>(std::cos(half))};
+            return spin * originRotation;
+        }
+
+        void Evaluate(float t, Vec3& outPos, Quat& outRot) const {
+            outPos = PositionAt(t);
+            outRot = RotationAt(t);
+        }
+
+        Vec3 Origin() const { return origin; }
+        Quat OriginRotation() const { return originRotation; }
+        Vec3 Velocity() const { return velocity; }
+        Vec3 AngularVelocity() const { return angularVelocity; }
+        bool Spins() const { return angularSpeed > 1e-6f; }
+
+    private:
+        Vec3 origin = Zero();
+        Quat originRotation = Identity();
+        Vec3 velocity = Zero();
+        Vec3 angularVelocity = Zero();
+        Vec3 axis = Zero();
+        float angularSpeed = 0.0f;
+    };
+
+}  // namespace TrickSaber::Math
@@ -0,0 +1,54 @@
+#pragma once
+
+// Hand velocity from a short history of timestamped poses instead of a single finite
+// difference. Hand transforms move at render rate while FixedUpdate runs on its own clock,
+// so consecutive ticks can see no movement and then double movement. Repeated samples are
+// dropped, and the velocity is the derivative at the newest sample of a local quadratic
+// least-squares fit (Savitzky-Golay with real timestamps), which has no half-window lag.
+
+#include "physics/math.hpp"
+
+#include <cstdint>
+
+namespace TrickSaber::Math {
+
+    class MotionHistory {
+    public:
+        static constexpr int CAPACITY = 16;  // 130 ms at 120 Hz
+
+        void Reset() { size = 0; }
+
+        // Adds a pose seen at timeNs. Ignored if it is identical to the newest sample (the
+        // hand has not been re-posed since the last tick) or not newer than it.
+        void Push(uint64_t timeNs, Vec3 position);
+        void Push(uint64_t timeNs, Vec3 position, Quat rotation);
+
+        // Velocity (m/s) at the newest sample, fitted over samples at most window seconds old.
+        Vec3 LinearVelocity(float window) const;
+
+        // Angular velocity (rad/s, world) at the newest sample. Only meaningful if rotations
+        // were pushed.
+        Vec3 AngularVelocity(float window) const;
+
+        // Largest-magnitude LinearVelocity(window) evaluated at each sample from the last
+        // peakWindow seconds, so a release right after the fastest part of a flick keeps it.
+        Vec3 PeakLinearVelocity(float window, float peakWindow) const;
+
+        int Size() const { return size; }
+
+    private:
+        // Derivative at sample `end` of a fit over samples [.., end] within window seconds.
+        // values are 3 component arrays indexed like the ring.
+        Vec3 Fit(int end, float window, float const* vx, float const* vy, float const* vz) const;
+
+        int Index(int age) const { return (head - 1 - age) & (CAPACITY - 1); }
+
+        uint64_t time[CAPACITY];
+        float px[CAPACITY], py[CAPACITY], pz[CAPACITY];
+        float rx[CAPACITY], ry[CAPACITY], rz[CAPACITY];  // rotation vectors, unwrapped
+        Quat rotation[CAPACITY];
+        int head = 0;
+        int size = 0;
+    };
+
+}  // namespace TrickSaber::Math
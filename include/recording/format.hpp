@@ -0,0 +1,273 @@
+#pragma once
+
+// Versioned binary layout for tick recordings, shared by the on-device recorder and the
+// host reader. Pure C++, no Unity types.
+//
+// File:  Header, then one variable-length frame per tick until EOF.
+// Frame: varint dtMicros
+//        2x hand   { varint buttons, 3x zigzag varint position delta, u32 rotation }
+//        u8 saberCount
+//        Nx saber  { u8 state | space << 4 | hand << 5, 3x zigzag varint position delta, u32 rotation }
+// Positions are quantized to 1/POSITION_SCALE m and delta-coded against the previous frame
+// of the same hand/saber slot. Rotations use smallest-three: 2 bits for the dropped
+// component, 10 bits for each of the other three.
+
+#include "physics/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace TrickSaber::Recording {
+
+    constexpr char MAGIC[4] = {'T', 'S', 'R', 'C'};
+    constexpr uint16_t FORMAT_VERSION = 2;
+    constexpr float POSITION_SCALE = 10000.0f;  // 0.1 mm
+    constexpr int MAX_RECORDED_SABERS = 8;
+    constexpr int HAND_COUNT = 2;
+
+    // Bits of TickSample::buttons, one mask per hand: the raw controller mask (Input::ButtonBit)
+    // in the low 16 bits and the actions the sabers on that hand ran with above them, which are
+    // a combo's rather than the bindings' while one drives the saber.
+    constexpr uint32_t BUTTON_RAW_MASK = 0xFFFFu;
+    constexpr int BUTTON_ACTION_SHIFT = 16;
+    constexpr uint32_t BUTTON_THROW = 1u << (BUTTON_ACTION_SHIFT + 0);
+    constexpr uint32_t BUTTON_SPIN = 1u << (BUTTON_ACTION_SHIFT + 1);
+    constexpr uint32_t BUTTON_COMBO = 1u << (BUTTON_ACTION_SHIFT + 2);
+    constexpr uint32_t BUTTON_REVERSE_SPIN = 1u << 31;  // A combo ran the hand's spin the other way
+    constexpr int MAX_FRAME_BYTES = 4 + HAND_COUNT * (5 + 3 * 5 + 4) + 1 + MAX_RECORDED_SABERS * (1 + 3 * 5 + 4);
+
+    struct Header {
+        char magic[4];
+        uint16_t version;
+        uint16_t maxSabers;
+        float positionScale;
+        uint32_t reserved;
+    };
+    static_assert(sizeof(Header) == 16);
+
+    struct SaberSample {
+        uint8_t state;  // SaberInteractionState
+        uint8_t space;  // PoseSpace the pose is expressed in
+        uint8_t hand;   // Config::Hand
+        Math::Vec3 position;
+        Math::Quat rotation;
+    };
+
+    // Uncompressed per-tick sample, the unit pushed into the recorder ring.
+    struct TickSample {
+        float deltaTime;
+        uint32_t buttons[HAND_COUNT];
+        Math::Vec3 handPosition[HAND_COUNT];
+        Math::Quat handRotation[HAND_COUNT];
+        uint8_t saberCount;
+        SaberSample sabers[MAX_RECORDED_SABERS];
+    };
+
+    inline Header MakeHeader() {
+        Header header;
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = FORMAT_VERSION;
+        header.maxSabers = MAX_RECORDED_SABERS;
+        header.positionScale = POSITION_SCALE;
+        header.reserved = 0;
+        return header;
+    }
+
+    inline bool IsValidHeader(Header const& header) {
+        return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == FORMAT_VERSION;
+    }
+
+    // --- Smallest-three quaternion packing ---
+    constexpr float SMALLEST_THREE_RANGE = 0.70710678f;  // 1/sqrt(2)
+    constexpr float SMALLEST_THREE_STEPS = 1022.0f;      // even, so 0 is exactly representable
+
+    inline uint32_t PackQuat(Math::Quat q) {
+        float c[4] = {q.x, q.y, q.z, q.w};
+        int largest = 0;
+        for (int i = 1; i < 4; i++) {
+            if (std::abs(c[i]) > std::abs(c[largest])) {
+                largest = i;
+            }
+        }
+        float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+        uint32_t packed = static_cast<uint32_t>(largest) << 30;
+        int shift = 20;
+        for (int i = 0; i < 4; i++) {
+            if (i == largest) {
+                continue;
+            }
+            float normalized = (c[i] * sign + SMALLEST_THREE_RANGE) / (2.0f * SMALLEST_THREE_RANGE);
+            uint32_t bits = static_cast<uint32_t>(std::lround(std::clamp(normalized, 0.0f, 1.0f) * SMALLEST_THREE_STEPS));
+            packed |= bits << shift;
+            shift -= 10;
+        }
+        return packed;
+    }
+
+    inline Math::Quat UnpackQuat(uint32_t packed) {
+        int largest = static_cast<int>(packed >> 30);
+        float c[4];
+        float sumSq = 0.0f;
+        int shift = 20;
+        for (int i = 0; i < 4; i++) {
+            if (i == largest) {
+                continue;
+            }
+            float normalized = static_cast<float>((packed >> shift) & 1023u) / SMALLEST_THREE_STEPS;
+            c[i] = normalized * 2.0f * SMALLEST_THREE_RANGE - SMALLEST_THREE_RANGE;
+            sumSq += c[i] * c[i];
+            shift -= 10;
+        }
+        c[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSq));
+        return Math::Normalized(Math::Quat{c[0], c[1], c[2], c[3]});
+    }
+
+    // --- Varints ---
+    inline uint8_t* WriteVarint(uint8_t* out, uint32_t value) {
+        while (value >= 0x80) {
+            *out++ = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        *out++ = static_cast<uint8_t>(value);
+        return out;
+    }
+
+    inline uint8_t const* ReadVarint(uint8_t const* in, uint8_t const* end, uint32_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 35 && in < end; shift += 7) {
+            uint8_t byte = *in++;
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return in;
+            }
+        }
+        return nullptr;
+    }
+
+    inline uint32_t ZigZag(int32_t v) { return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31); }
+    inline int32_t UnZigZag(uint32_t v) { return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1); }
+
+    inline uint8_t* WriteU32(uint8_t* out, uint32_t v) {
+        for (int i = 0; i < 4; i++) {
+            *out++ = static_cast<uint8_t>(v >> (8 * i));
+        }
+        return out;
+    }
+
+    inline uint8_t const* ReadU32(uint8_t const* in, uint8_t const* end, uint32_t& v) {
+        if (end - in < 4) {
+            return nullptr;
+        }
+        v = 0;
+        for (int i = 0; i < 4; i++) {
+            v |= static_cast<uint32_t>(in[i]) << (8 * i);
+        }
+        return in + 4;
+    }
+
+    // Delta state for one position stream (a hand or a saber slot).
+    struct QuantizedPosition {
+        int32_t v[3] = {0, 0, 0};
+    };
+
+    inline uint8_t* WritePosition(uint8_t* out, Math::Vec3 p, QuantizedPosition& prev) {
+        float const c[3] = {p.x, p.y, p.z};
+        for (int i = 0; i < 3; i++) {
+            int32_t q = static_cast<int32_t>(std::lround(c[i] * POSITION_SCALE));
+            out = WriteVarint(out, ZigZag(q - prev.v[i]));
+            prev.v[i] = q;
+        }
+        return out;
+    }
+
+    inline uint8_t const* ReadPosition(uint8_t const* in, uint8_t const* end, Math::Vec3& p, QuantizedPosition& prev) {
+        float c[3];
+        for (int i = 0; i < 3; i++) {
+            uint32_t raw;
+            if (!(in = ReadVarint(in, end, raw))) {
+                return nullptr;
+            }
+            prev.v[i] += UnZigZag(raw);
+            c[i] = static_cast<float>(prev.v[i]) / POSITION_SCALE;
+        }
+        p = {c[0], c[1], c[2]};
+        return in;
+    }
+
+    // Stateful frame codec; encoder and decoder must see the same frame sequence.
+    class FrameCodec {
+    public:
+        // Writes one frame into out (at least MAX_FRAME_BYTES) and returns its length.
+        int Encode(TickSample const& sample, uint8_t* out) {
+            uint8_t* p = out;
+            p = WriteVarint(p, static_cast<uint32_t>(std::lround(std::max(sample.deltaTime, 0.0f) * 1e6f)));
+            for (int h = 0; h < HAND_COUNT; h++) {
+                p = WriteVarint(p, sample.buttons[h]);
+                p = WritePosition(p, sample.handPosition[h], hands[h]);
+                p = WriteU32(p, PackQuat(sample.handRotation[h]));
+            }
+            int count = std::min<int>(sample.saberCount, MAX_RECORDED_SABERS);
+            *p++ = static_cast<uint8_t>(count);
+            for (int s = 0; s < count; s++) {
+                SaberSample const& saber = sample.sabers[s];
+                *p++ = static_cast<uint8_t>((saber.state & 0x0F) | ((saber.space & 1) << 4) | ((saber.hand & 1) << 5));
+                p = WritePosition(p, saber.position, sabers[s]);
+                p = WriteU32(p, PackQuat(saber.rotation));
+            }
+            return static_cast<int>(p - out);
+        }
+
+        // Reads one frame; returns the byte after it, or nullptr if the buffer ends mid-frame or
+        // the frame claims more sabers than MAX_RECORDED_SABERS.
+        uint8_t const* Decode(uint8_t const* in, uint8_t const* end, TickSample& sample) {
+            uint32_t raw;
+            if (!(in = ReadVarint(in, end, raw))) {
+                return nullptr;
+            }
+            sample.deltaTime = static_cast<float>(raw) * 1e-6f;
+            for (int h = 0; h < HAND_COUNT; h++) {
+                if (!(in = ReadVarint(in, end, sample.buttons[h]))) {
+                    return nullptr;
+                }
+                if (!(in = ReadPosition(in, end, sample.handPosition[h], hands[h]))) {
+                    return nullptr;
+                }
+                if (!(in = ReadU32(in, end, raw))) {
+                    return nullptr;
+                }
+                sample.handRotation[h] = UnpackQuat(raw);
+            }
+            if (in >= end) {
+                return nullptr;
+            }
+            sample.saberCount = *in++;
+            if (sample.saberCount > MAX_RECORDED_SABERS) {
+                return nullptr;
+            }
+            for (int s = 0; s < sample.saberCount; s++) {
+                if (in >= end) {
+                    return nullptr;
+                }
+                uint8_t stateByte = *in++;
+                sample.sabers[s].state = stateByte & 0x0F;
+                sample.sabers[s].space = (stateByte >> 4) & 1;
+                sample.sabers[s].hand = (stateByte >> 5) & 1;
+                if (!(in = ReadPosition(in, end, sample.sabers[s].position, sabers[s]))) {
+                    return nullptr;
+                }
+                if (!(in = ReadU32(in, end, raw))) {
+                    return nullptr;
+                }
+                sample.sabers[s].rotation = UnpackQuat(raw);
+            }
+            return in;
+        }
+
+    private:
+        QuantizedPosition hands[HAND_COUNT];
+        QuantizedPosition sabers[MAX_RECORDED_SABERS];
+    };
+
+}  // namespace TrickSaber::Recording
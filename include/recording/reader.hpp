@@ -0,0 +1,64 @@
+#pragma once
+
+// Host-side reader for .tsrec recordings. Header-only and free of Unity/il2cpp types so
+// tools and offline analysis can include it directly.
+
+#include "recording/format.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace TrickSaber::Recording {
+
+    class Reader {
+    public:
+        // Loads the whole file; returns false if it is missing or not a supported version.
+        bool Open(std::string const& path) {
+            std::FILE* f = std::fopen(path.c_str(), "rb");
+            if (!f) {
+                return false;
+            }
+            data.clear();
+            uint8_t chunk[1 << 16];
+            size_t n;
+            while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) {
+                data.insert(data.end(), chunk, chunk + n);
+            }
+            std::fclose(f);
+
+            if (data.size() < sizeof(Header)) {
+                return false;
+            }
+            std::memcpy(&header, data.data(), sizeof(Header));
+            cursor = data.data() + sizeof(Header);
+            codec = FrameCodec();
+            return IsValidHeader(header);
+        }
+
+        // Decodes the next frame. Returns false at end of file, on a truncated final frame (the
+        // recorder may have been killed mid-write) or on a malformed one.
+        bool Next(TickSample& sample) {
+            if (!cursor) {
+                return false;
+            }
+            uint8_t const* end = data.data() + data.size();
+            if (cursor >= end) {
+                return false;
+            }
+            uint8_t const* next = codec.Decode(cursor, end, sample);
+            cursor = next;
+            return next != nullptr;
+        }
+
+        Header const& FileHeader() const { return header; }
+        size_t FileSize() const { return data.size(); }
+
+    private:
+        std::vector<uint8_t> data;
+        uint8_t const* cursor = nullptr;
+        Header header = {};
+        FrameCodec codec;
+    };
+
+}  // namespace TrickSaber::Recording
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "recording/format.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace TrickSaber::Recording {
+
+    // Per-tick capture of input and saber poses for offline tuning and repro of
+    // "my saber flew off" reports. The hook thread only copies a TickSample into a
+    // preallocated ring; a background thread compresses and streams it to
+    // <mod data dir>/recordings/<timestamp>.tsrec (see recording/format.hpp).
+
+    // Opens a new recording file and starts the writer thread. No-op if already recording.
+    bool Start();
+
+    // Stops the writer thread after it has drained the ring and closed the file.
+    void Stop();
+
+    bool IsRecording();
+
+    // Hook thread only. Drops the sample (and counts it) if the ring is full.
+    void Push(TickSample const& sample);
+
+    uint64_t DroppedSamples();
+
+    // Path of the current or most recent recording, empty if none.
+    std::string LastPath();
+
+}  // namespace TrickSaber::Recording
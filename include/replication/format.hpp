@@ -0,0 +1,111 @@
+#pragma once
+
+// Wire layout of the trick-state replication stream that lets spectators see our sabers
+// thrown, spun and returning. Pure C++, no Unity types; shares the varint, zigzag and
+// smallest-three helpers with the recording format.
+//
+// Packet: u8 version
+//         u16 sequence
+//         u32 timeMs          sender clock
+//         u8 saberCount       slots at or past this are gone
+//         u8 recordCount
+//         Nx record
+// Record: u8 slot | kind << 3 | space << 5 | state << 6
+//   State:  u8 state | spin << 2 | hand << 3 | trajectory << 4
+//           [trajectory: 3x zigzag varint release position, u32 release rotation,
+//                        3x zigzag varint velocity, 3x zigzag varint angular velocity,
+//                        varint flightMs]
+//   Pose:   3x zigzag varint position, u32 rotation
+//   Target: 3x zigzag varint position, u32 rotation   world pose a return is headed for
+//           varint returnMs, varint returnDurationMs, u8 returnStyle (physics/return-path.hpp)
+//
+// The stream carries changes, not snapshots: a state record goes out the tick a saber's
+// state, spin or hand changes (and is repeated, see STATE_REPEATS), and poses only while a
+// saber is somewhere its avatar's hand would not put it, at the stream's rate. A thrown
+// saber's state record carries its ThrowTrajectory, so the receiver evaluates the flight
+// itself and the poses sent meanwhile only back it up. A returning saber sends Target records
+// instead of poses, saying where the hand is and how far into the return it is: the return
+// spins as fast as the throw did, far too fast to interpolate at any sensible rate, so the
+// receiver runs it with the trick machine's ReturnPose on the same path. The target sent is
+// the one the sender aims for, already led by its hand's velocity. Any one Target record is
+// enough to place the whole return, so losing some of them costs nothing.
+//
+// Pose records are absolute. At 1 mm a position inside an 8 m play space is two bytes per
+// axis either way, so coding it against an earlier pose saves nothing here, and it would
+// make every lost packet cost the poses after it too. Each pose record also carries the
+// saber's state in its head, so losing a packet costs only the poses in it.
+
+#include "recording/format.hpp"
+
+#include <cstdint>
+
+namespace TrickSaber::Replication {
+
+    constexpr uint8_t PACKET_VERSION = 2;
+    constexpr int MAX_REPLICATED_SABERS = 8;
+    constexpr float POSITION_SCALE = 1000.0f;          // 1 mm
+    constexpr float VELOCITY_SCALE = 1000.0f;          // 1 mm/s
+    constexpr float ANGULAR_VELOCITY_SCALE = 1000.0f;  // 1 mrad/s
+
+    enum class RecordKind : uint8_t { State, Pose, Target };
+
+    constexpr int PACKET_HEADER_BYTES = 1 + 2 + 4 + 1 + 1;
+    constexpr int STATE_RECORD_BYTES = 1 + 1 + 3 * 5 + 4 + 3 * 5 + 3 * 5 + 5;
+    constexpr int POSE_RECORD_BYTES = 1 + 3 * 5 + 4 + 5 + 5 + 1;  // Target's size
+    constexpr int MAX_RECORDS = 2 * MAX_REPLICATED_SABERS;
+    constexpr int MAX_PACKET_BYTES = PACKET_HEADER_BYTES + MAX_REPLICATED_SABERS * (STATE_RECORD_BYTES + POSE_RECORD_BYTES);
+
+    inline uint8_t RecordHead(int slot, RecordKind kind, uint8_t space, uint8_t state) {
+        return static_cast<uint8_t>(slot | static_cast<int>(kind) << 3 | space << 5 | state << 6);
+    }
+
+    inline uint8_t* WriteU16(uint8_t* out, uint16_t v) {
+        *out++ = static_cast<uint8_t>(v);
+        *out++ = static_cast<uint8_t>(v >> 8);
+        return out;
+    }
+
+    inline uint8_t const* ReadU16(uint8_t const* in, uint8_t const* end, uint16_t& v) {
+        if (end - in < 2) {
+            return nullptr;
+        }
+        v = static_cast<uint16_t>(in[0] | in[1] << 8);
+        return in + 2;
+    }
+
+    inline uint8_t const* ReadU8(uint8_t const* in, uint8_t const* end, uint8_t& v) {
+        if (in >= end) {
+            return nullptr;
+        }
+        v = *in;
+        return in + 1;
+    }
+
+    // Vector quantized to 1/scale, as three zigzag varints.
+    inline uint8_t* WriteVec(uint8_t* out, Math::Vec3 v, float scale) {
+        float const c[3] = {v.x, v.y, v.z};
+        for (int i = 0; i < 3; i++) {
+            out = Recording::WriteVarint(out, Recording::ZigZag(static_cast<int32_t>(std::lround(c[i] * scale))));
+        }
+        return out;
+    }
+
+    inline uint8_t const* ReadVec(uint8_t const* in, uint8_t const* end, Math::Vec3& v, float scale) {
+        float c[3];
+        for (int i = 0; i < 3; i++) {
+            uint32_t raw;
+            if (!(in = Recording::ReadVarint(in, end, raw))) {
+                return nullptr;
+            }
+            c[i] = static_cast<float>(Recording::UnZigZag(raw)) / scale;
+        }
+        v = {c[0], c[1], c[2]};
+        return in;
+    }
+
+    // True if sequence a was sent after b, across the u16 wrap.
+    inline bool SequenceAfter(uint16_t a, uint16_t b) {
+        return static_cast<int16_t>(a - b) > 0;
+    }
+
+}  // namespace TrickSaber::Replication
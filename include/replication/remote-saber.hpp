@@ -0,0 +1,90 @@
+#pragma once
+
+// Receiver side of one replicated saber: the latest state from the stream, the last two
+// throws (trajectory and return) and a short history of received poses to draw from.
+//
+// Sample() is meant to be asked for a time somewhat behind the newest packet (see
+// INTERPOLATION_PERIODS), so there is usually a received pose on either side of it:
+//   - held still: nothing to draw, the avatar's hand already has the saber;
+//   - in flight: the ThrowTrajectory from the throw's state record, exact at any time;
+//   - returning: the trick machine's own ReturnPose, towards the received return targets;
+//   - otherwise: between the two received poses around renderTime, or past the newest one
+//     at its last velocity for up to MAX_EXTRAPOLATION seconds when packets are late.
+// The previous throw is kept so a saber caught and thrown again inside the interpolation
+// delay still finishes its first return.
+
+#include "physics/math.hpp"
+#include "physics/trajectory.hpp"
+#include "saber/trick-machine.hpp"
+
+#include <cstdint>
+
+namespace TrickSaber::Replication {
+
+    // How far behind the newest packet to draw, in send periods.
+    constexpr float INTERPOLATION_PERIODS = 2.0f;
+    constexpr float MAX_EXTRAPOLATION = 0.1f;  // seconds
+    constexpr float MAX_SAMPLE_GAP = 0.25f;    // Poses further apart are not blended
+
+    struct PoseSample {
+        float time;             // Sender clock, seconds
+        Math::Vec3 position;
+        Math::Quat rotation;
+        uint8_t space;          // Saber::PoseSpace: local to the hand, or world
+        bool returnTarget;      // Where a return is headed, not where the saber is
+    };
+
+    // One throw as the receiver knows it.
+    struct RemoteFlight {
+        bool valid = false;
+        Math::ThrowTrajectory trajectory;
+        float releaseTime = 0.0f;
+        float recallTime = 0.0f;      // Flight ends here; +inf while still thrown
+        float returnDuration = 0.0f;  // 0 until a state record says how long the return takes
+        uint8_t returnStyle = Math::DEFAULT_RETURN_STYLE;
+    };
+
+    class RemoteSaber {
+    public:
+        static constexpr int HISTORY = 8;
+
+        void Clear();
+
+        void OnState(float time, Saber::SaberInteractionState state, bool spinActive, uint8_t hand);
+        void OnTrajectory(float releaseTime, Math::ThrowTrajectory const& trajectory);
+        void OnReturn(float recallTime, float returnDuration, uint8_t returnStyle);
+        void OnPose(float time, uint8_t space, Math::Vec3 position, Math::Quat rotation, bool returnTarget = false);
+
+        // Every pose record also says which state the saber was in; a change whose state
+        // records were all lost is picked up from it.
+        void OnPoseState(float time, Saber::SaberInteractionState poseState);
+
+        // Pose to draw at renderTime on the sender's clock. False while the saber is held
+        // still, or before anything about it has been received.
+        bool Sample(float renderTime, Math::Vec3& position, Math::Quat& rotation, uint8_t& space) const;
+
+        bool Known() const { return known; }
+        Saber::SaberInteractionState State() const { return state; }
+        bool SpinActive() const { return spinActive; }
+        uint8_t Hand() const { return hand; }
+
+    private:
+        PoseSample const& At(int age) const { return history[(newest - age + HISTORY) % HISTORY]; }
+        bool SampleFlight(RemoteFlight const& flight, float renderTime, Math::Vec3& position, Math::Quat& rotation) const;
+        bool SampleTarget(float renderTime, Math::Vec3& position, Math::Quat& rotation) const;
+
+        PoseSample history[HISTORY];
+        int newest = -1;
+        int size = 0;
+
+        bool known = false;
+        Saber::SaberInteractionState state = Saber::SaberInteractionState::Held;
+        bool spinActive = false;
+        uint8_t hand = 0;
+        float stillSince = 0.0f;    // When it was last put back in hand, not spinning
+
+        RemoteFlight flight;        // Latest throw
+        RemoteFlight previousFlight;
+    };
+
+}  // namespace TrickSaber::Replication
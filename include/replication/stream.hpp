@@ -0,0 +1,102 @@
+#pragma once
+
+// Encoder and decoder for the replication stream (replication/format.hpp). Both work in
+// fixed arrays sized for MAX_REPLICATED_SABERS and never allocate; a packet is built in,
+// or parsed from, a caller's buffer of at most MAX_PACKET_BYTES.
+
+#include "replication/format.hpp"
+#include "replication/remote-saber.hpp"
+
+#include <cstdint>
+
+namespace TrickSaber::Replication {
+
+    // Send periods between keyframes. A keyframe re-sends every saber's state, trajectory
+    // included, even when nothing is moving, so a late joiner or a receiver that lost more
+    // than STATE_REPEATS packets in a row catches up within this many.
+    constexpr int KEY_INTERVAL = 15;
+
+    // Packets after a state change that repeat its state record, so one lost packet does not
+    // leave spectators with a stale state until the next keyframe.
+    constexpr int STATE_REPEATS = 2;
+
+    // One of our sabers as of this tick.
+    struct SaberFrame {
+        Saber::SaberInteractionState state;
+        bool spinActive;
+        uint8_t hand;
+        bool hasPose;                             // False while held still
+        uint8_t space;                            // Saber::PoseSpace of position / rotation
+        Math::Vec3 position;                      // While returning with a returnDuration:
+        Math::Quat rotation;                      // the world pose it is returning to
+        Math::ThrowTrajectory const* trajectory;  // The flight, while Thrown or Returning
+        float flightTime;                         // Seconds since release
+        float returnTime;                         // Seconds since recall, while Returning
+        float returnDuration;                     // 0 to send a return as plain poses
+        uint8_t returnStyle;                      // Math::ReturnStyle of the return's path
+    };
+
+    // Bandwidth and loss for one peer. The sent side of our own broadcast is kept the same way.
+    struct PeerStats {
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+        uint64_t lost = 0;       // Sequence gaps
+        uint64_t late = 0;       // Arrived after a newer packet; dropped
+        uint64_t malformed = 0;
+        float firstTime = 0.0f;  // Sender clock of the first and newest packet, for rates
+        float lastTime = 0.0f;
+
+        float BytesPerSecond() const { return lastTime > firstTime ? static_cast<float>(bytes) / (lastTime - firstTime) : 0.0f; }
+    };
+
+    class StreamEncoder {
+    public:
+        StreamEncoder() { Reset(); }
+
+        // Pose packets per second while any saber has a pose to send.
+        void SetRate(int packetsPerSecond);
+        int Rate() const { return rate; }
+
+        // Makes the next packet a keyframe; call when the stream restarts.
+        void Reset();
+
+        // Writes this tick's packet to out, which holds at least MAX_PACKET_BYTES, and
+        // returns its size, or 0 if nothing is due. A state change goes out the tick it
+        // happens; poses and keyframes at the rate. Sabers past MAX_REPLICATED_SABERS are not sent.
+        int Encode(float now, SaberFrame const* frames, int count, uint8_t* out);
+
+        PeerStats const& Stats() const { return stats; }
+
+    private:
+        int rate = 30;
+        float nextPoseTime = 0.0f;
+        int periodsSinceKey = KEY_INTERVAL;
+        uint16_t sequence = 0;
+        int sentCount = -1;
+        uint8_t sentState[MAX_REPLICATED_SABERS];
+        int stateRepeats[MAX_REPLICATED_SABERS];
+        PeerStats stats;
+    };
+
+    // Everything received from one peer.
+    struct RemotePeer {
+        RemoteSaber sabers[MAX_REPLICATED_SABERS];
+        int count = 0;
+        float newestTime = 0.0f;  // Sender clock of the newest packet
+        PeerStats stats;
+
+        // Sender time to draw at: INTERPOLATION_PERIODS send periods behind the newest packet.
+        float RenderTime(int rate) const { return newestTime - INTERPOLATION_PERIODS / static_cast<float>(rate); }
+
+        void Clear();
+
+        // --- Decoder state ---
+        bool started = false;
+        uint16_t lastSequence = 0;
+    };
+
+    // Applies one packet to peer. Returns false, and leaves the sabers untouched, for a packet
+    // that is malformed or older than one already applied.
+    bool Decode(uint8_t const* data, int size, RemotePeer& peer);
+
+}  // namespace TrickSaber::Replication
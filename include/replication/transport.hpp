@@ -0,0 +1,80 @@
+#pragma once
+
+// Where replication packets go. The stream itself never touches a socket or a game
+// session; whatever carries it implements Transport. LoopbackTransport hands every packet
+// straight back, with optional loss, for host tools.
+
+#include "replication/format.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace TrickSaber::Replication {
+
+    class Transport {
+    public:
+        virtual ~Transport() = default;
+
+        // Sends one packet to every peer. data is only valid for the call.
+        virtual void Broadcast(uint8_t const* data, int size) = 0;
+
+        // Copies the next received packet into buffer (MAX_PACKET_BYTES) and returns its size,
+        // or 0 when there is none. peer is the sender, in [0, MAX_PEERS).
+        virtual int Receive(int& peer, uint8_t* buffer) = 0;
+    };
+
+    constexpr int MAX_PEERS = 8;
+
+    // Delivers our own broadcasts back to us as peer 0, through a fixed ring. Drops a packet
+    // when the ring is full, or with probability lossRate.
+    class LoopbackTransport final : public Transport {
+    public:
+        static constexpr int CAPACITY = 64;
+
+        void SetLoss(float lossRate) { loss = static_cast<uint32_t>(lossRate * 4294967295.0f); }
+        uint64_t Dropped() const { return dropped; }
+
+        void Broadcast(uint8_t const* data, int size) override {
+            if (size > MAX_PACKET_BYTES || tail - head == CAPACITY || NextRandom() < loss) {
+                dropped++;
+                return;
+            }
+            Packet& packet = ring[tail % CAPACITY];
+            std::memcpy(packet.data, data, size);
+            packet.size = size;
+            tail++;
+        }
+
+        int Receive(int& peer, uint8_t* buffer) override {
+            if (head == tail) {
+                return 0;
+            }
+            Packet const& packet = ring[head % CAPACITY];
+            std::memcpy(buffer, packet.data, packet.size);
+            head++;
+            peer = 0;
+            return packet.size;
+        }
+
+    private:
+        struct Packet {
+            uint8_t data[MAX_PACKET_BYTES];
+            int size;
+        };
+
+        uint32_t NextRandom() {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            return seed;
+        }
+
+        Packet ring[CAPACITY];
+        uint64_t head = 0;
+        uint64_t tail = 0;
+        uint32_t loss = 0;
+        uint32_t seed = 0x9E3779B9u;
+        uint64_t dropped = 0;
+    };
+
+}  // namespace TrickSaber::Replication
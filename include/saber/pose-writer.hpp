@@ -0,0 +1,58 @@
+#pragma once
+
+#include "UnityEngine/Transform.hpp"
+#include "physics/math.hpp"
+
+#include <cstdint>
+
+namespace TrickSaber::Saber {
+
+    enum class PoseSpace : uint8_t { Local, World };
+
+    struct PoseWriteStats {
+        uint64_t issued = 0;
+        uint64_t elided = 0;
+        float issuedPerSecond = 0.0f;
+        float elidedPerSecond = 0.0f;
+    };
+
+    // Per-saber pending pose. The tick records at most one target pose per saber and
+    // Flush() turns it into a single SetLocalPositionAndRotation / SetPositionAndRotation,
+    // or nothing at all when it matches the last pose written within epsilon.
+    class PoseWriter {
+    public:
+        void SetLocal(Math::Vec3 position, Math::Quat rotation);
+        void SetWorld(Math::Vec3 position, Math::Quat rotation);
+
+        // Forget the last written pose; call after SetParent or anything else that moves
+        // the transform behind our back.
+        void Invalidate();
+
+        // Issues the pending write, if any, and clears it. Returns true if a write was issued.
+        bool Flush(UnityEngine::Transform* transform);
+
+        // The pose most recently written to the transform, if it is still known.
+        bool LastWritten(Math::Vec3& position, Math::Quat& rotation, PoseSpace& space) const {
+            position = writtenPosition;
+            rotation = writtenRotation;
+            space = writtenSpace;
+            return writtenValid;
+        }
+
+    private:
+        Math::Vec3 pendingPosition;
+        Math::Quat pendingRotation;
+        PoseSpace pendingSpace = PoseSpace::Local;
+        bool dirty = false;
+
+        Math::Vec3 writtenPosition;
+        Math::Quat writtenRotation;
+        PoseSpace writtenSpace = PoseSpace::Local;
+        bool writtenValid = false;
+    };
+
+    // Advances the per-second rates; call once per tick with that tick's delta time.
+    void TickPoseWriteStats(float deltaTime);
+    PoseWriteStats const& GetPoseWriteStats();
+
+}  // namespace TrickSaber::Saber
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "UnityEngine/Transform.hpp"
+#include "beatsaber-hook/shared/utils/typedefs-wrappers.hpp"
+#include "physics/math.hpp"
+#include "saber/pose-writer.hpp"
+#include "saber/trick-machine.hpp"
+#include "settings/snapshot.hpp"
+
+#include <cstdint>
+
+namespace TrickSaber::Saber {
+
+    // Setup data captured in SaberModelController::Init; not touched by the tick math.
+    struct SaberColdData {
+        SafePtrUnity<UnityEngine::Transform> saberTransform;
+        SafePtrUnity<UnityEngine::Transform> originalParent;
+        SafePtrUnity<UnityEngine::Transform> handTransform;
+        SaberRestPose restPose;
+        Config::Hand hand;
+    };
+
+    static_assert(MAX_SABERS <= 64, "handle validity is kept in 64-bit masks");
+
+    // Structure-of-arrays store indexed by saber slot. Slots [0, count) are live and kept
+    // dense: removing a slot moves the last one into its place. Per-tick trick fields come
+    // from TrickHotState so the kernels stream through them; Unity-side data lives apart.
+    struct SaberStateStore : TrickHotState {
+        PoseWriter poseWriter[MAX_SABERS];
+        float motionTime[MAX_SABERS];  // Time.time when the slot's motion last advanced
+
+        // --- Blade sweeps for thrown cuts (saber/thrown-cuts.hpp) ---
+        Math::Vec3 sweptPosition[MAX_SABERS];  // World pose the last sweep ended at
+        Math::Quat sweptRotation[MAX_SABERS];
+        int sweptFrame[MAX_SABERS];            // Time.frameCount of that sweep, -1 for none
+
+        // --- Cold, setup ---
+        SaberColdData cold[MAX_SABERS];
+
+        // --- Handle validity, one bit per slot ---
+        // ValidateHandles() asks Unity once per tick whether each tracked transform is alive; the
+        // rest of the tick reads these masks instead of testing the SafePtrUnity handles again.
+        // Scene changes clear them with InvalidateHandles().
+        uint64_t saberAlive = 0;
+        uint64_t parentAlive = 0;
+        uint64_t handAlive = 0;
+        // Set while the saber is under originalParent. Setup, Reattach and Detach are the only
+        // places that reparent a saber, so this stands in for comparing get_parent().
+        uint64_t attached = 0;
+        // Set when auto-recall took a saber back while its throw button was held; the throw
+        // input is ignored until the button is released.
+        uint64_t autoRecalled = 0;
+        // Native alive checks made through IsAlive() since the last TakeLivenessChecks().
+        uint32_t livenessChecks = 0;
+
+        static constexpr uint64_t Bit(int slot) { return 1ull << slot; }
+
+        // Saber, original parent and hand all alive as of the last validation.
+        bool Ready(int slot) const { return (saberAlive & parentAlive & handAlive & Bit(slot)) != 0; }
+
+        bool IsAlive(SafePtrUnity<UnityEngine::Transform>& handle) {
+            livenessChecks++;
+            return static_cast<bool>(handle);
+        }
+
+        void ValidateHandles();
+        void InvalidateHandles();
+
+        uint32_t TakeLivenessChecks() {
+            uint32_t checks = livenessChecks;
+            livenessChecks = 0;
+            return checks;
+        }
+
+        // Returns the slot tracking this saber transform, claiming a new one if needed.
+        // Returns -1 when every slot is in use.
+        int FindOrAdd(UnityEngine::Transform* saberTransform);
+
+        // Returns the slot tracking this saber transform, or -1.
+        int Find(UnityEngine::Transform* saberTransform);
+
+        // Puts a slot back into Held with no spin and no pending motion.
+        void ResetHot(int slot);
+
+        void Remove(int slot);
+    };
+
+    SaberStateStore& GetSaberStateStore();
+
+}  // namespace TrickSaber::Saber
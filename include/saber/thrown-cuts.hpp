@@ -0,0 +1,40 @@
+#pragma once
+
+// What sabers in the air can cut this frame. The note and wall update hooks report where each
+// object is as the game moves it, and the saber render hook sweeps each flying blade from its
+// last pose to this one against them (physics/blade-sweep.hpp). Pure C++ so host tools can
+// feed it.
+//
+// Reports go into two buffers, this frame's and the last, swapped by the first report of a
+// new frame. An object's motion over the frame is its position now less its position in the
+// last buffer, found by handle from where the previous match left off: the game updates its
+// objects in the same order every frame, so that is almost always the next one. When sabers
+// update before the objects in a frame they get the last frame's buffer moved on one frame
+// by that motion.
+
+#include "physics/blade-sweep.hpp"
+
+namespace TrickSaber::Saber {
+
+    // The game's blade: this far along the saber's local Z, before the saber's scale.
+    constexpr float BLADE_LENGTH = 1.0f;
+    constexpr float BLADE_RADIUS = 0.02f;
+
+    // Reach of a note's cut collider and a bomb's from their centres.
+    constexpr float NOTE_CUT_RADIUS = 0.3f;
+    constexpr float BOMB_HIT_RADIUS = 0.18f;
+
+    // Motion over one frame past which an object is taken as newly spawned from its pool.
+    constexpr float MAX_TARGET_STEP = 1.0f;
+
+    // frame is Time.frameCount. Reports past MAX_CUT_TARGETS in a frame are dropped.
+    void AddCutTarget(void* owner, Math::CutTargetKind kind, Math::Vec3 center, int frame);
+    void AddObstacleTarget(void* owner, Math::Vec3 center, Math::Quat rotation, Math::Vec3 halfExtents, int frame);
+
+    // Everything reported this frame, or last frame's moved on; empty when there is neither.
+    Math::CutTargets const& CutTargetsFor(int frame);
+
+    // Forgets every report, so no handle outlives the level it came from.
+    void ClearCutTargets();
+
+}  // namespace TrickSaber::Saber
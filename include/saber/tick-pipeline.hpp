@@ -0,0 +1,132 @@
+#pragma once
+
+// The fixed tick split into read, compute and apply, so the trick math can run off the Unity
+// main thread:
+//
+//   1. Gather, main thread, in FixedUpdate: everything a saber's tick reads from Unity, input
+//      and config goes into a plain SaberTickInput per slot. That is its resolved actions, its
+//      tuning, and the hand and saber poses the tick is going to ask for (saber/trick-machine.hpp).
+//   2. Compute, on the workers or inline: the hand's velocity sample, TickTrick() and the motion
+//      it advances, on the slot's TrickHotState. Every Unity call the tick would have made is
+//      written to the slot's SaberTickOutput instead.
+//   3. Apply, main thread: reparenting, pose writes and log events from the outputs. It happens
+//      in the first hook that needs the sabers again: the saber render update of the same
+//      frame, or the next FixedUpdate.
+//
+// Between Publish() and Finish() the workers own slots [0, count) of the TrickHotState, so the
+// main thread must call Finish() before reading or writing any of them. Ticks alternate between
+// two jobs, so the job being gathered is never the one whose outputs are being applied.
+//
+// Workers claim SABERS_PER_CHUNK slots at a time from one counter. The counter is tagged with
+// the tick's sequence number, so a worker that wakes late can never claim from a newer tick.
+// Two sabers make one chunk on one worker; more chunks wake more workers, up to
+// MAX_TICK_WORKERS. Finish() runs on the main thread any chunks no worker has claimed yet, then
+// waits for the ones in flight. So a worker that misses the point where its results are needed
+// costs no more than the inline tick it replaced.
+//
+// Pure C++ with no Unity types, so host tools can run it.
+
+#include "saber/trick-machine.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace TrickSaber::Saber {
+
+    constexpr int MAX_TICK_WORKERS = 3;  // Leaves a core for Unity's own job workers
+    constexpr int SABERS_PER_CHUNK = 8;
+    constexpr int MAX_TICK_EVENTS = 4;   // Per saber per tick; a throw logs two
+
+    // Phase 1: one saber's reads for a tick.
+    struct SaberTickInput {
+        bool ready;                   // Saber, parent and hand alive; otherwise only the hand sample is taken
+        bool attached;                // Under its original parent
+        uint32_t actions;             // Input::ActionBit, after combos and auto recall
+        float deltaTime;              // Since the slot's motion last advanced
+        Config::HandTuning tuning;    // By value; returnPath points at a static baked table (Math::ReturnPathFor)
+        SaberRestPose rest;
+        Math::Vec3 handRestPoint;     // The rest position in world space; read while returning
+        Math::Quat handRotation;      // World; read while returning
+        Math::Vec3 saberPosition;     // World; read on a throw tick
+        Math::Quat saberRotation;
+    };
+
+    struct TickEvent {
+        Log::Event event;
+        Log::Level level;
+        float value;
+    };
+
+    // Phase 2: what one saber's tick would have done to Unity, in the order apply does it.
+    struct SaberTickOutput {
+        SaberInteractionState stateBefore;
+        bool buttonEdge;
+        bool detach;                  // Unparent keeping the world pose
+        bool reattach;                // Back under the original parent
+        bool hasPose;                 // Then write this pose
+        bool world;
+        Math::Vec3 position;
+        Math::Quat rotation;
+        int eventCount;
+        TickEvent events[MAX_TICK_EVENTS];
+        uint64_t computeNs;           // The slot's compute, wherever it ran
+    };
+
+    struct TickJob {
+        int count = 0;                // Slots to tick; every one gets a hand sample
+        uint64_t timeNs = 0;          // When the hand positions were read
+        uint64_t publishedNs = 0;
+        SaberTickInput input[MAX_SABERS];
+        SaberTickOutput output[MAX_SABERS];
+        std::atomic<int> done{0};     // Chunks computed
+    };
+
+    class TickPipeline {
+    public:
+        TickPipeline() = default;
+        TickPipeline(TickPipeline const&) = delete;
+        TickPipeline& operator=(TickPipeline const&) = delete;
+        ~TickPipeline() { Stop(); }
+
+        // Main thread. The job to gather the next tick into; fill count, timeNs and the inputs,
+        // with the hand positions in state.handPosition.
+        TickJob& Gather() { return jobs[gathering]; }
+
+        // Main thread. Computes the gathered job against state: here and now, or on the workers
+        // when threaded. Call Finish() for the previous job first.
+        void Publish(TrickHotState& state, bool threaded);
+
+        // Main thread. The published job once every slot is computed, for the caller to apply,
+        // or null when none is waiting. Each job is returned once.
+        TickJob* Finish();
+
+        // Sabers the last Finish() computed on the main thread because no worker had claimed
+        // them, not counting ticks published inline.
+        int InlineSabers() const { return inlineSabers; }
+
+        // Joins the workers; the next threaded Publish() starts them again.
+        void Stop();
+
+    private:
+        void EnsureWorkers(int chunks);
+        void WorkerLoop(uint32_t seen);
+        int RunChunks();  // Sabers computed
+
+        TickJob jobs[2];
+        int gathering = 0;
+        TickJob* published = nullptr;  // Read by workers once a claim on it succeeds
+        TrickHotState* state = nullptr;
+        bool waiting = false;           // published not yet returned by Finish()
+        uint32_t tick = 0;
+        int inlineSabers = 0;
+
+        // tick << 32 | chunk count << 16 | next chunk
+        std::atomic<uint64_t> claim{0};
+        std::atomic<uint32_t> wake{0};
+        std::atomic<bool> stopping{false};
+        std::thread workers[MAX_TICK_WORKERS];
+        int workerCount = 0;
+    };
+
+}  // namespace TrickSaber::Saber
@@ -0,0 +1,95 @@
+#pragma once
+
+// The per-tick Transform calls, made straight into Unity's native methods. A codegen wrapper
+// looks its method up and boxes its arguments on every call; the internal call behind it (the
+// *_Injected variant that takes its structs by pointer) is one indirect call.
+//
+// ResolveTransformICalls() looks the internal calls up by name once at load.
+// SelfTestTransformICalls() then checks each against its wrapper on a scratch transform and
+// keeps only those that agree. Until then, and for good for any entry that was not found or
+// disagreed, these go through the wrappers. Setup and menu code keeps calling the wrappers.
+
+#include "UnityEngine/Quaternion.hpp"
+#include "UnityEngine/Transform.hpp"
+#include "UnityEngine/Vector3.hpp"
+#include "physics/convert.hpp"
+
+namespace TrickSaber::Saber {
+
+    // Null for an entry that goes through its wrapper.
+    struct TransformICalls {
+        void (*getPosition)(UnityEngine::Transform* self, UnityEngine::Vector3* result);
+        void (*getRotation)(UnityEngine::Transform* self, UnityEngine::Quaternion* result);
+        void (*transformPoint)(UnityEngine::Transform* self, UnityEngine::Vector3* position, UnityEngine::Vector3* result);
+        void (*setParent)(UnityEngine::Transform* self, UnityEngine::Transform* parent, bool worldPositionStays);
+        void (*setPositionAndRotation)(UnityEngine::Transform* self, UnityEngine::Vector3* position, UnityEngine::Quaternion* rotation);
+        void (*setLocalPositionAndRotation)(UnityEngine::Transform* self, UnityEngine::Vector3* position, UnityEngine::Quaternion* rotation);
+    };
+
+    // Main thread only, like every Transform call.
+    inline TransformICalls transformICalls = {};
+
+    // At load, after il2cpp_functions::Init(). Only finds the calls; none is used yet.
+    void ResolveTransformICalls();
+
+    // Main thread, once Unity can create objects (the first main menu). Turns on each resolved
+    // call that gives its wrapper's result, and times both paths into Metric::TransformICall
+    // and Metric::TransformWrapper.
+    void SelfTestTransformICalls();
+
+    inline Math::Vec3 WorldPosition(UnityEngine::Transform* transform) {
+        if (auto call = transformICalls.getPosition) {
+            UnityEngine::Vector3 result;
+            call(transform, &result);
+            return Math::FromUnity(result);
+        }
+        return Math::FromUnity(transform->get_position());
+    }
+
+    inline Math::Quat WorldRotation(UnityEngine::Transform* transform) {
+        if (auto call = transformICalls.getRotation) {
+            UnityEngine::Quaternion result;
+            call(transform, &result);
+            return Math::FromUnity(result);
+        }
+        return Math::FromUnity(transform->get_rotation());
+    }
+
+    inline Math::Vec3 PointToWorld(UnityEngine::Transform* transform, UnityEngine::Vector3 local) {
+        if (auto call = transformICalls.transformPoint) {
+            UnityEngine::Vector3 result;
+            call(transform, &local, &result);
+            return Math::FromUnity(result);
+        }
+        return Math::FromUnity(transform->TransformPoint(local));
+    }
+
+    inline void SetParent(UnityEngine::Transform* transform, UnityEngine::Transform* parent, bool worldPositionStays) {
+        if (auto call = transformICalls.setParent) {
+            call(transform, parent, worldPositionStays);
+        } else {
+            transform->SetParent(parent, worldPositionStays);
+        }
+    }
+
+    inline void SetWorldPose(UnityEngine::Transform* transform, Math::Vec3 position, Math::Quat rotation) {
+        UnityEngine::Vector3 p = Math::ToUnity(position);
+        UnityEngine::Quaternion q = Math::ToUnity(rotation);
+        if (auto call = transformICalls.setPositionAndRotation) {
+            call(transform, &p, &q);
+        } else {
+            transform->SetPositionAndRotation(p, q);
+        }
+    }
+
+    inline void SetLocalPose(UnityEngine::Transform* transform, Math::Vec3 position, Math::Quat rotation) {
+        UnityEngine::Vector3 p = Math::ToUnity(position);
+        UnityEngine::Quaternion q = Math::ToUnity(rotation);
+        if (auto call = transformICalls.setLocalPositionAndRotation) {
+            call(transform, &p, &q);
+        } else {
+            transform->SetLocalPositionAndRotation(p, q);
+        }
+    }
+
+}  // namespace TrickSaber::Saber
@@ -0,0 +1,235 @@
+#pragma once
+
+// The throw / spin / return state machine, free of il2cpp and Unity types. Everything it
+// needs from the outside world goes through an IO object passed to TickTrick():
+//
+//   bool ThrowPressed();                 // polled once per tick
+//   bool SpinPressed();                  // polled only while Held with spin bound
+//   Math::Vec3 SaberPosition();          // world
+//   Math::Quat SaberRotation();          // world
+//   void Detach();                       // unparent, keeping the world pose
+//   bool Reattach();                     // back under the hand if not already; true if it moved
+//   Math::Vec3 HandPointToWorld(Math::Vec3 local);
+//   Math::Quat HandRotation();           // world
+//   void SetLocal(Math::Vec3, Math::Quat);
+//   void SetWorld(Math::Vec3, Math::Quat);
+//   template <Log::Level L> void Emit(Log::Event event, float value = 0.0f);
+//
+// On device that is a thin wrapper over OVRInput, the saber Transform and its PoseWriter
+// (saber/unity-trick-io.hpp); host tools provide their own. The saber's pose is only read on
+// the tick that throws it (StartsThrow()) and the hand's only while the saber returns
+// (StartsRecall()), so the fixed tick can read both ahead of time (saber/tick-pipeline.hpp).
+//
+// TickTrick() runs the state transitions once per FixedUpdate and then AdvanceMotion().
+// AdvanceMotion() can also be called on its own from a render-rate hook with the time since
+// the slot last advanced. Flight and return spin are evaluated in closed form from the
+// slot's ThrowTrajectory at its time since release, so what is drawn is exact at whatever
+// rate it is sampled.
+
+#include "log-events.hpp"
+#include "physics/math.hpp"
+#include "physics/return-path.hpp"
+#include "physics/trajectory.hpp"
+#include "physics/velocity-estimator.hpp"
+#include "settings/tuning.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace TrickSaber::Saber {
+
+    enum class SaberInteractionState : uint8_t { Held, Thrown, Returning };
+
+    // Enough for custom-saber / multi-saber mods that spawn extra sabers per hand.
+    constexpr int MAX_SABERS = 64;
+
+    // Span of hand history the release velocity is fitted over.
+    constexpr float VELOCITY_FIT_WINDOW = 0.05f;
+
+    // Saber pose relative to its hand, captured when the saber is set up.
+    struct SaberRestPose {
+        Math::Vec3 position;
+        Math::Quat rotation;
+        Math::Vec3 scale;
+    };
+
+    // Per-tick trick state, structure-of-arrays indexed by saber slot.
+    struct TrickHotState {
+        int count = 0;
+
+        SaberInteractionState state[MAX_SABERS];
+        bool spinActive[MAX_SABERS];
+        bool throwPressedLastFrame[MAX_SABERS];
+        float spinAngle[MAX_SABERS];                 // Degrees accumulated since spin start
+        float returnTime[MAX_SABERS];
+        Math::Vec3 handPosition[MAX_SABERS];
+        Math::MotionHistory handMotion[MAX_SABERS];   // Timestamped handPosition history
+        Math::ThrowTrajectory trajectory[MAX_SABERS]; // World-space flight from the throw
+        double flightTime[MAX_SABERS];                // Seconds since release, runs through the return; double
+                                                      // so a long throw's sum of ticks does not drift
+        Math::Vec3 releasePosition[MAX_SABERS];       // World position when recall starts
+        Math::Quat releaseRotation[MAX_SABERS];       // World rotation when recall starts
+    };
+
+    // Appends every live slot's handPosition to its history, stamped with timeNs. Use the time
+    // the pose was read, not accumulated deltaTime, so render-rate updates land where they happened.
+    void PushHandSamples(TrickHotState& state, uint64_t timeNs);
+
+    // Controller velocity for a throw released now: the fitted velocity at the newest sample, or the
+    // fastest one over the last tuning.peakReleaseWindow seconds when that is set.
+    Math::Vec3 ReleaseVelocity(TrickHotState const& state, int slot, Config::HandTuning const& tuning);
+
+    // Natural tumble for a throw without player spin (rad/s, world space). kind says which
+    // branch was taken, for logging.
+    Math::Vec3 NaturalThrowAngularVelocity(Math::Vec3 throwVelocityWorld, Math::Vec3 saberForwardWorld, Log::Event& kind);
+
+    // Local pose of a held saber spun by angleDeg around its local X axis through a pivot zOffset along its length.
+    // Same result as RotateAround(TransformPoint(forward * zOffset), TransformDirection(right), angle) applied to the
+    // rest pose, but computed in parent space so it needs no transform reads and does not accumulate error.
+    void HeldSpinLocalPose(SaberRestPose const& rest, float zOffset, float angleDeg, Math::Vec3& outPos, Math::Quat& outRot);
+
+    // Hand target a return should aim for: targetPosition led by the hand's velocity over
+    // the returnDuration left (physics/return-path.hpp).
+    Math::Vec3 ReturnAim(TrickHotState const& state, int slot, Math::Vec3 targetPosition, float returnDuration);
+
+    // World pose of a returning saber t of the way (0..1) along path into the hand, flightTime
+    // seconds after release. The target is the hand's rest pose for the saber in world space.
+    inline void ReturnPose(Math::ReturnPath const& path, Math::ThrowTrajectory const& trajectory, Math::Vec3 releasePosition,
+                           Math::Quat releaseRotation, float flightTime, float t, Math::Vec3 targetPosition,
+                           Math::Quat targetRotation, Math::Vec3& outPos, Math::Quat& outRot) {
+        float progress;
+        path.Sample(releasePosition, targetPosition, t, outPos, progress);
+        if (trajectory.Spins()) {
+            // Keep spinning at the throw rate while easing into the hand
+            outRot = Math::Slerp(trajectory.RotationAt(flightTime), targetRotation, progress * progress * progress);
+        } else {
+            outRot = Math::Slerp(releaseRotation, targetRotation, progress);
+        }
+    }
+
+    // True when a tick with this throw input throws the saber, or recalls it.
+    inline bool StartsThrow(TrickHotState const& s, int i, bool throwInputPressed) {
+        return throwInputPressed && s.state[i] == SaberInteractionState::Held && !s.throwPressedLastFrame[i];
+    }
+    inline bool StartsRecall(TrickHotState const& s, int i, bool throwInputPressed) {
+        return !throwInputPressed && s.state[i] == SaberInteractionState::Thrown && s.throwPressedLastFrame[i];
+    }
+
+    // --- Moves one saber forward by elapsed seconds and queues its pose ---
+    template <typename IO>
+    void AdvanceMotion(TrickHotState& s, int i, SaberRestPose const& rest, Config::HandTuning const& tuning, float elapsed, IO& io) {
+        using Log::Event;
+        using Log::Level;
+        using namespace Math;
+
+        if (s.state[i] == SaberInteractionState::Held) {
+            // Apply player-controlled spin if active; the angle is exact, no sub-steps needed
+            if (s.spinActive[i]) {
+                s.spinAngle[i] = std::fmod(s.spinAngle[i] + tuning.spinDegPerSec * elapsed, 360.0f);
+                Vec3 localPos;
+                Quat localRot;
+                HeldSpinLocalPose(rest, tuning.spinAnchorZOffset, s.spinAngle[i], localPos, localRot);
+                io.SetLocal(localPos, localRot);
+            } else {
+                // If not actively spinning by player; elided unless something moved it
+                io.SetLocal(rest.position, rest.rotation);
+            }
+        } else if (s.state[i] == SaberInteractionState::Thrown) {
+            // --- Simulated Throw ---
+            s.flightTime[i] += elapsed;
+            Vec3 position;
+            Quat rotation;
+            s.trajectory[i].Evaluate(static_cast<float>(s.flightTime[i]), position, rotation);
+            io.SetWorld(position, rotation);
+        } else if (s.state[i] == SaberInteractionState::Returning) {
+            s.returnTime[i] += elapsed;
+            s.flightTime[i] += elapsed;
+
+            float t = std::clamp(s.returnTime[i] / tuning.returnDuration, 0.0f, 1.0f);
+            Vec3 targetPos_world = ReturnAim(s, i, io.HandPointToWorld(rest.position), tuning.returnDuration);
+            Quat targetRot_world = io.HandRotation() * rest.rotation;
+            Vec3 returnPos;
+            Quat returnRot;
+            ReturnPose(*tuning.returnPath, s.trajectory[i], s.releasePosition[i], s.releaseRotation[i],
+                       static_cast<float>(s.flightTime[i]), t, targetPos_world, targetRot_world, returnPos, returnRot);
+            io.SetWorld(returnPos, returnRot);
+
+            if (t >= 1.0f) {
+                s.state[i] = SaberInteractionState::Held;
+                io.template Emit<Level::Info>(Event::ReturnedToHand);
+                // The Held branch will handle final parenting and position setting next tick
+            }
+        }
+    }
+
+    // --- One saber, one tick. Returns true if a button edge was seen this tick ---
+    // deltaTime is the time since this slot's motion last advanced, which is shorter than the
+    // fixed step when a render-rate AdvanceMotion() ran in between.
+    template <typename IO>
+    bool TickTrick(TrickHotState& s, int i, SaberRestPose const& rest, Config::HandTuning const& tuning, float deltaTime, IO& io) {
+        using Log::Event;
+        using Log::Level;
+        using namespace Math;
+
+        // --- Handle Throw Button Input ---
+        bool throwInputPressed = tuning.throwBound && io.ThrowPressed();
+        bool buttonEdge = throwInputPressed != s.throwPressedLastFrame[i];
+
+        if (StartsThrow(s, i, throwInputPressed)) {
+            // --- Initiate Throw ---
+            s.state[i] = SaberInteractionState::Thrown;
+
+            io.Detach();
+            Vec3 saberWorldPosition = io.SaberPosition();
+            Quat saberWorldRotation = io.SaberRotation();
+
+            Vec3 worldVelocity = ReleaseVelocity(s, i, tuning) * tuning.throwVelocityMultiplier;
+            io.template Emit<Level::Info>(Event::ThrowInitiated, Magnitude(worldVelocity));
+            Vec3 worldAngularVelocity;  // Radians/sec
+            if (s.spinActive[i]) {
+                worldAngularVelocity = (saberWorldRotation * Right()) * tuning.spinRadPerSec;
+            } else {
+                Event kind;
+                worldAngularVelocity = NaturalThrowAngularVelocity(worldVelocity, saberWorldRotation * Forward(), kind);
+                io.template Emit<Level::Info>(kind, Magnitude(worldVelocity));
+            }
+            s.trajectory[i] = ThrowTrajectory(saberWorldPosition, saberWorldRotation, worldVelocity, worldAngularVelocity);
+            s.flightTime[i] = 0.0f;
+            s.spinActive[i] = false;
+        } else if (StartsRecall(s, i, throwInputPressed)) {
+            // --- Initiate Recall ---
+            s.state[i] = SaberInteractionState::Returning;
+            io.template Emit<Level::Info>(Event::RecallInitiated);
+            s.returnTime[i] = 0.0f;
+            // Same pose the last advance drew; no transform reads needed
+            s.trajectory[i].Evaluate(static_cast<float>(s.flightTime[i]), s.releasePosition[i], s.releaseRotation[i]);
+        }
+        s.throwPressedLastFrame[i] = throwInputPressed;
+
+
+        // --- Handle Player-Controlled Spin ---
+        if (tuning.spinBound && s.state[i] == SaberInteractionState::Held) {
+            bool spinInputPressed = io.SpinPressed();
+            if (spinInputPressed && !s.spinActive[i]) {
+                buttonEdge = true;
+                s.spinActive[i] = true; s.spinAngle[i] = 0.0f;
+                io.template Emit<Level::Info>(Event::SpinActivated);
+            } else if (!spinInputPressed && s.spinActive[i]) {
+                // The Held block below queues the rest pose this same tick
+                s.spinActive[i] = false; io.template Emit<Level::Info>(Event::SpinDeactivated);
+            }
+        } else if (s.state[i] == SaberInteractionState::Held && s.spinActive[i]) {  // Edge: Button unassigned from config
+            s.spinActive[i] = false; io.template Emit<Level::Info>(Event::SpinDeactivated);
+        }
+
+
+        // --- Apply Saber States ---
+        if (s.state[i] == SaberInteractionState::Held && io.Reattach()) {
+            io.template Emit<Level::Info>(Event::Reparented);
+        }
+        AdvanceMotion(s, i, rest, tuning, deltaTime, io);
+        return buttonEdge;
+    }
+
+}  // namespace TrickSaber::Saber
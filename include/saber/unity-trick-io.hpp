@@ -0,0 +1,105 @@
+#pragma once
+
+#include "input/bindings.hpp"
+#include "logger.hpp"
+#include "physics/convert.hpp"
+#include "saber/state-store.hpp"
+#include "saber/tick-pipeline.hpp"
+#include "saber/transform-icalls.hpp"
+
+namespace TrickSaber::Saber {
+
+    // Unity side of the trick state machine (saber/trick-machine.hpp) for one saber slot.
+    // Every call into Unity a trick makes goes through here or the slot's PoseWriter.
+    struct UnityTrickIO {
+        SaberStateStore& store;
+        int slot;
+        uint32_t actions;      // The hand's resolved action bits for this tick (Input::ActionBit)
+
+        SaberColdData& Cold() { return store.cold[slot]; }
+
+        bool ThrowPressed() { return actions & Input::ActionBit(Input::Throw); }
+        bool SpinPressed() { return actions & Input::ActionBit(Input::Spin); }
+
+        Math::Vec3 SaberPosition() { return WorldPosition(Cold().saberTransform.ptr()); }
+        Math::Quat SaberRotation() { return WorldRotation(Cold().saberTransform.ptr()); }
+
+        void Detach() {
+            SetParent(Cold().saberTransform.ptr(), nullptr, true);
+            store.attached &= ~SaberStateStore::Bit(slot);
+            store.poseWriter[slot].Invalidate();
+        }
+
+        bool Reattach() {
+            if (store.attached & SaberStateStore::Bit(slot)) {
+                return false;
+            }
+            auto& cold = Cold();
+            SetParent(cold.saberTransform.ptr(), cold.originalParent.ptr(), false);
+            store.attached |= SaberStateStore::Bit(slot);
+            store.poseWriter[slot].Invalidate();
+            return true;
+        }
+
+        Math::Vec3 HandPointToWorld(Math::Vec3 local) {
+            return PointToWorld(Cold().handTransform.ptr(), Math::ToUnity(local));
+        }
+        Math::Quat HandRotation() { return WorldRotation(Cold().handTransform.ptr()); }
+
+        void SetLocal(Math::Vec3 position, Math::Quat rotation) { store.poseWriter[slot].SetLocal(position, rotation); }
+        void SetWorld(Math::Vec3 position, Math::Quat rotation) { store.poseWriter[slot].SetWorld(position, rotation); }
+
+        template <Log::Level L>
+        void Emit(Log::Event event, float value = 0.0f) {
+            Log::Emit<L>(event, slot, Cold().hand, value);
+        }
+    };
+
+    // --- The fixed tick through the pipeline (saber/tick-pipeline.hpp) ---
+    // Phase 1 for a Ready slot whose actions, tuning and deltaTime are already in `in`: the
+    // transform reads its TickTrick() is going to ask for, the same ones UnityTrickIO makes.
+    inline void GatherTickReads(SaberStateStore& store, int slot, SaberTickInput& in) {
+        SaberColdData& cold = store.cold[slot];
+        in.ready = true;
+        in.attached = (store.attached & SaberStateStore::Bit(slot)) != 0;
+        in.rest = cold.restPose;
+        bool throwPressed = in.tuning.throwBound && (in.actions & Input::ActionBit(Input::Throw));
+        if (store.state[slot] == SaberInteractionState::Returning || StartsRecall(store, slot, throwPressed)) {
+            in.handRestPoint = PointToWorld(cold.handTransform.ptr(), Math::ToUnity(cold.restPose.position));
+            in.handRotation = WorldRotation(cold.handTransform.ptr());
+        }
+        if (StartsThrow(store, slot, throwPressed)) {
+            in.saberPosition = WorldPosition(cold.saberTransform.ptr());
+            in.saberRotation = WorldRotation(cold.saberTransform.ptr());
+        }
+    }
+
+    // Phase 3 for a slot: its reparenting, pending pose and log events. The pose is written by
+    // the slot's next PoseWriter::Flush().
+    inline void ApplyTickWrites(SaberStateStore& store, int slot, SaberTickOutput const& out) {
+        UnityTrickIO io{store, slot, 0};
+        if (out.detach) {
+            io.Detach();
+        }
+        if (out.reattach) {
+            io.Reattach();
+        }
+        if (out.hasPose) {
+            if (out.world) {
+                io.SetWorld(out.position, out.rotation);
+            } else {
+                io.SetLocal(out.position, out.rotation);
+            }
+        }
+        for (int e = 0; e < out.eventCount; e++) {
+            TickEvent const& event = out.events[e];
+            switch (event.level) {
+                case Log::Level::Debug: io.Emit<Log::Level::Debug>(event.event, event.value); break;
+                case Log::Level::Info: io.Emit<Log::Level::Info>(event.event, event.value); break;
+                case Log::Level::Warn: io.Emit<Log::Level::Warn>(event.event, event.value); break;
+                case Log::Level::Error: io.Emit<Log::Level::Error>(event.event, event.value); break;
+            }
+        }
+    }
+
+}  // namespace TrickSaber::Saber
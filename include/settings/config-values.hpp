@@ -0,0 +1,59 @@
+#pragma once
+
+// Every TrickSaberConfig value as plain data, for code that must not touch config-utils off
+// the main thread (see settings/persistence.hpp). Pure C++ so host tools can use it.
+
+#include "settings/preset-format.hpp"
+
+
+// Config values that are not part of a preset, as X(name, type) with name a TrickSaberConfig member.
+#define TRICKSABER_GLOBAL_FIELDS(X)     \
+    X(ModEnabled, bool)                 \
+    X(LeftSaberPresetButton, int)       \
+    X(LeftSaberPresetChordButton, int)  \
+    X(RightSaberPresetButton, int)      \
+    X(RightSaberPresetChordButton, int) \
+    X(ThrownSabersCut, bool)            \
+    X(AutoRecall, bool)                 \
+    X(ThreadedTick, bool)
+
+#define TRICKSABER_CONFIG_FIELDS(X) \
+    TRICKSABER_GLOBAL_FIELDS(X)     \
+    TRICKSABER_PRESET_FIELDS(X)
+
+namespace TrickSaber::Config {
+
+    struct ConfigValues {
+#define TRICKSABER_CONFIG_MEMBER(name, type) type name;
+        TRICKSABER_CONFIG_FIELDS(TRICKSABER_CONFIG_MEMBER)
+#undef TRICKSABER_CONFIG_MEMBER
+    };
+
+#define TRICKSABER_CONFIG_COUNT(name, type) +1
+    constexpr int CONFIG_FIELD_COUNT = 0 TRICKSABER_CONFIG_FIELDS(TRICKSABER_CONFIG_COUNT);
+#undef TRICKSABER_CONFIG_COUNT
+
+    template <typename Writer>
+    void WriteConfigValue(Writer& writer, bool value) { writer.Bool(value); }
+    template <typename Writer>
+    void WriteConfigValue(Writer& writer, int value) { writer.Int(value); }
+    // config-utils keeps floats in its document as doubles
+    template <typename Writer>
+    void WriteConfigValue(Writer& writer, float value) { writer.Double(static_cast<double>(value)); }
+
+    // The config file as config-utils writes it: one JSON object, one member per value, keyed
+    // by keys[i] for the i-th value of TRICKSABER_CONFIG_FIELDS. Writer is a rapidjson writer
+    // (PrettyWriter, as config-utils uses, on device) or anything with the same calls.
+    template <typename Writer>
+    void WriteConfigJson(Writer& writer, ConfigValues const& values, char const* const* keys) {
+        writer.StartObject();
+        int field = 0;
+#define TRICKSABER_WRITE(name, type) \
+        writer.Key(keys[field++]);   \
+        WriteConfigValue(writer, values.name);
+        TRICKSABER_CONFIG_FIELDS(TRICKSABER_WRITE)
+#undef TRICKSABER_WRITE
+        writer.EndObject();
+    }
+
+}  // namespace TrickSaber::Config
@@ -5,23 +5,47 @@
 
 DECLARE_CONFIG(TrickSaberConfig) {
     CONFIG_VALUE(ModEnabled, bool, "Enable TriickSaber Mod", true, "Toggles the entire mod on or off.");
+    CONFIG_VALUE(PeakThrowVelocity, bool, "Peak Throw Velocity", false, "Throw with the fastest hand speed from the last 60 ms instead of the speed at release.");
+    CONFIG_VALUE(LeftSaberPresetButton, int, "Left Saber Preset Button", 0, "Left button that switches to the next preset.");
+    CONFIG_VALUE(LeftSaberPresetChordButton, int, "Left Saber Preset Chord Button", 0, "Extra left button that must be held to switch presets.");
+    CONFIG_VALUE(RightSaberPresetButton, int, "Right Saber Preset Button", 0, "Right button that switches to the next preset.");
+    CONFIG_VALUE(RightSaberPresetChordButton, int, "Right Saber Preset Chord Button", 0, "Extra right button that must be held to switch presets.");
+    CONFIG_VALUE(ThrownSabersCut, bool, "Thrown Sabers Cut", false, "Sabers in flight or returning cut the notes and hit the bombs they pass through.");
+    CONFIG_VALUE(AutoRecall, bool, "Auto Recall", false, "Recall a thrown saber in time to be back in hand for its next note.");
+    CONFIG_VALUE(ThreadedTick, bool, "Threaded Tick", false, "Run the sabers' trick physics on worker threads and apply it before the frame is drawn.");
 
     CONFIG_VALUE(LeftSaberSpinButton, int, "Left Saber Spin Button", 0, "Button to activate left saber spin.");
     CONFIG_VALUE(LeftSaberThrowButton, int, "Left Saber Throw Button", 0, "Button to activate left saber throw.");
+    CONFIG_VALUE(LeftSaberSpinChordButton, int, "Left Saber Spin Chord Button", 0, "Extra button that must be held with the left spin button.");
+    CONFIG_VALUE(LeftSaberThrowChordButton, int, "Left Saber Throw Chord Button", 0, "Extra button that must be held with the left throw button.");
+    CONFIG_VALUE(LeftSaberSpinDoubleTap, bool, "Left Saber Spin Double Tap", false, "Left spin engages on a double tap and holds until released.");
+    CONFIG_VALUE(LeftSaberThrowDoubleTap, bool, "Left Saber Throw Double Tap", false, "Left throw engages on a double tap and holds until released.");
+    CONFIG_VALUE(LeftSaberComboButton, int, "Left Saber Combo Button", 0, "Button that starts the left scripted combo.");
+    CONFIG_VALUE(LeftSaberCombo, int, "Left Saber Combo", 0, "Scripted combo the left combo button plays.");
 
     CONFIG_VALUE(LeftSaberSpinClockwise, bool, "Left Spin Clockwise", true, "If true, spins clockwise, else counter-clockwise.");
     CONFIG_VALUE(LeftSaberSpinSpeed, float, "Left Spin Speed", 2000.0, "Speed of left saber spin in degrees per second.");
     CONFIG_VALUE(LeftSaberSpinAnchorZOffset, float, "Left Spin Anchor Z-Offset", -0.2f, "Offset along saber's length (Z) for spin pivot. Positive is towards tip.");
     CONFIG_VALUE(LeftSaberThrowVelocityMultiplier, float, "Left Throw Velocity Multiplier", 3.0f, "Multiplier for the initial throw velocity of the left saber.");
     CONFIG_VALUE(LeftSaberReturnDuration, float, "Left Saber Return Duration (sec)", 0.2f, "Time it takes for a thrown saber to return. Shorter is faster.");
+    CONFIG_VALUE(LeftSaberReturnCurve, int, "Left Saber Return Path", 0, "Path the left saber flies back on: straight, arc or curl.");
+    CONFIG_VALUE(LeftSaberReturnEasing, int, "Left Saber Return Easing", 0, "How the left saber's return speeds up and slows down along its path.");
 
     CONFIG_VALUE(RightSaberSpinButton, int, "Right Saber Spin Button", 0, "Button to activate right saber spin.");
     CONFIG_VALUE(RightSaberThrowButton, int, "Right Saber Throw Button", 0, "Button to activate right saber throw.");
+    CONFIG_VALUE(RightSaberSpinChordButton, int, "Right Saber Spin Chord Button", 0, "Extra button that must be held with the right spin button.");
+    CONFIG_VALUE(RightSaberThrowChordButton, int, "Right Saber Throw Chord Button", 0, "Extra button that must be held with the right throw button.");
+    CONFIG_VALUE(RightSaberSpinDoubleTap, bool, "Right Saber Spin Double Tap", false, "Right spin engages on a double tap and holds until released.");
+    CONFIG_VALUE(RightSaberThrowDoubleTap, bool, "Right Saber Throw Double Tap", false, "Right throw engages on a double tap and holds until released.");
+    CONFIG_VALUE(RightSaberComboButton, int, "Right Saber Combo Button", 0, "Button that starts the right scripted combo.");
+    CONFIG_VALUE(RightSaberCombo, int, "Right Saber Combo", 0, "Scripted combo the right combo button plays.");
 
     CONFIG_VALUE(RightSaberSpinClockwise, bool, "Right Spin Clockwise", true, "If true, spins clockwise, else counter-clockwise.");
     CONFIG_VALUE(RightSaberSpinSpeed, float, "Right Spin Speed", 2000.0, "Speed of right saber spin in degrees per second.")
     CONFIG_VALUE(RightSaberSpinAnchorZOffset, float, "Right Spin Anchor Z-Offset", -0.2f, "Offset along saber's length (Z) for spin pivot. Positive is towards tip.")
     CONFIG_VALUE(RightSaberThrowVelocityMultiplier, float, "Right Throw Velocity Multiplier", 3.0f, "Multiplier for the initial throw velocity of the right saber."); 
     CONFIG_VALUE(RightSaberReturnDuration, float, "Right Saber Return Duration (sec)", 0.2f, "Time it takes for a thrown saber to return. Shorter is faster.");
+    CONFIG_VALUE(RightSaberReturnCurve, int, "Right Saber Return Path", 0, "Path the right saber flies back on: straight, arc or curl.");
+    CONFIG_VALUE(RightSaberReturnEasing, int, "Right Saber Return Easing", 0, "How the right saber's return speeds up and slows down along its path.");
 
 };
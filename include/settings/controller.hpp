@@ -10,6 +10,9 @@ namespace TrickSaber::UI {
 
     extern std::vector<std::string_view> RightControllerButtonChoices;
     extern std::vector<std::string_view> LeftControllerButtonChoices;
+    extern std::vector<std::string_view> ComboChoices;
+    extern std::vector<std::string_view> ReturnCurveChoices;
+    extern std::vector<std::string_view> ReturnEasingChoices;
 
     void SettingsViewControllerDidActivate(
         HMUI::ViewController* self,
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "settings/save-worker.hpp"
+
+#include <string>
+
+namespace TrickSaber::Config {
+
+    // Settings changes apply in memory at once (SetValue(value, false), which still fires the
+    // change events) and reach the config file through a background SaveWorker. Menu code
+    // calls SaveLater() after each change instead of letting config-utils write the file.
+
+    // Starts the worker on the file config-utils loads (getConfigFilePath()). Call once from
+    // late_load after Config::Init(); config-utils still reads the file at load, it just no
+    // longer writes it.
+    void StartPersistence();
+
+    // Main thread: queues the current config values for writing. Costs a copy and a lock.
+    void SaveLater();
+
+    // Has anything unsaved written now, without waiting: leaving the main menu, before a level
+    // could crash the game.
+    void SaveNow();
+
+    // Writes anything unsaved and waits for it, up to half a second. Only for the app being
+    // paused, after which it may be killed without another callback.
+    bool FlushSaves();
+
+    SaveStats PersistenceStats();
+
+}  // namespace TrickSaber::Config
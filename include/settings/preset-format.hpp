@@ -0,0 +1,122 @@
+#pragma once
+
+// On-disk layout of the preset store. The file is mapped as-is, so every record is a fixed
+// size and the whole file is allocated up front:
+//
+//   PresetFileHeader
+//   PresetRecord[MAX_PRESETS]   only [0, count) are in use
+//
+// A header whose magic, version or record size does not match is treated as no file; the
+// store moves it aside and starts a new one, carrying the records over when they are from an
+// earlier version (IsMigratableHeader). Pure C++ so host tools can read and write it.
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Every config value a preset carries, as X(name, type) with name a TrickSaberConfig member.
+// The rest of the config (settings/config-values.hpp) is not part of a preset. New fields go
+// at the end: records from an older version are the same bytes minus the tail, which is how
+// the store migrates them.
+#define TRICKSABER_PRESET_FIELDS(X)             \
+    X(PeakThrowVelocity, bool)                  \
+    X(LeftSaberSpinButton, int)                 \
+    X(LeftSaberThrowButton, int)                \
+    X(LeftSaberSpinChordButton, int)            \
+    X(LeftSaberThrowChordButton, int)           \
+    X(LeftSaberSpinDoubleTap, bool)             \
+    X(LeftSaberThrowDoubleTap, bool)            \
+    X(LeftSaberComboButton, int)                \
+    X(LeftSaberCombo, int)                      \
+    X(LeftSaberSpinClockwise, bool)             \
+    X(LeftSaberSpinSpeed, float)                \
+    X(LeftSaberSpinAnchorZOffset, float)        \
+    X(LeftSaberThrowVelocityMultiplier, float)  \
+    X(LeftSaberReturnDuration, float)           \
+    X(RightSaberSpinButton, int)                \
+    X(RightSaberThrowButton, int)               \
+    X(RightSaberSpinChordButton, int)           \
+    X(RightSaberThrowChordButton, int)          \
+    X(RightSaberSpinDoubleTap, bool)            \
+    X(RightSaberThrowDoubleTap, bool)           \
+    X(RightSaberComboButton, int)               \
+    X(RightSaberCombo, int)                     \
+    X(RightSaberSpinClockwise, bool)            \
+    X(RightSaberSpinSpeed, float)               \
+    X(RightSaberSpinAnchorZOffset, float)       \
+    X(RightSaberThrowVelocityMultiplier, float) \
+    X(RightSaberReturnDuration, float)          \
+    X(LeftSaberReturnCurve, int)                \
+    X(LeftSaberReturnEasing, int)               \
+    X(RightSaberReturnCurve, int)               \
+    X(RightSaberReturnEasing, int)
+
+namespace TrickSaber::Presets {
+
+    constexpr char MAGIC[4] = {'T', 'S', 'P', 'R'};
+    constexpr uint16_t FORMAT_VERSION = 2;
+    constexpr int MAX_PRESETS = 256;
+    constexpr int NAME_BYTES = 32;  // including the terminator
+
+    struct PresetValues {
+#define TRICKSABER_PRESET_MEMBER(name, type) type name;
+        TRICKSABER_PRESET_FIELDS(TRICKSABER_PRESET_MEMBER)
+#undef TRICKSABER_PRESET_MEMBER
+    };
+
+    struct PresetRecord {
+        char name[NAME_BYTES];
+        PresetValues values;
+    };
+
+    struct PresetFileHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t recordSize;
+        uint32_t capacity;
+        uint32_t count;
+        int32_t active;        // Index of the preset last switched to, -1 for none
+        uint32_t reserved[3];
+    };
+
+    static_assert(std::is_trivially_copyable_v<PresetRecord> && std::is_standard_layout_v<PresetRecord>);
+    static_assert(sizeof(PresetFileHeader) == 32);
+
+    constexpr std::size_t FILE_BYTES = sizeof(PresetFileHeader) + MAX_PRESETS * sizeof(PresetRecord);
+
+    inline PresetFileHeader MakeHeader() {
+        PresetFileHeader header = {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = FORMAT_VERSION;
+        header.recordSize = sizeof(PresetRecord);
+        header.capacity = MAX_PRESETS;
+        header.active = -1;
+        return header;
+    }
+
+    inline bool IsValidHeader(PresetFileHeader const& header) {
+        return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == FORMAT_VERSION &&
+               header.recordSize == sizeof(PresetRecord) && header.capacity == MAX_PRESETS &&
+               header.count <= MAX_PRESETS && header.active < static_cast<int32_t>(header.count);
+    }
+
+    // A header from an earlier version whose records are a prefix of today's (fields were
+    // only appended since), so they can be copied over with the new fields filled in.
+    inline bool IsMigratableHeader(PresetFileHeader const& header) {
+        return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version < FORMAT_VERSION &&
+               header.recordSize > NAME_BYTES && header.recordSize < sizeof(PresetRecord) &&
+               header.capacity == MAX_PRESETS && header.count <= MAX_PRESETS &&
+               header.active < static_cast<int32_t>(header.count);
+    }
+
+    inline PresetRecord* Records(PresetFileHeader* header) {
+        return reinterpret_cast<PresetRecord*>(header + 1);
+    }
+
+    // Copies name into a record, truncating to fit.
+    inline void SetName(PresetRecord& record, char const* name) {
+        std::memset(record.name, 0, NAME_BYTES);
+        std::strncpy(record.name, name, NAME_BYTES - 1);
+    }
+
+}  // namespace TrickSaber::Presets
@@ -0,0 +1,69 @@
+#pragma once
+
+// The ranges the settings UI offers for each preset value. Values that reach a preset some
+// other way (an imported JSON file, an edited or damaged store) are clamped into them before
+// they are published or written back to config-utils, so every dropdown index is in range and
+// every number is one the UI could have set. Pure C++ so host tests can check it.
+
+#include "combo/library.hpp"
+#include "input/bindings.hpp"
+#include "physics/return-path.hpp"
+#include "settings/preset-format.hpp"
+
+#include <algorithm>
+
+namespace TrickSaber::Presets {
+
+    struct FloatRange {
+        float min;
+        float max;
+    };
+
+    constexpr FloatRange SPIN_SPEED_RANGE = {100.0f, 10000.0f};
+    constexpr FloatRange SPIN_ANCHOR_RANGE = {-1.0f, 1.0f};
+    constexpr FloatRange THROW_MULTIPLIER_RANGE = {0.5f, 5.0f};
+    constexpr FloatRange RETURN_DURATION_RANGE = {0.02f, 1.5f};
+
+    // NaN takes the minimum.
+    inline float Clamp(float value, FloatRange range) {
+        return !(value >= range.min) ? range.min : std::min(value, range.max);
+    }
+
+    // Dropdown index with count choices; anything outside takes the first.
+    inline int ClampChoice(int value, int count) {
+        return value >= 0 && value < count ? value : 0;
+    }
+
+    inline void ClampValues(PresetValues& values) {
+        constexpr int BUTTONS = Input::BUTTON_COUNT + 1;  // Including "None"
+        constexpr int CURVES = static_cast<int>(Math::ReturnCurve::Count);
+        constexpr int EASINGS = static_cast<int>(Math::ReturnEasing::Count);
+
+        values.LeftSaberSpinButton = ClampChoice(values.LeftSaberSpinButton, BUTTONS);
+        values.LeftSaberThrowButton = ClampChoice(values.LeftSaberThrowButton, BUTTONS);
+        values.LeftSaberSpinChordButton = ClampChoice(values.LeftSaberSpinChordButton, BUTTONS);
+        values.LeftSaberThrowChordButton = ClampChoice(values.LeftSaberThrowChordButton, BUTTONS);
+        values.LeftSaberComboButton = ClampChoice(values.LeftSaberComboButton, BUTTONS);
+        values.LeftSaberCombo = ClampChoice(values.LeftSaberCombo, Combo::ComboCount);
+        values.LeftSaberSpinSpeed = Clamp(values.LeftSaberSpinSpeed, SPIN_SPEED_RANGE);
+        values.LeftSaberSpinAnchorZOffset = Clamp(values.LeftSaberSpinAnchorZOffset, SPIN_ANCHOR_RANGE);
+        values.LeftSaberThrowVelocityMultiplier = Clamp(values.LeftSaberThrowVelocityMultiplier, THROW_MULTIPLIER_RANGE);
+        values.LeftSaberReturnDuration = Clamp(values.LeftSaberReturnDuration, RETURN_DURATION_RANGE);
+        values.LeftSaberReturnCurve = ClampChoice(values.LeftSaberReturnCurve, CURVES);
+        values.LeftSaberReturnEasing = ClampChoice(values.LeftSaberReturnEasing, EASINGS);
+
+        values.RightSaberSpinButton = ClampChoice(values.RightSaberSpinButton, BUTTONS);
+        values.RightSaberThrowButton = ClampChoice(values.RightSaberThrowButton, BUTTONS);
+        values.RightSaberSpinChordButton = ClampChoice(values.RightSaberSpinChordButton, BUTTONS);
+        values.RightSaberThrowChordButton = ClampChoice(values.RightSaberThrowChordButton, BUTTONS);
+        values.RightSaberComboButton = ClampChoice(values.RightSaberComboButton, BUTTONS);
+        values.RightSaberCombo = ClampChoice(values.RightSaberCombo, Combo::ComboCount);
+        values.RightSaberSpinSpeed = Clamp(values.RightSaberSpinSpeed, SPIN_SPEED_RANGE);
+        values.RightSaberSpinAnchorZOffset = Clamp(values.RightSaberSpinAnchorZOffset, SPIN_ANCHOR_RANGE);
+        values.RightSaberThrowVelocityMultiplier = Clamp(values.RightSaberThrowVelocityMultiplier, THROW_MULTIPLIER_RANGE);
+        values.RightSaberReturnDuration = Clamp(values.RightSaberReturnDuration, RETURN_DURATION_RANGE);
+        values.RightSaberReturnCurve = ClampChoice(values.RightSaberReturnCurve, CURVES);
+        values.RightSaberReturnEasing = ClampChoice(values.RightSaberReturnEasing, EASINGS);
+    }
+
+}  // namespace TrickSaber::Presets
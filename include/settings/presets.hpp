@@ -0,0 +1,50 @@
+#pragma once
+
+#include "settings/preset-format.hpp"
+
+#include <string>
+
+namespace TrickSaber::Presets {
+
+    // Named sets of trick settings kept in <mod data dir>/presets.tspr (see settings/preset-format.hpp),
+    // mapped into memory at load. Switching publishes a config snapshot straight from the mapped
+    // record, so it costs the same as any config change and never parses or writes JSON. The
+    // config-utils values catch up with ApplyPending() from the menus.
+
+    // Maps the preset file, creating it with the current config as "Default" if there is none.
+    // Call once from late_load after Config::Init().
+    bool Init();
+
+    int Count();
+
+    // Empty for an out-of-range index.
+    std::string Name(int index);
+
+    // Preset last switched to, or -1.
+    int Active();
+
+    // Publishes the preset's settings. O(1); safe from the FixedUpdate hook.
+    bool Activate(int index);
+
+    // Activates the preset after the active one, wrapping around.
+    void CycleNext();
+
+    // Stores the current config values under name, replacing a preset with the same name.
+    // Returns its index, or -1 if the store is full or not mapped.
+    int SaveCurrent(std::string const& name);
+
+    bool Delete(int index);
+
+    // Writes the active preset into the config-utils values (one background config file write)
+    // if a switch happened since the last call. Menu code only: every value fires its change event.
+    void ApplyPending();
+
+    // <mod data dir>/presets.json, one object per preset keyed by TrickSaberConfig member names.
+    // Import adds or replaces presets by name; values missing from a preset keep the current config.
+    // Both return the number of presets written or read, or -1 on error.
+    int ExportJson();
+    int ImportJson();
+
+    std::string JsonPath();
+
+}  // namespace TrickSaber::Presets
@@ -0,0 +1,179 @@
+#pragma once
+
+// Coalesces settings changes into occasional background file writes. The UI thread hands over
+// a copy of the values on every change, which only takes a lock; a worker thread writes the
+// newest copy once changes have paused for DEBOUNCE, or MAX_DELAY after the first unsaved one
+// while they keep coming (a held slider). Every write goes through WriteFileAtomically, so a
+// crash at any point leaves either the previous file or the new one, never a mix.
+//
+// Pure C++ with no Unity or config-utils types, so host tools can drive it.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace TrickSaber::Config {
+
+    constexpr std::chrono::milliseconds DEBOUNCE{500};
+    constexpr std::chrono::milliseconds MAX_DELAY{2000};
+
+    // Writes contents to path + ".tmp", syncs it, and renames it over path, then syncs the
+    // directory so the rename itself survives a power cut. False, with path untouched, on error.
+    bool WriteFileAtomically(std::string const& path, std::string_view contents);
+
+    struct SaveStats {
+        uint64_t changes = 0;   // Handed over by the UI thread
+        uint64_t writes = 0;    // Files written
+        uint64_t failures = 0;  // Writes that failed and will be retried
+    };
+
+    template <typename Values>
+    class SaveWorker {
+    public:
+        using Render = std::string (*)(Values const& values);
+
+        SaveWorker() = default;
+        SaveWorker(SaveWorker const&) = delete;
+        SaveWorker& operator=(SaveWorker const&) = delete;
+        ~SaveWorker() { Stop(); }
+
+        void Start(std::string filePath, Render renderFile) {
+            Stop();
+            path = std::move(filePath);
+            render = renderFile;
+            stopping = false;
+            thread = std::thread([this] { Run(); });
+        }
+
+        // Writes anything unsaved and joins the worker.
+        void Stop() {
+            if (!thread.joinable()) {
+                return;
+            }
+            {
+                std::lock_guard lock(mutex);
+                stopping = true;
+            }
+            wake.notify_one();
+            thread.join();
+        }
+
+        // UI thread, on every change. Never touches the file.
+        void Changed(Values const& values) {
+            bool wasClean;
+            {
+                std::lock_guard lock(mutex);
+                auto now = Clock::now();
+                pending = values;
+                stats.changes++;
+                wasClean = !dirty;
+                if (wasClean) {
+                    firstChange = now;
+                }
+                lastChange = now;
+                dirty = true;
+            }
+            // A dirty worker is already waiting on a deadline and re-checks it when it wakes
+            if (wasClean) {
+                wake.notify_one();
+            }
+        }
+
+        // Has the worker write anything unsaved now, without waiting for it. Only takes the lock.
+        void FlushSoon() {
+            {
+                std::lock_guard lock(mutex);
+                if (!dirty) {
+                    return;
+                }
+                flushRequested = true;
+            }
+            wake.notify_one();
+        }
+
+        // Writes anything unsaved now and waits for it. True once every change handed over
+        // before the call is on disk; false if that has not happened within timeout.
+        bool Flush(std::chrono::milliseconds timeout) {
+            std::unique_lock lock(mutex);
+            uint64_t target = stats.changes;
+            if (saved >= target) {
+                return true;
+            }
+            flushRequested = true;
+            wake.notify_one();
+            return written.wait_for(lock, timeout, [&] { return saved >= target; });
+        }
+
+        SaveStats Stats() {
+            std::lock_guard lock(mutex);
+            return stats;
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void Run() {
+            std::unique_lock lock(mutex);
+            while (true) {
+                if (!dirty) {
+                    if (stopping) {
+                        return;
+                    }
+                    wake.wait_for(lock, MAX_DELAY);
+                    continue;
+                }
+                auto due = std::min(lastChange + DEBOUNCE, firstChange + MAX_DELAY);
+                if (!flushRequested && !stopping && Clock::now() < due) {
+                    wake.wait_until(lock, due);
+                    continue;
+                }
+
+                Values values = pending;
+                uint64_t generation = stats.changes;
+                dirty = false;
+                flushRequested = false;
+                lock.unlock();
+                bool ok = WriteFileAtomically(path, render(values));
+                lock.lock();
+
+                if (ok) {
+                    saved = generation;
+                    stats.writes++;
+                    written.notify_all();
+                } else {
+                    stats.failures++;
+                    if (!dirty) {
+                        // Try again a debounce from now rather than spinning on a full disk
+                        dirty = true;
+                        firstChange = lastChange = Clock::now();
+                    }
+                    if (stopping) {
+                        return;
+                    }
+                }
+            }
+        }
+
+        std::string path;
+        Render render = nullptr;
+        std::thread thread;
+
+        std::mutex mutex;
+        std::condition_variable wake;     // Worker: a change, a flush or stop
+        std::condition_variable written;  // Flush(): a write finished
+        Values pending{};
+        bool dirty = false;
+        bool flushRequested = false;
+        bool stopping = false;
+        Clock::time_point firstChange;    // Oldest unsaved change
+        Clock::time_point lastChange;
+        uint64_t saved = 0;               // stats.changes as of the last good write
+        SaveStats stats;
+    };
+
+}  // namespace TrickSaber::Config
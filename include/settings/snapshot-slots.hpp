@@ -0,0 +1,120 @@
+#pragma once
+
+// A published value that readers pin instead of copy. Publish() fills a slot no reader holds
+// and swaps it in; Acquire() pins the current slot for as long as the returned Pin lives, so
+// a publish landing mid-tick can never rewrite what a reader is looking at.
+//
+// A reader bumps the slot's count and then checks the slot is still current, backing off if
+// a publish got in between. The writer only refills a slot whose count it saw at zero, and
+// every one of those loads and stores is seq_cst, so either the writer sees the reader's pin
+// or the reader sees the slot has been retired. Publishers are serialized by a mutex.
+//
+// Pure C++, so the host tests can hammer it from several threads.
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace TrickSaber::Config {
+
+    template <typename T, int SLOTS = 4>
+    class SnapshotSlots {
+        static_assert(SLOTS >= 2, "a publish needs a slot besides the current one");
+
+        struct alignas(64) Slot {
+            T value;
+            std::atomic<int> readers{0};
+        };
+
+    public:
+        class Pin {
+        public:
+            Pin() = default;
+            Pin(Pin&& other) noexcept : slot(other.slot) { other.slot = nullptr; }
+            Pin& operator=(Pin&& other) noexcept {
+                if (this != &other) {
+                    Release();
+                    slot = other.slot;
+                    other.slot = nullptr;
+                }
+                return *this;
+            }
+            Pin(Pin const&) = delete;
+            Pin& operator=(Pin const&) = delete;
+            ~Pin() { Release(); }
+
+            T const& operator*() const { return slot->value; }
+            T const* operator->() const { return &slot->value; }
+            explicit operator bool() const { return slot != nullptr; }
+
+        private:
+            friend class SnapshotSlots;
+            explicit Pin(Slot* slot) : slot(slot) {}
+
+            void Release() {
+                if (slot) {
+                    slot->readers.fetch_sub(1, std::memory_order_release);
+                    slot = nullptr;
+                }
+            }
+
+            Slot* slot = nullptr;
+        };
+
+        // Empty Pin until the first Publish(). Lock-free; retries only when a publish lands
+        // between its two loads.
+        Pin Acquire() {
+            for (;;) {
+                int index = current.load(std::memory_order_seq_cst);
+                if (index < 0) {
+                    return Pin();
+                }
+                Slot& slot = slots[index];
+                slot.readers.fetch_add(1, std::memory_order_seq_cst);
+                if (current.load(std::memory_order_seq_cst) == index) {
+                    return Pin(&slot);
+                }
+                slot.readers.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        // Calls fill(T&, generation) on a slot no reader holds, then makes it current.
+        // Returns the new generation. Waits only if every other slot is pinned.
+        template <typename Fill>
+        uint32_t Publish(Fill&& fill) {
+            std::lock_guard lock(writer);
+            int now = current.load(std::memory_order_relaxed);
+            int index = FreeSlot(now);
+            while (index < 0) {
+                std::this_thread::yield();
+                index = FreeSlot(now);
+            }
+            uint32_t next = ++generation;
+            fill(slots[index].value, next);
+            current.store(index, std::memory_order_seq_cst);
+            return next;
+        }
+
+        uint32_t Generation() {
+            std::lock_guard lock(writer);
+            return generation;
+        }
+
+    private:
+        int FreeSlot(int now) {
+            for (int i = 0; i < SLOTS; i++) {
+                if (i != now && slots[i].readers.load(std::memory_order_seq_cst) == 0) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        Slot slots[SLOTS];
+        std::atomic<int> current{-1};
+        std::mutex writer;
+        uint32_t generation = 0;
+    };
+
+}  // namespace TrickSaber::Config
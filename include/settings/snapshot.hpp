@@ -0,0 +1,57 @@
+#pragma once
+
+#include "GlobalNamespace/OVRInput.hpp"
+#include "input/bindings.hpp"
+#include "settings/preset-format.hpp"
+#include "settings/snapshot-slots.hpp"
+#include "settings/tuning.hpp"
+
+#include <cstdint>
+
+namespace TrickSaber::Config {
+
+    // Per-hand values with everything the tick needs already derived. Bindings are compiled
+    // into a dense poll table: each distinct bound button is polled once per tick into bit
+    // pollBits[i] of the hand's raw mask, however many actions or sabers use it.
+    struct HandSettings : HandTuning {
+        Input::Binding bindings[Input::ActionCount];
+        int pollCount;
+        GlobalNamespace::OVRInput::Button pollButtons[Input::BUTTON_COUNT];
+        uint32_t pollBits[Input::BUTTON_COUNT];
+        int combo;  // Combo::ComboId started by the Combo action
+    };
+
+    // Immutable view of getTrickSaberConfig(), rebuilt only when a value changes.
+    struct alignas(64) Snapshot {
+        HandSettings hands[HandCount];
+        bool modEnabled;
+        bool thrownSabersCut;
+        bool autoRecall;
+        bool threadedTick;  // Tick compute on the worker pool (saber/tick-pipeline.hpp)
+        uint32_t generation;
+    };
+
+    GlobalNamespace::OVRInput::Button GetOVRButtonForConfig(int configuredButtonIndex, bool isLeftController);
+
+    // Builds the first snapshot and subscribes to every config value's change event.
+    // Call once after getTrickSaberConfig().Init().
+    void Init();
+
+    // Rebuilds and publishes a new snapshot from the current config values.
+    void Republish();
+
+    // Publishes a snapshot from preset values without touching the config-utils values. Mod
+    // enable, the preset-cycle bindings and the other global values still come from config. O(1);
+    // any thread, though config-utils values are only read safely on the main thread.
+    void Publish(Presets::PresetValues const& values);
+
+    // The config-utils values a preset carries, as they are now.
+    Presets::PresetValues CaptureConfig();
+
+    using SnapshotPin = SnapshotSlots<Snapshot>::Pin;
+
+    // The published snapshot, pinned: it is not rewritten until the pin is dropped, whatever
+    // is published meanwhile. Hold it for one tick at most (settings/snapshot-slots.hpp).
+    SnapshotPin Current();
+
+}  // namespace TrickSaber::Config
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+namespace TrickSaber::Math {
+    struct ReturnPath;
+}
+
+namespace TrickSaber::Config {
+
+    enum Hand : int { Left = 0, Right = 1, HandCount = 2 };
+
+    // Per-hand values the trick state machine reads. No input or Unity types, so the
+    // machine can be driven from host tools.
+    struct HandTuning {
+        bool throwBound;
+        bool spinBound;
+        float spinDirection;            // +1 clockwise, -1 counter-clockwise
+        float spinDegPerSec;            // signed, direction applied
+        float spinRadPerSec;            // signed, direction applied
+        float spinAnchorZOffset;
+        float throwVelocityMultiplier;
+        float returnDuration;           // clamped to >= MIN_RETURN_DURATION
+        uint8_t returnStyle;            // Math::ReturnStyle of the curve and easing
+        Math::ReturnPath const* returnPath;  // Baked for returnStyle, never null
+        float peakReleaseWindow;        // seconds; 0 throws with the latest hand velocity
+    };
+
+    constexpr float MIN_RETURN_DURATION = 0.01f;
+    constexpr float PEAK_RELEASE_WINDOW = 0.06f;
+
+}  // namespace TrickSaber::Config
@@ -0,0 +1,116 @@
+#include "beatmap/gap-index.hpp"
+#include "perf/timers.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+namespace TrickSaber::Beatmap {
+
+    constexpr int MAX_CURSOR_STEPS = 4;
+
+    struct BusyInterval {
+        float start;
+        float end;
+    };
+
+    GapIndex BuildGapIndex(std::vector<TimelineItem> const& items) {
+        std::vector<BusyInterval> busy[HAND_COUNT];
+        for (TimelineItem const& item : items) {
+            if (item.hand < 0 || item.hand >= HAND_COUNT || item.kind == TimelineKind::Bomb || item.kind == TimelineKind::Obstacle) {
+                continue;
+            }
+            busy[item.hand].push_back({item.time, std::max(item.time, item.endTime)});
+        }
+
+        GapIndex index;
+        for (int hand = 0; hand < HAND_COUNT; hand++) {
+            std::vector<BusyInterval>& intervals = busy[hand];
+            std::sort(intervals.begin(), intervals.end(), [](BusyInterval a, BusyInterval b) { return a.start < b.start; });
+            std::vector<FreeWindow>& windows = index.windows[hand];
+            windows.reserve(intervals.size() + 1);
+            float freeFrom = -INFINITY;
+            for (BusyInterval interval : intervals) {
+                // Overlapping or touching intervals merge; only a real gap makes a window
+                if (interval.start > freeFrom) {
+                    windows.push_back({freeFrom, interval.start - freeFrom, interval.start});
+                }
+                freeFrom = std::max(freeFrom, interval.end);
+            }
+            windows.push_back({freeFrom, INFINITY, INFINITY});
+        }
+        return index;
+    }
+
+    float TimeUntilNextCut(GapIndex const& index, GapCursor& cursor, int hand, float songTime) {
+        std::vector<FreeWindow> const& windows = index.windows[hand];
+        int count = static_cast<int>(windows.size());
+        auto passed = [songTime](FreeWindow const& w) { return w.nextCut <= songTime; };
+        int& k = cursor.window[hand];
+        if (k > count || (k > 0 && songTime < windows[k - 1].nextCut)) {
+            // Song time went back: a restart or a seek
+            k = static_cast<int>(std::partition_point(windows.begin(), windows.end(), passed) - windows.begin());
+        } else {
+            // Playing moves on a window or two a tick at most; further than that is a seek
+            for (int steps = 0; k < count && passed(windows[k]); steps++) {
+                if (steps == MAX_CURSOR_STEPS) {
+                    k = static_cast<int>(std::partition_point(windows.begin() + k, windows.end(), passed) - windows.begin());
+                    break;
+                }
+                k++;
+            }
+        }
+        if (k == count) {
+            return INFINITY;
+        }
+        if (songTime < windows[k].start) {
+            return 0.0f;  // Between windows: the hand is mid-arc or mid-chain
+        }
+        return windows[k].nextCut - songTime;
+    }
+
+    // --- Build worker ---
+    static std::atomic<uint32_t> generation{0};
+    static std::atomic<GapIndex*> finished{nullptr};  // Built and waiting for the main thread
+    static std::unique_ptr<GapIndex> current;         // Main thread only
+    static std::atomic<uint64_t> lastBuildNs{0};
+
+    void StartGapIndexBuild(std::vector<TimelineItem> items) {
+        uint32_t build = generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+        current.reset();
+        std::thread([items = std::move(items), build] {
+            uint64_t start = Perf::NowNs();
+            auto index = std::make_unique<GapIndex>(BuildGapIndex(items));
+            index->generation = build;
+            lastBuildNs.store(Perf::NowNs() - start, std::memory_order_relaxed);
+            if (generation.load(std::memory_order_acquire) == build) {
+                delete finished.exchange(index.release(), std::memory_order_acq_rel);
+            }
+        }).detach();
+    }
+
+    GapIndex const* CurrentGapIndex(GapCursor& cursor) {
+        if (GapIndex* ready = finished.exchange(nullptr, std::memory_order_acq_rel)) {
+            if (ready->generation == generation.load(std::memory_order_acquire)) {
+                current.reset(ready);
+                cursor = GapCursor();
+            } else {
+                delete ready;
+            }
+        }
+        return current.get();
+    }
+
+    void ClearGapIndex() {
+        generation.fetch_add(1, std::memory_order_acq_rel);
+        current.reset();
+        delete finished.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    uint64_t LastGapIndexBuildNs() {
+        return lastBuildNs.load(std::memory_order_relaxed);
+    }
+
+}  // namespace TrickSaber::Beatmap
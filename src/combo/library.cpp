@@ -0,0 +1,63 @@
+#include "combo/library.hpp"
+
+namespace TrickSaber::Combo {
+
+    using Input::Spin;
+    using Input::Throw;
+    using Saber::SaberInteractionState;
+
+    static constexpr float WIND_UP = 0.4f;    // Held spin before letting go
+    static constexpr float FLIGHT = 0.4f;     // Time in the air before the recall
+    static constexpr float FINISH = 0.4f;     // Closing spin once back in the hand
+
+    // Spin up, throw while spinning so the blade keeps turning in the air, recall, then
+    // counter-spin as soon as it is back in the hand.
+    static Sequence SpinThrowCombo(ComboContext& ctx) {
+        ctx.Hold(Spin);
+        co_await ctx.Seconds(WIND_UP);
+        ctx.Hold(Throw);
+        co_await ctx.Seconds(FLIGHT);
+        ctx.Release(Throw);
+        ctx.Release(Spin);
+        co_await ctx.UntilState(SaberInteractionState::Held);
+        ctx.reverseSpin = true;
+        ctx.Hold(Spin);
+        co_await ctx.Seconds(FINISH);
+        ctx.Release(Spin);
+    }
+
+    // Two short throws back to back, the second leaving as soon as the first is caught.
+    static Sequence DoubleThrowCombo(ComboContext& ctx) {
+        for (int i = 0; i < 2; i++) {
+            ctx.Hold(Throw);
+            co_await ctx.Seconds(FLIGHT * 0.5f);
+            ctx.Release(Throw);
+            co_await ctx.UntilState(SaberInteractionState::Held);
+            co_await ctx.NextTick();
+        }
+    }
+
+    // Spin one way, then the other, for as long as the player keeps the combo held.
+    static Sequence ReverseSpinCombo(ComboContext& ctx) {
+        ctx.Hold(Spin);
+        co_await ctx.Seconds(WIND_UP);
+        ctx.Release(Spin);
+        co_await ctx.NextTick();
+        ctx.reverseSpin = true;
+        ctx.Hold(Spin);
+        co_await ctx.UntilReleased(Input::Combo);
+        ctx.Release(Spin);
+    }
+
+    static constexpr char const* NAMES[ComboCount] = {"Spin Throw", "Double Throw", "Reverse Spin"};
+    static constexpr ComboFn COMBOS[ComboCount] = {SpinThrowCombo, DoubleThrowCombo, ReverseSpinCombo};
+
+    char const* ComboName(int id) {
+        return id >= 0 && id < ComboCount ? NAMES[id] : "None";
+    }
+
+    ComboFn GetCombo(int id) {
+        return id >= 0 && id < ComboCount ? COMBOS[id] : nullptr;
+    }
+
+}  // namespace TrickSaber::Combo
@@ -0,0 +1,96 @@
+#include "combo/scheduler.hpp"
+
+namespace TrickSaber::Combo {
+
+    ComboScheduler::ComboScheduler() {
+        for (int8_t& runner : runnerForSlot) {
+            runner = -1;
+        }
+        freeRunners = Saber::MAX_SABERS == 64 ? ~0ull : (1ull << Saber::MAX_SABERS) - 1;
+    }
+
+    bool ComboScheduler::Start(int slot, ComboFn fn) {
+        if (runnerForSlot[slot] >= 0 || freeRunners == 0) {
+            return false;
+        }
+        int index = __builtin_ctzll(freeRunners);
+        Runner& runner = runners[index];
+        runner.context.actions = 0;
+        runner.context.reverseSpin = false;
+        runner.sequence = fn(runner.context);
+        if (!runner.sequence.Valid()) {
+            runner.context.arena.Rewind();
+            return false;
+        }
+
+        freeRunners &= ~(1ull << index);
+        runnerForSlot[slot] = static_cast<int8_t>(index);
+        activeCount++;
+        return true;
+    }
+
+    void ComboScheduler::Free(int slot) {
+        int index = runnerForSlot[slot];
+        Runner& runner = runners[index];
+        runner.sequence.Reset();
+        runner.context.arena.Rewind();
+        runner.context.actions = 0;
+        runner.context.reverseSpin = false;
+        freeRunners |= 1ull << index;
+        runnerForSlot[slot] = -1;
+        activeCount--;
+    }
+
+    void ComboScheduler::Cancel(int slot) {
+        if (runnerForSlot[slot] >= 0) {
+            Free(slot);
+        }
+    }
+
+    void ComboScheduler::CancelAll() {
+        for (int slot = 0; slot < Saber::MAX_SABERS && activeCount > 0; slot++) {
+            Cancel(slot);
+        }
+    }
+
+    void ComboScheduler::MoveSlot(int from, int to) {
+        if (from != to) {
+            runnerForSlot[to] = runnerForSlot[from];
+            runnerForSlot[from] = -1;
+        }
+    }
+
+    ComboContext const* ComboScheduler::Tick(int slot, float now, uint32_t handActions, uint32_t handPressed, Saber::SaberInteractionState state) {
+        int index = runnerForSlot[slot];
+        if (index < 0) {
+            return nullptr;
+        }
+        Runner& runner = runners[index];
+        ComboContext& context = runner.context;
+        context.now = now;
+        context.handActions = handActions;
+        context.handPressed = handPressed;
+        context.state = state;
+
+        Wait& wait = runner.sequence.Waiting();
+        bool ready = false;
+        switch (wait.kind) {
+            case WaitKind::None: ready = true; break;
+            case WaitKind::Ticks: ready = --wait.ticks <= 0; break;
+            case WaitKind::Until: ready = now >= wait.until; break;
+            case WaitKind::Pressed: ready = (handPressed & wait.mask) != 0; break;
+            case WaitKind::Released: ready = (handActions & wait.mask) == 0; break;
+            case WaitKind::State: ready = state == wait.state; break;
+        }
+        if (ready) {
+            wait.kind = WaitKind::None;
+            runner.sequence.Resume();
+            if (runner.sequence.Done()) {
+                Free(slot);
+                return nullptr;
+            }
+        }
+        return &context;
+    }
+
+}  // namespace TrickSaber::Combo
@@ -0,0 +1,39 @@
+#include "input/bindings.hpp"
+
+namespace TrickSaber::Input {
+
+    uint32_t InputTracker::Update(uint32_t buttons, float now, Binding const* bindings) {
+        previous = current;
+        current = buttons;
+
+        uint32_t nextActions = 0;
+        uint32_t nextChordHeld = 0;
+        for (int a = 0; a < ActionCount; a++) {
+            Binding const& binding = bindings[a];
+            uint32_t bit = 1u << a;
+            bool held = binding.mask != 0 && (buttons & binding.mask) == binding.mask;
+            if (!held) {
+                continue;
+            }
+            nextChordHeld |= bit;
+
+            if (!binding.doubleTap) {
+                nextActions |= bit;
+            } else if (actions & bit) {
+                nextActions |= bit;  // Latched until the chord is released
+            } else if (!(chordHeld & bit)) {
+                // Chord just completed; engage if it is the second press in the window
+                if (now - lastChordPress[a] <= DOUBLE_TAP_WINDOW) {
+                    nextActions |= bit;
+                    lastChordPress[a] = -1e9f;
+                } else {
+                    lastChordPress[a] = now;
+                }
+            }
+        }
+        chordHeld = nextChordHeld;
+        actions = nextActions;
+        return actions;
+    }
+
+}  // namespace TrickSaber::Input
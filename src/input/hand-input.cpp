@@ -0,0 +1,30 @@
+#include "input/hand-input.hpp"
+#include "perf/timers.hpp"
+#include "perf/trace.hpp"
+
+namespace TrickSaber::Input {
+
+    GlobalNamespace::OVRInput::Controller HandController(Config::Hand hand) {
+        return hand == Config::Left ? GlobalNamespace::OVRInput::Controller::LTouch : GlobalNamespace::OVRInput::Controller::RTouch;
+    }
+
+    void PollInput(HandInput& input, Config::Snapshot const& config, float now) {
+        TS_TRACE_SCOPE(Trace::Span::InputPoll);
+        input.inputPollNs = Perf::NowNs();
+        for (int h = 0; h < Config::HandCount; h++) {
+            Config::HandSettings const& hand = config.hands[h];
+            auto controller = HandController(static_cast<Config::Hand>(h));
+            uint32_t buttons = 0;
+            for (int b = 0; b < hand.pollCount; b++) {
+                if (GlobalNamespace::OVRInput::Get(hand.pollButtons[b], controller)) {
+                    buttons |= hand.pollBits[b];
+                }
+            }
+            uint32_t previous = input.actions[h];
+            input.actions[h] = input.tracker[h].Update(buttons, now, hand.bindings);
+            input.pressed[h] = input.actions[h] & ~previous;
+            input.recorded[h] = 0;
+        }
+    }
+
+}  // namespace TrickSaber::Input
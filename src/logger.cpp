@@ -1,6 +1,124 @@
 #include "logger.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 Paper::ConstLoggerContext<12UL> getLogger() {
     static auto fastContext = Paper::Logger::WithContext<"TriickSaber">();
     return fastContext;
-}
\ No newline at end of file
+}
+
+namespace TrickSaber::Log {
+
+    static constexpr uint32_t RING_CAPACITY = 1024;  // power of two
+    static constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(20);
+
+    static Record ring[RING_CAPACITY];
+    alignas(64) static std::atomic<uint32_t> head{0};  // written by the hook thread
+    alignas(64) static std::atomic<uint32_t> tail{0};  // written by the flush thread
+    alignas(64) static std::atomic<uint64_t> dropped{0};
+    static std::atomic<bool> started{false};
+
+    static uint64_t NowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void Push(Level level, Event event, int slot, int hand, float a, float b, float c, float d) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Record& r = ring[h & (RING_CAPACITY - 1)];
+        r.timestampNs = NowNs();
+        r.event = event;
+        r.level = level;
+        r.slot = static_cast<uint8_t>(slot);
+        r.hand = static_cast<uint8_t>(hand);
+        r.values[0] = a;
+        r.values[1] = b;
+        r.values[2] = c;
+        r.values[3] = d;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    uint64_t DroppedRecords() {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    static void Format(Record const& r) {
+        char const* side = r.hand == 0 ? "Left" : "Right";
+        switch (r.event) {
+            case Event::ThrowInitiated:
+                getLogger().info("[TS] [FixedUpdate] [{} Saber {}] Throw Initiated ({:.2f} m/s)", side, r.slot, r.values[0]);
+                break;
+            case Event::GentleThrow:
+                getLogger().info("[TS] [FixedUpdate] [{} Saber {}] Gentle throw", side, r.slot);
+                break;
+            case Event::StraightThrow:
+                getLogger().info("[TS] [FixedUpdate] [{} Saber {}] Straight throw", side, r.slot);
+                break;
+            case Event::NormalThrow:
+                getLogger().info("[TS] [FixedUpdate] [{} Saber {}] Normal throw ({:.2f} m/s)", side, r.slot, r.values[0]);
+                break;
+            case Event::RecallInitiated:
+                getLogger().info("[TS] [FixedUpdate] [{} Saber {}] Recall Initiated", side, r.slot);
+                break;
+            case Event::SpinActivated:
+                getLogger().info("[TS] [FixedUpdate] [{} Saber {}] Spin Activated", side, r.slot);
+                break;
+            case Event::SpinDeactivated:
+                getLogger().info("[TS] [FixedUpdate] [{} Saber {}] Spin Deactivated, restoring position", side, r.slot);
+                break;
+            case Event::Reparented:
+                getLogger().info("[TS] [FixedUpdate] [{} Saber {}] Re-parented and reset in Held state", side, r.slot);
+                break;
+            case Event::ReturnedToHand:
+                getLogger().info("[TS] [FixedUpdate] [{} Saber {}] Returned to hand", side, r.slot);
+                break;
+            case Event::SaberInvalid:
+                getLogger().error("[TS] [FixedUpdate] [{} Saber {}] Became invalid while not Held. Resetting state", side, r.slot);
+                break;
+            case Event::NoteCut:
+                getLogger().info("[TS] [Render] [{} Saber {}] Thrown saber cut a note ({:.2f} through the frame)", side, r.slot, r.values[0]);
+                break;
+            case Event::BombHit:
+                getLogger().info("[TS] [Render] [{} Saber {}] Thrown saber hit a bomb ({:.2f} through the frame)", side, r.slot, r.values[0]);
+                break;
+            case Event::ObstacleHit:
+                getLogger().debug("[TS] [Render] [{} Saber {}] Thrown saber passed through a wall ({:.2f} through the frame)", side, r.slot, r.values[0]);
+                break;
+            case Event::AutoRecall:
+                getLogger().info("[TS] [FixedUpdate] [{} Saber {}] Auto recall, next note in {:.2f} s", side, r.slot, r.values[0]);
+                break;
+        }
+    }
+
+    static void FlushLoop() {
+        uint64_t reportedDropped = 0;
+        while (true) {
+            uint32_t t = tail.load(std::memory_order_relaxed);
+            uint32_t h = head.load(std::memory_order_acquire);
+            for (; t != h; t++) {
+                Format(ring[t & (RING_CAPACITY - 1)]);
+            }
+            tail.store(t, std::memory_order_release);
+
+            uint64_t d = dropped.load(std::memory_order_relaxed);
+            if (d != reportedDropped) {
+                getLogger().warn("[TS] [Log] {} hook log records dropped (ring full)", d - reportedDropped);
+                reportedDropped = d;
+            }
+            std::this_thread::sleep_for(FLUSH_INTERVAL);
+        }
+    }
+
+    void Start() {
+        if (started.exchange(true)) {
+            return;
+        }
+        std::thread(FlushLoop).detach();
+    }
+
+}  // namespace TrickSaber::Log
@@ -1,121 +1,126 @@
 #include "main.hpp"
 #include "logger.hpp"
 #include "util.hpp"
-
-#ifndef M_PI
-    #define M_PI 3.14159265358979323846
-#endif
-
-const float DEG2RAD_CONSTANT = M_PI / 180.0f;
-const float RAD2DEG_CONSTANT = 180.0f / M_PI;
-
-// --- Global Saber Transform References using SafePtrUnity ---
-static SafePtrUnity<UnityEngine::Transform> leftSaberTransform;
-static SafePtrUnity<UnityEngine::Transform> rightSaberTransform;
-
-// --- Original Saber Local Poses (Quaternions and Vector3 are value types) ---
-static UnityEngine::Quaternion originalLeftSaberLocalRotation;
-static UnityEngine::Vector3 originalLeftSaberLocalPosition;
-static UnityEngine::Quaternion originalRightSaberLocalRotation;
-static UnityEngine::Vector3 originalRightSaberLocalPosition;
-
-// --- Saber Interaction States ---
-enum class SaberInteractionState { Held, Thrown, Returning };
-static SaberInteractionState leftSaberState = SaberInteractionState::Held;
-static SaberInteractionState rightSaberState = SaberInteractionState::Held;
-
-// --- Original Parent References ---
-static SafePtrUnity<UnityEngine::Transform> leftSaberOriginalParent;
-static SafePtrUnity<UnityEngine::Transform> rightSaberOriginalParent;
-
-// --- Controller Velocity & Simulated Throw State ---
-static UnityEngine::Vector3 leftControllerVelocity;
-static UnityEngine::Vector3 rightControllerVelocity;
-static UnityEngine::Vector3 prevLeftHandPos;
-static UnityEngine::Vector3 prevRightHandPos;
-
-static UnityEngine::Vector3 leftSaberSimulatedWorldVelocity; // For thrown state
-static UnityEngine::Vector3 rightSaberSimulatedWorldVelocity;
-static UnityEngine::Vector3 leftSaberSimulatedWorldAngularVelocity; // Radians/sec
-static UnityEngine::Vector3 rightSaberSimulatedWorldAngularVelocity;
-
-// --- Player-Controlled Spin States ---
-static bool leftSpinActive = false;
-static bool rightSpinActive = false;
-
-// --- Throw Button Edge Detection ---
-static bool leftThrowButtonPressedLastFrame = false;
-static bool rightThrowButtonPressedLastFrame = false;
-
-// --- Saber Return Tweening ---
-static float leftSaberReturnTime = 0.0f;
-static float rightSaberReturnTime = 0.0f;
-static UnityEngine::Vector3 leftSaberThrowReleasePosition; // World position when recall starts
-static UnityEngine::Quaternion leftSaberThrowReleaseRotation; // World rotation when recall starts
-static UnityEngine::Vector3 rightSaberThrowReleasePosition;
-static UnityEngine::Quaternion rightSaberThrowReleaseRotation;
-
-// --- Hand/Controller Transforms (for re-attachment and velocity calc) ---
-static SafePtrUnity<UnityEngine::Transform> leftHandTransform;
-static SafePtrUnity<UnityEngine::Transform> rightHandTransform;
+#include "physics/math.hpp"
+#include "physics/convert.hpp"
+#include "settings/snapshot.hpp"
+#include "saber/state-store.hpp"
+#include "saber/unity-trick-io.hpp"
+#include "saber/tick-pipeline.hpp"
+#include "saber/transform-icalls.hpp"
+#include "input/hand-input.hpp"
+#include "perf/timers.hpp"
+#include "perf/trace.hpp"
+#include "recording/recorder.hpp"
+#include "combo/library.hpp"
+#include "settings/presets.hpp"
+#include "settings/persistence.hpp"
+#include "saber/thrown-cuts.hpp"
+#include "beatmap/gap-index.hpp"
+
+using namespace TrickSaber::Math;
+using TrickSaber::Saber::SaberInteractionState;
+using TrickSaber::Saber::SaberStateStore;
+using TrickSaber::Saber::UnityTrickIO;
+
+// All per-saber state (left, right and any extra sabers spawned by other mods) lives in
+// the slot-indexed store from saber/state-store.hpp; see GetSaberStateStore().
 
 // --- Misc Flags & Constants ---
 static bool mainMenuHasLoaded = false; // Optional safety for saber init
-const float MIN_NATURAL_ROTATION_RAD_PER_SEC = 3.14f;                 // Approx 0.5 RPS (base spin for any throw)
-const float THROW_VELOCITY_TO_ROTATION_SCALE = 2.5f;                  // How much throw speed (m/s) contributes to rotation speed (rad/s).
-const float MAX_NATURAL_ROTATION_FROM_VELOCITY_RAD_PER_SEC = 70.0f;   // Cap to prevent insane spins from velocity
-const float MIN_THROW_SPEED_FOR_CROSS_PRODUCT_ROTATION = 0.2f;        // Min throw speed (m/s) to attempt cross-product rotation, else min spin.
-
-
-// --- Helper function to map configured index to OVRInput::Button ---
-GlobalNamespace::OVRInput::Button GetOVRButtonForConfig(int configuredButtonIndex, bool isLeftController) {
-    if (configuredButtonIndex == 0) return GlobalNamespace::OVRInput::Button::None;
-    if (isLeftController) {
-        switch (configuredButtonIndex) {
-            case 1: return GlobalNamespace::OVRInput::Button::One;
-            case 2: return GlobalNamespace::OVRInput::Button::Two;
-            case 3: return GlobalNamespace::OVRInput::Button::PrimaryIndexTrigger;
-            case 4: return GlobalNamespace::OVRInput::Button::PrimaryHandTrigger;
-            default: return GlobalNamespace::OVRInput::Button::None;
-        }
-    } else { // Right Controller
-        switch (configuredButtonIndex) {
-            case 1: return GlobalNamespace::OVRInput::Button::One;
-            case 2: return GlobalNamespace::OVRInput::Button::Two;
-            case 3: return GlobalNamespace::OVRInput::Button::PrimaryIndexTrigger;
-            case 4: return GlobalNamespace::OVRInput::Button::PrimaryHandTrigger;
-            default: return GlobalNamespace::OVRInput::Button::None;
-        }
+const float MAX_MOTION_ELAPSED = 0.25f;  // Caps catch-up after hitches and pauses (seconds)
+
+// Scripted combos running on saber slots; see combo/scheduler.hpp.
+static TrickSaber::Combo::ComboScheduler combos;
+
+// --- Armed / disarmed ---
+// The per-tick hooks only do work while armed: from the first saber set up in a level until
+// the main menu shows, the level's sabers are gone or the mod is disabled. Disarmed, the
+// FixedUpdate hook is the original call plus one branch on this flag.
+static bool armed = false;
+static void Arm(char const* reason);
+static void Disarm(SaberStateStore& store, char const* reason);
+
+// --- Thrown cuts ---
+// The note and wall hooks report positions only while a saber is in the air with thrown cuts
+// on; the FixedUpdate hook sets this from the states it just ticked.
+static bool collectingCutTargets = false;
+constexpr int MAX_THROWN_HITS = 16;  // Per saber per frame
+
+// --- Auto recall ---
+// A thrown saber is recalled once its hand's next note is no further away than the return takes
+// plus this, so it is back in hand with time to line up the cut.
+constexpr float AUTO_RECALL_MARGIN = 0.1f;
+static SafePtrUnity<GlobalNamespace::AudioTimeSyncController> audioTimeSync;
+static TrickSaber::Beatmap::GapCursor gapCursor;
+
+// --- Fixed tick pipeline (saber/tick-pipeline.hpp) ---
+// FixedUpdate gathers each tick and publishes it. With threaded tick off it is computed and
+// applied there and then; on, it is applied by whichever comes first of the saber render update,
+// the next FixedUpdate, a saber set up or the main menu. Nothing reads the store's trick state
+// before FinishTick().
+static TrickSaber::Saber::TickPipeline tickPipeline;
+static int tickFrame = -1;     // Time.frameCount the waiting tick was gathered in
+static float tickDeltaTime;    // Its Time.deltaTime, for what runs on its results
+static void FinishTick(SaberStateStore& store, bool handlesChecked);
+
+static char const* HandName(TrickSaber::Config::Hand hand) {
+    return hand == TrickSaber::Config::Left ? "Left" : "Right";
+}
+
+
+// --- Re-attach a saber to its original parent and pose, and clear its trick state ---
+static void ResetSaberToHeld(SaberStateStore& store, int slot) {
+    auto& cold = store.cold[slot];
+    if (store.IsAlive(cold.saberTransform) && store.IsAlive(cold.originalParent)) {
+        cold.saberTransform->SetParent(cold.originalParent.ptr(), false);
+        store.attached |= SaberStateStore::Bit(slot);
+        store.poseWriter[slot].Invalidate();
+        store.poseWriter[slot].SetLocal(cold.restPose.position, cold.restPose.rotation);
+        store.poseWriter[slot].Flush(cold.saberTransform.ptr());
     }
+    store.state[slot] = SaberInteractionState::Held;
+    store.spinActive[slot] = false;
+    combos.Cancel(slot);
 }
 
 // --- Hook for MainMenuViewController ---
 MAKE_HOOK_MATCH(MainMenuViewController_DidActivate_Hook, &GlobalNamespace::MainMenuViewController::DidActivate, void,
     GlobalNamespace::MainMenuViewController *self, bool firstActivation, bool addedToHierarchy, bool screenSystemEnabling) {
     MainMenuViewController_DidActivate_Hook(self, firstActivation, addedToHierarchy, screenSystemEnabling);
+    TrickSaber::Perf::ScopedTimer timer(TrickSaber::Perf::Metric::MainMenuDidActivateHook);
+    TS_TRACE_SCOPE(TrickSaber::Trace::Span::MainMenu);
     if (firstActivation) {
         mainMenuHasLoaded = true;
+        TrickSaber::Saber::SelfTestTransformICalls();
     }
-
-    if (leftSaberState != SaberInteractionState::Held || leftSpinActive) {
-        if (leftSaberTransform && leftSaberOriginalParent) {
-            leftSaberTransform->SetParent(leftSaberOriginalParent.ptr(), false);
-            leftSaberTransform->set_localPosition(originalLeftSaberLocalPosition);
-            leftSaberTransform->set_localRotation(originalLeftSaberLocalRotation);
-        }
-        leftSaberState = SaberInteractionState::Held;
-        leftSpinActive = false;
-        getLogger().info("[TS] [Menu] Left Saber state reset on Main Menu.");
-    }
-    if (rightSaberState != SaberInteractionState::Held || rightSpinActive) {
-         if (rightSaberTransform && rightSaberOriginalParent) {
-            rightSaberTransform->SetParent(rightSaberOriginalParent.ptr(), false);
-            rightSaberTransform->set_localPosition(originalRightSaberLocalPosition);
-            rightSaberTransform->set_localRotation(originalRightSaberLocalRotation);
+    TrickSaber::Presets::ApplyPending();
+    TrickSaber::Beatmap::ClearGapIndex();
+
+    SaberStateStore& store = TrickSaber::Saber::GetSaberStateStore();
+    FinishTick(store, false);
+    for (int i = 0; i < store.count; i++) {
+        if (store.state[i] != SaberInteractionState::Held || store.spinActive[i]) {
+            ResetSaberToHeld(store, i);
+            getLogger().info("[TS] [Menu] {} Saber (slot {}) state reset on Main Menu.", HandName(store.cold[i].hand), i);
         }
-        rightSaberState = SaberInteractionState::Held;
-        rightSpinActive = false;
-        getLogger().info("[TS] [Menu] Right Saber state reset on Main Menu.");
+    }
+    Disarm(store, "main menu");
+}
+
+// --- Settings changed in the menus reach the disk before a level or the app going away can lose them ---
+MAKE_HOOK_MATCH(MainMenuViewController_DidDeactivate_Hook, &GlobalNamespace::MainMenuViewController::DidDeactivate, void,
+    GlobalNamespace::MainMenuViewController* self, bool removedFromHierarchy, bool screenSystemDisabling) {
+    MainMenuViewController_DidDeactivate_Hook(self, removedFromHierarchy, screenSystemDisabling);
+    TrickSaber::Config::SaveNow();
+}
+
+MAKE_HOOK_MATCH(OculusVRHelper_OnApplicationPause_Hook, &GlobalNamespace::OculusVRHelper::OnApplicationPause, void,
+    GlobalNamespace::OculusVRHelper* self, bool pauseStatus) {
+    OculusVRHelper_OnApplicationPause_Hook(self, pauseStatus);
+    if (pauseStatus) {
+        // Suspended apps can be killed without another callback
+        TrickSaber::Config::FlushSaves();
     }
 }
 
@@ -123,419 +128,517 @@ MAKE_HOOK_MATCH(MainMenuViewController_DidActivate_Hook, &GlobalNamespace::MainM
 MAKE_HOOK_MATCH(SaberModelController_Init_Hook, &GlobalNamespace::SaberModelController::Init, void,
     GlobalNamespace::SaberModelController* self, UnityEngine::Transform* parent, GlobalNamespace::Saber* saber, UnityEngine::Color color) {
     SaberModelController_Init_Hook(self, parent, saber, color);
+    TrickSaber::Perf::ScopedTimer timer(TrickSaber::Perf::Metric::SaberInitHook);
+    TS_TRACE_SCOPE(TrickSaber::Trace::Span::SaberInit);
     if (!saber) { getLogger().error("[TS] [SMC] Saber is null"); return; }
     UnityEngine::Transform* currentSaberActualTransform = saber->get_transform();
     if (!currentSaberActualTransform) { getLogger().error("[TS] [SMC] Saber transform is null"); return; }
 
     GlobalNamespace::SaberType saberType = saber->get_saberType();
+    TrickSaber::Config::Hand hand;
     if (saberType == GlobalNamespace::SaberType::SaberA) { // Left
-        leftSaberTransform = currentSaberActualTransform;
-        if (leftSaberTransform) {
-            originalLeftSaberLocalRotation = leftSaberTransform->get_localRotation();
-            originalLeftSaberLocalPosition = leftSaberTransform->get_localPosition();
-            leftSaberOriginalParent = leftSaberTransform->get_parent();
-            leftHandTransform = leftSaberOriginalParent.ptr();
-            leftSaberState = SaberInteractionState::Held;
-            leftSpinActive = false;
-            getLogger().info("[TS] [SMC] Found/Updated Left Saber (SaberA)");
-        }
+        hand = TrickSaber::Config::Left;
     } else if (saberType == GlobalNamespace::SaberType::SaberB) { // Right
-        rightSaberTransform = currentSaberActualTransform;
-        if (rightSaberTransform) {
-            originalRightSaberLocalRotation = rightSaberTransform->get_localRotation();
-            originalRightSaberLocalPosition = rightSaberTransform->get_localPosition();
-            rightSaberOriginalParent = rightSaberTransform->get_parent();
-            rightHandTransform = rightSaberOriginalParent.ptr();
-            rightSaberState = SaberInteractionState::Held;
-            rightSpinActive = false;
-            getLogger().info("[TS] [SMC] Found/Updated Right Saber (SaberB)");
+        hand = TrickSaber::Config::Right;
+    } else {
+        return;
+    }
+
+    SaberStateStore& store = TrickSaber::Saber::GetSaberStateStore();
+    FinishTick(store, false);
+    int slot = store.FindOrAdd(currentSaberActualTransform);
+    if (slot < 0) { getLogger().error("[TS] [SMC] No free saber slot, ignoring saber"); return; }
+
+    auto& cold = store.cold[slot];
+    cold.hand = hand;
+    cold.restPose.rotation = FromUnity(currentSaberActualTransform->get_localRotation());
+    cold.restPose.position = FromUnity(currentSaberActualTransform->get_localPosition());
+    cold.restPose.scale = FromUnity(currentSaberActualTransform->get_localScale());
+    cold.originalParent = currentSaberActualTransform->get_parent();
+    cold.handTransform = cold.originalParent.ptr();
+    store.attached |= SaberStateStore::Bit(slot);
+    store.ResetHot(slot);
+    combos.Cancel(slot);
+    store.motionTime[slot] = UnityEngine::Time::get_time();
+    if (store.IsAlive(cold.handTransform)) {
+        store.handPosition[slot] = FromUnity(cold.handTransform->get_position());
+    }
+    getLogger().info("[TS] [SMC] Found/Updated {} Saber ({}) in slot {}", HandName(hand),
+        hand == TrickSaber::Config::Left ? "SaberA" : "SaberB", slot);
+    Arm("saber set up");
+}
+
+static TrickSaber::Perf::Metric StateMetric(SaberInteractionState state) {
+    switch (state) {
+        case SaberInteractionState::Thrown: return TrickSaber::Perf::Metric::SaberThrownTick;
+        case SaberInteractionState::Returning: return TrickSaber::Perf::Metric::SaberReturningTick;
+        default: return TrickSaber::Perf::Metric::SaberHeldTick;
+    }
+}
+
+// --- Seconds since the slot's motion last advanced, from either the fixed tick or a render update ---
+static float ConsumeMotionTime(SaberStateStore& store, int slot, float now) {
+    float elapsed = std::clamp(now - store.motionTime[slot], 0.0f, MAX_MOTION_ELAPSED);
+    store.motionTime[slot] = now;
+    return elapsed;
+}
+
+static TrickSaber::Input::HandInput handInput;
+
+// --- Arming starts every live slot from a clean tick; setup data from SaberModelController::Init is kept ---
+static void Arm(char const* reason) {
+    if (armed || !TrickSaber::Config::Current()->modEnabled) {
+        return;
+    }
+    SaberStateStore& store = TrickSaber::Saber::GetSaberStateStore();
+    float now = UnityEngine::Time::get_time();
+    for (int i = 0; i < store.count; i++) {
+        // Time and hand history from before the disarm would read as one long, fast motion
+        store.motionTime[i] = now;
+        store.handMotion[i].Reset();
+    }
+    handInput = TrickSaber::Input::HandInput();
+    armed = true;
+    getLogger().info("[TS] [Hook] Armed ({}), {} sabers", reason, store.count);
+}
+
+// --- Disarming puts every saber back in hand so nothing is left mid-trick while the hooks idle ---
+static void Disarm(SaberStateStore& store, char const* reason) {
+    if (!armed) {
+        return;
+    }
+    FinishTick(store, false);
+    for (int i = 0; i < store.count; i++) {
+        if (store.state[i] != SaberInteractionState::Held || store.spinActive[i]) {
+            ResetSaberToHeld(store, i);
         }
     }
+    combos.CancelAll();
+    handInput = TrickSaber::Input::HandInput();
+    collectingCutTargets = false;
+    TrickSaber::Saber::ClearCutTargets();
+    store.autoRecalled = 0;
+    store.InvalidateHandles();
+    armed = false;
+    getLogger().info("[TS] [Hook] Disarmed ({})", reason);
+}
+
+// --- Combo button: starts the hand's combo on a held saber, or cancels the one running ---
+// While a combo runs its actions and tuning replace the hand's for that saber.
+static TrickSaber::Combo::ComboContext const* TickCombo(SaberStateStore& store, int i, TrickSaber::Config::HandSettings const& handConfig, float now) {
+    int hand = store.cold[i].hand;
+    if (handInput.pressed[hand] & TrickSaber::Input::ActionBit(TrickSaber::Input::Combo)) {
+        if (combos.Running(i)) {
+            combos.Cancel(i);
+        } else if (auto combo = TrickSaber::Combo::GetCombo(handConfig.combo); combo && store.state[i] == SaberInteractionState::Held) {
+            if (!combos.Start(i, combo)) {
+                getLogger().warn("[TS] [Combo] Could not start {} on {} Saber (slot {})",
+                    TrickSaber::Combo::ComboName(handConfig.combo), HandName(store.cold[i].hand), i);
+            }
+        }
+    }
+    if (!combos.Running(i)) {
+        return nullptr;
+    }
+    TrickSaber::Perf::ScopedTimer timer(TrickSaber::Perf::Metric::ComboTick);
+    return combos.Tick(i, now, handInput.actions[hand], handInput.pressed[hand], store.state[i]);
+}
+
+// --- Auto recall: takes the throw button away from a thrown saber whose hand has a note coming ---
+// The press stays ignored until the player lets go, so the caught saber is not thrown again.
+static uint32_t AutoRecall(SaberStateStore& store, int i, float returnDuration, float untilCut, uint32_t actions) {
+    uint64_t bit = SaberStateStore::Bit(i);
+    uint32_t throwBit = TrickSaber::Input::ActionBit(TrickSaber::Input::Throw);
+    if (store.state[i] == SaberInteractionState::Thrown && !(store.autoRecalled & bit) && untilCut <= returnDuration + AUTO_RECALL_MARGIN) {
+        store.autoRecalled |= bit;
+        TrickSaber::Log::Emit<TrickSaber::Log::Level::Info>(TrickSaber::Log::Event::AutoRecall, i, store.cold[i].hand, untilCut);
+    }
+    if (store.autoRecalled & bit) {
+        if (actions & throwBit) {
+            return actions & ~throwBit;
+        }
+        store.autoRecalled &= ~bit;
+    }
+    return actions;
+}
+
+// --- Phase 1 for one saber: its input and tuning after combos and auto recall, and the reads its tick needs ---
+// untilCut is the time to the hand's next note, or INFINITY when auto recall is off.
+static void GatherSaber(SaberStateStore& store, int i, TrickSaber::Config::HandSettings const& handConfig, float deltaTime, float now,
+                        float untilCut, TrickSaber::Saber::SaberTickInput& in) {
+    int hand = store.cold[i].hand;
+    TrickSaber::Combo::ComboContext const* combo = TickCombo(store, i, handConfig, now);
+    TrickSaber::Config::HandTuning comboTuning;
+    TrickSaber::Config::HandTuning const* tuning = &handConfig;
+    uint32_t actions = handInput.actions[hand];
+    if (combo) {
+        comboTuning = TrickSaber::Combo::ComboTuning(handConfig, combo->reverseSpin);
+        tuning = &comboTuning;
+        actions = combo->actions;
+        if (combo->reverseSpin) handInput.recorded[hand] |= TrickSaber::Recording::BUTTON_REVERSE_SPIN;
+    }
+    actions = AutoRecall(store, i, tuning->returnDuration, untilCut, actions);
+    handInput.recorded[hand] |= actions << TrickSaber::Recording::BUTTON_ACTION_SHIFT;
+
+    in.actions = actions;
+    in.deltaTime = deltaTime;
+    in.tuning = *tuning;
+    TrickSaber::Saber::GatherTickReads(store, i, in);
+}
+
+// --- Copies this tick's input and resulting poses into the recorder ring ---
+// Hand rotations are only read here, so they cost nothing while not recording.
+static void RecordTick(SaberStateStore& store, float deltaTime) {
+    TS_TRACE_SCOPE(TrickSaber::Trace::Span::Record);
+    TrickSaber::Recording::TickSample sample = {};
+    sample.deltaTime = deltaTime;
+    bool handSeen[TrickSaber::Config::HandCount] = {false, false};
+    for (int h = 0; h < TrickSaber::Config::HandCount; h++) {
+        sample.buttons[h] = handInput.tracker[h].Buttons() | handInput.recorded[h];
+        sample.handRotation[h] = Identity();
+    }
+    for (int i = 0; i < store.count; i++) {
+        int hand = store.cold[i].hand;
+        if (!handSeen[hand] && (store.handAlive & SaberStateStore::Bit(i))) {
+            handSeen[hand] = true;
+            sample.handPosition[hand] = store.handPosition[i];
+            sample.handRotation[hand] = TrickSaber::Saber::WorldRotation(store.cold[i].handTransform.ptr());
+        }
+        if (sample.saberCount < TrickSaber::Recording::MAX_RECORDED_SABERS) {
+            auto& saber = sample.sabers[sample.saberCount++];
+            TrickSaber::Saber::PoseSpace space;
+            if (!store.poseWriter[i].LastWritten(saber.position, saber.rotation, space)) {
+                saber.rotation = Identity();
+            }
+            saber.state = static_cast<uint8_t>(store.state[i]);
+            saber.space = static_cast<uint8_t>(space);
+            saber.hand = static_cast<uint8_t>(hand);
+        }
+    }
+    TrickSaber::Recording::Push(sample);
+}
+
+// --- Phase 3: the tick's reparenting, pose writes and events, then everything that reads its results ---
+static void ApplyTick(SaberStateStore& store, TrickSaber::Saber::TickJob const& job) {
+    for (int i = 0; i < job.count; i++) {
+        TrickSaber::Saber::SaberTickOutput const& out = job.output[i];
+        if (!job.input[i].ready || !store.Ready(i)) {
+            continue;
+        }
+        TrickSaber::Saber::ApplyTickWrites(store, i, out);
+        bool written;
+        {
+            TS_TRACE_SCOPE(TrickSaber::Trace::Span::PoseWrite, i);
+            written = store.poseWriter[i].Flush(store.cold[i].saberTransform.ptr());
+        }
+        if (written && out.buttonEdge) {
+            TrickSaber::Perf::Record(TrickSaber::Perf::Metric::ButtonEdgeToWrite, TrickSaber::Perf::NowNs() - handInput.inputPollNs);
+        }
+        TrickSaber::Perf::Record(StateMetric(out.stateBefore), out.computeNs);
+    }
+
+    bool anyInAir = false;
+    for (int i = 0; i < store.count && !anyInAir; i++) {
+        anyInAir = store.state[i] != SaberInteractionState::Held;
+    }
+    TrickSaber::Config::SnapshotPin pinned = TrickSaber::Config::Current();
+    TrickSaber::Config::Snapshot const& config = *pinned;
+    collectingCutTargets = config.thrownSabersCut && anyInAir;
+
+    if (TrickSaber::Recording::IsRecording()) {
+        RecordTick(store, tickDeltaTime);
+    }
+}
+
+// --- Waits for the published tick, running what no worker got to, and applies it ---
+// handlesChecked: the store's masks are this frame's. A tick gathered in an earlier frame
+// otherwise checks them again first, as Unity destroys objects at the end of a frame.
+static void FinishTick(SaberStateStore& store, bool handlesChecked) {
+    uint64_t start = TrickSaber::Perf::NowNs();
+    TrickSaber::Saber::TickJob* job = tickPipeline.Finish();
+    if (!job) {
+        return;
+    }
+    TS_TRACE_SCOPE(TrickSaber::Trace::Span::TickApply);
+    TrickSaber::Perf::Record(TrickSaber::Perf::Metric::TickFinish, TrickSaber::Perf::NowNs() - start);
+    TrickSaber::Perf::SetCounter(TrickSaber::Perf::Counter::InlineTickSabers, tickPipeline.InlineSabers());
+    if (!handlesChecked && tickFrame != UnityEngine::Time::get_frameCount()) {
+        store.ValidateHandles();
+    }
+    ApplyTick(store, *job);
+    TrickSaber::Perf::Record(TrickSaber::Perf::Metric::TickLatency, TrickSaber::Perf::NowNs() - job->publishedNs);
 }
 
 // --- Input Hook with Spin and Throw Logic ---
+// All vector/quaternion math runs on the native types from physics/math.hpp; the only
+// il2cpp crossings left here are input polling and transform reads/writes.
 MAKE_HOOK_MATCH(TrickSaberInputUpdateHook, &GlobalNamespace::OculusVRHelper::FixedUpdate, void, GlobalNamespace::OculusVRHelper* self) {
     TrickSaberInputUpdateHook(self);
+    if (!armed) {
+        return;  // Menus, results, disabled: nothing to do
+    }
+    TrickSaber::Perf::ScopedTimer timer(TrickSaber::Perf::Metric::FixedUpdateHook);
+    TS_TRACE_SCOPE(TrickSaber::Trace::Span::FixedUpdate);
+
+    // One snapshot pin per tick; everything below reads config through it.
+    TrickSaber::Config::SnapshotPin pinned = TrickSaber::Config::Current();
+    TrickSaber::Config::Snapshot const& config = *pinned;
+    SaberStateStore& store = TrickSaber::Saber::GetSaberStateStore();
 
     // --- Mod Enabled Check ---
-    if (!getTrickSaberConfig().ModEnabled.GetValue()) {
-        // Rest states, why not..
-        if (leftSaberState != SaberInteractionState::Held || leftSpinActive) {
-            if (leftSaberTransform && leftSaberOriginalParent) {
-                leftSaberTransform->SetParent(leftSaberOriginalParent.ptr(), false);
-                leftSaberTransform->set_localPosition(originalLeftSaberLocalPosition);
-                leftSaberTransform->set_localRotation(originalLeftSaberLocalRotation);
-            }
-            leftSaberState = SaberInteractionState::Held; leftSpinActive = false;
-        }
-        if (rightSaberState != SaberInteractionState::Held || rightSpinActive) {
-            if (rightSaberTransform && rightSaberOriginalParent) {
-                rightSaberTransform->SetParent(rightSaberOriginalParent.ptr(), false);
-                rightSaberTransform->set_localPosition(originalRightSaberLocalPosition);
-                rightSaberTransform->set_localRotation(originalRightSaberLocalRotation);
-            }
-            rightSaberState = SaberInteractionState::Held; rightSpinActive = false;
-        }
-        return;  // Exit if disabled
+    if (!config.modEnabled) {
+        Disarm(store, "mod disabled");
+        return;
     }
 
     float deltaTime = UnityEngine::Time::get_deltaTime();
     if (deltaTime <= 0.00001f) deltaTime = 1.0f / 90.0f;
+    float now = UnityEngine::Time::get_time();
 
-    // --- Calculate Controller Linear Velocities ---
-    if (leftHandTransform) {
-        leftControllerVelocity = UnityEngine::Vector3::op_Division(
-            UnityEngine::Vector3::op_Subtraction(leftHandTransform->get_position(), prevLeftHandPos), deltaTime);
-        prevLeftHandPos = leftHandTransform->get_position();
-    }
-    if (rightHandTransform) {
-        rightControllerVelocity = UnityEngine::Vector3::op_Division(
-            UnityEngine::Vector3::op_Subtraction(rightHandTransform->get_position(), prevRightHandPos), deltaTime);
-        prevRightHandPos = rightHandTransform->get_position();
-    }
-
-    // --- START [Left Saber Logic] ---
-    if (leftSaberTransform && leftHandTransform && leftSaberOriginalParent) {
-        // --- Handle Throw Button Input ---
-        int leftThrowBtnIdx = getTrickSaberConfig().LeftSaberThrowButton.GetValue();
-        bool leftThrowInputPressed = false;
-        if (leftThrowBtnIdx > 0) {
-            leftThrowInputPressed = GlobalNamespace::OVRInput::Get(GetOVRButtonForConfig(
-                leftThrowBtnIdx, true), GlobalNamespace::OVRInput::Controller::LTouch);
+    // --- The only native liveness checks this tick; everything below reads the masks ---
+    {
+        TS_TRACE_SCOPE(TrickSaber::Trace::Span::ValidateHandles);
+        store.ValidateHandles();
+    }
+    // The last tick, if nothing applied it since: skips sabers that went away in between
+    FinishTick(store, true);
+
+    // --- Drop sabers whose objects are gone (scene change, other mods destroying extras) ---
+    for (int i = store.count - 1; i >= 0; i--) {
+        if (!(store.saberAlive & SaberStateStore::Bit(i))) {
+            if (store.state[i] != SaberInteractionState::Held) {
+                TrickSaber::Log::Emit<TrickSaber::Log::Level::Error>(TrickSaber::Log::Event::SaberInvalid, i, store.cold[i].hand);
+            }
+            combos.Cancel(i);
+            combos.MoveSlot(store.count - 1, i);
+            store.Remove(i);
         }
+    }
+    if (store.count == 0) {
+        Disarm(store, "sabers gone");
+        return;
+    }
 
-        if (leftThrowInputPressed && leftSaberState == SaberInteractionState::Held && !leftThrowButtonPressedLastFrame) {
-            // --- Initiate Throw ---
-            leftSaberState = SaberInteractionState::Thrown;
-            getLogger().info("[TS] [FixedUpdate] [Left Saber] Throw Initiated");
-            
-            leftSaberTransform->SetParent(nullptr, true);
-
-            float throwMultiplier = getTrickSaberConfig().LeftSaberThrowVelocityMultiplier.GetValue();
-            leftSaberSimulatedWorldVelocity = UnityEngine::Vector3::op_Multiply(leftControllerVelocity, throwMultiplier); 
-            if (leftSpinActive) {
-                float speed = getTrickSaberConfig().LeftSaberSpinSpeed.GetValue();
-                bool clockwise = getTrickSaberConfig().LeftSaberSpinClockwise.GetValue();
-                float direction = clockwise ? 1.0f : -1.0f;
-                UnityEngine::Vector3 localSpinAxis = UnityEngine::Vector3::get_right();
-                leftSaberSimulatedWorldAngularVelocity = UnityEngine::Vector3::op_Multiply(
-                    leftSaberTransform->TransformDirection(localSpinAxis),
-                    direction * speed * DEG2RAD_CONSTANT
-                );
-            } else {
-                UnityEngine::Vector3 throwVelocityWorld = leftSaberSimulatedWorldVelocity;
-                float throwSpeedMagnitude = throwVelocityWorld.get_magnitude();
-                
-                if (throwSpeedMagnitude < 1.0f) { // Gentle throw -> Minimal 
-                    UnityEngine::Vector3 worldRollAxis = leftSaberTransform->TransformDirection(
-                        UnityEngine::Vector3::get_forward());
-                    leftSaberSimulatedWorldAngularVelocity = UnityEngine::Vector3::op_Multiply(
-                        worldRollAxis, throwSpeedMagnitude * MIN_NATURAL_ROTATION_RAD_PER_SEC);
-                    getLogger().info("[TS] [FixedUpdate] [Left Saber] Gentle throw");
-                } else {
-                    UnityEngine::Vector3 throwDirectionWorldNormalized = throwVelocityWorld.get_normalized();
-                    UnityEngine::Vector3 saberForwardWorld = leftSaberTransform->TransformDirection(
-                        UnityEngine::Vector3::get_forward());
-
-                    // Cross product to get a perpendicular spin axis
-                    UnityEngine::Vector3 naturalSpinAxisWorld = UnityEngine::Vector3::Cross(saberForwardWorld,
-                     throwDirectionWorldNormalized);
-
-                    if (naturalSpinAxisWorld.get_sqrMagnitude() < 0.1f) {
-                        naturalSpinAxisWorld = saberForwardWorld;
-                        getLogger().info("[TS] [FixedUpdate] [Left Saber] Straight throws");
-                    } else {
-                        naturalSpinAxisWorld = naturalSpinAxisWorld.get_normalized();
-                        getLogger().info("[TS] [FixedUpdate] [Left Saber] Normal throw");
-                    }
-                    
-                    float spinSpeedFromVelocity = throwSpeedMagnitude * THROW_VELOCITY_TO_ROTATION_SCALE;
-                    spinSpeedFromVelocity = UnityEngine::Mathf::Min(spinSpeedFromVelocity,
-                     MAX_NATURAL_ROTATION_FROM_VELOCITY_RAD_PER_SEC);
-                    
-                    float totalNaturalSpinRadPerSec = MIN_NATURAL_ROTATION_RAD_PER_SEC + spinSpeedFromVelocity;
-
-                    leftSaberSimulatedWorldAngularVelocity = UnityEngine::Vector3::op_Multiply(naturalSpinAxisWorld,
-                     totalNaturalSpinRadPerSec);
-                }
+    // --- Calculate Controller Linear Velocities ---
+    {
+        TS_TRACE_SCOPE(TrickSaber::Trace::Span::HandVelocity);
+        for (int i = 0; i < store.count; i++) {
+            if (store.handAlive & SaberStateStore::Bit(i)) {
+                store.handPosition[i] = TrickSaber::Saber::WorldPosition(store.cold[i].handTransform.ptr());
             }
-            leftSpinActive = false;
-        } else if (!leftThrowInputPressed && leftSaberState == SaberInteractionState::Thrown && leftThrowButtonPressedLastFrame) {
-            // --- Initialte Recall ---
-            leftSaberState = SaberInteractionState::Returning;
-            getLogger().info("[TS] [FixedUpdate] [Left Saber] Recall Initiated");
-            leftSaberReturnTime = 0.0f;
-            leftSaberThrowReleasePosition = leftSaberTransform->get_position();
-            leftSaberThrowReleaseRotation = leftSaberTransform->get_rotation();
         }
-        leftThrowButtonPressedLastFrame = leftThrowInputPressed;
-
-
-        // --- Handle Player-Controlled Spin ---
-        int leftSpinBtnIdx = getTrickSaberConfig().LeftSaberSpinButton.GetValue();
-        if (leftSpinBtnIdx > 0 && leftSaberState == SaberInteractionState::Held) {
-            bool spinInputPressed = GlobalNamespace::OVRInput::Get(GetOVRButtonForConfig(
-                leftSpinBtnIdx, true), GlobalNamespace::OVRInput::Controller::LTouch);
-            if (spinInputPressed && !leftSpinActive) {
-                leftSpinActive = true; getLogger().info("[TS] [FixedUpdate] [Left Saber] Spin Activated");
-            } else if (!spinInputPressed && leftSpinActive) {
-                leftSpinActive = false; getLogger().info("[TS] [FixedUpdate] [Left Saber] Spin Deactivated, restoring position");
-                if(leftSaberTransform) {
-                    leftSaberTransform->set_localRotation(originalLeftSaberLocalRotation);
-                    leftSaberTransform->set_localPosition(originalLeftSaberLocalPosition);
-                }
-            }
-        } else if (leftSaberState == SaberInteractionState::Held && leftSpinActive) {  // Edge: Button unassigned from config
-            leftSpinActive = false; getLogger().info("[TS] [FixedUpdate] [Left Saber] Spin Deactivated, restoring position");
-             if(leftSaberTransform) {
-                leftSaberTransform->set_localRotation(originalLeftSaberLocalRotation);
-                leftSaberTransform->set_localPosition(originalLeftSaberLocalPosition);
+    }
+    // Hand samples are pushed with the tick's compute
+    uint64_t handsReadNs = TrickSaber::Perf::NowNs();
+
+    TrickSaber::Input::PollInput(handInput, config, now);
+    if ((handInput.pressed[TrickSaber::Config::Left] | handInput.pressed[TrickSaber::Config::Right]) &
+        TrickSaber::Input::ActionBit(TrickSaber::Input::NextPreset)) {
+        // Takes effect from the next tick; this one finishes on the snapshot it loaded
+        TrickSaber::Presets::CycleNext();
+    }
+    // --- Time to each hand's next note, from the level's gap index once its build is done ---
+    float untilCut[TrickSaber::Config::HandCount] = {INFINITY, INFINITY};
+    if (config.autoRecall && audioTimeSync) {
+        if (auto gaps = TrickSaber::Beatmap::CurrentGapIndex(gapCursor)) {
+            float songTime = audioTimeSync->get_songTime();
+            for (int h = 0; h < TrickSaber::Config::HandCount; h++) {
+                untilCut[h] = TrickSaber::Beatmap::TimeUntilNextCut(*gaps, gapCursor, h, songTime);
             }
         }
+    }
+
+    TrickSaber::Saber::TickJob& job = tickPipeline.Gather();
+    job.count = store.count;
+    job.timeNs = handsReadNs;
+    for (int i = 0; i < store.count; i++) {
+        job.input[i].ready = false;
+        if (store.Ready(i)) {
+            TS_TRACE_SCOPE(TrickSaber::Trace::Span::SaberTick, i);
+            int hand = store.cold[i].hand;
+            GatherSaber(store, i, config.hands[hand], ConsumeMotionTime(store, i, now), now, untilCut[hand], job.input[i]);
+        }
+    }
+    tickFrame = UnityEngine::Time::get_frameCount();
+    tickDeltaTime = deltaTime;
+    tickPipeline.Publish(store, config.threadedTick);
+    if (!config.threadedTick) {
+        FinishTick(store, true);
+    }
 
+    TrickSaber::Saber::TickPoseWriteStats(deltaTime);
+    auto const& poseWrites = TrickSaber::Saber::GetPoseWriteStats();
+    TrickSaber::Perf::SetCounter(TrickSaber::Perf::Counter::PoseWritesIssued, static_cast<uint64_t>(poseWrites.issuedPerSecond));
+    TrickSaber::Perf::SetCounter(TrickSaber::Perf::Counter::PoseWritesElided, static_cast<uint64_t>(poseWrites.elidedPerSecond));
+    TrickSaber::Perf::SetCounter(TrickSaber::Perf::Counter::LivenessChecks, store.TakeLivenessChecks());
+}
 
-        // --- Apply Saber States ---
-        if (leftSaberState == SaberInteractionState::Held) {
-            if (leftSaberTransform->get_parent() != leftSaberOriginalParent) {
-                leftSaberTransform->SetParent(leftSaberOriginalParent.ptr(), false);
-                leftSaberTransform->set_localPosition(originalLeftSaberLocalPosition);
-                leftSaberTransform->set_localRotation(originalLeftSaberLocalRotation);
-                getLogger().info("[TS] [FixedUpdate] [Left Saber] Re-parented and reset in Held state");
-            }
-            // Apply player-controlled spin if active
-            if (leftSpinActive) {
-                float speed = getTrickSaberConfig().LeftSaberSpinSpeed.GetValue();
-                bool clockwise = getTrickSaberConfig().LeftSaberSpinClockwise.GetValue();
-                float direction = clockwise ? 1.0f : -1.0f;
-                float zOffset = getTrickSaberConfig().LeftSaberSpinAnchorZOffset.GetValue();
-                UnityEngine::Vector3 localSpinAxis = UnityEngine::Vector3::get_right();
-                UnityEngine::Vector3 localPivotOffset = UnityEngine::Vector3::op_Multiply(UnityEngine::Vector3::get_forward(), zOffset);
-                UnityEngine::Vector3 worldPivotPoint = leftSaberTransform->TransformPoint(localPivotOffset);
-                UnityEngine::Vector3 worldSpinAxis = leftSaberTransform->TransformDirection(localSpinAxis);
-                float rotationAngleThisFrame = direction * speed * deltaTime;
-                leftSaberTransform->RotateAround(worldPivotPoint, worldSpinAxis, rotationAngleThisFrame);
-            } else {
-                // If not actively spinning by player
-                leftSaberTransform->set_localPosition(originalLeftSaberLocalPosition);
-                leftSaberTransform->set_localRotation(originalLeftSaberLocalRotation);
-            }
-        } else if (leftSaberState == SaberInteractionState::Thrown) {
-            // --- Simulated Throw ---
-            UnityEngine::Vector3 currentPos = leftSaberTransform->get_position();
-            UnityEngine::Vector3 newPos = UnityEngine::Vector3::op_Addition(
-                currentPos, UnityEngine::Vector3::op_Multiply(leftSaberSimulatedWorldVelocity, deltaTime));
-            leftSaberTransform->set_position(newPos);
-
-            if (leftSaberSimulatedWorldAngularVelocity.get_sqrMagnitude() > 0.0001f) {
-                float angle = leftSaberSimulatedWorldAngularVelocity.get_magnitude() * deltaTime * RAD2DEG_CONSTANT;
-                UnityEngine::Vector3 axis = leftSaberSimulatedWorldAngularVelocity.get_normalized();
-                UnityEngine::Quaternion deltaRotation = UnityEngine::Quaternion::AngleAxis(angle, axis);
-                leftSaberTransform->set_rotation(UnityEngine::Quaternion::op_Multiply(
-                    deltaRotation, leftSaberTransform->get_rotation()));
-            }
-        } else if (leftSaberState == SaberInteractionState::Returning) {
-            leftSaberReturnTime += deltaTime;
-            float leftSaberReturnDuration = getTrickSaberConfig().LeftSaberReturnDuration.GetValue();
-            if (leftSaberReturnDuration < 0.01f) leftSaberReturnDuration = 0.01f;
-
-            float t = UnityEngine::Mathf::Clamp01(leftSaberReturnTime / leftSaberReturnDuration);
-            UnityEngine::Vector3 targetPos_world = leftHandTransform->TransformPoint(originalLeftSaberLocalPosition);
-            UnityEngine::Quaternion targetRot_world = UnityEngine::Quaternion::op_Multiply(
-                leftHandTransform->get_rotation(), originalLeftSaberLocalRotation);
-            leftSaberTransform->set_position(UnityEngine::Vector3::Lerp(leftSaberThrowReleasePosition, targetPos_world, t));
-            
-            if (leftSaberSimulatedWorldAngularVelocity.get_sqrMagnitude() > 0.0001f && t < 0.95f) {
-                 float angle = leftSaberSimulatedWorldAngularVelocity.get_magnitude() * deltaTime * RAD2DEG_CONSTANT;
-                 UnityEngine::Vector3 axis = leftSaberSimulatedWorldAngularVelocity.get_normalized();
-                 UnityEngine::Quaternion deltaRotation = UnityEngine::Quaternion::AngleAxis(angle, axis);
-                 leftSaberTransform->set_rotation(UnityEngine::Quaternion::op_Multiply(
-                    deltaRotation, leftSaberTransform->get_rotation()));
-                 leftSaberTransform->set_rotation(UnityEngine::Quaternion::Slerp(
-                    leftSaberTransform->get_rotation(), targetRot_world, t*t*t));
-            } else {
-                leftSaberTransform->set_rotation(UnityEngine::Quaternion::Slerp(
-                    leftSaberThrowReleaseRotation, targetRot_world, t));
-            }
+// --- Level start: the beatmap's timeline goes to a worker that builds the gap index (beatmap/gap-index.hpp) ---
+static int8_t CuttingHand(GlobalNamespace::ColorType color) {
+    return color == GlobalNamespace::ColorType::ColorA ? TrickSaber::Config::Left
+         : color == GlobalNamespace::ColorType::ColorB ? TrickSaber::Config::Right : -1;
+}
 
-            if (t >= 1.0f) {
-                leftSaberState = SaberInteractionState::Held;
-                getLogger().info("[TS] [FixedUpdate] [Left Saber] Returned to hand");
-                // The Held block will handle final parenting and position setting next frame
-            }
+static std::vector<TrickSaber::Beatmap::TimelineItem> ReadTimeline(GlobalNamespace::IReadonlyBeatmapData* beatmapData) {
+    using TrickSaber::Beatmap::TimelineKind;
+    std::vector<TrickSaber::Beatmap::TimelineItem> items;
+    auto list = beatmapData->get_allBeatmapDataItems();
+    if (!list) {
+        return items;
+    }
+    items.reserve(list->get_Count());
+    for (auto node = list->get_First(); node; node = node->get_Next()) {
+        GlobalNamespace::BeatmapDataItem* item = node->get_Value();
+        if (auto note = il2cpp_utils::try_cast<GlobalNamespace::NoteData>(item)) {
+            bool bomb = (*note)->get_gameplayType() == GlobalNamespace::NoteData::GameplayType::Bomb;
+            float time = (*note)->get_time();
+            items.push_back({time, time, bomb ? TimelineKind::Bomb : TimelineKind::Note, bomb ? int8_t(-1) : CuttingHand((*note)->get_colorType())});
+        } else if (auto slider = il2cpp_utils::try_cast<GlobalNamespace::SliderData>(item)) {
+            items.push_back({(*slider)->get_time(), (*slider)->get_tailTime(), TimelineKind::Slider, CuttingHand((*slider)->get_colorType())});
+        } else if (auto obstacle = il2cpp_utils::try_cast<GlobalNamespace::ObstacleData>(item)) {
+            float time = (*obstacle)->get_time();
+            items.push_back({time, time + (*obstacle)->get_duration(), TimelineKind::Obstacle, -1});
         }
-    } else if (leftSaberState != SaberInteractionState::Held && !leftSaberTransform) {
-        leftSaberState = SaberInteractionState::Held; leftSpinActive = false;
-        getLogger().error("[TS] [FixedUpdate] [Left Saber] Became invalid while not Held. Resetting state");
     }
-    // --- END [Left Saber Logic] ---
+    return items;
+}
 
+MAKE_HOOK_MATCH(BeatmapCallbacksController_ctor_Hook, &GlobalNamespace::BeatmapCallbacksController::_ctor, void,
+    GlobalNamespace::BeatmapCallbacksController* self, GlobalNamespace::BeatmapCallbacksController::InitData* initData) {
+    BeatmapCallbacksController_ctor_Hook(self, initData);
+    if (!initData || !initData->beatmapData) {
+        return;
+    }
+    // Only the walk over the managed list stays on the main thread
+    TrickSaber::Perf::ScopedTimer timer(TrickSaber::Perf::Metric::BeatmapRead);
+    TrickSaber::Beatmap::StartGapIndexBuild(ReadTimeline(initData->beatmapData));
+}
 
-    // --- START [Right Saber Logic] ---
-    if (rightSaberTransform && rightHandTransform && rightSaberOriginalParent) {
-        // --- Handle Throw Button Input ---
-        int rightThrowBtnIdx = getTrickSaberConfig().RightSaberThrowButton.GetValue();
-        bool rightThrowInputPressed = false;
-        if (rightThrowBtnIdx > 0) {
-            rightThrowInputPressed = GlobalNamespace::OVRInput::Get(GetOVRButtonForConfig(
-                rightThrowBtnIdx, false), GlobalNamespace::OVRInput::Controller::RTouch);
-        }
+MAKE_HOOK_MATCH(AudioTimeSyncController_Start_Hook, &GlobalNamespace::AudioTimeSyncController::Start, void,
+    GlobalNamespace::AudioTimeSyncController* self) {
+    AudioTimeSyncController_Start_Hook(self);
+    audioTimeSync = self;
+}
 
-        if (rightThrowInputPressed && rightSaberState == SaberInteractionState::Held && !rightThrowButtonPressedLastFrame) {
-            // --- Initiate Throw ---
-            rightSaberState = SaberInteractionState::Thrown;
-            getLogger().info("[TS] [FixedUpdate] [Right Saber] Throw Initiated");
-            
-            rightSaberTransform->SetParent(nullptr, true);
-
-            float throwMultiplier = getTrickSaberConfig().RightSaberThrowVelocityMultiplier.GetValue();
-            rightSaberSimulatedWorldVelocity = UnityEngine::Vector3::op_Multiply(rightControllerVelocity, throwMultiplier);
-            if (rightSpinActive) { // If it was being actively spun by your mod
-                float speed = getTrickSaberConfig().RightSaberSpinSpeed.GetValue();
-                bool clockwise = getTrickSaberConfig().RightSaberSpinClockwise.GetValue();
-                float direction = clockwise ? 1.0f : -1.0f;
-                UnityEngine::Vector3 localSpinAxis = UnityEngine::Vector3::get_right();
-                rightSaberSimulatedWorldAngularVelocity = UnityEngine::Vector3::op_Multiply(
-                    rightSaberTransform->TransformDirection(localSpinAxis),
-                    direction * speed * DEG2RAD_CONSTANT
-                );
-            } else {
-                UnityEngine::Vector3 throwVelocityWorld = rightSaberSimulatedWorldVelocity;
-                float throwSpeedMagnitude = throwVelocityWorld.get_magnitude();
-                
-                if (throwSpeedMagnitude < 1.0f) {
-                    UnityEngine::Vector3 worldRollAxis = rightSaberTransform->TransformDirection(UnityEngine::Vector3::get_forward());
-                    rightSaberSimulatedWorldAngularVelocity = UnityEngine::Vector3::op_Multiply(
-                        worldRollAxis, throwSpeedMagnitude * MIN_NATURAL_ROTATION_RAD_PER_SEC);
-                    getLogger().info("[TS] [FixedUpdate] [Right Saber] Gentle throw");
-                } else {
-                    UnityEngine::Vector3 throwDirectionWorldNormalized = throwVelocityWorld.get_normalized();
-                    UnityEngine::Vector3 saberForwardWorld = rightSaberTransform->TransformDirection(
-                        UnityEngine::Vector3::get_forward());
-
-                    UnityEngine::Vector3 naturalSpinAxisWorld = UnityEngine::Vector3::Cross(
-                        saberForwardWorld, throwDirectionWorldNormalized);
-
-                    if (naturalSpinAxisWorld.get_sqrMagnitude() < 0.1f) {
-                        naturalSpinAxisWorld = saberForwardWorld;
-                        getLogger().info("[TS] [FixedUpdate] [Right Saber] Straight throw");
-                    } else {
-                        naturalSpinAxisWorld = naturalSpinAxisWorld.get_normalized();
-                        getLogger().info("[TS] [FixedUpdate] [Right Saber] Normal throw");
-                    }
-                    
-                    float spinSpeedFromVelocity = throwSpeedMagnitude * THROW_VELOCITY_TO_ROTATION_SCALE;
-                    spinSpeedFromVelocity = UnityEngine::Mathf::Min(spinSpeedFromVelocity, MAX_NATURAL_ROTATION_FROM_VELOCITY_RAD_PER_SEC);
-                    float totalNaturalSpinRadPerSec = MIN_NATURAL_ROTATION_RAD_PER_SEC + spinSpeedFromVelocity;
-
-                    rightSaberSimulatedWorldAngularVelocity = UnityEngine::Vector3::op_Multiply(
-                        naturalSpinAxisWorld, totalNaturalSpinRadPerSec);
-                }
-            }
-            rightSpinActive = false;
-        } else if (!rightThrowInputPressed && rightSaberState == SaberInteractionState::Thrown && rightThrowButtonPressedLastFrame) {
-            // --- Initiate Recall ---
-            rightSaberState = SaberInteractionState::Returning;
-            getLogger().info("[TS] [FixedUpdate] [Right Saber] Recall Initiated");
-            rightSaberReturnTime = 0.0f;
-            rightSaberThrowReleasePosition = rightSaberTransform->get_position();
-            rightSaberThrowReleaseRotation = rightSaberTransform->get_rotation();
+// --- Notes, bombs and walls report where the game moved them, for thrown sabers to cut ---
+MAKE_HOOK_MATCH(NoteController_ManualUpdate_Hook, &GlobalNamespace::NoteController::ManualUpdate, void, GlobalNamespace::NoteController* self) {
+    NoteController_ManualUpdate_Hook(self);
+    if (!collectingCutTargets) {
+        return;
+    }
+    GlobalNamespace::NoteData* noteData = self->get_noteData();
+    bool bomb = noteData && noteData->get_gameplayType() == GlobalNamespace::NoteData::GameplayType::Bomb;
+    TrickSaber::Saber::AddCutTarget(self, bomb ? CutTargetKind::Bomb : CutTargetKind::Note,
+        TrickSaber::Saber::WorldPosition(self->get_noteTransform()), UnityEngine::Time::get_frameCount());
+}
+
+MAKE_HOOK_MATCH(ObstacleController_ManualUpdate_Hook, &GlobalNamespace::ObstacleController::ManualUpdate, void, GlobalNamespace::ObstacleController* self) {
+    ObstacleController_ManualUpdate_Hook(self);
+    if (!collectingCutTargets) {
+        return;
+    }
+    UnityEngine::Transform* transform = self->get_transform();
+    UnityEngine::Bounds bounds = self->get_bounds();  // Local to the obstacle
+    TrickSaber::Saber::AddObstacleTarget(self, TrickSaber::Saber::PointToWorld(transform, bounds.get_center()),
+        TrickSaber::Saber::WorldRotation(transform), FromUnity(bounds.get_extents()), UnityEngine::Time::get_frameCount());
+}
+
+// --- Sweeps a saber in the air from its last frame's pose to this one and cuts what it passed through ---
+// Notes and bombs go through the game's own cut handling, as if the blade had hit them in hand.
+// The game has nothing that cuts walls, so a wall hit is only logged.
+static void CutWithThrownSaber(SaberStateStore& store, int slot, GlobalNamespace::Saber* saber) {
+    TrickSaber::Perf::ScopedTimer timer(TrickSaber::Perf::Metric::BladeSweep);
+    TS_TRACE_SCOPE(TrickSaber::Trace::Span::BladeSweep, slot);
+    int frame = UnityEngine::Time::get_frameCount();
+    Vec3 position;
+    Quat rotation;
+    TrickSaber::Saber::PoseSpace space;
+    if (!store.poseWriter[slot].LastWritten(position, rotation, space) || space != TrickSaber::Saber::PoseSpace::World) {
+        store.sweptFrame[slot] = -1;
+        return;
+    }
+    if (store.sweptFrame[slot] == frame) {
+        return;
+    }
+    // The first frame in the air has nothing to sweep from, so it tests the pose alone
+    bool continues = store.sweptFrame[slot] == frame - 1;
+    Vec3 fromPosition = continues ? store.sweptPosition[slot] : position;
+    Quat fromRotation = continues ? store.sweptRotation[slot] : rotation;
+    store.sweptPosition[slot] = position;
+    store.sweptRotation[slot] = rotation;
+    store.sweptFrame[slot] = frame;
+
+    static TrickSaber::Math::BladeSweep sweep;
+    TrickSaber::Math::CutTargets const& targets = TrickSaber::Saber::CutTargetsFor(frame);
+    if (targets.count == 0) {
+        return;
+    }
+    float length = TrickSaber::Saber::BLADE_LENGTH * store.cold[slot].restPose.scale.z;
+    SweepBlade(fromPosition, fromRotation, position, rotation, 0.0f, length, TrickSaber::Saber::BLADE_RADIUS, targets.maxMove, sweep);
+    TrickSaber::Math::BladeHit hits[MAX_THROWN_HITS];
+    int count = FindBladeHits(sweep, targets, hits, MAX_THROWN_HITS);
+
+    int hand = store.cold[slot].hand;
+    for (int h = 0; h < count; h++) {
+        auto const& hit = hits[h];
+        CutTargetKind kind = targets.kind[hit.target];
+        if (kind == CutTargetKind::Obstacle) {
+            TrickSaber::Log::Emit<TrickSaber::Log::Level::Debug>(TrickSaber::Log::Event::ObstacleHit, slot, hand, hit.time);
+            continue;
         }
-        rightThrowButtonPressedLastFrame = rightThrowInputPressed;
-
-        // --- Handle Player-Controlled Spin ---
-        int rightSpinBtnIdx = getTrickSaberConfig().RightSaberSpinButton.GetValue();
-        if (rightSpinBtnIdx > 0 && rightSaberState == SaberInteractionState::Held) {
-            bool spinInputPressed = GlobalNamespace::OVRInput::Get(GetOVRButtonForConfig(
-                rightSpinBtnIdx, false), GlobalNamespace::OVRInput::Controller::RTouch);
-            if (spinInputPressed && !rightSpinActive) {
-                rightSpinActive = true;
-                getLogger().info("[TS] [FixedUpdate] [Right Saber] Spin Activated");
-            } else if (!spinInputPressed && rightSpinActive) {
-                rightSpinActive = false;
-                getLogger().info("[TS] [FixedUpdate] [Right Saber] Spin Deactivated, restoring position");
-                if(rightSaberTransform) {
-                    rightSaberTransform->set_localRotation(originalRightSaberLocalRotation);
-                    rightSaberTransform->set_localPosition(originalRightSaberLocalPosition);
-                }
-            }
-        } else if (rightSaberState == SaberInteractionState::Held && rightSpinActive) {
-            rightSpinActive = false;
-            getLogger().info("[TS] [FixedUpdate] [Right Saber] Spin Deactivated, restoring position");
-            if(rightSaberTransform) {
-                rightSaberTransform->set_localRotation(originalRightSaberLocalRotation);
-                rightSaberTransform->set_localPosition(originalRightSaberLocalPosition);
-            }
+        auto note = static_cast<GlobalNamespace::NoteController*>(targets.handle[hit.target]);
+        auto cuttable = note->GetComponentInChildren<GlobalNamespace::CuttableBySaber*>();
+        if (!cuttable || !cuttable->get_isActiveAndEnabled() || !cuttable->get_canBeCut()) {
+            continue;  // Already cut, or back in its pool
         }
-        
-        // --- Apply Saber States ---
-        if (rightSaberState == SaberInteractionState::Held) {
-            if (rightSaberTransform->get_parent() != rightSaberOriginalParent) {
-                rightSaberTransform->SetParent(rightSaberOriginalParent.ptr(), false);
-                rightSaberTransform->set_localPosition(originalRightSaberLocalPosition);
-                rightSaberTransform->set_localRotation(originalRightSaberLocalRotation);
-                getLogger().info("[TS] [FixedUpdate] [Right Saber] Re-parented and reset in Held state");
-            }
-            if (rightSpinActive) {
-                float speed = getTrickSaberConfig().RightSaberSpinSpeed.GetValue();
-                bool clockwise = getTrickSaberConfig().RightSaberSpinClockwise.GetValue();
-                float direction = clockwise ? 1.0f : -1.0f;
-                float zOffset = getTrickSaberConfig().RightSaberSpinAnchorZOffset.GetValue();
-                UnityEngine::Vector3 localSpinAxis = UnityEngine::Vector3::get_right();
-                UnityEngine::Vector3 localPivotOffset = UnityEngine::Vector3::op_Multiply(UnityEngine::Vector3::get_forward(), zOffset);
-                UnityEngine::Vector3 worldPivotPoint = rightSaberTransform->TransformPoint(localPivotOffset);
-                UnityEngine::Vector3 worldSpinAxis = rightSaberTransform->TransformDirection(localSpinAxis);
-                float rotationAngleThisFrame = direction * speed * deltaTime;
-                rightSaberTransform->RotateAround(worldPivotPoint, worldSpinAxis, rotationAngleThisFrame);
-            } else {
-                rightSaberTransform->set_localPosition(originalRightSaberLocalPosition);
-                rightSaberTransform->set_localRotation(originalRightSaberLocalRotation);
-            }
-        } else if (rightSaberState == SaberInteractionState::Thrown) {
-            // --- Simulated ---
-            UnityEngine::Vector3 currentPos = rightSaberTransform->get_position();
-            UnityEngine::Vector3 newPos = UnityEngine::Vector3::op_Addition(currentPos, UnityEngine::Vector3::op_Multiply(
-                rightSaberSimulatedWorldVelocity, deltaTime));
-            rightSaberTransform->set_position(newPos);
-
-            if (rightSaberSimulatedWorldAngularVelocity.get_sqrMagnitude() > 0.0001f) {
-                float angle = rightSaberSimulatedWorldAngularVelocity.get_magnitude() * deltaTime * RAD2DEG_CONSTANT;
-                UnityEngine::Vector3 axis = rightSaberSimulatedWorldAngularVelocity.get_normalized();
-                UnityEngine::Quaternion deltaRotation = UnityEngine::Quaternion::AngleAxis(angle, axis);
-                rightSaberTransform->set_rotation(UnityEngine::Quaternion::op_Multiply(
-                    deltaRotation, rightSaberTransform->get_rotation()));
-            }
-        } else if (rightSaberState == SaberInteractionState::Returning) {
-            rightSaberReturnTime += deltaTime;
-            float rightSaberReturnDuration = getTrickSaberConfig().RightSaberReturnDuration.GetValue();
-            if (rightSaberReturnDuration < 0.01f) rightSaberReturnDuration = 0.01f;
-            float t = UnityEngine::Mathf::Clamp01(rightSaberReturnTime / rightSaberReturnDuration);
-            UnityEngine::Vector3 targetPos_world = rightHandTransform->TransformPoint(originalRightSaberLocalPosition);
-            UnityEngine::Quaternion targetRot_world = UnityEngine::Quaternion::op_Multiply(
-                rightHandTransform->get_rotation(), originalRightSaberLocalRotation);
-            rightSaberTransform->set_position(UnityEngine::Vector3::Lerp(rightSaberThrowReleasePosition, targetPos_world, t));
-            
-            if (rightSaberSimulatedWorldAngularVelocity.get_sqrMagnitude() > 0.0001f && t < 0.95f) {
-                 float angle = rightSaberSimulatedWorldAngularVelocity.get_magnitude() * deltaTime * RAD2DEG_CONSTANT;
-                 UnityEngine::Vector3 axis = rightSaberSimulatedWorldAngularVelocity.get_normalized();
-                 UnityEngine::Quaternion deltaRotation = UnityEngine::Quaternion::AngleAxis(angle, axis);
-                 rightSaberTransform->set_rotation(UnityEngine::Quaternion::op_Multiply(
-                    deltaRotation, rightSaberTransform->get_rotation()));
-                 rightSaberTransform->set_rotation(UnityEngine::Quaternion::Slerp(
-                    rightSaberTransform->get_rotation(), targetRot_world, t*t*t));
-            } else {
-                rightSaberTransform->set_rotation(UnityEngine::Quaternion::Slerp(
-                    rightSaberThrowReleaseRotation, targetRot_world, t));
-            }
+        UnityEngine::Quaternion orientation = UnityEngine::Quaternion::LookRotation(ToUnity(hit.bladeDirection),
+            ToUnity(Cross(hit.bladeDirection, hit.cutDirection)));
+        cuttable->Cut(saber, ToUnity(hit.point), orientation, ToUnity(hit.cutDirection));
+        TrickSaber::Log::Emit<TrickSaber::Log::Level::Info>(
+            kind == CutTargetKind::Bomb ? TrickSaber::Log::Event::BombHit : TrickSaber::Log::Event::NoteCut, slot, hand, hit.time);
+    }
+}
 
-            if (t >= 1.0f) {
-                rightSaberState = SaberInteractionState::Held;
-                getLogger().info("[TS] [FixedUpdate] [Right Saber] Returned to hand");
+// --- Render-rate pose update, just before the game samples the blade for cutting ---
+// Sabers in flight, returning or spinning get the pose for this frame's time, evaluated from
+// their trajectory, instead of holding the last FixedUpdate pose until the next one.
+MAKE_HOOK_MATCH(Saber_ManualUpdate_Hook, &GlobalNamespace::Saber::ManualUpdate, void, GlobalNamespace::Saber* self) {
+    if (!armed) {
+        Saber_ManualUpdate_Hook(self);
+        return;
+    }
+    SaberStateStore& store = TrickSaber::Saber::GetSaberStateStore();
+    TrickSaber::Config::SnapshotPin pinned = TrickSaber::Config::Current();
+    TrickSaber::Config::Snapshot const& config = *pinned;
+    FinishTick(store, false);
+
+    bool anyMoving = false;
+    for (int i = 0; i < store.count && !anyMoving; i++) {
+        anyMoving = store.state[i] != SaberInteractionState::Held || store.spinActive[i];
+    }
+    if (config.modEnabled && anyMoving) {
+        TrickSaber::Perf::ScopedTimer timer(TrickSaber::Perf::Metric::SaberRenderUpdateHook);
+        int slot = store.Find(self->get_transform());
+        TS_TRACE_SCOPE(TrickSaber::Trace::Span::RenderUpdate, slot);
+        if (slot >= 0 && (store.state[slot] != SaberInteractionState::Held || store.spinActive[slot])) {
+            auto& cold = store.cold[slot];
+            if (store.Ready(slot)) {
+                UnityTrickIO io{store, slot, 0};  // No input is read here
+                TrickSaber::Config::HandTuning tuning = config.hands[cold.hand];
+                if (auto combo = combos.Context(slot)) {
+                    tuning = TrickSaber::Combo::ComboTuning(tuning, combo->reverseSpin);
+                }
+                TrickSaber::Saber::AdvanceMotion(store, slot, cold.restPose, tuning,
+                    ConsumeMotionTime(store, slot, UnityEngine::Time::get_time()), io);
+                store.poseWriter[slot].Flush(cold.saberTransform.ptr());
+                if (config.thrownSabersCut && store.state[slot] != SaberInteractionState::Held) {
+                    CutWithThrownSaber(store, slot, self);
+                }
             }
         }
-    } else if (rightSaberState != SaberInteractionState::Held && !rightSaberTransform) {
-        rightSaberState = SaberInteractionState::Held; rightSpinActive = false;
-        getLogger().error("[TS] [FixedUpdate] [Right Saber] Became invalid while not Held. Resetting state");
     }
+
+    Saber_ManualUpdate_Hook(self);
 }
 
 
@@ -546,8 +649,13 @@ extern "C" __attribute__((visibility("default"))) void setup(CModInfo& info) {
 
 extern "C" __attribute__((visibility("default"))) void late_load() {
     il2cpp_functions::Init();
+    TrickSaber::Saber::ResolveTransformICalls();
 
     getTrickSaberConfig().Init(modInfo);
+    TrickSaber::Log::Start();
+    TrickSaber::Config::Init();
+    TrickSaber::Presets::Init();
+    TrickSaber::Config::StartPersistence();
 
 
     getLogger().info("Deactivated Score Submission safely !!");
@@ -559,7 +667,14 @@ extern "C" __attribute__((visibility("default"))) void late_load() {
     auto logger = Paper::ConstLoggerContext("TrickSaberLite");
     getLogger().info("Installing Hooks..");
     INSTALL_HOOK(logger, MainMenuViewController_DidActivate_Hook);
+    INSTALL_HOOK(logger, MainMenuViewController_DidDeactivate_Hook);
+    INSTALL_HOOK(logger, OculusVRHelper_OnApplicationPause_Hook);
     INSTALL_HOOK(logger, SaberModelController_Init_Hook);
-    INSTALL_HOOK(logger, TrickSaberInputUpdateHook);  
+    INSTALL_HOOK(logger, TrickSaberInputUpdateHook);
+    INSTALL_HOOK(logger, Saber_ManualUpdate_Hook);
+    INSTALL_HOOK(logger, NoteController_ManualUpdate_Hook);
+    INSTALL_HOOK(logger, ObstacleController_ManualUpdate_Hook);
+    INSTALL_HOOK(logger, BeatmapCallbacksController_ctor_Hook);
+    INSTALL_HOOK(logger, AudioTimeSyncController_Start_Hook);
     getLogger().info("Hooks installed!!");
 }
\ No newline at end of file
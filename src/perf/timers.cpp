@@ -0,0 +1,83 @@
+#include "perf/timers.hpp"
+
+#include <cstdio>
+
+namespace TrickSaber::Perf {
+
+    static LatencyHistogram histograms[static_cast<int>(Metric::Count)];
+
+    static char const* const METRIC_NAMES[] = {
+        "FixedUpdate",
+        "Saber Init",
+        "Main Menu",
+        "Held tick",
+        "Thrown tick",
+        "Returning tick",
+        "Edge to write",
+        "Render update",
+        "Combo tick",
+        "Preset switch",
+        "Setting change",
+        "Blade sweep",
+        "Beatmap read",
+        "Tick finish",
+        "Tick latency",
+        "Transform icall",
+        "Transform wrapper",
+    };
+    static_assert(sizeof(METRIC_NAMES) / sizeof(METRIC_NAMES[0]) == static_cast<int>(Metric::Count));
+
+    static uint64_t counterLast[static_cast<int>(Counter::Count)];
+    static uint64_t counterMax[static_cast<int>(Counter::Count)];
+
+    static char const* const COUNTER_NAMES[] = {
+        "Liveness checks/tick",
+        "Sabers ticked inline/tick",
+        "Pose writes/s",
+        "Pose writes elided/s",
+    };
+    static_assert(sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == static_cast<int>(Counter::Count));
+
+    void SetCounter(Counter counter, uint64_t value) {
+        int i = static_cast<int>(counter);
+        counterLast[i] = value;
+        counterMax[i] = std::max(counterMax[i], value);
+    }
+
+    LatencyHistogram& Histogram(Metric metric) {
+        return histograms[static_cast<int>(metric)];
+    }
+
+    void ResetAll() {
+        for (auto& histogram : histograms) {
+            histogram.Reset();
+        }
+        for (int i = 0; i < static_cast<int>(Counter::Count); i++) {
+            counterLast[i] = 0;
+            counterMax[i] = 0;
+        }
+    }
+
+    std::string FormatSummary() {
+        std::string out;
+        char line[160];
+        for (int i = 0; i < static_cast<int>(Metric::Count); i++) {
+            LatencyHistogram const& h = histograms[i];
+            std::snprintf(line, sizeof(line), "%s: n=%llu  p50 %.1f  p99 %.1f  p99.9 %.1f  max %.1f us\n",
+                METRIC_NAMES[i],
+                static_cast<unsigned long long>(h.Count()),
+                h.Percentile(0.5) / 1000.0,
+                h.Percentile(0.99) / 1000.0,
+                h.Percentile(0.999) / 1000.0,
+                h.Max() / 1000.0);
+            out += line;
+        }
+        for (int i = 0; i < static_cast<int>(Counter::Count); i++) {
+            std::snprintf(line, sizeof(line), "%s: last %llu  max %llu\n", COUNTER_NAMES[i],
+                static_cast<unsigned long long>(counterLast[i]), static_cast<unsigned long long>(counterMax[i]));
+            out += line;
+        }
+        return out;
+    }
+
+}  // namespace TrickSaber::Perf
@@ -0,0 +1,234 @@
+#include "perf/trace.hpp"
+#include "perf/timers.hpp"
+#include "logger.hpp"
+
+#include "beatsaber-hook/shared/config/config-utils.hpp"
+
+#include <ctime>
+#include <filesystem>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+namespace TrickSaber::Trace {
+
+    static constexpr char const* TRACE_DIR = "traces";  // Under the loader's data directory for this mod
+    static constexpr int MAX_DEPTH = 32;
+
+    static char const* const SPAN_NAMES[] = {
+        "FixedUpdate",
+        "Validate handles",
+        "Hand velocity",
+        "Input poll",
+        "Saber tick",
+        "State apply",
+        "Pose write",
+        "Record",
+        "Render update",
+        "Saber Init",
+        "Main Menu",
+        "Blade sweep",
+        "Tick apply",
+    };
+    static_assert(sizeof(SPAN_NAMES) / sizeof(SPAN_NAMES[0]) == static_cast<int>(Span::Count));
+
+    static char const* const EVENT_NAMES[] = {
+        "Throw",
+        "Gentle throw",
+        "Straight throw",
+        "Normal throw",
+        "Recall",
+        "Spin on",
+        "Spin off",
+        "Reparented",
+        "Returned to hand",
+        "Saber invalid",
+        "Note cut",
+        "Bomb hit",
+        "Obstacle hit",
+        "Auto recall",
+    };
+    static_assert(sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0]) == static_cast<int>(Log::Event::AutoRecall) + 1);
+
+    struct ThreadBuffer {
+        std::atomic<uint32_t> count{0};  // Written by the owning thread only
+        std::atomic<bool> ready{false};
+        int tid = 0;
+    };
+
+    std::atomic<bool> capturing{false};
+
+    static TraceEvent events[MAX_THREADS][THREAD_CAPACITY];
+    static ThreadBuffer buffers[MAX_THREADS];
+    static std::atomic<int> threadCount{0};
+    static std::atomic<uint64_t> dropped{0};
+    static std::atomic<bool> writing{false};
+    static uint64_t captureStartNs = 0;
+
+    static thread_local int mine = -1;          // Index into buffers, once this thread recorded
+    static thread_local bool refused = false;   // Came after MAX_THREADS others
+
+    char const* SpanName(Span span) {
+        return static_cast<int>(span) < static_cast<int>(Span::Count) ? SPAN_NAMES[static_cast<int>(span)] : "?";
+    }
+
+    static int RegisteredThreads() {
+        return std::min(threadCount.load(std::memory_order_acquire), MAX_THREADS);
+    }
+
+    bool Start() {
+        if (writing.load(std::memory_order_acquire)) {
+            return false;
+        }
+        for (int t = 0; t < RegisteredThreads(); t++) {
+            buffers[t].count.store(0, std::memory_order_relaxed);
+        }
+        dropped.store(0, std::memory_order_relaxed);
+        captureStartNs = Perf::NowNs();
+        capturing.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void Stop() {
+        capturing.store(false, std::memory_order_release);
+    }
+
+    uint64_t Dropped() {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    int EventCount() {
+        int total = 0;
+        for (int t = 0; t < RegisteredThreads(); t++) {
+            total += static_cast<int>(buffers[t].count.load(std::memory_order_acquire));
+        }
+        return total;
+    }
+
+    void Push(Phase phase, uint8_t id, int slot, int hand, float value) {
+        if (mine < 0) {
+            int index = refused ? MAX_THREADS : threadCount.fetch_add(1, std::memory_order_acq_rel);
+            if (index >= MAX_THREADS) {
+                refused = true;
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            mine = index;
+            buffers[index].tid = static_cast<int>(syscall(SYS_gettid));
+            buffers[index].ready.store(true, std::memory_order_release);
+        }
+        ThreadBuffer& buffer = buffers[mine];
+        uint32_t n = buffer.count.load(std::memory_order_relaxed);
+        if (n >= THREAD_CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events[mine][n] = {Perf::NowNs(), phase, id, static_cast<int8_t>(slot), static_cast<uint8_t>(hand), value};
+        buffer.count.store(n + 1, std::memory_order_release);
+    }
+
+    // --- Chrome trace JSON ---
+
+    static double Micros(uint64_t ns) {
+        return static_cast<double>(static_cast<int64_t>(ns - captureStartNs)) / 1000.0;
+    }
+
+    static bool WriteSpan(std::FILE* file, bool& first, char phase, uint8_t id, int slot, uint64_t ns, int tid) {
+        int written = std::fprintf(file, "%s\n{\"name\":\"%s\",\"cat\":\"hook\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d",
+            first ? "" : ",", SpanName(static_cast<Span>(id)), phase, Micros(ns), tid);
+        first = false;
+        if (slot >= 0 && phase == 'B') {
+            written = std::fprintf(file, ",\"args\":{\"slot\":%d}}", slot);
+        } else {
+            written = std::fputs("}", file);
+        }
+        return written >= 0;
+    }
+
+    int WriteChromeJson(std::FILE* file) {
+        int written = 0;
+        bool first = true;
+        bool ok = std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file) >= 0;
+        for (int t = 0; t < RegisteredThreads() && ok; t++) {
+            ThreadBuffer const& buffer = buffers[t];
+            if (!buffer.ready.load(std::memory_order_acquire)) {
+                continue;
+            }
+            uint32_t n = buffer.count.load(std::memory_order_acquire);
+            if (n == 0) {
+                continue;
+            }
+            ok = std::fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",", buffer.tid, t == 0 ? "Unity main" : "TrickSaber") >= 0;
+            first = false;
+
+            // Open spans, so ends whose begin came before the capture can be dropped
+            uint8_t open[MAX_DEPTH];
+            int8_t openSlot[MAX_DEPTH];
+            int depth = 0;
+            int skipped = 0;  // Begins past MAX_DEPTH, whose ends are dropped too
+            uint64_t lastNs = captureStartNs;
+            for (uint32_t i = 0; i < n && ok; i++) {
+                TraceEvent const& e = events[t][i];
+                lastNs = e.timestampNs;
+                if (e.phase == Phase::Begin) {
+                    if (depth == MAX_DEPTH) {
+                        skipped++;
+                        continue;
+                    }
+                    open[depth] = e.id;
+                    openSlot[depth++] = e.slot;
+                    ok = WriteSpan(file, first, 'B', e.id, e.slot, e.timestampNs, buffer.tid);
+                    written++;
+                } else if (e.phase == Phase::End) {
+                    if (skipped > 0) {
+                        skipped--;
+                    } else if (depth > 0 && open[depth - 1] == e.id) {
+                        depth--;
+                        ok = WriteSpan(file, first, 'E', e.id, e.slot, e.timestampNs, buffer.tid);
+                        written++;
+                    }
+                } else {
+                    char const* name = e.id <= static_cast<uint8_t>(Log::Event::AutoRecall) ? EVENT_NAMES[e.id] : "?";
+                    ok = std::fprintf(file,
+                        ",\n{\"name\":\"%s\",\"cat\":\"trick\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,"
+                        "\"args\":{\"slot\":%d,\"hand\":%d,\"value\":%.3f}}",
+                        name, Micros(e.timestampNs), buffer.tid, e.slot, e.hand, static_cast<double>(e.value)) >= 0;
+                    written++;
+                }
+            }
+            // Spans still open when the capture stopped end with the thread's last event
+            while (depth > 0 && ok) {
+                depth--;
+                ok = WriteSpan(file, first, 'E', open[depth], openSlot[depth], lastNs, buffer.tid);
+                written++;
+            }
+        }
+        ok = ok && std::fputs("\n]}\n", file) >= 0;
+        return ok ? written : -1;
+    }
+
+    std::string StopAndSave() {
+        Stop();
+        if (EventCount() == 0 || writing.exchange(true, std::memory_order_acq_rel)) {
+            return {};
+        }
+        std::filesystem::path directory = std::filesystem::path(getDataDir(modInfo)) / TRACE_DIR;
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        char name[48];
+        std::time_t now = std::time(nullptr);
+        std::strftime(name, sizeof(name), "trace-%Y%m%d-%H%M%S.json", std::localtime(&now));
+        std::string path = (directory / name).string();
+
+        std::thread([path] {
+            if (std::FILE* file = std::fopen(path.c_str(), "wb")) {
+                WriteChromeJson(file);
+                std::fclose(file);
+            }
+            writing.store(false, std::memory_order_release);
+        }).detach();
+        return path;
+    }
+
+}  // namespace TrickSaber::Trace
@@ -0,0 +1,333 @@
+#include "physics/blade-sweep.hpp"
+
+namespace TrickSaber::Math {
+
+    // --- Four lanes at a time, on NEON or SSE where there is one ---
+    namespace {
+#if defined(TS_MATH_NEON)
+        using Lanes = float32x4_t;
+        using LaneMask = uint32x4_t;
+        inline Lanes Load(float const* p) { return vld1q_f32(p); }
+        inline Lanes Splat(float v) { return vdupq_n_f32(v); }
+        inline Lanes Add(Lanes a, Lanes b) { return vaddq_f32(a, b); }
+        inline Lanes Sub(Lanes a, Lanes b) { return vsubq_f32(a, b); }
+        inline Lanes Mul(Lanes a, Lanes b) { return vmulq_f32(a, b); }
+        inline Lanes Min(Lanes a, Lanes b) { return vminq_f32(a, b); }
+        inline Lanes Max(Lanes a, Lanes b) { return vmaxq_f32(a, b); }
+        inline LaneMask LessEqual(Lanes a, Lanes b) { return vcleq_f32(a, b); }
+        inline LaneMask And(LaneMask a, LaneMask b) { return vandq_u32(a, b); }
+        inline int Bits(LaneMask m) {
+            uint32x4_t const weights = {1, 2, 4, 8};
+            return static_cast<int>(vaddvq_u32(vandq_u32(m, weights)));
+        }
+#elif defined(TS_MATH_SSE)
+        using Lanes = __m128;
+        using LaneMask = __m128;
+        inline Lanes Load(float const* p) { return _mm_load_ps(p); }
+        inline Lanes Splat(float v) { return _mm_set1_ps(v); }
+        inline Lanes Add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+        inline Lanes Sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+        inline Lanes Mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+        inline Lanes Min(Lanes a, Lanes b) { return _mm_min_ps(a, b); }
+        inline Lanes Max(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+        inline LaneMask LessEqual(Lanes a, Lanes b) { return _mm_cmple_ps(a, b); }
+        inline LaneMask And(LaneMask a, LaneMask b) { return _mm_and_ps(a, b); }
+        inline int Bits(LaneMask m) { return _mm_movemask_ps(m); }
+#else
+        struct Lanes { float v[4]; };
+        struct LaneMask { bool v[4]; };
+        template <typename F>
+        inline Lanes Each(F f) { return {{f(0), f(1), f(2), f(3)}}; }
+        inline Lanes Load(float const* p) { return {{p[0], p[1], p[2], p[3]}}; }
+        inline Lanes Splat(float v) { return {{v, v, v, v}}; }
+        inline Lanes Add(Lanes a, Lanes b) { return Each([&](int i) { return a.v[i] + b.v[i]; }); }
+        inline Lanes Sub(Lanes a, Lanes b) { return Each([&](int i) { return a.v[i] - b.v[i]; }); }
+        inline Lanes Mul(Lanes a, Lanes b) { return Each([&](int i) { return a.v[i] * b.v[i]; }); }
+        inline Lanes Min(Lanes a, Lanes b) { return Each([&](int i) { return std::min(a.v[i], b.v[i]); }); }
+        inline Lanes Max(Lanes a, Lanes b) { return Each([&](int i) { return std::max(a.v[i], b.v[i]); }); }
+        inline LaneMask LessEqual(Lanes a, Lanes b) { return {{a.v[0] <= b.v[0], a.v[1] <= b.v[1], a.v[2] <= b.v[2], a.v[3] <= b.v[3]}}; }
+        inline LaneMask And(LaneMask a, LaneMask b) { return {{a.v[0] && b.v[0], a.v[1] && b.v[1], a.v[2] && b.v[2], a.v[3] && b.v[3]}}; }
+        inline int Bits(LaneMask m) { return m.v[0] | m.v[1] << 1 | m.v[2] << 2 | m.v[3] << 3; }
+#endif
+    }  // namespace
+
+    int CutTargets::AddSphere(void* owner, CutTargetKind targetKind, Vec3 center, Vec3 moved, float sphereRadius) {
+        if (count >= MAX_CUT_TARGETS) {
+            return -1;
+        }
+        int i = count++;
+        cx[i] = center.x; cy[i] = center.y; cz[i] = center.z;
+        dx[i] = moved.x; dy[i] = moved.y; dz[i] = moved.z;
+        radius[i] = sphereRadius;
+        kind[i] = targetKind;
+        handle[i] = owner;
+        maxMove = std::max(maxMove, Magnitude(moved));
+        return i;
+    }
+
+    int CutTargets::AddBox(void* owner, Vec3 center, Quat boxRotation, Vec3 boxHalfExtents, Vec3 moved) {
+        int i = AddSphere(owner, CutTargetKind::Obstacle, center, moved, Magnitude(boxHalfExtents));
+        if (i >= 0) {
+            rotation[i] = boxRotation;
+            halfExtents[i] = boxHalfExtents;
+        }
+        return i;
+    }
+
+    void SweepBlade(Vec3 fromPosition, Quat fromRotation, Vec3 toPosition, Quat toRotation, float bladeStart,
+                    float bladeEnd, float radius, float otherTravel, BladeSweep& sweep) {
+        float angle = 2.0f * std::acos(std::min(1.0f, std::abs(Dot(fromRotation, toRotation))));
+        float reach = std::max(std::abs(bladeStart), std::abs(bladeEnd));
+        float bladeTravel = Magnitude(toPosition - fromPosition) + angle * reach;
+        int steps = std::min(static_cast<int>(std::ceil((bladeTravel + otherTravel) / MAX_SAMPLE_SPACING)), MAX_SWEEP_SAMPLES - 1);
+
+        sweep.samples = steps + 1;
+        sweep.padded = (sweep.samples + 3) & ~3;
+        sweep.radius = radius;
+        sweep.spacing = steps > 0 ? bladeTravel / static_cast<float>(steps) : 0.0f;
+        sweep.inflate = radius + 0.5f * sweep.spacing;
+        sweep.lengthSq = (bladeEnd - bladeStart) * (bladeEnd - bladeStart);
+        sweep.lo = {INFINITY, INFINITY, INFINITY};
+        sweep.hi = {-INFINITY, -INFINITY, -INFINITY};
+        // Slerp(from, to, t) is (to * from^-1)^t * from, so each sample is one turn on from the last
+        Quat turn = steps > 0 ? Slerp(fromRotation, toRotation, 1.0f / static_cast<float>(steps)) * Inverse(fromRotation) : Identity();
+        Quat rotation = steps > 0 ? fromRotation : toRotation;
+        for (int k = 0; k < sweep.padded; k++) {
+            int sample = std::min(k, steps);
+            float s = steps > 0 ? static_cast<float>(sample) / static_cast<float>(steps) : 1.0f;
+            if (k > 0 && k <= steps) {
+                rotation = k == steps ? toRotation : turn * rotation;
+            }
+            Vec3 start = Lerp(fromPosition, toPosition, s) + rotation * (Forward() * bladeStart);
+            Vec3 along = rotation * (Forward() * (bladeEnd - bladeStart));
+            sweep.bx[k] = start.x; sweep.by[k] = start.y; sweep.bz[k] = start.z;
+            sweep.ax[k] = along.x; sweep.ay[k] = along.y; sweep.az[k] = along.z;
+            sweep.time[k] = s;
+            Vec3 end = start + along;
+            sweep.lo = {std::min({sweep.lo.x, start.x, end.x}), std::min({sweep.lo.y, start.y, end.y}), std::min({sweep.lo.z, start.z, end.z})};
+            sweep.hi = {std::max({sweep.hi.x, start.x, end.x}), std::max({sweep.hi.y, start.y, end.y}), std::max({sweep.hi.z, start.z, end.z})};
+        }
+    }
+
+    // --- Narrow phase ---
+
+    static Vec3 SampleStart(BladeSweep const& sweep, int k) { return {sweep.bx[k], sweep.by[k], sweep.bz[k]}; }
+    static Vec3 SampleAlong(BladeSweep const& sweep, int k) { return {sweep.ax[k], sweep.ay[k], sweep.az[k]}; }
+
+    // Where the target was at sample k's time.
+    static Vec3 CenterAt(CutTargets const& targets, int i, float time) {
+        return targets.Center(i) - Vec3{targets.dx[i], targets.dy[i], targets.dz[i]} * (1.0f - time);
+    }
+
+    // Radius the target has to come within: its own, the blade's grown one, and half of its
+    // own motion between samples.
+    static float Reach(BladeSweep const& sweep, CutTargets const& targets, int i) {
+        int steps = sweep.samples - 1;
+        float moved = Magnitude(Vec3{targets.dx[i], targets.dy[i], targets.dz[i]});
+        return sweep.inflate + (steps > 0 ? 0.5f * moved / static_cast<float>(steps) : 0.0f);
+    }
+
+    // First sample whose blade segment comes within reach of sphere target i, or -1. Also the
+    // blade parameter (0..1) of the closest point.
+    static int FirstSphereSample(BladeSweep const& sweep, CutTargets const& targets, int i, float reach, float& along) {
+        float invLengthSq = sweep.lengthSq > 0.0f ? 1.0f / sweep.lengthSq : 0.0f;
+        Lanes reachSq = Splat((targets.radius[i] + reach) * (targets.radius[i] + reach));
+        Lanes cx = Splat(targets.cx[i]), cy = Splat(targets.cy[i]), cz = Splat(targets.cz[i]);
+        Lanes dx = Splat(targets.dx[i]), dy = Splat(targets.dy[i]), dz = Splat(targets.dz[i]);
+        Lanes zero = Splat(0.0f), one = Splat(1.0f), inv = Splat(invLengthSq);
+        for (int k = 0; k < sweep.padded; k += 4) {
+            Lanes back = Sub(one, Load(sweep.time + k));
+            Lanes wx = Sub(Sub(cx, Mul(dx, back)), Load(sweep.bx + k));
+            Lanes wy = Sub(Sub(cy, Mul(dy, back)), Load(sweep.by + k));
+            Lanes wz = Sub(Sub(cz, Mul(dz, back)), Load(sweep.bz + k));
+            Lanes ax = Load(sweep.ax + k), ay = Load(sweep.ay + k), az = Load(sweep.az + k);
+            Lanes s = Min(Max(Mul(Add(Add(Mul(wx, ax), Mul(wy, ay)), Mul(wz, az)), inv), zero), one);
+            Lanes ex = Sub(wx, Mul(ax, s)), ey = Sub(wy, Mul(ay, s)), ez = Sub(wz, Mul(az, s));
+            int bits = Bits(LessEqual(Add(Add(Mul(ex, ex), Mul(ey, ey)), Mul(ez, ez)), reachSq));
+            if (bits) {
+                int first = k + __builtin_ctz(static_cast<unsigned>(bits));
+                Vec3 w = CenterAt(targets, i, sweep.time[first]) - SampleStart(sweep, first);
+                along = std::clamp(Dot(w, SampleAlong(sweep, first)) * invLengthSq, 0.0f, 1.0f);
+                return first;
+            }
+        }
+        return -1;
+    }
+
+    // Squared distance from point to the segment start + along * [0, 1], and the segment
+    // parameter of the closest point.
+    static float SegmentDistanceSq(Vec3 point, Vec3 start, Vec3 along, float invLengthSq, float& s) {
+        Vec3 w = point - start;
+        s = std::clamp(Dot(w, along) * invLengthSq, 0.0f, 1.0f);
+        return SqrMagnitude(w - along * s);
+    }
+
+    // Whether the blade really touches sphere target i, first found within reach at sample
+    // first. Only steps with an end within reach can hold a contact, so each of those is
+    // resampled at BOMB_SAMPLE_SPACING and tested against the blade's own radius plus half the
+    // finer spacing. Between two samples both blade ends move along the chord, off the arc by
+    // at most spacing^2 / (8 * blade reach): 0.2 mm for a 1 m blade. On a contact, k is the
+    // sample ending its step and time, point and along are where it happened.
+    static bool ConfirmSphere(BladeSweep const& sweep, CutTargets const& targets, int i, int first, float reach,
+                              int& k, float& time, Vec3& point, float& along) {
+        int steps = sweep.samples - 1;
+        if (steps == 0) {
+            return true;  // A single pose is tested at the blade's own radius already
+        }
+        float invLengthSq = sweep.lengthSq > 0.0f ? 1.0f / sweep.lengthSq : 0.0f;
+        float reachSq = (targets.radius[i] + reach) * (targets.radius[i] + reach);
+        float travel = sweep.spacing + Magnitude(Vec3{targets.dx[i], targets.dy[i], targets.dz[i]}) / static_cast<float>(steps);
+        int parts = std::max(1, static_cast<int>(std::ceil(travel / BOMB_SAMPLE_SPACING)));
+        float exact = targets.radius[i] + sweep.radius + 0.5f * travel / static_cast<float>(parts);
+        float exactSq = exact * exact;
+
+        auto inReach = [&](int sample) {
+            float s;
+            return SegmentDistanceSq(CenterAt(targets, i, sweep.time[sample]), SampleStart(sweep, sample),
+                                     SampleAlong(sweep, sample), invLengthSq, s) <= reachSq;
+        };
+        bool fromIn = first > 0 && inReach(first - 1);
+        for (int step = std::max(first - 1, 0); step < steps; step++) {
+            bool toIn = inReach(step + 1);
+            if (fromIn || toIn) {
+                Vec3 fromStart = SampleStart(sweep, step), toStart = SampleStart(sweep, step + 1);
+                Vec3 fromAlong = SampleAlong(sweep, step), toAlong = SampleAlong(sweep, step + 1);
+                for (int part = 0; part <= parts; part++) {
+                    float f = static_cast<float>(part) / static_cast<float>(parts);
+                    float t = sweep.time[step] + (sweep.time[step + 1] - sweep.time[step]) * f;
+                    Vec3 start = Lerp(fromStart, toStart, f);
+                    Vec3 segment = Lerp(fromAlong, toAlong, f);
+                    float s;
+                    if (SegmentDistanceSq(CenterAt(targets, i, t), start, segment, invLengthSq, s) <= exactSq) {
+                        k = step + 1;
+                        time = t;
+                        point = start + segment * s;
+                        along = s;
+                        return true;
+                    }
+                }
+            }
+            fromIn = toIn;
+        }
+        return false;
+    }
+
+    // Segment start + along * [0, 1] against the box |x| <= half, as the entry parameter.
+    static bool SegmentHitsBox(Vec3 start, Vec3 along, Vec3 half, float& enter) {
+        float const s[3] = {start.x, start.y, start.z};
+        float const a[3] = {along.x, along.y, along.z};
+        float const h[3] = {half.x, half.y, half.z};
+        float lo = 0.0f, hi = 1.0f;
+        for (int axis = 0; axis < 3; axis++) {
+            if (std::abs(a[axis]) < 1e-8f) {
+                if (std::abs(s[axis]) > h[axis]) return false;
+                continue;
+            }
+            float inv = 1.0f / a[axis];
+            float t1 = (-h[axis] - s[axis]) * inv;
+            float t2 = (h[axis] - s[axis]) * inv;
+            lo = std::max(lo, std::min(t1, t2));
+            hi = std::min(hi, std::max(t1, t2));
+        }
+        enter = lo;
+        return lo <= hi;
+    }
+
+    // First sample whose blade segment enters box target i grown by reach, or -1. Growing the
+    // box's faces rather than rounding it is conservative at its edges.
+    static int FirstBoxSample(BladeSweep const& sweep, CutTargets const& targets, int i, float reach, float& along) {
+        Quat toLocal = Inverse(targets.rotation[i]);
+        Vec3 half = targets.halfExtents[i] + Vec3{reach, reach, reach};
+        for (int k = 0; k < sweep.samples; k++) {
+            Vec3 start = toLocal * (SampleStart(sweep, k) - CenterAt(targets, i, sweep.time[k]));
+            if (SegmentHitsBox(start, toLocal * SampleAlong(sweep, k), half, along)) {
+                return k;
+            }
+        }
+        return -1;
+    }
+
+    static BladeHit DescribeHit(BladeSweep const& sweep, CutTargets const& targets, int i, int k, float along) {
+        BladeHit hit;
+        hit.target = i;
+        hit.time = sweep.time[k];
+        hit.point = SampleStart(sweep, k) + SampleAlong(sweep, k) * along;
+        hit.bladeDirection = Normalized(SampleAlong(sweep, k));
+
+        // How the hit blade point moved over the neighbouring step, less the target's own motion
+        int steps = sweep.samples - 1;
+        Vec3 moved = Vec3{targets.dx[i], targets.dy[i], targets.dz[i]} * -1.0f;
+        if (steps > 0) {
+            int from = k > 0 ? k - 1 : 0;
+            int to = k > 0 ? k : 1;
+            Vec3 fromPoint = SampleStart(sweep, from) + SampleAlong(sweep, from) * along;
+            Vec3 toPoint = SampleStart(sweep, to) + SampleAlong(sweep, to) * along;
+            moved = toPoint - fromPoint + moved * (1.0f / static_cast<float>(steps));
+        }
+        hit.cutDirection = SqrMagnitude(moved) > 1e-12f ? Normalized(moved) : Forward();
+        return hit;
+    }
+
+    int FindBladeHits(BladeSweep const& sweep, CutTargets const& targets, BladeHit* hits, int maxHits) {
+        if (sweep.samples == 0) {
+            return 0;
+        }
+        // --- Broad phase: each target's path, grown by its radius, against the sweep's bounds ---
+        int candidates[MAX_CUT_TARGETS];
+        int candidateCount = 0;
+        float grow = sweep.inflate;
+        Lanes loX = Splat(sweep.lo.x - grow), loY = Splat(sweep.lo.y - grow), loZ = Splat(sweep.lo.z - grow);
+        Lanes hiX = Splat(sweep.hi.x + grow), hiY = Splat(sweep.hi.y + grow), hiZ = Splat(sweep.hi.z + grow);
+        auto overlaps = [](Lanes c, Lanes d, Lanes r, Lanes lo, Lanes hi) {
+            Lanes before = Sub(c, d);
+            return And(LessEqual(Sub(Min(c, before), r), hi), LessEqual(lo, Add(Max(c, before), r)));
+        };
+        int i = 0;
+        for (; i + 4 <= targets.count; i += 4) {
+            Lanes r = Load(targets.radius + i);
+            LaneMask in = And(And(overlaps(Load(targets.cx + i), Load(targets.dx + i), r, loX, hiX),
+                                  overlaps(Load(targets.cy + i), Load(targets.dy + i), r, loY, hiY)),
+                              overlaps(Load(targets.cz + i), Load(targets.dz + i), r, loZ, hiZ));
+            for (int bits = Bits(in); bits; bits &= bits - 1) {
+                candidates[candidateCount++] = i + __builtin_ctz(static_cast<unsigned>(bits));
+            }
+        }
+        for (; i < targets.count; i++) {
+            Vec3 now = targets.Center(i);
+            Vec3 before = now - Vec3{targets.dx[i], targets.dy[i], targets.dz[i]};
+            float r = targets.radius[i];
+            if (std::min(now.x, before.x) - r <= sweep.hi.x + grow && sweep.lo.x - grow <= std::max(now.x, before.x) + r &&
+                std::min(now.y, before.y) - r <= sweep.hi.y + grow && sweep.lo.y - grow <= std::max(now.y, before.y) + r &&
+                std::min(now.z, before.z) - r <= sweep.hi.z + grow && sweep.lo.z - grow <= std::max(now.z, before.z) + r) {
+                candidates[candidateCount++] = i;
+            }
+        }
+
+        // --- Narrow phase, survivors only ---
+        int hitCount = 0;
+        for (int c = 0; c < candidateCount && hitCount < maxHits; c++) {
+            int target = candidates[c];
+            float reach = Reach(sweep, targets, target);
+            float along = 0.0f;
+            int k = targets.kind[target] == CutTargetKind::Obstacle ? FirstBoxSample(sweep, targets, target, reach, along)
+                                                                    : FirstSphereSample(sweep, targets, target, reach, along);
+            if (k < 0) {
+                continue;
+            }
+            if (targets.kind[target] != CutTargetKind::Bomb) {
+                hits[hitCount++] = DescribeHit(sweep, targets, target, k, along);
+                continue;
+            }
+            float time;
+            Vec3 point;
+            if (ConfirmSphere(sweep, targets, target, k, reach, k, time, point, along)) {
+                BladeHit& hit = hits[hitCount++];
+                hit = DescribeHit(sweep, targets, target, k, along);
+                hit.time = time;
+                hit.point = point;
+            }
+        }
+        return hitCount;
+    }
+
+}  // namespace TrickSaber::Math
@@ -0,0 +1,64 @@
+#include "physics/return-path.hpp"
+
+namespace TrickSaber::Math {
+
+    // Bézier control points in units of the start-to-target distance: along, sideways, up.
+    struct CurveControls {
+        float along1, side1, up1;
+        float along2, side2, up2;
+    };
+
+    static constexpr CurveControls CURVES[] = {
+        {1.0f / 3.0f, 0.0f, 0.0f, 2.0f / 3.0f, 0.0f, 0.0f},  // Straight: exactly the line
+        {0.15f, 0.55f, 0.15f, 0.85f, 0.55f, 0.15f},          // Arc: swings out to one side like a boomerang
+        {0.5f, -0.35f, 0.45f, 1.15f, 0.45f, 0.05f},          // Curl: rises, crosses over and hooks into the hand
+    };
+    static_assert(sizeof(CURVES) / sizeof(CURVES[0]) == static_cast<int>(ReturnCurve::Count));
+
+    static float Ease(ReturnEasing easing, float t) {
+        switch (easing) {
+            case ReturnEasing::EaseIn: return t * t * t;
+            case ReturnEasing::EaseOut: return 1.0f - (1.0f - t) * (1.0f - t) * (1.0f - t);
+            case ReturnEasing::EaseInOut: return t * t * (3.0f - 2.0f * t);
+            default: return t;
+        }
+    }
+
+    static ReturnPath Bake(ReturnCurve curve, ReturnEasing easing) {
+        CurveControls const& c = CURVES[static_cast<int>(curve)];
+        ReturnPath path;
+        for (int i = 0; i <= RETURN_PATH_SEGMENTS; i++) {
+            float u = Ease(easing, static_cast<float>(i) / RETURN_PATH_SEGMENTS);
+            // Bernstein weights of the two control points and the end; the start's is implied
+            float b1 = 3.0f * (1.0f - u) * (1.0f - u) * u;
+            float b2 = 3.0f * (1.0f - u) * u * u;
+            float b3 = u * u * u;
+            path.along[i] = b1 * c.along1 + b2 * c.along2 + b3;
+            path.side[i] = b1 * c.side1 + b2 * c.side2;
+            path.up[i] = b1 * c.up1 + b2 * c.up2;
+            path.eased[i] = u;
+        }
+        return path;
+    }
+
+    ReturnPath const& ReturnPathFor(uint8_t style) {
+        constexpr int CURVE_COUNT = static_cast<int>(ReturnCurve::Count);
+        constexpr int EASING_COUNT = static_cast<int>(ReturnEasing::Count);
+        static ReturnPath const* const paths = [] {
+            static ReturnPath baked[CURVE_COUNT * EASING_COUNT];
+            for (int curve = 0; curve < CURVE_COUNT; curve++) {
+                for (int easing = 0; easing < EASING_COUNT; easing++) {
+                    baked[curve * EASING_COUNT + easing] = Bake(static_cast<ReturnCurve>(curve), static_cast<ReturnEasing>(easing));
+                }
+            }
+            return baked;
+        }();
+        int curve = style & 0x0f;
+        int easing = style >> 4;
+        if (curve >= CURVE_COUNT || easing >= EASING_COUNT) {
+            return paths[0];
+        }
+        return paths[curve * EASING_COUNT + easing];
+    }
+
+}  // namespace TrickSaber::Math
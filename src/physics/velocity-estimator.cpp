@@ -0,0 +1,134 @@
+#include "physics/velocity-estimator.hpp"
+
+namespace TrickSaber::Math {
+
+    static_assert((MotionHistory::CAPACITY & (MotionHistory::CAPACITY - 1)) == 0, "ring index is masked");
+
+    // Accumulated rotation vectors are rebased before they get large enough to lose precision.
+    static constexpr float ROTATION_REBASE_LIMIT = 1000.0f;
+
+    void MotionHistory::Push(uint64_t timeNs, Vec3 position) {
+        Push(timeNs, position, size > 0 ? rotation[Index(0)] : Identity());
+    }
+
+    void MotionHistory::Push(uint64_t timeNs, Vec3 position, Quat q) {
+        Vec3 accumulated = Zero();
+        if (size > 0) {
+            int newest = Index(0);
+            if (timeNs <= time[newest]) {
+                return;
+            }
+            Quat last = rotation[newest];
+            if (position.x == px[newest] && position.y == py[newest] && position.z == pz[newest] &&
+                q.x == last.x && q.y == last.y && q.z == last.z && q.w == last.w) {
+                return;
+            }
+            accumulated = Vec3{rx[newest], ry[newest], rz[newest]} + ToRotationVector(q * Inverse(last));
+        }
+
+        int slot = head;
+        time[slot] = timeNs;
+        px[slot] = position.x;
+        py[slot] = position.y;
+        pz[slot] = position.z;
+        rx[slot] = accumulated.x;
+        ry[slot] = accumulated.y;
+        rz[slot] = accumulated.z;
+        rotation[slot] = q;
+        head = (head + 1) & (CAPACITY - 1);
+        if (size < CAPACITY) {
+            size++;
+        }
+
+        if (std::abs(accumulated.x) + std::abs(accumulated.y) + std::abs(accumulated.z) > ROTATION_REBASE_LIMIT) {
+            for (int i = 0; i < CAPACITY; i++) {
+                rx[i] -= accumulated.x;
+                ry[i] -= accumulated.y;
+                rz[i] -= accumulated.z;
+            }
+        }
+    }
+
+    Vec3 MotionHistory::Fit(int end, float window, float const* vx, float const* vy, float const* vz) const {
+        // Gather the window into contiguous arrays, newest first, relative to the end sample
+        // and with time scaled to [-1, 0] so the normal equations stay well conditioned in float.
+        float u[CAPACITY], dx[CAPACITY], dy[CAPACITY], dz[CAPACITY];
+        int endSlot = Index(end);
+        float invWindow = 1.0f / window;
+        int n = 0;
+        for (int age = end; age < size; age++) {
+            int slot = Index(age);
+            float tau = static_cast<float>(static_cast<int64_t>(time[slot] - time[endSlot])) * 1e-9f;
+            if (tau < -window) {
+                break;
+            }
+            u[n] = tau * invWindow;
+            dx[n] = vx[slot] - vx[endSlot];
+            dy[n] = vy[slot] - vy[endSlot];
+            dz[n] = vz[slot] - vz[endSlot];
+            n++;
+        }
+        if (n < 2) {
+            return Zero();
+        }
+
+        // Straight sums over the gathered arrays; the compiler vectorizes these.
+        float s1 = 0.0f, s2 = 0.0f, s3 = 0.0f, s4 = 0.0f;
+        float x0 = 0.0f, y0 = 0.0f, z0 = 0.0f;
+        float x1 = 0.0f, y1 = 0.0f, z1 = 0.0f;
+        float x2 = 0.0f, y2 = 0.0f, z2 = 0.0f;
+        for (int i = 0; i < n; i++) {
+            float t = u[i], tt = t * t;
+            s1 += t; s2 += tt; s3 += tt * t; s4 += tt * tt;
+            x0 += dx[i]; y0 += dy[i]; z0 += dz[i];
+            x1 += dx[i] * t; y1 += dy[i] * t; z1 += dz[i] * t;
+            x2 += dx[i] * tt; y2 += dy[i] * tt; z2 += dz[i] * tt;
+        }
+        float s0 = static_cast<float>(n);
+
+        // Quadratic fit a + b u + c u^2; velocity is b at u = 0. Cramer's rule on the 3x3 normal
+        // equations, falling back to a straight line when there are too few samples to trust it.
+        float det = s0 * (s2 * s4 - s3 * s3) - s1 * (s1 * s4 - s3 * s2) + s2 * (s1 * s3 - s2 * s2);
+        if (n >= 4 && std::abs(det) > 1e-6f) {
+            float invDet = invWindow / det;
+            auto slope = [&](float r0, float r1, float r2) {
+                return (s0 * (r1 * s4 - s3 * r2) - r0 * (s1 * s4 - s3 * s2) + s2 * (s1 * r2 - r1 * s2)) * invDet;
+            };
+            return {slope(x0, x1, x2), slope(y0, y1, y2), slope(z0, z1, z2)};
+        }
+
+        float denom = s0 * s2 - s1 * s1;
+        if (std::abs(denom) < 1e-9f) {
+            return Zero();
+        }
+        float invDenom = invWindow / denom;
+        return {(s0 * x1 - s1 * x0) * invDenom, (s0 * y1 - s1 * y0) * invDenom, (s0 * z1 - s1 * z0) * invDenom};
+    }
+
+    Vec3 MotionHistory::LinearVelocity(float window) const {
+        return Fit(0, window, px, py, pz);
+    }
+
+    Vec3 MotionHistory::AngularVelocity(float window) const {
+        return Fit(0, window, rx, ry, rz);
+    }
+
+    Vec3 MotionHistory::PeakLinearVelocity(float window, float peakWindow) const {
+        Vec3 best = Zero();
+        float bestSqr = -1.0f;
+        uint64_t newest = size > 0 ? time[Index(0)] : 0;
+        for (int end = 0; end < size; end++) {
+            if (static_cast<float>(newest - time[Index(end)]) * 1e-9f > peakWindow) {
+                break;
+            }
+            Vec3 v = Fit(end, window, px, py, pz);
+            float sqr = SqrMagnitude(v);
+            if (sqr > bestSqr) {
+                best = v;
+                bestSqr = sqr;
+            }
+        }
+        return best;
+    }
+
+}  // namespace TrickSaber::Math
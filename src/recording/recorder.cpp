@@ -0,0 +1,127 @@
+#include "recording/recorder.hpp"
+#include "logger.hpp"
+
+#include "beatsaber-hook/shared/config/config-utils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <thread>
+
+namespace TrickSaber::Recording {
+
+    static constexpr uint32_t RING_CAPACITY = 2048;  // power of two, ~22 s at 90 Hz
+    static constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(50);
+    static constexpr char const* RECORDING_DIR = "recordings";  // Under the loader's data directory for this mod
+
+    static TickSample ring[RING_CAPACITY];
+    alignas(64) static std::atomic<uint32_t> head{0};  // written by the hook thread
+    alignas(64) static std::atomic<uint32_t> tail{0};  // written by the writer thread
+    alignas(64) static std::atomic<uint64_t> dropped{0};
+    static std::atomic<bool> recording{false};
+    static std::thread writer;
+    static std::FILE* file = nullptr;
+    static std::string lastPath;
+
+    void Push(TickSample const& sample) {
+        if (!recording.load(std::memory_order_relaxed)) {
+            return;
+        }
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ring[h & (RING_CAPACITY - 1)] = sample;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    static void Drain(FrameCodec& codec) {
+        static uint8_t buffer[64 * MAX_FRAME_BYTES];
+        int used = 0;
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t h = head.load(std::memory_order_acquire);
+        while (t != h) {
+            used += codec.Encode(ring[t & (RING_CAPACITY - 1)], buffer + used);
+            tail.store(++t, std::memory_order_release);
+            if (used > static_cast<int>(sizeof(buffer)) - MAX_FRAME_BYTES) {
+                std::fwrite(buffer, 1, used, file);
+                used = 0;
+            }
+        }
+        if (used > 0) {
+            std::fwrite(buffer, 1, used, file);
+        }
+    }
+
+    static void WriteLoop() {
+        FrameCodec codec;
+        while (recording.load(std::memory_order_acquire)) {
+            Drain(codec);
+            std::this_thread::sleep_for(FLUSH_INTERVAL);
+        }
+        Drain(codec);
+    }
+
+    bool Start() {
+        if (recording.load(std::memory_order_relaxed)) {
+            return true;
+        }
+
+        std::filesystem::path directory = std::filesystem::path(getDataDir(modInfo)) / RECORDING_DIR;
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+
+        char name[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(name, sizeof(name), "%Y%m%d-%H%M%S.tsrec", std::localtime(&now));
+        std::string path = (directory / name).string();
+
+        file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            getLogger().error("[TS] [Recording] Could not open {}", path);
+            return false;
+        }
+        Header header = MakeHeader();
+        std::fwrite(&header, sizeof(header), 1, file);
+
+        lastPath = path;
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+        dropped.store(0, std::memory_order_relaxed);
+        recording.store(true, std::memory_order_release);
+        writer = std::thread(WriteLoop);
+        getLogger().info("[TS] [Recording] Started {}", path);
+        return true;
+    }
+
+    void Stop() {
+        if (!recording.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+        writer.join();
+        std::fclose(file);
+        file = nullptr;
+
+        uint64_t lost = dropped.load(std::memory_order_relaxed);
+        if (lost > 0) {
+            getLogger().warn("[TS] [Recording] {} samples dropped, ring was full", lost);
+        }
+        getLogger().info("[TS] [Recording] Stopped {} ({} ticks)", lastPath, tail.load(std::memory_order_relaxed));
+    }
+
+    bool IsRecording() {
+        return recording.load(std::memory_order_relaxed);
+    }
+
+    uint64_t DroppedSamples() {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    std::string LastPath() {
+        return lastPath;
+    }
+
+}  // namespace TrickSaber::Recording
@@ -0,0 +1,200 @@
+#include "replication/remote-saber.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace TrickSaber::Replication {
+
+    using Saber::SaberInteractionState;
+
+    static constexpr float NEVER = std::numeric_limits<float>::infinity();
+
+    void RemoteSaber::Clear() {
+        *this = RemoteSaber();
+    }
+
+    void RemoteSaber::OnState(float time, SaberInteractionState newState, bool newSpin, uint8_t newHand) {
+        hand = newHand;
+        if (known && newState == state && newSpin == spinActive) {
+            return;  // Repeated by a keyframe
+        }
+        if (newState != SaberInteractionState::Thrown && flight.recallTime == NEVER) {
+            // Out of the air; OnReturn corrects this to the exact recall if it comes
+            flight.recallTime = time;
+        }
+        stillSince = newState == SaberInteractionState::Held && !newSpin ? time : NEVER;
+        state = newState;
+        spinActive = newSpin;
+        known = true;
+    }
+
+    void RemoteSaber::OnTrajectory(float releaseTime, Math::ThrowTrajectory const& trajectory) {
+        if (flight.valid && std::abs(releaseTime - flight.releaseTime) < 0.005f) {
+            return;  // Same throw, resent; keep the first copy so it never jumps
+        }
+        previousFlight = flight;
+        // Whatever was missed of the last throw, it was over by this release
+        previousFlight.recallTime = std::min(previousFlight.recallTime, releaseTime);
+        flight = {true, trajectory, releaseTime, NEVER, 0.0f, Math::DEFAULT_RETURN_STYLE};
+    }
+
+    void RemoteSaber::OnReturn(float recallTime, float returnDuration, uint8_t returnStyle) {
+        // A recall stamped from a state change is never early, so one later than that belongs
+        // to a throw whose trajectory has not arrived yet
+        if (flight.valid && recallTime >= flight.releaseTime && recallTime <= flight.recallTime + 0.005f) {
+            flight.recallTime = recallTime;
+            flight.returnDuration = returnDuration;
+            flight.returnStyle = returnStyle;
+        }
+    }
+
+    void RemoteSaber::OnPoseState(float time, SaberInteractionState poseState) {
+        if (!known || poseState != state) {
+            // Held with a pose to send means spinning
+            OnState(time, poseState, poseState == SaberInteractionState::Held || spinActive, hand);
+        }
+    }
+
+    void RemoteSaber::OnPose(float time, uint8_t space, Math::Vec3 position, Math::Quat rotation, bool returnTarget) {
+        if (size > 0 && time <= history[newest].time) {
+            return;
+        }
+        newest = (newest + 1) % HISTORY;
+        history[newest] = {time, position, rotation, space, returnTarget};
+        size = std::min(size + 1, HISTORY);
+    }
+
+    bool RemoteSaber::SampleTarget(float renderTime, Math::Vec3& position, Math::Quat& rotation) const {
+        // Nearest return targets on either side of renderTime
+        PoseSample const* before = nullptr;
+        PoseSample const* after = nullptr;
+        for (int age = 0; age < size; age++) {
+            PoseSample const& sample = At(age);
+            if (!sample.returnTarget) {
+                continue;
+            }
+            if (sample.time > renderTime) {
+                after = &sample;
+            } else {
+                before = &sample;
+                break;
+            }
+        }
+        if (before && after && after->time - before->time <= MAX_SAMPLE_GAP) {
+            float t = (renderTime - before->time) / (after->time - before->time);
+            position = Math::Lerp(before->position, after->position, t);
+            rotation = Math::Slerp(before->rotation, after->rotation, t);
+            return true;
+        }
+        PoseSample const* nearest = before ? before : after;
+        if (!nearest) {
+            return false;
+        }
+        position = nearest->position;
+        rotation = nearest->rotation;
+        return true;
+    }
+
+    bool RemoteSaber::SampleFlight(RemoteFlight const& thrown, float renderTime, Math::Vec3& position, Math::Quat& rotation) const {
+        if (!thrown.valid || renderTime < thrown.releaseTime) {
+            return false;
+        }
+        if (renderTime < thrown.recallTime) {
+            thrown.trajectory.Evaluate(renderTime - thrown.releaseTime, position, rotation);
+            return true;
+        }
+        Math::Vec3 targetPosition;
+        Math::Quat targetRotation;
+        if (thrown.returnDuration <= 0.0f || renderTime >= thrown.recallTime + thrown.returnDuration ||
+            !SampleTarget(renderTime, targetPosition, targetRotation)) {
+            return false;
+        }
+        // Replay the return the way the sender's trick machine ran it
+        Math::Vec3 releasePosition;
+        Math::Quat releaseRotation;
+        thrown.trajectory.Evaluate(thrown.recallTime - thrown.releaseTime, releasePosition, releaseRotation);
+        float t = (renderTime - thrown.recallTime) / thrown.returnDuration;
+        Saber::ReturnPose(Math::ReturnPathFor(thrown.returnStyle), thrown.trajectory, releasePosition, releaseRotation, renderTime - thrown.releaseTime, t,
+                          targetPosition, targetRotation, position, rotation);
+        return true;
+    }
+
+    // A spinning saber can turn more than half a turn between the poses we get, most of all
+    // when one is lost, and the shortest path between them then spins it backwards. Picks the
+    // turn about the same axis, either way round, closest to what its spin so far predicts.
+    static Math::Vec3 Unwrap(Math::Vec3 turn, Math::Vec3 expected) {
+        float angle = Math::Magnitude(turn);
+        if (angle < 1e-4f) {
+            return turn;
+        }
+        Math::Vec3 axis = turn / angle;
+        float along = Math::Dot(expected, axis);
+        float best = angle;
+        for (float candidate : {angle - 2.0f * Math::PI, angle + 2.0f * Math::PI}) {
+            if (std::abs(candidate - along) < std::abs(best - along)) {
+                best = candidate;
+            }
+        }
+        return axis * best;
+    }
+
+    static bool Blendable(PoseSample const& a, PoseSample const& b) {
+        return a.space == b.space && b.time - a.time > 1e-4f && b.time - a.time <= MAX_SAMPLE_GAP;
+    }
+
+    bool RemoteSaber::Sample(float renderTime, Math::Vec3& position, Math::Quat& rotation, uint8_t& space) const {
+        if (!known || renderTime >= stillSince) {
+            return false;
+        }
+        if (SampleFlight(flight, renderTime, position, rotation) || SampleFlight(previousFlight, renderTime, position, rotation)) {
+            space = 1;  // PoseSpace::World
+            return true;
+        }
+        if (size == 0) {
+            return false;
+        }
+
+        // Newest received pose at or before renderTime
+        int age = 0;
+        while (age < size - 1 && At(age).time > renderTime) {
+            age++;
+        }
+        PoseSample const& a = At(age);
+        space = a.space;
+        if (a.time > renderTime) {
+            // Older than anything kept
+            position = a.position;
+            rotation = a.rotation;
+            return true;
+        }
+
+        if (age > 0 && Blendable(a, At(age - 1))) {
+            PoseSample const& b = At(age - 1);
+            float t = (renderTime - a.time) / (b.time - a.time);
+            position = Math::Lerp(a.position, b.position, t);
+            Math::Vec3 turn = Math::ToRotationVector(b.rotation * Math::Inverse(a.rotation));
+            if (age + 1 < size && Blendable(At(age + 1), a)) {
+                PoseSample const& p = At(age + 1);
+                Math::Vec3 expected = Math::ToRotationVector(a.rotation * Math::Inverse(p.rotation)) * ((b.time - a.time) / (a.time - p.time));
+                turn = Unwrap(turn, expected);
+            }
+            rotation = Math::Normalized(Math::FromAngularVelocity(turn, t) * a.rotation);
+            return true;
+        }
+
+        // Nothing after a to blend towards (past the newest pose, or the next one is in the
+        // other space): carry on at the velocity a arrived with
+        position = a.position;
+        rotation = a.rotation;
+        if (age + 1 < size && Blendable(At(age + 1), a)) {
+            PoseSample const& p = At(age + 1);
+            float span = a.time - p.time;
+            float ahead = std::min(renderTime - a.time, MAX_EXTRAPOLATION);
+            position = a.position + (a.position - p.position) * (ahead / span);
+            Math::Vec3 omega = Math::ToRotationVector(a.rotation * Math::Inverse(p.rotation)) / span;
+            rotation = Math::Normalized(Math::FromAngularVelocity(omega, ahead) * a.rotation);
+        }
+        return true;
+    }
+
+}  // namespace TrickSaber::Replication
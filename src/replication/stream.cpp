@@ -0,0 +1,281 @@
+#include "replication/stream.hpp"
+
+#include <algorithm>
+
+namespace TrickSaber::Replication {
+
+    using Saber::SaberInteractionState;
+
+    static constexpr uint8_t STATE_MASK = 0x03;
+    static constexpr uint8_t STATE_SPIN = 1 << 2;
+    static constexpr uint8_t STATE_HAND = 1 << 3;
+    static constexpr uint8_t STATE_TRAJECTORY = 1 << 4;
+    static constexpr uint8_t NO_STATE = 0xFF;
+
+    static uint8_t StateByte(SaberFrame const& frame) {
+        return static_cast<uint8_t>(static_cast<uint8_t>(frame.state) | (frame.spinActive ? STATE_SPIN : 0) |
+                                    (frame.hand ? STATE_HAND : 0));
+    }
+
+    static uint32_t Millis(float seconds) {
+        return static_cast<uint32_t>(std::lround(std::max(seconds, 0.0f) * 1000.0f));
+    }
+
+    static bool ReturnsToTarget(SaberFrame const& frame) {
+        return frame.state == SaberInteractionState::Returning && frame.trajectory && frame.returnDuration > 0.0f;
+    }
+
+    static void Count(PeerStats& stats, int size, float time) {
+        if (stats.packets == 0) {
+            stats.firstTime = time;
+        }
+        stats.packets++;
+        stats.bytes += static_cast<uint64_t>(size);
+        stats.lastTime = time;
+    }
+
+    // --- Encoder ---
+
+    void StreamEncoder::SetRate(int packetsPerSecond) {
+        rate = std::clamp(packetsPerSecond, 1, 120);
+    }
+
+    void StreamEncoder::Reset() {
+        nextPoseTime = 0.0f;
+        periodsSinceKey = KEY_INTERVAL;
+        sentCount = -1;
+        for (int i = 0; i < MAX_REPLICATED_SABERS; i++) {
+            sentState[i] = NO_STATE;
+            stateRepeats[i] = 0;
+        }
+    }
+
+    int StreamEncoder::Encode(float now, SaberFrame const* frames, int count, uint8_t* out) {
+        count = std::min(count, MAX_REPLICATED_SABERS);
+        float period = 1.0f / static_cast<float>(rate);
+        bool poseDue = now >= nextPoseTime;
+        if (poseDue) {
+            // Keep the cadence through jittery ticks, restart it after a stall
+            nextPoseTime = now - nextPoseTime < period ? nextPoseTime + period : now + period;
+            periodsSinceKey++;
+        }
+        bool key = poseDue && periodsSinceKey >= KEY_INTERVAL;
+
+        uint8_t stateBytes[MAX_REPLICATED_SABERS];
+        bool stateDue = count != sentCount;
+        bool anyPose = false;
+        bool anyRepeat = false;
+        for (int i = 0; i < count; i++) {
+            stateBytes[i] = StateByte(frames[i]);
+            stateDue |= stateBytes[i] != sentState[i];
+            anyPose |= frames[i].hasPose;
+            anyRepeat |= stateRepeats[i] > 0;
+        }
+        if (!stateDue && !key && !(poseDue && (anyPose || anyRepeat))) {
+            return 0;
+        }
+        if (key) {
+            periodsSinceKey = 0;
+        }
+
+        uint8_t* p = out;
+        *p++ = PACKET_VERSION;
+        p = WriteU16(p, sequence++);
+        p = Recording::WriteU32(p, static_cast<uint32_t>(std::lround(now * 1000.0f)));
+        *p++ = static_cast<uint8_t>(count);
+        uint8_t* recordCount = p++;
+        int records = 0;
+
+        for (int i = 0; i < count; i++) {
+            SaberFrame const& frame = frames[i];
+            bool changed = stateBytes[i] != sentState[i];
+            bool repeat = !changed && stateRepeats[i] > 0;
+            if (changed) {
+                stateRepeats[i] = STATE_REPEATS;
+            } else if (repeat) {
+                stateRepeats[i]--;
+            }
+            if (changed || key || repeat) {
+                bool withTrajectory = frame.state != SaberInteractionState::Held && frame.trajectory;
+                *p++ = RecordHead(i, RecordKind::State, 0, 0);
+                *p++ = static_cast<uint8_t>(stateBytes[i] | (withTrajectory ? STATE_TRAJECTORY : 0));
+                if (withTrajectory) {
+                    Math::ThrowTrajectory const& trajectory = *frame.trajectory;
+                    p = WriteVec(p, trajectory.Origin(), POSITION_SCALE);
+                    p = Recording::WriteU32(p, Recording::PackQuat(trajectory.OriginRotation()));
+                    p = WriteVec(p, trajectory.Velocity(), VELOCITY_SCALE);
+                    p = WriteVec(p, trajectory.AngularVelocity(), ANGULAR_VELOCITY_SCALE);
+                    p = Recording::WriteVarint(p, Millis(frame.flightTime));
+                }
+                sentState[i] = stateBytes[i];
+                records++;
+            }
+
+            if (frame.hasPose && (poseDue || changed)) {
+                RecordKind kind = ReturnsToTarget(frame) ? RecordKind::Target : RecordKind::Pose;
+                *p++ = RecordHead(i, kind, frame.space, static_cast<uint8_t>(frame.state));
+                p = WriteVec(p, frame.position, POSITION_SCALE);
+                p = Recording::WriteU32(p, Recording::PackQuat(frame.rotation));
+                if (kind == RecordKind::Target) {
+                    p = Recording::WriteVarint(p, Millis(frame.returnTime));
+                    p = Recording::WriteVarint(p, Millis(frame.returnDuration));
+                    *p++ = frame.returnStyle;
+                }
+                records++;
+            }
+        }
+        for (int i = count; i < MAX_REPLICATED_SABERS; i++) {
+            sentState[i] = NO_STATE;
+            stateRepeats[i] = 0;
+        }
+        sentCount = count;
+        *recordCount = static_cast<uint8_t>(records);
+
+        int size = static_cast<int>(p - out);
+        Count(stats, size, now);
+        return size;
+    }
+
+    // --- Decoder ---
+
+    void RemotePeer::Clear() {
+        *this = RemotePeer();
+    }
+
+    namespace {
+        struct ParsedRecord {
+            uint8_t slot;
+            RecordKind kind;
+            uint8_t space;
+            uint8_t poseState;
+            uint8_t stateByte;
+            Math::Vec3 position;
+            Math::Quat rotation;
+            Math::Vec3 velocity;
+            Math::Vec3 angularVelocity;
+            float flightTime;
+            float returnDuration;
+            float returnTime;
+            uint8_t returnStyle;
+        };
+    }
+
+    static uint8_t const* ParseRecord(uint8_t const* p, uint8_t const* end, int count, ParsedRecord& record) {
+        uint8_t head;
+        if (!(p = ReadU8(p, end, head))) {
+            return nullptr;
+        }
+        record.slot = head & 0x07;
+        record.kind = static_cast<RecordKind>((head >> 3) & 0x03);
+        record.space = (head >> 5) & 0x01;
+        record.poseState = head >> 6;
+        if (record.slot >= count || record.kind > RecordKind::Target ||
+            record.poseState > static_cast<uint8_t>(SaberInteractionState::Returning)) {
+            return nullptr;
+        }
+
+        uint32_t raw;
+        if (record.kind != RecordKind::State) {
+            if (!(p = ReadVec(p, end, record.position, POSITION_SCALE)) || !(p = Recording::ReadU32(p, end, raw))) {
+                return nullptr;
+            }
+            record.rotation = Recording::UnpackQuat(raw);
+            if (record.kind == RecordKind::Target) {
+                uint32_t duration;
+                if (!(p = Recording::ReadVarint(p, end, raw)) || !(p = Recording::ReadVarint(p, end, duration)) ||
+                    !(p = ReadU8(p, end, record.returnStyle))) {
+                    return nullptr;
+                }
+                record.returnTime = static_cast<float>(raw) / 1000.0f;
+                record.returnDuration = static_cast<float>(duration) / 1000.0f;
+            }
+            return p;
+        }
+
+        if (!(p = ReadU8(p, end, record.stateByte)) || (record.stateByte & STATE_MASK) > static_cast<uint8_t>(SaberInteractionState::Returning)) {
+            return nullptr;
+        }
+        if (record.stateByte & STATE_TRAJECTORY) {
+            if (!(p = ReadVec(p, end, record.position, POSITION_SCALE)) ||
+                !(p = Recording::ReadU32(p, end, raw)) ||
+                !(p = ReadVec(p, end, record.velocity, VELOCITY_SCALE)) ||
+                !(p = ReadVec(p, end, record.angularVelocity, ANGULAR_VELOCITY_SCALE))) {
+                return nullptr;
+            }
+            record.rotation = Recording::UnpackQuat(raw);
+            if (!(p = Recording::ReadVarint(p, end, raw))) {
+                return nullptr;
+            }
+            record.flightTime = static_cast<float>(raw) / 1000.0f;
+        }
+        return p;
+    }
+
+    bool Decode(uint8_t const* data, int size, RemotePeer& peer) {
+        uint8_t const* p = data;
+        uint8_t const* end = data + size;
+        uint8_t version, count, recordCount;
+        uint16_t sequence;
+        uint32_t timeMs;
+        if (!(p = ReadU8(p, end, version)) || version != PACKET_VERSION ||
+            !(p = ReadU16(p, end, sequence)) ||
+            !(p = Recording::ReadU32(p, end, timeMs)) ||
+            !(p = ReadU8(p, end, count)) || count > MAX_REPLICATED_SABERS ||
+            !(p = ReadU8(p, end, recordCount)) || recordCount > MAX_RECORDS) {
+            peer.stats.malformed++;
+            return false;
+        }
+        if (peer.started && !SequenceAfter(sequence, peer.lastSequence)) {
+            peer.stats.late++;
+            return false;
+        }
+
+        // Parse everything before applying anything, so a bad packet changes nothing
+        ParsedRecord records[MAX_RECORDS];
+        for (int r = 0; r < recordCount; r++) {
+            if (!(p = ParseRecord(p, end, count, records[r]))) {
+                peer.stats.malformed++;
+                return false;
+            }
+        }
+        if (p != end) {
+            peer.stats.malformed++;
+            return false;
+        }
+
+        float time = static_cast<float>(timeMs) / 1000.0f;
+        if (peer.started) {
+            peer.stats.lost += static_cast<uint16_t>(sequence - peer.lastSequence - 1);
+        }
+        Count(peer.stats, size, time);
+        peer.started = true;
+        peer.lastSequence = sequence;
+
+        for (int i = count; i < peer.count; i++) {
+            peer.sabers[i].Clear();
+        }
+        peer.count = count;
+        peer.newestTime = time;
+
+        for (int r = 0; r < recordCount; r++) {
+            ParsedRecord const& record = records[r];
+            RemoteSaber& saber = peer.sabers[record.slot];
+            if (record.kind == RecordKind::State) {
+                saber.OnState(time, static_cast<SaberInteractionState>(record.stateByte & STATE_MASK),
+                              record.stateByte & STATE_SPIN, record.stateByte & STATE_HAND ? 1 : 0);
+                if (record.stateByte & STATE_TRAJECTORY) {
+                    saber.OnTrajectory(time - record.flightTime,
+                                       Math::ThrowTrajectory(record.position, record.rotation, record.velocity, record.angularVelocity));
+                }
+            } else {
+                saber.OnPoseState(time, static_cast<SaberInteractionState>(record.poseState));
+                if (record.kind == RecordKind::Target) {
+                    saber.OnReturn(time - record.returnTime, record.returnDuration, record.returnStyle);
+                }
+                saber.OnPose(time, record.space, record.position, record.rotation, record.kind == RecordKind::Target);
+            }
+        }
+        return true;
+    }
+
+}  // namespace TrickSaber::Replication
@@ -0,0 +1,79 @@
+#include "saber/pose-writer.hpp"
+#include "saber/transform-icalls.hpp"
+
+#include <cmath>
+
+namespace TrickSaber::Saber {
+
+    // 0.01 mm and ~0.05 degrees; well under anything visible on a headset.
+    static constexpr float POSITION_EPSILON_SQR = 1e-10f;
+    static constexpr float ROTATION_DOT_EPSILON = 1e-7f;
+
+    static PoseWriteStats stats;
+    static uint64_t issuedThisWindow = 0;
+    static uint64_t elidedThisWindow = 0;
+    static float windowTime = 0.0f;
+
+    void PoseWriter::SetLocal(Math::Vec3 position, Math::Quat rotation) {
+        pendingPosition = position;
+        pendingRotation = rotation;
+        pendingSpace = PoseSpace::Local;
+        dirty = true;
+    }
+
+    void PoseWriter::SetWorld(Math::Vec3 position, Math::Quat rotation) {
+        pendingPosition = position;
+        pendingRotation = rotation;
+        pendingSpace = PoseSpace::World;
+        dirty = true;
+    }
+
+    void PoseWriter::Invalidate() {
+        writtenValid = false;
+    }
+
+    bool PoseWriter::Flush(UnityEngine::Transform* transform) {
+        if (!dirty) {
+            return false;
+        }
+        dirty = false;
+
+        if (writtenValid && writtenSpace == pendingSpace &&
+            Math::SqrMagnitude(pendingPosition - writtenPosition) < POSITION_EPSILON_SQR &&
+            1.0f - std::abs(Math::Dot(pendingRotation, writtenRotation)) < ROTATION_DOT_EPSILON) {
+            elidedThisWindow++;
+            stats.elided++;
+            return false;
+        }
+
+        if (pendingSpace == PoseSpace::Local) {
+            SetLocalPose(transform, pendingPosition, pendingRotation);
+        } else {
+            SetWorldPose(transform, pendingPosition, pendingRotation);
+        }
+        writtenPosition = pendingPosition;
+        writtenRotation = pendingRotation;
+        writtenSpace = pendingSpace;
+        writtenValid = true;
+        issuedThisWindow++;
+        stats.issued++;
+        return true;
+    }
+
+    void TickPoseWriteStats(float deltaTime) {
+        windowTime += deltaTime;
+        if (windowTime < 1.0f) {
+            return;
+        }
+        stats.issuedPerSecond = issuedThisWindow / windowTime;
+        stats.elidedPerSecond = elidedThisWindow / windowTime;
+        issuedThisWindow = 0;
+        elidedThisWindow = 0;
+        windowTime = 0.0f;
+    }
+
+    PoseWriteStats const& GetPoseWriteStats() {
+        return stats;
+    }
+
+}  // namespace TrickSaber::Saber
@@ -0,0 +1,110 @@
+#include "saber/state-store.hpp"
+
+namespace TrickSaber::Saber {
+
+    static SaberStateStore store;
+
+    SaberStateStore& GetSaberStateStore() {
+        return store;
+    }
+
+    int SaberStateStore::Find(UnityEngine::Transform* saberTransform) {
+        for (int i = 0; i < count; i++) {
+            if (cold[i].saberTransform.ptr() == saberTransform) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    int SaberStateStore::FindOrAdd(UnityEngine::Transform* saberTransform) {
+        int existing = Find(saberTransform);
+        if (existing >= 0) {
+            return existing;
+        }
+        if (count >= MAX_SABERS) {
+            return -1;
+        }
+        int slot = count++;
+        cold[slot] = SaberColdData();
+        cold[slot].saberTransform = saberTransform;
+        for (uint64_t* mask : {&saberAlive, &parentAlive, &handAlive, &attached, &autoRecalled}) {
+            *mask &= ~Bit(slot);
+        }
+        ResetHot(slot);
+        return slot;
+    }
+
+    void SaberStateStore::ResetHot(int slot) {
+        state[slot] = SaberInteractionState::Held;
+        spinActive[slot] = false;
+        throwPressedLastFrame[slot] = false;
+        spinAngle[slot] = 0.0f;
+        returnTime[slot] = 0.0f;
+        handMotion[slot].Reset();
+        trajectory[slot] = Math::ThrowTrajectory();
+        flightTime[slot] = 0.0f;
+        poseWriter[slot].Invalidate();
+        sweptFrame[slot] = -1;
+    }
+
+    void SaberStateStore::ValidateHandles() {
+        uint64_t saber = 0, parent = 0, hand = 0;
+        for (int i = 0; i < count; i++) {
+            if (IsAlive(cold[i].saberTransform)) saber |= Bit(i);
+            bool parentOk = IsAlive(cold[i].originalParent);
+            if (parentOk) parent |= Bit(i);
+            // The hand is the original parent unless another mod set things up differently
+            bool sameObject = parentOk && cold[i].handTransform.ptr() == cold[i].originalParent.ptr();
+            if (sameObject ? parentOk : IsAlive(cold[i].handTransform)) hand |= Bit(i);
+        }
+        saberAlive = saber;
+        parentAlive = parent;
+        handAlive = hand;
+    }
+
+    void SaberStateStore::InvalidateHandles() {
+        saberAlive = 0;
+        parentAlive = 0;
+        handAlive = 0;
+    }
+
+    // Moves bit from into bit to and clears from; just clears it when they are the same.
+    static void MoveBit(uint64_t& mask, int from, int to) {
+        uint64_t moved = (mask >> from) & 1ull;
+        mask &= ~(SaberStateStore::Bit(from) | SaberStateStore::Bit(to));
+        if (from != to) {
+            mask |= moved << to;
+        }
+    }
+
+    void SaberStateStore::Remove(int slot) {
+        int last = --count;
+        for (uint64_t* mask : {&saberAlive, &parentAlive, &handAlive, &attached, &autoRecalled}) {
+            MoveBit(*mask, last, slot);
+        }
+        if (slot == last) {
+            cold[last] = SaberColdData();
+            return;
+        }
+        state[slot] = state[last];
+        spinActive[slot] = spinActive[last];
+        throwPressedLastFrame[slot] = throwPressedLastFrame[last];
+        spinAngle[slot] = spinAngle[last];
+        returnTime[slot] = returnTime[last];
+        handPosition[slot] = handPosition[last];
+        handMotion[slot] = handMotion[last];
+        trajectory[slot] = trajectory[last];
+        flightTime[slot] = flightTime[last];
+        releasePosition[slot] = releasePosition[last];
+        releaseRotation[slot] = releaseRotation[last];
+        poseWriter[slot] = poseWriter[last];
+        motionTime[slot] = motionTime[last];
+        sweptPosition[slot] = sweptPosition[last];
+        sweptRotation[slot] = sweptRotation[last];
+        sweptFrame[slot] = sweptFrame[last];
+        cold[slot] = cold[last];
+        cold[last] = SaberColdData();
+    }
+
+}  // namespace TrickSaber::Saber
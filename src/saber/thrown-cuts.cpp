@@ -0,0 +1,92 @@
+#include "saber/thrown-cuts.hpp"
+
+namespace TrickSaber::Saber {
+
+    using Math::CutTargets;
+    using Math::Vec3;
+
+    static CutTargets buffers[2];
+    static CutTargets const empty{};
+    static int current = 0;
+    static int currentFrame = -1;
+    static int previousFrame = -1;
+    static bool carried = false;          // Current buffer moved on a frame by CutTargetsFor()
+    static bool previousCarried = false;
+    static int cursor = 0;                // Where in the previous buffer the next match is looked for
+
+    static CutTargets& Begin(int frame) {
+        if (frame != currentFrame) {
+            previousFrame = currentFrame;
+            previousCarried = carried;
+            current ^= 1;
+            buffers[current].Clear();
+            currentFrame = frame;
+            carried = false;
+            cursor = 0;
+        }
+        return buffers[current];
+    }
+
+    // How far owner moved since the last frame's report, or nothing if it was not reported.
+    static Vec3 Moved(void* owner, Vec3 center, int frame) {
+        if (previousFrame != frame - 1) {
+            return Math::Zero();
+        }
+        CutTargets const& previous = buffers[current ^ 1];
+        for (int n = 0; n < previous.count; n++) {
+            int j = cursor + n < previous.count ? cursor + n : cursor + n - previous.count;
+            if (previous.handle[j] != owner) {
+                continue;
+            }
+            cursor = j + 1;
+            Vec3 before = previous.Center(j);
+            if (previousCarried) {
+                before = before - Vec3{previous.dx[j], previous.dy[j], previous.dz[j]};
+            }
+            Vec3 moved = center - before;
+            return Math::SqrMagnitude(moved) <= MAX_TARGET_STEP * MAX_TARGET_STEP ? moved : Math::Zero();
+        }
+        return Math::Zero();
+    }
+
+    void AddCutTarget(void* owner, Math::CutTargetKind kind, Vec3 center, int frame) {
+        CutTargets& targets = Begin(frame);
+        float radius = kind == Math::CutTargetKind::Bomb ? BOMB_HIT_RADIUS : NOTE_CUT_RADIUS;
+        targets.AddSphere(owner, kind, center, Moved(owner, center, frame), radius);
+    }
+
+    void AddObstacleTarget(void* owner, Vec3 center, Math::Quat rotation, Vec3 halfExtents, int frame) {
+        CutTargets& targets = Begin(frame);
+        targets.AddBox(owner, center, rotation, halfExtents, Moved(owner, center, frame));
+    }
+
+    CutTargets const& CutTargetsFor(int frame) {
+        if (currentFrame == frame) {
+            return buffers[current];
+        }
+        if (currentFrame != frame - 1) {
+            return empty;
+        }
+        CutTargets& targets = buffers[current];
+        if (!carried) {
+            for (int i = 0; i < targets.count; i++) {
+                targets.cx[i] += targets.dx[i];
+                targets.cy[i] += targets.dy[i];
+                targets.cz[i] += targets.dz[i];
+            }
+            carried = true;
+        }
+        return targets;
+    }
+
+    void ClearCutTargets() {
+        buffers[0].Clear();
+        buffers[1].Clear();
+        currentFrame = -1;
+        previousFrame = -1;
+        carried = false;
+        previousCarried = false;
+        cursor = 0;
+    }
+
+}  // namespace TrickSaber::Saber
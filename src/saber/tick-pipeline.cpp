@@ -0,0 +1,178 @@
+#include "saber/tick-pipeline.hpp"
+#include "input/bindings.hpp"
+#include "perf/timers.hpp"
+#include "perf/trace.hpp"
+
+#include <algorithm>
+
+namespace TrickSaber::Saber {
+
+    // The trick machine's IO for a gathered tick: reads come from the input, and writes and
+    // events go to the output for the main thread to apply.
+    struct DeferredTrickIO {
+        SaberTickInput const& in;
+        SaberTickOutput& out;
+
+        bool ThrowPressed() { return in.actions & Input::ActionBit(Input::Throw); }
+        bool SpinPressed() { return in.actions & Input::ActionBit(Input::Spin); }
+
+        Math::Vec3 SaberPosition() { return in.saberPosition; }
+        Math::Quat SaberRotation() { return in.saberRotation; }
+
+        void Detach() { out.detach = true; }
+
+        bool Reattach() {
+            if ((in.attached && !out.detach) || out.reattach) {
+                return false;
+            }
+            out.reattach = true;
+            return true;
+        }
+
+        Math::Vec3 HandPointToWorld(Math::Vec3) { return in.handRestPoint; }  // Only ever asked for the rest position
+        Math::Quat HandRotation() { return in.handRotation; }
+
+        void SetLocal(Math::Vec3 position, Math::Quat rotation) { SetPose(position, rotation, false); }
+        void SetWorld(Math::Vec3 position, Math::Quat rotation) { SetPose(position, rotation, true); }
+
+        template <Log::Level L>
+        void Emit(Log::Event event, float value = 0.0f) {
+            if (out.eventCount < MAX_TICK_EVENTS) {
+                out.events[out.eventCount++] = {event, L, value};
+            }
+        }
+
+    private:
+        void SetPose(Math::Vec3 position, Math::Quat rotation, bool world) {
+            out.hasPose = true;
+            out.world = world;
+            out.position = position;
+            out.rotation = rotation;
+        }
+    };
+
+    static void ComputeSlots(TickJob& job, TrickHotState& s, int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            s.handMotion[i].Push(job.timeNs, s.handPosition[i]);
+            SaberTickInput const& in = job.input[i];
+            SaberTickOutput& out = job.output[i];
+            out.stateBefore = s.state[i];
+            out.buttonEdge = out.detach = out.reattach = out.hasPose = false;
+            out.eventCount = 0;
+            out.computeNs = 0;
+            if (!in.ready) {
+                continue;
+            }
+            uint64_t start = Perf::NowNs();
+            TS_TRACE_SCOPE(Trace::Span::StateApply, i);
+            DeferredTrickIO io{in, out};
+            out.buttonEdge = TickTrick(s, i, in.rest, in.tuning, in.deltaTime, io);
+            out.computeNs = Perf::NowNs() - start;
+        }
+    }
+
+    static constexpr uint64_t ClaimWord(uint32_t tick, int chunks, int next) {
+        return static_cast<uint64_t>(tick) << 32 | static_cast<uint64_t>(chunks) << 16 | static_cast<uint64_t>(next);
+    }
+
+    void TickPipeline::Publish(TrickHotState& hot, bool threaded) {
+        TickJob& job = jobs[gathering];
+        gathering ^= 1;
+        int chunks = (job.count + SABERS_PER_CHUNK - 1) / SABERS_PER_CHUNK;
+        job.done.store(0, std::memory_order_relaxed);
+        job.publishedNs = Perf::NowNs();
+        published = &job;
+        state = &hot;
+        waiting = true;
+        inlineSabers = 0;
+        tick++;
+        if (!threaded || chunks == 0) {
+            ComputeSlots(job, hot, 0, job.count);
+            job.done.store(chunks, std::memory_order_relaxed);
+            claim.store(ClaimWord(tick, chunks, chunks), std::memory_order_relaxed);
+            return;
+        }
+        EnsureWorkers(chunks);
+        // Everything above is visible to a worker whose claim on this word succeeds
+        claim.store(ClaimWord(tick, chunks, 0), std::memory_order_release);
+        wake.fetch_add(1, std::memory_order_release);
+        if (chunks > 1) {
+            wake.notify_all();
+        } else {
+            wake.notify_one();
+        }
+    }
+
+    TickJob* TickPipeline::Finish() {
+        if (!waiting) {
+            return nullptr;
+        }
+        TickJob& job = *published;
+        int chunks = static_cast<int>(claim.load(std::memory_order_relaxed) >> 16 & 0xffff);
+        if (job.done.load(std::memory_order_acquire) < chunks) {
+            // Past the deadline: what no worker has started runs here
+            inlineSabers = RunChunks();
+            while (job.done.load(std::memory_order_acquire) < chunks) {
+                std::this_thread::yield();
+            }
+        }
+        waiting = false;
+        return &job;
+    }
+
+    int TickPipeline::RunChunks() {
+        int sabers = 0;
+        uint64_t current = claim.load(std::memory_order_acquire);
+        for (;;) {
+            int chunks = static_cast<int>(current >> 16 & 0xffff);
+            int next = static_cast<int>(current & 0xffff);
+            if (next >= chunks) {
+                return sabers;
+            }
+            if (!claim.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                continue;
+            }
+            // Claimed: the job cannot finish, and so cannot change, until this chunk is done
+            TickJob& job = *published;
+            int begin = next * SABERS_PER_CHUNK;
+            int end = std::min(begin + SABERS_PER_CHUNK, job.count);
+            ComputeSlots(job, *state, begin, end);
+            sabers += end - begin;
+            job.done.fetch_add(1, std::memory_order_release);
+            current++;
+        }
+    }
+
+    void TickPipeline::EnsureWorkers(int chunks) {
+        stopping.store(false, std::memory_order_relaxed);
+        for (int wanted = std::min(chunks, MAX_TICK_WORKERS); workerCount < wanted; workerCount++) {
+            // From the wake count before this tick's, so a worker that starts late still sees it
+            workers[workerCount] = std::thread([this, seen = wake.load(std::memory_order_relaxed)] { WorkerLoop(seen); });
+        }
+    }
+
+    void TickPipeline::WorkerLoop(uint32_t seen) {
+        for (;;) {
+            wake.wait(seen, std::memory_order_acquire);
+            seen = wake.load(std::memory_order_acquire);
+            if (stopping.load(std::memory_order_acquire)) {
+                return;
+            }
+            RunChunks();
+        }
+    }
+
+    void TickPipeline::Stop() {
+        if (workerCount == 0) {
+            return;
+        }
+        stopping.store(true, std::memory_order_release);
+        wake.fetch_add(1, std::memory_order_release);
+        wake.notify_all();
+        for (int i = 0; i < workerCount; i++) {
+            workers[i].join();
+        }
+        workerCount = 0;
+    }
+
+}  // namespace TrickSaber::Saber
@@ -0,0 +1,207 @@
+#include "saber/transform-icalls.hpp"
+#include "logger.hpp"
+#include "perf/timers.hpp"
+
+#include "UnityEngine/GameObject.hpp"
+#include "UnityEngine/Object.hpp"
+#include "beatsaber-hook/shared/utils/il2cpp-functions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace TrickSaber::Saber {
+
+    using Math::Quat;
+    using Math::Vec3;
+
+    static TransformICalls found = {};  // Resolved but not yet checked
+
+    template <typename Fn>
+    static void Resolve(Fn& entry, char const* name) {
+        entry = reinterpret_cast<Fn>(il2cpp_functions::resolve_icall(name));
+        if (!entry) {
+            getLogger().warn("[TS] [ICall] {} not found, using its wrapper", name);
+        }
+    }
+
+    void ResolveTransformICalls() {
+        transformICalls = {};
+        Resolve(found.getPosition, "UnityEngine.Transform::get_position_Injected(UnityEngine.Vector3&)");
+        Resolve(found.getRotation, "UnityEngine.Transform::get_rotation_Injected(UnityEngine.Quaternion&)");
+        Resolve(found.transformPoint, "UnityEngine.Transform::TransformPoint_Injected(UnityEngine.Vector3&,UnityEngine.Vector3&)");
+        Resolve(found.setParent, "UnityEngine.Transform::SetParent(UnityEngine.Transform,System.Boolean)");
+        Resolve(found.setPositionAndRotation,
+            "UnityEngine.Transform::SetPositionAndRotation_Injected(UnityEngine.Vector3&,UnityEngine.Quaternion&)");
+        Resolve(found.setLocalPositionAndRotation,
+            "UnityEngine.Transform::SetLocalPositionAndRotation_Injected(UnityEngine.Vector3&,UnityEngine.Quaternion&)");
+    }
+
+    // --- Self-test ---
+    // A child under a moved, rotated and unevenly scaled parent, so every call has a real
+    // transform to apply. Every check reads back through the wrappers.
+    static constexpr Vec3 PARENT_POSITION = {1.5f, -0.25f, 3.0f};
+    static constexpr Quat PARENT_ROTATION = {0.18257f, 0.36515f, 0.54772f, 0.73030f};
+    static constexpr Vec3 PARENT_SCALE = {1.25f, 0.8f, 1.1f};
+    static constexpr Vec3 CHILD_POSITION = {0.1f, 0.2f, -0.3f};
+    static constexpr Quat CHILD_ROTATION = {0.5f, -0.5f, 0.5f, 0.5f};
+    static constexpr Vec3 TEST_POINT = {0.3f, -1.0f, 2.0f};
+    static constexpr Vec3 TEST_POSITION = {-0.4f, 1.2f, 0.7f};
+    static constexpr Quat TEST_ROTATION = {0.0f, 0.70711f, 0.0f, 0.70711f};
+
+    static constexpr int TIMING_ROUNDS = 16;
+    static constexpr int CALLS_PER_ROUND = 256;
+
+    struct Scratch {
+        UnityEngine::Transform* parent;
+        UnityEngine::Transform* child;
+    };
+
+    static bool Near(Vec3 a, Vec3 b) { return Math::SqrMagnitude(a - b) < 1e-10f; }
+    static bool Near(Quat a, Quat b) { return 1.0f - std::abs(Math::Dot(a, b)) < 1e-6f; }
+
+    static void ResetChild(Scratch& s) {
+        s.child->SetParent(s.parent, false);
+        s.child->SetLocalPositionAndRotation(Math::ToUnity(CHILD_POSITION), Math::ToUnity(CHILD_ROTATION));
+    }
+
+    static bool CheckGetPosition(Scratch& s) {
+        UnityEngine::Vector3 result;
+        found.getPosition(s.child, &result);
+        return Near(Math::FromUnity(result), Math::FromUnity(s.child->get_position()));
+    }
+
+    static bool CheckGetRotation(Scratch& s) {
+        UnityEngine::Quaternion result;
+        found.getRotation(s.child, &result);
+        return Near(Math::FromUnity(result), Math::FromUnity(s.child->get_rotation()));
+    }
+
+    static bool CheckTransformPoint(Scratch& s) {
+        UnityEngine::Vector3 point = Math::ToUnity(TEST_POINT);
+        UnityEngine::Vector3 result;
+        found.transformPoint(s.child, &point, &result);
+        return Near(Math::FromUnity(result), Math::FromUnity(s.child->TransformPoint(Math::ToUnity(TEST_POINT))));
+    }
+
+    static bool CheckSetParent(Scratch& s) {
+        Vec3 world = Math::FromUnity(s.child->get_position());
+        found.setParent(s.child, nullptr, true);
+        bool detached = s.child->get_parent() == nullptr && Near(Math::FromUnity(s.child->get_position()), world);
+        found.setParent(s.child, s.parent, false);
+        return detached && s.child->get_parent() == s.parent;
+    }
+
+    static bool CheckSetPositionAndRotation(Scratch& s) {
+        UnityEngine::Vector3 position = Math::ToUnity(TEST_POSITION);
+        UnityEngine::Quaternion rotation = Math::ToUnity(TEST_ROTATION);
+        found.setPositionAndRotation(s.child, &position, &rotation);
+        Vec3 direct = Math::FromUnity(s.child->get_localPosition());
+        Quat directRotation = Math::FromUnity(s.child->get_localRotation());
+        ResetChild(s);
+        s.child->SetPositionAndRotation(position, rotation);
+        return Near(direct, Math::FromUnity(s.child->get_localPosition())) &&
+            Near(directRotation, Math::FromUnity(s.child->get_localRotation()));
+    }
+
+    static bool CheckSetLocalPositionAndRotation(Scratch& s) {
+        UnityEngine::Vector3 position = Math::ToUnity(TEST_POSITION);
+        UnityEngine::Quaternion rotation = Math::ToUnity(TEST_ROTATION);
+        found.setLocalPositionAndRotation(s.child, &position, &rotation);
+        return Near(Math::FromUnity(s.child->get_localPosition()), TEST_POSITION) &&
+            Near(Math::FromUnity(s.child->get_localRotation()), TEST_ROTATION);
+    }
+
+    // One call through the internal call and one through the wrapper, for timing.
+    static volatile float sink;
+
+    static void DirectGetPosition(Scratch& s) { sink = WorldPosition(s.child).x; }
+    static void WrapperGetPosition(Scratch& s) { sink = s.child->get_position().x; }
+    static void DirectGetRotation(Scratch& s) { sink = WorldRotation(s.child).w; }
+    static void WrapperGetRotation(Scratch& s) { sink = s.child->get_rotation().w; }
+    static void DirectTransformPoint(Scratch& s) { sink = PointToWorld(s.child, Math::ToUnity(TEST_POINT)).x; }
+    static void WrapperTransformPoint(Scratch& s) { sink = s.child->TransformPoint(Math::ToUnity(TEST_POINT)).x; }
+    static void DirectSetParent(Scratch& s) { SetParent(s.child, s.parent, false); }
+    static void WrapperSetParent(Scratch& s) { s.child->SetParent(s.parent, false); }
+    static void DirectSetPositionAndRotation(Scratch& s) { SetWorldPose(s.child, TEST_POSITION, TEST_ROTATION); }
+    static void WrapperSetPositionAndRotation(Scratch& s) {
+        s.child->SetPositionAndRotation(Math::ToUnity(TEST_POSITION), Math::ToUnity(TEST_ROTATION));
+    }
+    static void DirectSetLocalPositionAndRotation(Scratch& s) { SetLocalPose(s.child, TEST_POSITION, TEST_ROTATION); }
+    static void WrapperSetLocalPositionAndRotation(Scratch& s) {
+        s.child->SetLocalPositionAndRotation(Math::ToUnity(TEST_POSITION), Math::ToUnity(TEST_ROTATION));
+    }
+
+    struct Entry {
+        char const* name;
+        bool (*resolved)();
+        bool (*check)(Scratch&);
+        void (*promote)();
+        void (*direct)(Scratch&);
+        void (*wrapper)(Scratch&);
+    };
+
+#define TS_TRANSFORM_ICALL(field, Name, label)                                          \
+    {label, [] { return found.field != nullptr; }, Check##Name,                          \
+        [] { transformICalls.field = found.field; }, Direct##Name, Wrapper##Name}
+
+    static Entry const ENTRIES[] = {
+        TS_TRANSFORM_ICALL(getPosition, GetPosition, "get_position"),
+        TS_TRANSFORM_ICALL(getRotation, GetRotation, "get_rotation"),
+        TS_TRANSFORM_ICALL(transformPoint, TransformPoint, "TransformPoint"),
+        TS_TRANSFORM_ICALL(setParent, SetParent, "SetParent"),
+        TS_TRANSFORM_ICALL(setPositionAndRotation, SetPositionAndRotation, "SetPositionAndRotation"),
+        TS_TRANSFORM_ICALL(setLocalPositionAndRotation, SetLocalPositionAndRotation, "SetLocalPositionAndRotation"),
+    };
+
+#undef TS_TRANSFORM_ICALL
+
+    // Best round's ns per call, after a round to warm up.
+    static uint64_t TimeCalls(void (*call)(Scratch&), Scratch& s, Perf::Metric metric) {
+        uint64_t best = UINT64_MAX;
+        for (int round = 0; round <= TIMING_ROUNDS; round++) {
+            uint64_t start = Perf::NowNs();
+            for (int i = 0; i < CALLS_PER_ROUND; i++) {
+                call(s);
+            }
+            uint64_t perCall = (Perf::NowNs() - start) / CALLS_PER_ROUND;
+            if (round > 0) {
+                Perf::Record(metric, perCall);
+                best = std::min(best, perCall);
+            }
+        }
+        return best;
+    }
+
+    void SelfTestTransformICalls() {
+        UnityEngine::GameObject* parentObject = UnityEngine::GameObject::New_ctor("TrickSaberICallTest");
+        UnityEngine::GameObject* childObject = UnityEngine::GameObject::New_ctor("TrickSaberICallTestChild");
+        Scratch s{parentObject->get_transform(), childObject->get_transform()};
+        s.parent->SetPositionAndRotation(Math::ToUnity(PARENT_POSITION), Math::ToUnity(PARENT_ROTATION));
+        s.parent->set_localScale(Math::ToUnity(PARENT_SCALE));
+
+        int enabled = 0;
+        for (Entry const& entry : ENTRIES) {
+            if (!entry.resolved()) {
+                continue;
+            }
+            ResetChild(s);
+            if (!entry.check(s)) {
+                getLogger().warn("[TS] [ICall] {} disagrees with its wrapper, using the wrapper", entry.name);
+                continue;
+            }
+            entry.promote();
+            enabled++;
+            ResetChild(s);
+            uint64_t direct = TimeCalls(entry.direct, s, Perf::Metric::TransformICall);
+            ResetChild(s);
+            uint64_t wrapper = TimeCalls(entry.wrapper, s, Perf::Metric::TransformWrapper);
+            getLogger().info("[TS] [ICall] {}: {} ns direct, {} ns through the wrapper", entry.name, direct, wrapper);
+        }
+        getLogger().info("[TS] [ICall] {} of {} Transform calls go direct", enabled, sizeof(ENTRIES) / sizeof(ENTRIES[0]));
+
+        UnityEngine::Object::Destroy(childObject);
+        UnityEngine::Object::Destroy(parentObject);
+    }
+
+}  // namespace TrickSaber::Saber
@@ -0,0 +1,58 @@
+#include "saber/trick-machine.hpp"
+
+namespace TrickSaber::Saber {
+
+    using namespace Math;
+
+    static constexpr float MIN_NATURAL_ROTATION_RAD_PER_SEC = 3.14f;                 // Approx 0.5 RPS (base spin for any throw)
+    static constexpr float THROW_VELOCITY_TO_ROTATION_SCALE = 2.5f;                  // How much throw speed (m/s) contributes to rotation speed (rad/s).
+    static constexpr float MAX_NATURAL_ROTATION_FROM_VELOCITY_RAD_PER_SEC = 70.0f;   // Cap to prevent insane spins from velocity
+    static constexpr float MIN_THROW_SPEED_FOR_CROSS_PRODUCT_ROTATION = 0.2f;        // Min throw speed (m/s) to attempt cross-product rotation, else min spin.
+
+    void PushHandSamples(TrickHotState& s, uint64_t timeNs) {
+        for (int i = 0; i < s.count; i++) {
+            s.handMotion[i].Push(timeNs, s.handPosition[i]);
+        }
+    }
+
+    Vec3 ReleaseVelocity(TrickHotState const& s, int slot, Config::HandTuning const& tuning) {
+        if (tuning.peakReleaseWindow > 0.0f) {
+            return s.handMotion[slot].PeakLinearVelocity(VELOCITY_FIT_WINDOW, tuning.peakReleaseWindow);
+        }
+        return s.handMotion[slot].LinearVelocity(VELOCITY_FIT_WINDOW);
+    }
+
+    Vec3 ReturnAim(TrickHotState const& s, int slot, Vec3 targetPosition, float returnDuration) {
+        return PredictReturnTarget(targetPosition, s.handMotion[slot].LinearVelocity(VELOCITY_FIT_WINDOW),
+                                   returnDuration - s.returnTime[slot]);
+    }
+
+    Vec3 NaturalThrowAngularVelocity(Vec3 throwVelocityWorld, Vec3 saberForwardWorld, Log::Event& kind) {
+        float throwSpeedMagnitude = Magnitude(throwVelocityWorld);
+
+        if (throwSpeedMagnitude < 1.0f) { // Gentle throw -> Minimal
+            kind = Log::Event::GentleThrow;
+            return saberForwardWorld * (throwSpeedMagnitude * MIN_NATURAL_ROTATION_RAD_PER_SEC);
+        }
+
+        // Cross product to get a perpendicular spin axis
+        Vec3 naturalSpinAxisWorld = Cross(saberForwardWorld, Normalized(throwVelocityWorld));
+        if (SqrMagnitude(naturalSpinAxisWorld) < 0.1f) {
+            naturalSpinAxisWorld = saberForwardWorld;
+            kind = Log::Event::StraightThrow;
+        } else {
+            naturalSpinAxisWorld = Normalized(naturalSpinAxisWorld);
+            kind = Log::Event::NormalThrow;
+        }
+
+        float spinSpeedFromVelocity = std::min(throwSpeedMagnitude * THROW_VELOCITY_TO_ROTATION_SCALE, MAX_NATURAL_ROTATION_FROM_VELOCITY_RAD_PER_SEC);
+        return naturalSpinAxisWorld * (MIN_NATURAL_ROTATION_RAD_PER_SEC + spinSpeedFromVelocity);
+    }
+
+    void HeldSpinLocalPose(SaberRestPose const& rest, float zOffset, float angleDeg, Vec3& outPos, Quat& outRot) {
+        Vec3 pivotOffset = {0.0f, 0.0f, zOffset * rest.scale.z};
+        outRot = rest.rotation * AngleAxis(angleDeg, Right());
+        outPos = rest.position + rest.rotation * pivotOffset - outRot * pivotOffset;
+    }
+
+}  // namespace TrickSaber::Saber
@@ -1,6 +1,13 @@
 #include "settings/controller.hpp"
 #include "settings/config.hpp"
 #include "logger.hpp"
+#include "perf/timers.hpp"
+#include "perf/trace.hpp"
+#include "recording/recorder.hpp"
+#include "combo/library.hpp"
+#include "settings/presets.hpp"
+#include "settings/preset-limits.hpp"
+#include "settings/persistence.hpp"
 
 std::vector<std::string_view> TrickSaber::UI::RightControllerButtonChoices = {
     "None",
@@ -18,14 +25,59 @@ std::vector<std::string_view> TrickSaber::UI::LeftControllerButtonChoices = {
     "Left Grip"
 };
 
+std::vector<std::string_view> TrickSaber::UI::ComboChoices = [] {
+    std::vector<std::string_view> choices;
+    for (int id = 0; id < TrickSaber::Combo::ComboCount; id++) {
+        choices.push_back(TrickSaber::Combo::ComboName(id));
+    }
+    return choices;
+}();
+
+// Indexed by Math::ReturnCurve and Math::ReturnEasing
+std::vector<std::string_view> TrickSaber::UI::ReturnCurveChoices = {
+    "Straight",
+    "Arc",
+    "Curl"
+};
+
+std::vector<std::string_view> TrickSaber::UI::ReturnEasingChoices = {
+    "Linear",
+    "Ease In",
+    "Ease Out",
+    "Ease In-Out"
+};
+
 
 namespace TrickSaber::UI {
+    static std::string presetName;
+
+    // Applies a change at once; the config file catches up in the background.
+    template <typename Value, typename T>
+    static void Set(Value& value, T newValue) {
+        value.SetValue(newValue, false);
+        TrickSaber::Config::SaveLater();
+    }
+
+    // "2/5: Streaming", or why there is no such preset.
+    static std::string PresetLabel(int index = TrickSaber::Presets::Active()) {
+        char label[96];
+        int count = TrickSaber::Presets::Count();
+        if (index < 0 || index >= count) {
+            std::snprintf(label, sizeof(label), "No preset %d (%d saved)", index + 1, count);
+        } else {
+            std::snprintf(label, sizeof(label), "%d/%d: %s", index + 1, count, TrickSaber::Presets::Name(index).c_str());
+        }
+        return label;
+    }
+
     void SettingsViewControllerDidActivate(
         HMUI::ViewController* self,
         bool firstActivation,
         bool addedToHierarchy,
         bool screenSystemEnabling
     ) {
+        // A preset switched to from a controller chord reaches the config values here at the latest
+        TrickSaber::Presets::ApplyPending();
         if (!firstActivation) {
             return;
         }
@@ -39,7 +91,27 @@ namespace TrickSaber::UI {
 
         BSML::Lite::CreateToggle(parent, "Enable TriickSaber",
          getTrickSaberConfig().ModEnabled.GetValue(), [](bool value){
-            getTrickSaberConfig().ModEnabled.SetValue(value);
+            Set(getTrickSaberConfig().ModEnabled, value);
+        });
+
+        BSML::Lite::CreateToggle(parent, "Peak Throw Velocity",
+         getTrickSaberConfig().PeakThrowVelocity.GetValue(), [](bool value){
+            Set(getTrickSaberConfig().PeakThrowVelocity, value);
+        });
+
+        BSML::Lite::CreateToggle(parent, "Thrown Sabers Cut",
+         getTrickSaberConfig().ThrownSabersCut.GetValue(), [](bool value){
+            Set(getTrickSaberConfig().ThrownSabersCut, value);
+        });
+
+        BSML::Lite::CreateToggle(parent, "Auto Recall Before Notes",
+         getTrickSaberConfig().AutoRecall.GetValue(), [](bool value){
+            Set(getTrickSaberConfig().AutoRecall, value);
+        });
+
+        BSML::Lite::CreateToggle(parent, "Saber Physics On Worker Threads",
+         getTrickSaberConfig().ThreadedTick.GetValue(), [](bool value){
+            Set(getTrickSaberConfig().ThreadedTick, value);
         });
 
 
@@ -52,51 +124,121 @@ namespace TrickSaber::UI {
             [](StringW value) {
                 int selectedIndex = std::find(RightControllerButtonChoices.begin(),
                  RightControllerButtonChoices.end(), value) - RightControllerButtonChoices.begin();
-                getTrickSaberConfig().RightSaberSpinButton.SetValue(selectedIndex);
+                Set(getTrickSaberConfig().RightSaberSpinButton, selectedIndex);
             }
         );
 
         BSML::Lite::CreateToggle(parent, "Spin Clockwise",
          getTrickSaberConfig().RightSaberSpinClockwise.GetValue(), [](bool value){
-            getTrickSaberConfig().RightSaberSpinClockwise.SetValue(value);
+            Set(getTrickSaberConfig().RightSaberSpinClockwise, value);
         });
 
         BSML::Lite::CreateIncrementSetting(parent, "Spin Speed", 1, 50.0f,
             getTrickSaberConfig().RightSaberSpinSpeed.GetValue(),
-            100.0f, 10000.0f,
+            Presets::SPIN_SPEED_RANGE.min, Presets::SPIN_SPEED_RANGE.max,
             [](float value){
-                getTrickSaberConfig().RightSaberSpinSpeed.SetValue(value);
+                Set(getTrickSaberConfig().RightSaberSpinSpeed, value);
         });
 
         BSML::Lite::CreateIncrementSetting(parent, "Spin Anchor Z-Offset", 2, 0.05f,
             getTrickSaberConfig().RightSaberSpinAnchorZOffset.GetValue(),
-            -1.0f, 1.0f,
+            Presets::SPIN_ANCHOR_RANGE.min, Presets::SPIN_ANCHOR_RANGE.max,
             [](float value){
-                getTrickSaberConfig().RightSaberSpinAnchorZOffset.SetValue(value);
+                Set(getTrickSaberConfig().RightSaberSpinAnchorZOffset, value);
         });
 
         BSML::Lite::CreateIncrementSetting(parent, "Throw Velocity Multiplier", 1, 0.1f,
             getTrickSaberConfig().RightSaberThrowVelocityMultiplier.GetValue(),
-            0.5f, 5.0f,
+            Presets::THROW_MULTIPLIER_RANGE.min, Presets::THROW_MULTIPLIER_RANGE.max,
             [](float value){
-                getTrickSaberConfig().RightSaberThrowVelocityMultiplier.SetValue(value);
+                Set(getTrickSaberConfig().RightSaberThrowVelocityMultiplier, value);
         });
 
         BSML::Lite::CreateIncrementSetting(parent, "Saber Return Duration", 2, 0.02f,
             getTrickSaberConfig().RightSaberReturnDuration.GetValue(),
-            0.02f, 1.5f,
+            Presets::RETURN_DURATION_RANGE.min, Presets::RETURN_DURATION_RANGE.max,
             [](float value){
                 if (value < 0.01f) value = 0.02f;
-                getTrickSaberConfig().RightSaberReturnDuration.SetValue(value);
+                Set(getTrickSaberConfig().RightSaberReturnDuration, value);
         });
 
+        BSML::Lite::CreateDropdown(parent, "Return Path",
+            ReturnCurveChoices[std::clamp(getTrickSaberConfig().RightSaberReturnCurve.GetValue(), 0, static_cast<int>(ReturnCurveChoices.size()) - 1)],
+            ReturnCurveChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(ReturnCurveChoices.begin(),
+                 ReturnCurveChoices.end(), value) - ReturnCurveChoices.begin();
+                Set(getTrickSaberConfig().RightSaberReturnCurve, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateDropdown(parent, "Return Easing",
+            ReturnEasingChoices[std::clamp(getTrickSaberConfig().RightSaberReturnEasing.GetValue(), 0, static_cast<int>(ReturnEasingChoices.size()) - 1)],
+            ReturnEasingChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(ReturnEasingChoices.begin(),
+                 ReturnEasingChoices.end(), value) - ReturnEasingChoices.begin();
+                Set(getTrickSaberConfig().RightSaberReturnEasing, selectedIndex);
+            }
+        );
+
         BSML::Lite::CreateDropdown(parent, "Throw Button",
             RightControllerButtonChoices[getTrickSaberConfig().RightSaberThrowButton.GetValue()],
             RightControllerButtonChoices,
             [](StringW value) {
                 int selectedIndex = std::find(RightControllerButtonChoices.begin(),
                  RightControllerButtonChoices.end(), value) - RightControllerButtonChoices.begin();
-                getTrickSaberConfig().RightSaberThrowButton.SetValue(selectedIndex);
+                Set(getTrickSaberConfig().RightSaberThrowButton, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateDropdown(parent, "Spin Chord Button",
+            RightControllerButtonChoices[std::clamp(getTrickSaberConfig().RightSaberSpinChordButton.GetValue(), 0, static_cast<int>(RightControllerButtonChoices.size()) - 1)],
+            RightControllerButtonChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(RightControllerButtonChoices.begin(),
+                 RightControllerButtonChoices.end(), value) - RightControllerButtonChoices.begin();
+                Set(getTrickSaberConfig().RightSaberSpinChordButton, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateToggle(parent, "Spin On Double Tap",
+         getTrickSaberConfig().RightSaberSpinDoubleTap.GetValue(), [](bool value){
+            Set(getTrickSaberConfig().RightSaberSpinDoubleTap, value);
+        });
+
+        BSML::Lite::CreateDropdown(parent, "Throw Chord Button",
+            RightControllerButtonChoices[std::clamp(getTrickSaberConfig().RightSaberThrowChordButton.GetValue(), 0, static_cast<int>(RightControllerButtonChoices.size()) - 1)],
+            RightControllerButtonChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(RightControllerButtonChoices.begin(),
+                 RightControllerButtonChoices.end(), value) - RightControllerButtonChoices.begin();
+                Set(getTrickSaberConfig().RightSaberThrowChordButton, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateToggle(parent, "Throw On Double Tap",
+         getTrickSaberConfig().RightSaberThrowDoubleTap.GetValue(), [](bool value){
+            Set(getTrickSaberConfig().RightSaberThrowDoubleTap, value);
+        });
+
+        BSML::Lite::CreateDropdown(parent, "Combo Button",
+            RightControllerButtonChoices[std::clamp(getTrickSaberConfig().RightSaberComboButton.GetValue(), 0, static_cast<int>(RightControllerButtonChoices.size()) - 1)],
+            RightControllerButtonChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(RightControllerButtonChoices.begin(),
+                 RightControllerButtonChoices.end(), value) - RightControllerButtonChoices.begin();
+                Set(getTrickSaberConfig().RightSaberComboButton, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateDropdown(parent, "Combo",
+            ComboChoices[std::clamp(getTrickSaberConfig().RightSaberCombo.GetValue(), 0, static_cast<int>(ComboChoices.size()) - 1)],
+            ComboChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(ComboChoices.begin(),
+                 ComboChoices.end(), value) - ComboChoices.begin();
+                Set(getTrickSaberConfig().RightSaberCombo, selectedIndex);
             }
         );
 
@@ -110,34 +252,34 @@ namespace TrickSaber::UI {
             [](StringW value) {
                 int selectedIndex = std::find(LeftControllerButtonChoices.begin(),
                  LeftControllerButtonChoices.end(), value) - LeftControllerButtonChoices.begin();
-                getTrickSaberConfig().LeftSaberSpinButton.SetValue(selectedIndex);
+                Set(getTrickSaberConfig().LeftSaberSpinButton, selectedIndex);
             }
         );
 
         BSML::Lite::CreateToggle(parent, "Spin Clockwise",
          getTrickSaberConfig().LeftSaberSpinClockwise.GetValue(), [](bool value){
-            getTrickSaberConfig().LeftSaberSpinClockwise.SetValue(value);
+            Set(getTrickSaberConfig().LeftSaberSpinClockwise, value);
         });
         
         BSML::Lite::CreateIncrementSetting(parent, "Spin Speed", 1, 50.0f,
             getTrickSaberConfig().LeftSaberSpinSpeed.GetValue(),
-            100.0f, 10000.0f,
+            Presets::SPIN_SPEED_RANGE.min, Presets::SPIN_SPEED_RANGE.max,
             [](float value){
-                getTrickSaberConfig().LeftSaberSpinSpeed.SetValue(value);
+                Set(getTrickSaberConfig().LeftSaberSpinSpeed, value);
         });
 
         BSML::Lite::CreateIncrementSetting(parent, "Spin Anchor Z-Offset", 2, 0.05f,
             getTrickSaberConfig().LeftSaberSpinAnchorZOffset.GetValue(),
-            -1.0f, 1.0f,
+            Presets::SPIN_ANCHOR_RANGE.min, Presets::SPIN_ANCHOR_RANGE.max,
             [](float value){
-                getTrickSaberConfig().LeftSaberSpinAnchorZOffset.SetValue(value);
+                Set(getTrickSaberConfig().LeftSaberSpinAnchorZOffset, value);
         });
 
         BSML::Lite::CreateIncrementSetting(parent, "Throw Velocity Mult.", 1, 0.1f,
             getTrickSaberConfig().LeftSaberThrowVelocityMultiplier.GetValue(),
-            0.5f, 5.0f,
+            Presets::THROW_MULTIPLIER_RANGE.min, Presets::THROW_MULTIPLIER_RANGE.max,
             [](float value){
-                getTrickSaberConfig().LeftSaberThrowVelocityMultiplier.SetValue(value);
+                Set(getTrickSaberConfig().LeftSaberThrowVelocityMultiplier, value);
         });
 
         BSML::Lite::CreateDropdown(parent, "Throw Button",
@@ -146,17 +288,221 @@ namespace TrickSaber::UI {
             [](StringW value) {
                 int selectedIndex = std::find(LeftControllerButtonChoices.begin(),
                  LeftControllerButtonChoices.end(), value) - LeftControllerButtonChoices.begin();
-                getTrickSaberConfig().LeftSaberThrowButton.SetValue(selectedIndex);
+                Set(getTrickSaberConfig().LeftSaberThrowButton, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateDropdown(parent, "Spin Chord Button",
+            LeftControllerButtonChoices[std::clamp(getTrickSaberConfig().LeftSaberSpinChordButton.GetValue(), 0, static_cast<int>(LeftControllerButtonChoices.size()) - 1)],
+            LeftControllerButtonChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(LeftControllerButtonChoices.begin(),
+                 LeftControllerButtonChoices.end(), value) - LeftControllerButtonChoices.begin();
+                Set(getTrickSaberConfig().LeftSaberSpinChordButton, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateToggle(parent, "Spin On Double Tap",
+         getTrickSaberConfig().LeftSaberSpinDoubleTap.GetValue(), [](bool value){
+            Set(getTrickSaberConfig().LeftSaberSpinDoubleTap, value);
+        });
+
+        BSML::Lite::CreateDropdown(parent, "Throw Chord Button",
+            LeftControllerButtonChoices[std::clamp(getTrickSaberConfig().LeftSaberThrowChordButton.GetValue(), 0, static_cast<int>(LeftControllerButtonChoices.size()) - 1)],
+            LeftControllerButtonChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(LeftControllerButtonChoices.begin(),
+                 LeftControllerButtonChoices.end(), value) - LeftControllerButtonChoices.begin();
+                Set(getTrickSaberConfig().LeftSaberThrowChordButton, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateToggle(parent, "Throw On Double Tap",
+         getTrickSaberConfig().LeftSaberThrowDoubleTap.GetValue(), [](bool value){
+            Set(getTrickSaberConfig().LeftSaberThrowDoubleTap, value);
+        });
+
+        BSML::Lite::CreateDropdown(parent, "Combo Button",
+            LeftControllerButtonChoices[std::clamp(getTrickSaberConfig().LeftSaberComboButton.GetValue(), 0, static_cast<int>(LeftControllerButtonChoices.size()) - 1)],
+            LeftControllerButtonChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(LeftControllerButtonChoices.begin(),
+                 LeftControllerButtonChoices.end(), value) - LeftControllerButtonChoices.begin();
+                Set(getTrickSaberConfig().LeftSaberComboButton, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateDropdown(parent, "Combo",
+            ComboChoices[std::clamp(getTrickSaberConfig().LeftSaberCombo.GetValue(), 0, static_cast<int>(ComboChoices.size()) - 1)],
+            ComboChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(ComboChoices.begin(),
+                 ComboChoices.end(), value) - ComboChoices.begin();
+                Set(getTrickSaberConfig().LeftSaberCombo, selectedIndex);
             }
         );
 
         BSML::Lite::CreateIncrementSetting(parent, "Saber Return Duration", 2, 0.02f,
             getTrickSaberConfig().LeftSaberReturnDuration.GetValue(),
-            0.02f, 1.5f,
+            Presets::RETURN_DURATION_RANGE.min, Presets::RETURN_DURATION_RANGE.max,
             [](float value){
                 if (value < 0.01f) value = 0.02f;
-                getTrickSaberConfig().LeftSaberReturnDuration.SetValue(value);
+                Set(getTrickSaberConfig().LeftSaberReturnDuration, value);
+        });
+
+        BSML::Lite::CreateDropdown(parent, "Return Path",
+            ReturnCurveChoices[std::clamp(getTrickSaberConfig().LeftSaberReturnCurve.GetValue(), 0, static_cast<int>(ReturnCurveChoices.size()) - 1)],
+            ReturnCurveChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(ReturnCurveChoices.begin(),
+                 ReturnCurveChoices.end(), value) - ReturnCurveChoices.begin();
+                Set(getTrickSaberConfig().LeftSaberReturnCurve, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateDropdown(parent, "Return Easing",
+            ReturnEasingChoices[std::clamp(getTrickSaberConfig().LeftSaberReturnEasing.GetValue(), 0, static_cast<int>(ReturnEasingChoices.size()) - 1)],
+            ReturnEasingChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(ReturnEasingChoices.begin(),
+                 ReturnEasingChoices.end(), value) - ReturnEasingChoices.begin();
+                Set(getTrickSaberConfig().LeftSaberReturnEasing, selectedIndex);
+            }
+        );
+
+        // Presets:
+        BSML::Lite::CreateText(parent, "--- Presets ---");
+
+        auto presetText = BSML::Lite::CreateText(parent, PresetLabel());
+
+        BSML::Lite::CreateIncrementSetting(parent, "Preset", 0, 1.0f,
+            std::max(TrickSaber::Presets::Active(), 0),
+            0.0f, TrickSaber::Presets::MAX_PRESETS - 1.0f,
+            [presetText](float value){
+                if (TrickSaber::Presets::Activate(static_cast<int>(value))) {
+                    TrickSaber::Presets::ApplyPending();
+                }
+                presetText->set_text(PresetLabel(static_cast<int>(value)));
+        });
+
+        BSML::Lite::CreateStringSetting(parent, "Preset Name", presetName, [](StringW value) {
+            presetName = static_cast<std::string>(value);
+        });
+
+        BSML::Lite::CreateUIButton(parent, "Save Current As Preset", [presetText]() {
+            std::string name = presetName.empty() ? "Preset " + std::to_string(TrickSaber::Presets::Count() + 1) : presetName;
+            if (TrickSaber::Presets::SaveCurrent(name) < 0) {
+                getLogger().warn("[TS] [Presets] Could not save preset {}", name);
+            }
+            presetText->set_text(PresetLabel());
+        });
+
+        BSML::Lite::CreateUIButton(parent, "Delete Active Preset", [presetText]() {
+            TrickSaber::Presets::Delete(TrickSaber::Presets::Active());
+            presetText->set_text(PresetLabel());
+        });
+
+        BSML::Lite::CreateUIButton(parent, "Export Presets To JSON", [presetText]() {
+            int count = TrickSaber::Presets::ExportJson();
+            presetText->set_text(count < 0 ? "Export failed" : "Exported " + std::to_string(count) + " to " + TrickSaber::Presets::JsonPath());
+        });
+
+        BSML::Lite::CreateUIButton(parent, "Import Presets From JSON", [presetText]() {
+            int count = TrickSaber::Presets::ImportJson();
+            presetText->set_text(count < 0 ? "Import failed" : "Imported " + std::to_string(count) + "; " + PresetLabel());
+        });
+
+        BSML::Lite::CreateDropdown(parent, "Right Next Preset Button",
+            RightControllerButtonChoices[std::clamp(getTrickSaberConfig().RightSaberPresetButton.GetValue(), 0, static_cast<int>(RightControllerButtonChoices.size()) - 1)],
+            RightControllerButtonChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(RightControllerButtonChoices.begin(),
+                 RightControllerButtonChoices.end(), value) - RightControllerButtonChoices.begin();
+                Set(getTrickSaberConfig().RightSaberPresetButton, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateDropdown(parent, "Right Next Preset Chord",
+            RightControllerButtonChoices[std::clamp(getTrickSaberConfig().RightSaberPresetChordButton.GetValue(), 0, static_cast<int>(RightControllerButtonChoices.size()) - 1)],
+            RightControllerButtonChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(RightControllerButtonChoices.begin(),
+                 RightControllerButtonChoices.end(), value) - RightControllerButtonChoices.begin();
+                Set(getTrickSaberConfig().RightSaberPresetChordButton, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateDropdown(parent, "Left Next Preset Button",
+            LeftControllerButtonChoices[std::clamp(getTrickSaberConfig().LeftSaberPresetButton.GetValue(), 0, static_cast<int>(LeftControllerButtonChoices.size()) - 1)],
+            LeftControllerButtonChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(LeftControllerButtonChoices.begin(),
+                 LeftControllerButtonChoices.end(), value) - LeftControllerButtonChoices.begin();
+                Set(getTrickSaberConfig().LeftSaberPresetButton, selectedIndex);
+            }
+        );
+
+        BSML::Lite::CreateDropdown(parent, "Left Next Preset Chord",
+            LeftControllerButtonChoices[std::clamp(getTrickSaberConfig().LeftSaberPresetChordButton.GetValue(), 0, static_cast<int>(LeftControllerButtonChoices.size()) - 1)],
+            LeftControllerButtonChoices,
+            [](StringW value) {
+                int selectedIndex = std::find(LeftControllerButtonChoices.begin(),
+                 LeftControllerButtonChoices.end(), value) - LeftControllerButtonChoices.begin();
+                Set(getTrickSaberConfig().LeftSaberPresetChordButton, selectedIndex);
+            }
+        );
+
+        // Performance:
+        BSML::Lite::CreateText(parent, "--- Performance (us) ---");
+
+        auto perfText = BSML::Lite::CreateText(parent, TrickSaber::Perf::FormatSummary());
+
+        BSML::Lite::CreateUIButton(parent, "Refresh Stats", [perfText]() {
+            perfText->set_text(TrickSaber::Perf::FormatSummary());
+        });
+
+        BSML::Lite::CreateUIButton(parent, "Reset Stats", [perfText]() {
+            TrickSaber::Perf::ResetAll();
+            perfText->set_text(TrickSaber::Perf::FormatSummary());
+        });
+
+        // Recording (not persisted, always starts off):
+        BSML::Lite::CreateText(parent, "--- Recording ---");
+
+        BSML::Lite::CreateToggle(parent, "Record Input & Poses",
+         TrickSaber::Recording::IsRecording(), [](bool value){
+            if (value) {
+                TrickSaber::Recording::Start();
+            } else {
+                TrickSaber::Recording::Stop();
+            }
+        });
+
+#if TS_TRACE
+        // Tracing (not persisted, always starts off):
+        BSML::Lite::CreateText(parent, "--- Tracing ---");
+
+        auto traceText = BSML::Lite::CreateText(parent, "Not capturing");
+
+        BSML::Lite::CreateUIButton(parent, "Start Trace", [traceText]() {
+            traceText->set_text(TrickSaber::Trace::Start() ? "Capturing..." : "Still saving the last trace");
+        });
+
+        BSML::Lite::CreateUIButton(parent, "Stop & Save Trace", [traceText]() {
+            int events = TrickSaber::Trace::EventCount();
+            uint64_t dropped = TrickSaber::Trace::Dropped();
+            std::string path = TrickSaber::Trace::StopAndSave();
+            char status[256];
+            if (path.empty()) {
+                snprintf(status, sizeof(status), "Nothing saved");
+            } else {
+                snprintf(status, sizeof(status), "%d events (%llu dropped) to %s", events,
+                    static_cast<unsigned long long>(dropped), path.c_str());
+                getLogger().info("[TS] [Settings] Trace saved to {}", path);
+            }
+            traceText->set_text(status);
         });
+#endif
 
         getLogger().info("[TS] [Settings] UI Created");
     }
@@ -0,0 +1,73 @@
+#include "settings/persistence.hpp"
+#include "settings/config-values.hpp"
+#include "settings/config.hpp"
+#include "logger.hpp"
+#include "perf/timers.hpp"
+
+#include "beatsaber-hook/shared/config/config-utils.hpp"
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/prettywriter.h"
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/stringbuffer.h"
+
+namespace TrickSaber::Config {
+
+    static constexpr std::chrono::milliseconds FLUSH_TIMEOUT{500};
+
+    static SaveWorker<ConfigValues> worker;
+    static char const* keys[CONFIG_FIELD_COUNT];  // config-utils keeps the names for the process lifetime
+    static bool started = false;
+
+    static std::string Render(ConfigValues const& values) {
+        rapidjson::StringBuffer buffer;
+        rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+        WriteConfigJson(writer, values, keys);
+        return std::string(buffer.GetString(), buffer.GetSize());
+    }
+
+    void StartPersistence() {
+        auto& config = getTrickSaberConfig();
+        int field = 0;
+#define TRICKSABER_KEY(name, type) keys[field++] = config.name.GetName().c_str();
+        TRICKSABER_CONFIG_FIELDS(TRICKSABER_KEY)
+#undef TRICKSABER_KEY
+        // The file config-utils loaded the values from
+        std::string path = getConfigFilePath(modInfo);
+        worker.Start(path, Render);
+        started = true;
+        getLogger().info("[TS] [Config] Saving {} in the background", path);
+    }
+
+    void SaveLater() {
+        if (!started) {
+            return;
+        }
+        Perf::ScopedTimer timer(Perf::Metric::SettingChange);
+        auto& config = getTrickSaberConfig();
+        ConfigValues values;
+#define TRICKSABER_CAPTURE(name, type) values.name = config.name.GetValue();
+        TRICKSABER_CONFIG_FIELDS(TRICKSABER_CAPTURE)
+#undef TRICKSABER_CAPTURE
+        worker.Changed(values);
+    }
+
+    void SaveNow() {
+        if (started) {
+            worker.FlushSoon();
+        }
+    }
+
+    bool FlushSaves() {
+        if (!started) {
+            return true;
+        }
+        if (!worker.Flush(FLUSH_TIMEOUT)) {
+            getLogger().warn("[TS] [Config] Settings not saved within {} ms", FLUSH_TIMEOUT.count());
+            return false;
+        }
+        return true;
+    }
+
+    SaveStats PersistenceStats() {
+        return worker.Stats();
+    }
+
+}  // namespace TrickSaber::Config
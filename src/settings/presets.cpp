@@ -0,0 +1,319 @@
+#include "settings/presets.hpp"
+#include "settings/config.hpp"
+#include "settings/persistence.hpp"
+#include "settings/preset-limits.hpp"
+#include "settings/save-worker.hpp"
+#include "settings/snapshot.hpp"
+#include "logger.hpp"
+#include "perf/timers.hpp"
+
+#include "beatsaber-hook/shared/config/config-utils.hpp"
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/document.h"
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/prettywriter.h"
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/stringbuffer.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace TrickSaber::Presets {
+
+    static constexpr char const* PRESET_FILE = "presets.tspr";
+    static constexpr char const* JSON_FILE = "presets.json";
+
+    static PresetFileHeader* header = nullptr;  // Start of the mapping; records follow it
+    static bool configPending = false;
+
+    // The loader's data directory for this mod
+    static std::string Directory() {
+        return getDataDir(modInfo);
+    }
+
+    static std::string PathOf(char const* file) {
+        return (std::filesystem::path(Directory()) / file).string();
+    }
+
+    std::string JsonPath() {
+        return PathOf(JSON_FILE);
+    }
+
+    // Pushes edits to storage without waiting; switches only touch header->active and are
+    // left to the kernel's own writeback.
+    static void Sync() {
+        msync(header, FILE_BYTES, MS_ASYNC);
+    }
+
+    bool Init() {
+        std::error_code error;
+        std::filesystem::create_directories(Directory(), error);
+        std::string path = PathOf(PRESET_FILE);
+
+        int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            getLogger().error("[TS] [Presets] Could not open {}", path);
+            return false;
+        }
+
+        struct stat info;
+        PresetFileHeader existing = {};
+        bool readable = fstat(fd, &info) == 0 && pread(fd, &existing, sizeof(existing), 0) == sizeof(existing);
+        bool fresh = !readable || static_cast<std::size_t>(info.st_size) != FILE_BYTES || !IsValidHeader(existing);
+        // Records of an earlier version are read out whole before the file is replaced
+        std::vector<char> oldRecords;
+        bool migrate = fresh && readable && IsMigratableHeader(existing) &&
+                       static_cast<std::size_t>(info.st_size) == sizeof(existing) + MAX_PRESETS * existing.recordSize;
+        if (migrate) {
+            oldRecords.resize(static_cast<std::size_t>(existing.count) * existing.recordSize);
+            migrate = pread(fd, oldRecords.data(), oldRecords.size(), sizeof(existing)) == static_cast<ssize_t>(oldRecords.size());
+        }
+        if (fresh && info.st_size > 0) {
+            // Older or damaged layout: keep it for the user and start over
+            close(fd);
+            std::filesystem::rename(path, path + ".bak", error);
+            if (migrate) {
+                getLogger().info("[TS] [Presets] Migrating {} from version {}, original moved to .bak", path, existing.version);
+            } else {
+                getLogger().warn("[TS] [Presets] {} has an unknown layout, moved to .bak", path);
+            }
+            fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                getLogger().error("[TS] [Presets] Could not recreate {}", path);
+                return false;
+            }
+        }
+        if (fresh && ftruncate(fd, FILE_BYTES) != 0) {
+            close(fd);
+            getLogger().error("[TS] [Presets] Could not size {}", path);
+            return false;
+        }
+
+        void* mapping = mmap(nullptr, FILE_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            getLogger().error("[TS] [Presets] Could not map {}", path);
+            return false;
+        }
+        header = static_cast<PresetFileHeader*>(mapping);
+
+        if (fresh && migrate) {
+            // Fields are only ever appended, so an old record is a prefix of a new one; the
+            // fields it lacks take the current config, which has their defaults
+            *header = MakeHeader();
+            PresetValues defaults = Config::CaptureConfig();
+            for (uint32_t i = 0; i < existing.count; i++) {
+                PresetRecord& record = Records(header)[i];
+                record.values = defaults;
+                std::memcpy(&record, oldRecords.data() + i * existing.recordSize, existing.recordSize);
+            }
+            header->count = existing.count;
+            header->active = existing.active;
+            Sync();
+        } else if (fresh) {
+            *header = MakeHeader();
+            SaveCurrent("Default");
+        }
+        getLogger().info("[TS] [Presets] {} presets mapped, active {}", header->count, header->active);
+        return true;
+    }
+
+    int Count() {
+        return header ? static_cast<int>(header->count) : 0;
+    }
+
+    std::string Name(int index) {
+        if (index < 0 || index >= Count()) {
+            return {};
+        }
+        PresetRecord const& record = Records(header)[index];
+        return std::string(record.name, strnlen(record.name, NAME_BYTES));
+    }
+
+    int Active() {
+        return header ? header->active : -1;
+    }
+
+    bool Activate(int index) {
+        if (index < 0 || index >= Count()) {
+            return false;
+        }
+        Perf::ScopedTimer timer(Perf::Metric::PresetSwitch);
+        // The file may have been edited or written by another build
+        PresetValues values = Records(header)[index].values;
+        ClampValues(values);
+        Config::Publish(values);
+        header->active = index;
+        configPending = true;
+        return true;
+    }
+
+    void CycleNext() {
+        int count = Count();
+        if (count > 0) {
+            Activate((Active() + 1) % count);
+        }
+    }
+
+    static int FindByName(std::string const& name) {
+        for (int i = 0; i < Count(); i++) {
+            if (Name(i) == name.substr(0, NAME_BYTES - 1)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    static int Store(std::string const& name, PresetValues const& values) {
+        if (!header) {
+            return -1;
+        }
+        int index = FindByName(name);
+        if (index < 0) {
+            if (header->count >= MAX_PRESETS) {
+                return -1;
+            }
+            index = static_cast<int>(header->count++);
+        }
+        PresetRecord& record = Records(header)[index];
+        SetName(record, name.c_str());
+        record.values = values;
+        return index;
+    }
+
+    int SaveCurrent(std::string const& name) {
+        int index = Store(name, Config::CaptureConfig());
+        if (index >= 0) {
+            header->active = index;
+            Sync();
+        }
+        return index;
+    }
+
+    bool Delete(int index) {
+        int count = Count();
+        if (index < 0 || index >= count) {
+            return false;
+        }
+        PresetRecord* records = Records(header);
+        std::memmove(records + index, records + index + 1, (count - index - 1) * sizeof(PresetRecord));
+        header->count--;
+        if (header->active == index) {
+            header->active = -1;
+        } else if (header->active > index) {
+            header->active--;
+        }
+        Sync();
+        return true;
+    }
+
+    void ApplyPending() {
+        if (!configPending || Active() < 0) {
+            return;
+        }
+        configPending = false;
+        PresetValues values = Records(header)[Active()].values;
+        ClampValues(values);
+        auto& config = getTrickSaberConfig();
+#define TRICKSABER_APPLY(name, type) config.name.SetValue(values.name, false);
+        TRICKSABER_PRESET_FIELDS(TRICKSABER_APPLY)
+#undef TRICKSABER_APPLY
+        Config::SaveLater();
+        getLogger().info("[TS] [Presets] Config updated to preset {}", Name(Active()));
+    }
+
+    // --- JSON ---
+
+    template <typename Writer>
+    static void WriteValue(Writer& writer, bool value) { writer.Bool(value); }
+    template <typename Writer>
+    static void WriteValue(Writer& writer, int value) { writer.Int(value); }
+    template <typename Writer>
+    static void WriteValue(Writer& writer, float value) { writer.Double(value); }
+
+    static void ReadValue(rapidjson::Value const& json, bool& value) { if (json.IsBool()) value = json.GetBool(); }
+    static void ReadValue(rapidjson::Value const& json, int& value) { if (json.IsInt()) value = json.GetInt(); }
+    static void ReadValue(rapidjson::Value const& json, float& value) { if (json.IsNumber()) value = json.GetFloat(); }
+
+    int ExportJson() {
+        if (!header) {
+            return -1;
+        }
+        rapidjson::StringBuffer buffer;
+        rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+        writer.StartObject();
+        writer.Key("version");
+        writer.Int(FORMAT_VERSION);
+        writer.Key("presets");
+        writer.StartArray();
+        for (int i = 0; i < Count(); i++) {
+            PresetValues const& values = Records(header)[i].values;
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(Name(i).c_str());
+#define TRICKSABER_EXPORT(name, type) writer.Key(#name); WriteValue(writer, values.name);
+            TRICKSABER_PRESET_FIELDS(TRICKSABER_EXPORT)
+#undef TRICKSABER_EXPORT
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.EndObject();
+
+        std::string path = JsonPath();
+        if (!Config::WriteFileAtomically(path, std::string_view(buffer.GetString(), buffer.GetSize()))) {
+            getLogger().error("[TS] [Presets] Could not write {}", path);
+            return -1;
+        }
+        getLogger().info("[TS] [Presets] Exported {} presets to {}", Count(), path);
+        return Count();
+    }
+
+    int ImportJson() {
+        if (!header) {
+            return -1;
+        }
+        std::string path = JsonPath();
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            getLogger().error("[TS] [Presets] Could not read {}", path);
+            return -1;
+        }
+        std::string text;
+        char chunk[4096];
+        for (std::size_t n; (n = std::fread(chunk, 1, sizeof(chunk), file)) > 0;) {
+            text.append(chunk, n);
+        }
+        std::fclose(file);
+
+        rapidjson::Document document;
+        document.Parse(text.c_str());
+        if (document.HasParseError() || !document.IsObject() || !document.HasMember("presets") || !document["presets"].IsArray()) {
+            getLogger().error("[TS] [Presets] {} is not a preset export", path);
+            return -1;
+        }
+
+        PresetValues defaults = Config::CaptureConfig();
+        int imported = 0;
+        for (rapidjson::Value const& preset : document["presets"].GetArray()) {
+            if (!preset.IsObject() || !preset.HasMember("name") || !preset["name"].IsString()) {
+                continue;
+            }
+            PresetValues values = defaults;
+#define TRICKSABER_IMPORT(name, type) if (auto member = preset.FindMember(#name); member != preset.MemberEnd()) ReadValue(member->value, values.name);
+            TRICKSABER_PRESET_FIELDS(TRICKSABER_IMPORT)
+#undef TRICKSABER_IMPORT
+            ClampValues(values);
+            if (Store(preset["name"].GetString(), values) < 0) {
+                getLogger().warn("[TS] [Presets] Store full, stopped importing at {}", preset["name"].GetString());
+                break;
+            }
+            imported++;
+        }
+        Sync();
+        getLogger().info("[TS] [Presets] Imported {} presets from {}", imported, path);
+        return imported;
+    }
+
+}  // namespace TrickSaber::Presets
@@ -0,0 +1,52 @@
+#include "settings/save-worker.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace TrickSaber::Config {
+
+    static bool WriteAll(int fd, std::string_view contents) {
+        char const* p = contents.data();
+        std::size_t left = contents.size();
+        while (left > 0) {
+            ssize_t n = write(fd, p, left);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            p += n;
+            left -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    bool WriteFileAtomically(std::string const& path, std::string_view contents) {
+        std::string temp = path + ".tmp";
+        int fd = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        // The data has to be on disk before the rename is, or a power cut could leave the new
+        // name pointing at an empty file
+        bool ok = WriteAll(fd, contents) && fsync(fd) == 0;
+        ok = close(fd) == 0 && ok;
+        if (!ok || std::rename(temp.c_str(), path.c_str()) != 0) {
+            unlink(temp.c_str());
+            return false;
+        }
+
+        std::size_t slash = path.find_last_of('/');
+        std::string dir = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        int dirFd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            close(dirFd);
+        }
+        return true;
+    }
+
+}  // namespace TrickSaber::Config
@@ -0,0 +1,156 @@
+#include "settings/snapshot.hpp"
+#include "settings/config.hpp"
+#include "settings/config-values.hpp"
+#include "logger.hpp"
+#include "physics/math.hpp"
+#include "physics/return-path.hpp"
+
+#include <algorithm>
+
+namespace TrickSaber::Config {
+
+    using Presets::PresetValues;
+
+    // Readers pin the slot they tick with, so a publish mid-tick fills another one.
+    static SnapshotSlots<Snapshot> published;
+
+    GlobalNamespace::OVRInput::Button GetOVRButtonForConfig(int configuredButtonIndex, bool isLeftController) {
+        if (configuredButtonIndex == 0) return GlobalNamespace::OVRInput::Button::None;
+        if (isLeftController) {
+            switch (configuredButtonIndex) {
+                case 1: return GlobalNamespace::OVRInput::Button::One;
+                case 2: return GlobalNamespace::OVRInput::Button::Two;
+                case 3: return GlobalNamespace::OVRInput::Button::PrimaryIndexTrigger;
+                case 4: return GlobalNamespace::OVRInput::Button::PrimaryHandTrigger;
+                default: return GlobalNamespace::OVRInput::Button::None;
+            }
+        } else { // Right Controller
+            switch (configuredButtonIndex) {
+                case 1: return GlobalNamespace::OVRInput::Button::One;
+                case 2: return GlobalNamespace::OVRInput::Button::Two;
+                case 3: return GlobalNamespace::OVRInput::Button::PrimaryIndexTrigger;
+                case 4: return GlobalNamespace::OVRInput::Button::PrimaryHandTrigger;
+                default: return GlobalNamespace::OVRInput::Button::None;
+            }
+        }
+    }
+
+    struct ActionConfig {
+        int button;
+        int chordButton;
+        bool doubleTap;
+    };
+
+    static HandSettings BuildHand(ActionConfig throwAction, ActionConfig spinAction, int comboButton, int combo, ActionConfig presetAction, bool clockwise, float spinSpeed, float zOffset, float throwMult, float returnDuration, int returnCurve, int returnEasing, bool peakRelease, bool isLeft) {
+        HandSettings hand;
+        hand.bindings[Input::Throw] = Input::CompileBinding(throwAction.button, throwAction.chordButton, throwAction.doubleTap);
+        hand.bindings[Input::Spin] = Input::CompileBinding(spinAction.button, spinAction.chordButton, spinAction.doubleTap);
+        hand.throwBound = hand.bindings[Input::Throw].mask != 0;
+        hand.spinBound = hand.bindings[Input::Spin].mask != 0;
+        hand.bindings[Input::Combo] = Input::CompileBinding(comboButton, 0, false);
+        hand.combo = combo;
+        hand.bindings[Input::NextPreset] = Input::CompileBinding(presetAction.button, presetAction.chordButton, false);
+
+        uint32_t used = 0;
+        for (Input::Binding const& binding : hand.bindings) {
+            used |= binding.mask;
+        }
+        hand.pollCount = 0;
+        for (int index = 1; index <= Input::BUTTON_COUNT; index++) {
+            uint32_t bit = Input::ButtonBitForConfig(index);
+            if (used & bit) {
+                hand.pollButtons[hand.pollCount] = GetOVRButtonForConfig(index, isLeft);
+                hand.pollBits[hand.pollCount] = bit;
+                hand.pollCount++;
+            }
+        }
+
+        hand.spinDirection = clockwise ? 1.0f : -1.0f;
+        hand.spinDegPerSec = hand.spinDirection * spinSpeed;
+        hand.spinRadPerSec = hand.spinDegPerSec * Math::DEG2RAD;
+        hand.spinAnchorZOffset = zOffset;
+        hand.throwVelocityMultiplier = throwMult;
+        hand.returnDuration = std::max(returnDuration, MIN_RETURN_DURATION);
+        hand.returnStyle = Math::ReturnStyle(
+            static_cast<Math::ReturnCurve>(std::clamp(returnCurve, 0, static_cast<int>(Math::ReturnCurve::Count) - 1)),
+            static_cast<Math::ReturnEasing>(std::clamp(returnEasing, 0, static_cast<int>(Math::ReturnEasing::Count) - 1)));
+        hand.returnPath = &Math::ReturnPathFor(hand.returnStyle);
+        hand.peakReleaseWindow = peakRelease ? PEAK_RELEASE_WINDOW : 0.0f;
+        return hand;
+    }
+
+    PresetValues CaptureConfig() {
+        auto& config = getTrickSaberConfig();
+        PresetValues values;
+#define TRICKSABER_CAPTURE(name, type) values.name = config.name.GetValue();
+        TRICKSABER_PRESET_FIELDS(TRICKSABER_CAPTURE)
+#undef TRICKSABER_CAPTURE
+        return values;
+    }
+
+    static void Fill(Snapshot& next, PresetValues const& values, uint32_t generation) {
+        auto& config = getTrickSaberConfig();
+        next.modEnabled = config.ModEnabled.GetValue();
+        next.thrownSabersCut = config.ThrownSabersCut.GetValue();
+        next.autoRecall = config.AutoRecall.GetValue();
+        next.threadedTick = config.ThreadedTick.GetValue();
+        next.hands[Left] = BuildHand(
+            {values.LeftSaberThrowButton, values.LeftSaberThrowChordButton, values.LeftSaberThrowDoubleTap},
+            {values.LeftSaberSpinButton, values.LeftSaberSpinChordButton, values.LeftSaberSpinDoubleTap},
+            values.LeftSaberComboButton,
+            values.LeftSaberCombo,
+            {config.LeftSaberPresetButton.GetValue(), config.LeftSaberPresetChordButton.GetValue(), false},
+            values.LeftSaberSpinClockwise,
+            values.LeftSaberSpinSpeed,
+            values.LeftSaberSpinAnchorZOffset,
+            values.LeftSaberThrowVelocityMultiplier,
+            values.LeftSaberReturnDuration,
+            values.LeftSaberReturnCurve,
+            values.LeftSaberReturnEasing,
+            values.PeakThrowVelocity,
+            true
+        );
+        next.hands[Right] = BuildHand(
+            {values.RightSaberThrowButton, values.RightSaberThrowChordButton, values.RightSaberThrowDoubleTap},
+            {values.RightSaberSpinButton, values.RightSaberSpinChordButton, values.RightSaberSpinDoubleTap},
+            values.RightSaberComboButton,
+            values.RightSaberCombo,
+            {config.RightSaberPresetButton.GetValue(), config.RightSaberPresetChordButton.GetValue(), false},
+            values.RightSaberSpinClockwise,
+            values.RightSaberSpinSpeed,
+            values.RightSaberSpinAnchorZOffset,
+            values.RightSaberThrowVelocityMultiplier,
+            values.RightSaberReturnDuration,
+            values.RightSaberReturnCurve,
+            values.RightSaberReturnEasing,
+            values.PeakThrowVelocity,
+            false
+        );
+        next.generation = generation;
+    }
+
+    void Publish(PresetValues const& values) {
+        published.Publish([&](Snapshot& next, uint32_t generation) { Fill(next, values, generation); });
+    }
+
+    void Republish() {
+        Publish(CaptureConfig());
+    }
+
+    SnapshotPin Current() {
+        return published.Acquire();
+    }
+
+    void Init() {
+        auto& config = getTrickSaberConfig();
+        auto onChange = [](auto) { Republish(); };
+
+#define TRICKSABER_SUBSCRIBE(name, type) config.name.AddChangeEvent(onChange);
+        TRICKSABER_CONFIG_FIELDS(TRICKSABER_SUBSCRIBE)
+#undef TRICKSABER_SUBSCRIBE
+
+        Republish();
+        getLogger().info("[TS] [Config] Snapshot published (gen {})", published.Generation());
+    }
+
+}  // namespace TrickSaber::Config
@@ -0,0 +1,127 @@
+#include "beatmap/gap-index.hpp"
+#include "perf/timers.hpp"
+#include "support/generated-maps.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Beatmap;
+using Test::GenerateMap;
+using Test::MapRandom;
+using Test::SongLength;
+
+namespace {
+
+    constexpr float TICK = 1.0f / 90.0f;
+
+    struct MapSize {
+        char const* name;
+        int objects;
+        float nps;
+    };
+
+    // The longest ranked maps run to a few thousand notes; the densest to ~12 notes a second
+    constexpr MapSize MAPS[] = {
+        {"typical", 1200, 6.0f},
+        {"long ranked", 5000, 10.0f},
+        {"dense ranked", 8000, 12.0f},
+    };
+
+    // The same answer as TimeUntilNextCut(), from every object.
+    float ScanUntilNextCut(std::vector<TimelineItem> const& items, int hand, float songTime) {
+        float next = INFINITY;
+        for (TimelineItem const& item : items) {
+            if (item.hand != hand || item.kind == TimelineKind::Bomb || item.kind == TimelineKind::Obstacle) continue;
+            if (item.time <= songTime && songTime < item.endTime) return 0.0f;
+            if (item.time > songTime) next = std::min(next, item.time);
+        }
+        return next - songTime;
+    }
+
+    bool Matches(float a, float b) {
+        return a == b || std::abs(a - b) <= 1e-3f;
+    }
+
+    class GapIndexMaps : public ::testing::TestWithParam<MapSize> {
+    protected:
+        void SetUp() override {
+            MapRandom random(static_cast<uint32_t>(GetParam().objects));
+            items = GenerateMap(random, GetParam().objects, GetParam().nps);
+            index = BuildGapIndex(items);
+        }
+
+        // Queries both hands at songTime through one cursor, as the tick does, against a scan.
+        void Check(float songTime, char const* how) {
+            for (int hand = 0; hand < HAND_COUNT; hand++) {
+                float indexed = TimeUntilNextCut(index, cursor, hand, songTime);
+                float scanned = ScanUntilNextCut(items, hand, songTime);
+                if (!Matches(indexed, scanned) && mismatches++ < 5) {
+                    ADD_FAILURE() << how << " at " << songTime << " s, hand " << hand << ": index " << indexed << ", scan " << scanned;
+                }
+            }
+        }
+
+        float AnyObjectTime(MapRandom& random, bool end) {
+            TimelineItem const& item = items[static_cast<int>(random.Next(0.0f, static_cast<float>(items.size()) - 0.001f))];
+            return end ? item.endTime : item.time;
+        }
+
+        std::vector<TimelineItem> items;
+        GapIndex index;
+        GapCursor cursor;
+        int mismatches = 0;
+    };
+
+}  // namespace
+
+TEST_P(GapIndexMaps, MatchesAScanWhilePlaying) {
+    // A scan per query is slow on big maps, so play a stretch of each rather than all of it
+    float length = SongLength(items);
+    int ticks = std::min(static_cast<int>(length / TICK), 4000);
+    for (int t = 0; t < ticks; t++) {
+        Check(static_cast<float>(t) * length / static_cast<float>(ticks), "playing");
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST_P(GapIndexMaps, MatchesAScanAfterSeeks) {
+    MapRandom random(7);
+    float length = SongLength(items);
+    for (int n = 0; n < 500; n++) Check(random.Next(-1.0f, length), "after a seek");
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST_P(GapIndexMaps, MatchesAScanOnObjectEdges) {
+    MapRandom random(11);
+    for (int n = 0; n < 500; n++) Check(AnyObjectTime(random, false), "on an object");
+    for (int n = 0; n < 200; n++) Check(AnyObjectTime(random, true), "at an end");
+    EXPECT_EQ(mismatches, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(Maps, GapIndexMaps, ::testing::ValuesIn(MAPS),
+                         [](::testing::TestParamInfo<MapSize> const& info) { return std::to_string(info.param.objects); });
+
+// A second level started before the first one's build finished wins, as for a level restarted
+// during loading.
+TEST(GapIndex, OnlyTheLatestWorkerBuildIsPickedUp) {
+    MapRandom random(3);
+    std::vector<TimelineItem> first = GenerateMap(random, 40000, 20.0f);
+    std::vector<TimelineItem> second = GenerateMap(random, 1200, 6.0f);
+    GapIndex expected = BuildGapIndex(second);
+    GapCursor cursor;
+    StartGapIndexBuild(first);
+    StartGapIndexBuild(second);
+    uint64_t start = Perf::NowNs();
+    GapIndex const* picked = nullptr;
+    while (!(picked = CurrentGapIndex(cursor)) && Perf::NowNs() - start < 2000000000ull) {
+    }
+    ASSERT_NE(picked, nullptr);
+    EXPECT_EQ(picked->windows[0].size(), expected.windows[0].size());
+    EXPECT_EQ(picked->windows[1].size(), expected.windows[1].size());
+    ClearGapIndex();
+}
@@ -0,0 +1,199 @@
+#include "combo/library.hpp"
+#include "support/heap-counter.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Combo;
+using Saber::SaberInteractionState;
+using Test::HeapAllocations;
+
+namespace {
+
+    constexpr uint32_t THROW = Input::ActionBit(Input::Throw);
+    constexpr uint32_t SPIN = Input::ActionBit(Input::Spin);
+    constexpr uint32_t COMBO = Input::ActionBit(Input::Combo);
+
+    // Actions the combo on slot drives this tick, or ~0u once it has finished.
+    uint32_t Step(ComboScheduler& combos, int slot, float now, SaberInteractionState state = SaberInteractionState::Held,
+        uint32_t handActions = 0) {
+        ComboContext const* context = combos.Tick(slot, now, handActions, 0, state);
+        return context ? context->actions : ~0u;
+    }
+
+    // Keeps every local it declares across a suspension, so its frame outgrows the arena.
+    Sequence OversizedCombo(ComboContext& ctx) {
+        volatile char scratch[ARENA_BYTES];
+        scratch[0] = 1;
+        co_await ctx.NextTick();
+        scratch[ARENA_BYTES - 1] = scratch[0];
+    }
+
+}  // namespace
+
+TEST(ComboScheduler, SpinThrowFollowsItsTimeline) {
+    ComboScheduler combos;
+    ASSERT_TRUE(combos.Start(3, GetCombo(SpinThrow)));
+    EXPECT_TRUE(combos.Running(3));
+
+    EXPECT_EQ(Step(combos, 3, 1.0f), SPIN);
+    EXPECT_EQ(Step(combos, 3, 1.39f), SPIN);
+    EXPECT_EQ(Step(combos, 3, 1.4f), SPIN | THROW);
+    EXPECT_EQ(Step(combos, 3, 1.79f, SaberInteractionState::Thrown), SPIN | THROW);
+    EXPECT_EQ(Step(combos, 3, 1.81f, SaberInteractionState::Thrown), 0u);
+    EXPECT_FALSE(combos.Context(3)->reverseSpin);
+
+    // Waits out the return, then counter-spins once the saber is back in the hand
+    EXPECT_EQ(Step(combos, 3, 2.0f, SaberInteractionState::Returning), 0u);
+    EXPECT_EQ(Step(combos, 3, 2.1f), SPIN);
+    EXPECT_TRUE(combos.Context(3)->reverseSpin);
+    EXPECT_EQ(Step(combos, 3, 2.4f), SPIN);
+    EXPECT_EQ(Step(combos, 3, 2.51f), ~0u);
+    EXPECT_FALSE(combos.Running(3));
+    EXPECT_EQ(combos.ActiveCount(), 0);
+}
+
+TEST(ComboScheduler, DoubleThrowThrowsTwice) {
+    ComboScheduler combos;
+    ASSERT_TRUE(combos.Start(0, GetCombo(DoubleThrow)));
+    int throws = 0;
+    uint32_t last = 0;
+    SaberInteractionState state = SaberInteractionState::Held;
+    float now = 0.0f;
+    for (int tick = 0; tick < 500; tick++, now += 1.0f / 90.0f) {
+        uint32_t actions = Step(combos, 0, now, state);
+        if (actions == ~0u) {
+            break;
+        }
+        if ((actions & THROW) && !(last & THROW)) {
+            throws++;
+            state = SaberInteractionState::Thrown;
+        } else if (!(actions & THROW) && state == SaberInteractionState::Thrown) {
+            state = SaberInteractionState::Held;  // Caught straight away
+        }
+        last = actions;
+    }
+    EXPECT_EQ(throws, 2);
+    EXPECT_FALSE(combos.Running(0));
+}
+
+TEST(ComboScheduler, ReverseSpinLastsWhileTheComboIsHeld) {
+    ComboScheduler combos;
+    ASSERT_TRUE(combos.Start(0, GetCombo(ReverseSpin)));
+    EXPECT_EQ(Step(combos, 0, 0.0f, SaberInteractionState::Held, COMBO), SPIN);
+    EXPECT_EQ(Step(combos, 0, 0.4f, SaberInteractionState::Held, COMBO), 0u);
+    EXPECT_EQ(Step(combos, 0, 0.41f, SaberInteractionState::Held, COMBO), SPIN);
+    EXPECT_TRUE(combos.Context(0)->reverseSpin);
+    for (int tick = 0; tick < 1000; tick++) {
+        ASSERT_EQ(Step(combos, 0, 0.5f + tick, SaberInteractionState::Held, COMBO), SPIN);
+    }
+    EXPECT_EQ(Step(combos, 0, 1000.0f), ~0u);
+    EXPECT_EQ(combos.ActiveCount(), 0);
+}
+
+TEST(ComboScheduler, OneComboPerSlot) {
+    ComboScheduler combos;
+    EXPECT_TRUE(combos.Start(5, GetCombo(SpinThrow)));
+    EXPECT_FALSE(combos.Start(5, GetCombo(ReverseSpin)));
+    EXPECT_TRUE(combos.Start(6, GetCombo(ReverseSpin)));
+    EXPECT_EQ(combos.ActiveCount(), 2);
+    EXPECT_EQ(combos.Context(4), nullptr);
+    EXPECT_EQ(combos.Tick(4, 0.0f, 0, 0, SaberInteractionState::Held), nullptr);
+}
+
+TEST(ComboScheduler, EveryRunnerCanBeClaimed) {
+    ComboScheduler combos;
+    for (int slot = 0; slot < Saber::MAX_SABERS; slot++) {
+        ASSERT_TRUE(combos.Start(slot, GetCombo(slot % ComboCount)));
+    }
+    EXPECT_EQ(combos.ActiveCount(), Saber::MAX_SABERS);
+    combos.Cancel(7);
+    EXPECT_FALSE(combos.Running(7));
+    EXPECT_TRUE(combos.Start(7, GetCombo(SpinThrow)));
+    combos.CancelAll();
+    EXPECT_EQ(combos.ActiveCount(), 0);
+    for (int slot = 0; slot < Saber::MAX_SABERS; slot++) {
+        ASSERT_FALSE(combos.Running(slot));
+    }
+}
+
+TEST(ComboScheduler, CancelledComboStartsOverFromItsFirstStep) {
+    ComboScheduler combos;
+    ASSERT_TRUE(combos.Start(0, GetCombo(SpinThrow)));
+    Step(combos, 0, 0.0f);
+    EXPECT_EQ(Step(combos, 0, 0.4f), SPIN | THROW);
+    combos.Cancel(0);
+    EXPECT_EQ(combos.Context(0), nullptr);
+
+    ASSERT_TRUE(combos.Start(0, GetCombo(SpinThrow)));
+    EXPECT_EQ(combos.Context(0)->actions, 0u);
+    EXPECT_EQ(Step(combos, 0, 10.0f), SPIN);
+}
+
+TEST(ComboScheduler, MoveSlotCarriesTheRunningCombo) {
+    ComboScheduler combos;
+    ASSERT_TRUE(combos.Start(9, GetCombo(SpinThrow)));
+    ASSERT_TRUE(combos.Start(2, GetCombo(ReverseSpin)));
+    EXPECT_EQ(Step(combos, 9, 0.0f), SPIN);
+    EXPECT_EQ(Step(combos, 9, 0.4f), SPIN | THROW);
+
+    // As after SaberStateStore::Remove() compacted 9 into 2
+    combos.Cancel(2);
+    combos.MoveSlot(9, 2);
+    EXPECT_FALSE(combos.Running(9));
+    ASSERT_TRUE(combos.Running(2));
+    EXPECT_EQ(combos.ActiveCount(), 1);
+    EXPECT_EQ(Step(combos, 2, 0.5f, SaberInteractionState::Thrown), SPIN | THROW);
+    EXPECT_EQ(Step(combos, 2, 0.81f, SaberInteractionState::Thrown), 0u);
+    EXPECT_TRUE(combos.Start(9, GetCombo(DoubleThrow)));
+}
+
+TEST(ComboScheduler, OversizedFrameFailsToStart) {
+    ComboScheduler combos;
+    EXPECT_FALSE(combos.Start(0, OversizedCombo));
+    EXPECT_FALSE(combos.Running(0));
+    EXPECT_EQ(combos.ActiveCount(), 0);
+    // The failed start gave its runner back
+    EXPECT_TRUE(combos.Start(0, GetCombo(SpinThrow)));
+}
+
+// Starting, running and cancelling combos on every slot stays in the runners' arenas.
+TEST(ComboScheduler, NeverTouchesTheHeap) {
+    ComboScheduler combos;
+    uint64_t before = HeapAllocations();
+    for (int round = 0; round < 3; round++) {
+        for (int slot = 0; slot < Saber::MAX_SABERS; slot++) {
+            combos.Start(slot, GetCombo((slot + round) % ComboCount));
+        }
+        float now = 0.0f;
+        for (int tick = 0; tick < 200; tick++, now += 1.0f / 90.0f) {
+            SaberInteractionState state = tick % 40 < 20 ? SaberInteractionState::Held : SaberInteractionState::Thrown;
+            for (int slot = 0; slot < Saber::MAX_SABERS; slot++) {
+                combos.Tick(slot, now, tick < 150 ? COMBO : 0, 0, state);
+            }
+        }
+        combos.CancelAll();
+    }
+    uint64_t allocations = HeapAllocations() - before;
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST(ComboScheduler, ComboTuningFlipsOnlyTheSpin) {
+    Config::HandTuning tuning{};
+    tuning.spinDirection = 1.0f;
+    tuning.spinDegPerSec = 720.0f;
+    tuning.spinRadPerSec = 12.5f;
+    tuning.throwBound = false;
+    tuning.spinBound = false;
+
+    Config::HandTuning forward = ComboTuning(tuning, false);
+    EXPECT_TRUE(forward.throwBound);
+    EXPECT_TRUE(forward.spinBound);
+    EXPECT_EQ(forward.spinDegPerSec, 720.0f);
+
+    Config::HandTuning reverse = ComboTuning(tuning, true);
+    EXPECT_TRUE(reverse.throwBound);
+    EXPECT_EQ(reverse.spinDirection, -1.0f);
+    EXPECT_EQ(reverse.spinDegPerSec, -720.0f);
+    EXPECT_EQ(reverse.spinRadPerSec, -12.5f);
+}
@@ -0,0 +1,123 @@
+#include "input/bindings.hpp"
+#include "input/hand-input.hpp"
+#include "facade.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace TrickSaber::Input;
+
+namespace {
+
+    constexpr float TICK = 1.0f / 90.0f;
+
+    struct Bindings {
+        Binding table[ActionCount] = {};
+    };
+
+    Bindings ThrowOn(Binding binding) {
+        Bindings bindings;
+        bindings.table[Throw] = binding;
+        return bindings;
+    }
+
+}  // namespace
+
+TEST(Bindings, CompileMapsConfigIndices) {
+    EXPECT_EQ(CompileBinding(0, 0, false).mask, 0u);
+    EXPECT_EQ(CompileBinding(1, 0, false).mask, ButtonOne);
+    EXPECT_EQ(CompileBinding(3, 4, false).mask, IndexTrigger | HandTrigger);
+    // A chord without a main button, or an index out of range, is unbound
+    EXPECT_EQ(CompileBinding(0, 2, false).mask, 0u);
+    EXPECT_EQ(CompileBinding(5, 0, false).mask, 0u);
+    EXPECT_EQ(CompileBinding(-1, 1, false).mask, 0u);
+    EXPECT_FALSE(CompileBinding(0, 0, true).doubleTap);
+    EXPECT_TRUE(CompileBinding(2, 0, true).doubleTap);
+}
+
+TEST(InputTracker, SingleButtonFollowsTheButton) {
+    Bindings bindings = ThrowOn(CompileBinding(3, 0, false));
+    InputTracker tracker;
+    EXPECT_EQ(tracker.Update(0, 0.0f, bindings.table), 0u);
+    EXPECT_EQ(tracker.Update(IndexTrigger, TICK, bindings.table), ActionBit(Throw));
+    EXPECT_EQ(tracker.PressedEdges(), IndexTrigger);
+    EXPECT_EQ(tracker.Update(IndexTrigger | ButtonOne, 2 * TICK, bindings.table), ActionBit(Throw));
+    EXPECT_EQ(tracker.Update(ButtonOne, 3 * TICK, bindings.table), 0u);
+    EXPECT_EQ(tracker.ReleasedEdges(), IndexTrigger);
+}
+
+TEST(InputTracker, ChordNeedsEveryButton) {
+    Bindings bindings = ThrowOn(CompileBinding(1, 4, false));
+    InputTracker tracker;
+    EXPECT_EQ(tracker.Update(ButtonOne, 0.0f, bindings.table), 0u);
+    EXPECT_EQ(tracker.Update(HandTrigger, TICK, bindings.table), 0u);
+    EXPECT_EQ(tracker.Update(ButtonOne | HandTrigger, 2 * TICK, bindings.table), ActionBit(Throw));
+    EXPECT_EQ(tracker.Update(HandTrigger, 3 * TICK, bindings.table), 0u);
+}
+
+TEST(InputTracker, DoubleTapEngagesOnTheSecondPressAndLatches) {
+    Bindings bindings = ThrowOn(CompileBinding(2, 0, true));
+    InputTracker tracker;
+    float now = 0.0f;
+    EXPECT_EQ(tracker.Update(ButtonTwo, now += TICK, bindings.table), 0u);  // First press
+    EXPECT_EQ(tracker.Update(0, now += TICK, bindings.table), 0u);
+    EXPECT_EQ(tracker.Update(ButtonTwo, now += TICK, bindings.table), ActionBit(Throw));
+    for (int k = 0; k < 90; k++) {
+        ASSERT_EQ(tracker.Update(ButtonTwo, now += TICK, bindings.table), ActionBit(Throw));
+    }
+    EXPECT_EQ(tracker.Update(0, now += TICK, bindings.table), 0u);
+    // A third press right after counts as a new first press
+    EXPECT_EQ(tracker.Update(ButtonTwo, now += TICK, bindings.table), 0u);
+}
+
+TEST(InputTracker, DoubleTapTooSlowDoesNotEngage) {
+    Bindings bindings = ThrowOn(CompileBinding(2, 0, true));
+    InputTracker tracker;
+    EXPECT_EQ(tracker.Update(ButtonTwo, 1.0f, bindings.table), 0u);
+    EXPECT_EQ(tracker.Update(0, 1.0f + TICK, bindings.table), 0u);
+    float late = 1.0f + DOUBLE_TAP_WINDOW + TICK;
+    EXPECT_EQ(tracker.Update(ButtonTwo, late, bindings.table), 0u);
+    EXPECT_EQ(tracker.Update(0, late + TICK, bindings.table), 0u);
+    // The late press starts a new window
+    EXPECT_EQ(tracker.Update(ButtonTwo, late + 2 * TICK, bindings.table), ActionBit(Throw));
+}
+
+TEST(InputTracker, ActionsSharingAButtonResolveTogether) {
+    Bindings bindings;
+    bindings.table[Throw] = CompileBinding(3, 0, false);
+    bindings.table[Spin] = CompileBinding(3, 1, false);
+    bindings.table[Combo] = CompileBinding(1, 0, false);
+    InputTracker tracker;
+    EXPECT_EQ(tracker.Update(IndexTrigger, 0.0f, bindings.table), ActionBit(Throw));
+    EXPECT_EQ(tracker.Update(IndexTrigger | ButtonOne, TICK, bindings.table), ActionBit(Throw) | ActionBit(Spin) | ActionBit(Combo));
+    tracker.Reset();
+    EXPECT_EQ(tracker.Actions(), 0u);
+    EXPECT_EQ(tracker.Buttons(), 0u);
+}
+
+// One OVRInput call per entry of each hand's poll table, and each read lands on its bit.
+TEST(HandInput, PollsEachBoundButtonOnce) {
+    TrickSaber::Config::Snapshot config = {};
+    for (auto& hand : config.hands) {
+        hand.bindings[Throw] = CompileBinding(3, 0, false);
+        hand.bindings[Spin] = CompileBinding(3, 1, false);
+        hand.pollCount = 2;
+        hand.pollButtons[0] = GlobalNamespace::OVRInput::Button::One;
+        hand.pollBits[0] = ButtonOne;
+        hand.pollButtons[1] = GlobalNamespace::OVRInput::Button::PrimaryIndexTrigger;
+        hand.pollBits[1] = IndexTrigger;
+    }
+    HandInput input;
+    Facade::heldButtons[static_cast<unsigned>(GlobalNamespace::OVRInput::Controller::LTouch)] = 0x100;
+    Facade::heldButtons[static_cast<unsigned>(GlobalNamespace::OVRInput::Controller::RTouch)] = 0x101;
+    Facade::Counts before = Facade::counts;
+    PollInput(input, config, 0.0f);
+    EXPECT_EQ((Facade::counts - before).Of(Facade::Call::InputGet), 4u);
+    EXPECT_EQ(input.actions[TrickSaber::Config::Left], ActionBit(Throw));
+    EXPECT_EQ(input.actions[TrickSaber::Config::Right], ActionBit(Throw) | ActionBit(Spin));
+    EXPECT_EQ(input.pressed[TrickSaber::Config::Right], ActionBit(Throw) | ActionBit(Spin));
+
+    PollInput(input, config, TICK);
+    EXPECT_EQ(input.pressed[TrickSaber::Config::Right], 0u);
+    Facade::heldButtons[static_cast<unsigned>(GlobalNamespace::OVRInput::Controller::LTouch)] = 0;
+    Facade::heldButtons[static_cast<unsigned>(GlobalNamespace::OVRInput::Controller::RTouch)] = 0;
+}
@@ -0,0 +1,105 @@
+#include "logger.hpp"
+#include "facade.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+using namespace TrickSaber;
+using Facade::LinesLogged;
+using Facade::LogLine;
+
+namespace {
+
+    // Lines the flush thread formatted from records, leaving out its own drop reports.
+    uint64_t RecordLines() {
+        return LinesLogged(LogLine::Debug) + LinesLogged(LogLine::Info) + LinesLogged(LogLine::Error);
+    }
+
+    // Waits for the flush thread to account for every record pushed, as a line or as a drop.
+    bool Drained(uint64_t linesBefore, uint64_t droppedBefore, uint64_t pushed) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            if ((RecordLines() - linesBefore) + (Log::DroppedRecords() - droppedBefore) == pushed) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return false;
+    }
+
+    // One record of each formatting path: info, error and debug.
+    void PushMixed(uint32_t k) {
+        switch (k % 3) {
+            case 0: Log::Push(Log::Level::Info, Log::Event::ThrowInitiated, k % 64, k % 2, static_cast<float>(k)); break;
+            case 1: Log::Push(Log::Level::Error, Log::Event::SaberInvalid, k % 64, k % 2); break;
+            default: Log::Push(Log::Level::Debug, Log::Event::ObstacleHit, k % 64, k % 2, 0.5f); break;
+        }
+    }
+
+}  // namespace
+
+TEST(HookLog, RecordsPushedBeforeStartAreKept) {
+    uint64_t lines = RecordLines();
+    uint64_t dropped = Log::DroppedRecords();
+    for (uint32_t k = 0; k < 500; k++) {
+        PushMixed(k);
+    }
+    Log::Start();
+    ASSERT_TRUE(Drained(lines, dropped, 500));
+    EXPECT_EQ(Log::DroppedRecords(), dropped);
+}
+
+TEST(HookLog, PacedProducerLosesNothing) {
+    Log::Start();
+    uint64_t lines = RecordLines();
+    uint64_t dropped = Log::DroppedRecords();
+
+    // A tick's worth of records at a time, well under a ring per flush interval
+    constexpr uint32_t BURSTS = 100;
+    constexpr uint32_t PER_BURST = 8;
+    std::thread producer([] {
+        for (uint32_t burst = 0; burst < BURSTS; burst++) {
+            for (uint32_t k = 0; k < PER_BURST; k++) {
+                PushMixed(burst * PER_BURST + k);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    });
+    producer.join();
+
+    ASSERT_TRUE(Drained(lines, dropped, BURSTS * PER_BURST));
+    EXPECT_EQ(Log::DroppedRecords(), dropped);
+}
+
+TEST(HookLog, FloodDropsAndReportsButNeverLosesCount) {
+    Log::Start();
+    uint64_t lines = RecordLines();
+    uint64_t dropped = Log::DroppedRecords();
+    uint64_t warnings = LinesLogged(LogLine::Warn);
+
+    // Far more than the flush thread drains between wakeups
+    constexpr uint32_t PUSHED = 200000;
+    std::thread producer([] {
+        for (uint32_t k = 0; k < PUSHED; k++) {
+            PushMixed(k);
+            if (k % 4096 == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    producer.join();
+
+    ASSERT_TRUE(Drained(lines, dropped, PUSHED));
+    EXPECT_GT(Log::DroppedRecords(), dropped);
+    EXPECT_GT(RecordLines(), lines);
+
+    // The drop count is reported on the flush after the drops
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (LinesLogged(LogLine::Warn) == warnings && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_GT(LinesLogged(LogLine::Warn), warnings);
+}
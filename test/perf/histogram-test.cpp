@@ -0,0 +1,87 @@
+#include "perf/histogram.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using TrickSaber::Perf::LatencyHistogram;
+
+TEST(LatencyHistogram, SmallValuesGetExactBuckets) {
+    for (uint64_t ns = 0; ns < LatencyHistogram::SUB_COUNT; ns++) {
+        int index = LatencyHistogram::BucketIndex(ns);
+        EXPECT_EQ(LatencyHistogram::BucketLowerBound(index), ns);
+        EXPECT_EQ(LatencyHistogram::BucketWidth(index), 1u);
+    }
+}
+
+TEST(LatencyHistogram, BucketsTileTheRange) {
+    // Each bucket starts where the previous one ended, and both its ends map back to it
+    uint64_t next = 0;
+    for (int index = 0; index < LatencyHistogram::BUCKET_COUNT - 1; index++) {
+        uint64_t lower = LatencyHistogram::BucketLowerBound(index);
+        uint64_t width = LatencyHistogram::BucketWidth(index);
+        ASSERT_EQ(lower, next) << "bucket " << index;
+        ASSERT_EQ(LatencyHistogram::BucketIndex(lower), index);
+        ASSERT_EQ(LatencyHistogram::BucketIndex(lower + width - 1), index);
+        next = lower + width;
+    }
+    EXPECT_EQ(LatencyHistogram::BucketIndex(uint64_t(1) << (LatencyHistogram::MAX_EXPONENT + 1)), LatencyHistogram::BUCKET_COUNT - 1);
+    EXPECT_EQ(LatencyHistogram::BucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogram, BucketErrorWithinOneSubBucket) {
+    std::mt19937_64 rng(6);
+    double bound = 1.0 / LatencyHistogram::SUB_COUNT;
+    for (int k = 0; k < 200000; k++) {
+        uint64_t ns = rng() >> (64 - 1 - static_cast<int>(rng() % (LatencyHistogram::MAX_EXPONENT + 1)));
+        int index = LatencyHistogram::BucketIndex(ns);
+        uint64_t lower = LatencyHistogram::BucketLowerBound(index);
+        ASSERT_GE(ns, lower);
+        ASSERT_LT(ns - lower, LatencyHistogram::BucketWidth(index));
+        if (ns >= LatencyHistogram::SUB_COUNT) {
+            ASSERT_LE(static_cast<double>(ns - lower) / static_cast<double>(ns), bound) << ns;
+        }
+    }
+}
+
+// Percentiles against an exact sort of the same samples, on a long-tailed hook-like
+// distribution: the reported value must be inside the right bucket, so within 1/SUB_COUNT.
+TEST(LatencyHistogram, PercentilesMatchExactWithinBucketError) {
+    std::mt19937_64 rng(60);
+    std::lognormal_distribution<double> hookNs(std::log(2000.0), 0.8);
+    std::vector<uint64_t> samples;
+    LatencyHistogram histogram;
+    for (int k = 0; k < 100000; k++) {
+        uint64_t ns = static_cast<uint64_t>(hookNs(rng));
+        if (k % 1000 == 0) {
+            ns *= 50;  // The odd GC pause
+        }
+        samples.push_back(ns);
+        histogram.Record(ns);
+    }
+    std::sort(samples.begin(), samples.end());
+    EXPECT_EQ(histogram.Count(), samples.size());
+    EXPECT_EQ(histogram.Max(), samples.back());
+
+    for (double q : {0.0, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+        uint64_t exact = samples[static_cast<size_t>(q * static_cast<double>(samples.size() - 1))];
+        uint64_t reported = histogram.Percentile(q);
+        double error = std::abs(static_cast<double>(reported) - static_cast<double>(exact)) / static_cast<double>(exact);
+        EXPECT_LE(error, 1.0 / LatencyHistogram::SUB_COUNT) << "q " << q << ": exact " << exact << ", reported " << reported;
+    }
+}
+
+TEST(LatencyHistogram, PercentileNeverExceedsMax) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.Percentile(0.5), 0u);
+    histogram.Record(1000);
+    EXPECT_EQ(histogram.Percentile(1.0), 1000u);
+    histogram.Reset();
+    EXPECT_EQ(histogram.Count(), 0u);
+    EXPECT_EQ(histogram.Max(), 0u);
+    EXPECT_EQ(histogram.Percentile(0.99), 0u);
+}
@@ -0,0 +1,330 @@
+// The trace files a capture writes must open in chrome://tracing and ui.perfetto.dev. The main
+// thread and three workers record nested spans and instants into one capture, including spans
+// cut off by its start and end, and a fifth thread that should be refused. The written JSON is
+// parsed back and checked for known phases, per-thread timestamps that never go backwards, and
+// B/E pairs that nest and close.
+
+#include "perf/trace.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace TrickSaber;
+using Trace::Span;
+
+namespace {
+
+    // Minimal JSON reader, enough for the trace file.
+    struct Json {
+        enum Type { Null, Bool, Number, String, Array, Object } type = Null;
+        double number = 0.0;
+        std::string text;
+        std::vector<Json> items;
+        std::vector<std::pair<std::string, Json>> fields;
+
+        Json const* Field(char const* name) const {
+            for (auto const& [key, value] : fields) {
+                if (key == name) return &value;
+            }
+            return nullptr;
+        }
+    };
+
+    class JsonReader {
+    public:
+        explicit JsonReader(std::string const& source) : p(source.c_str()), end(source.c_str() + source.size()) {}
+
+        bool Document(Json& out) {
+            if (!Value(out)) return false;
+            Space();
+            return p == end;
+        }
+
+    private:
+        void Space() {
+            while (p < end && std::strchr(" \t\r\n", *p)) p++;
+        }
+
+        bool Literal(char const* word) {
+            size_t n = std::strlen(word);
+            if (static_cast<size_t>(end - p) < n || std::strncmp(p, word, n) != 0) return false;
+            p += n;
+            return true;
+        }
+
+        bool Str(std::string& out) {
+            if (p >= end || *p != '"') return false;
+            for (p++; p < end && *p != '"'; p++) {
+                if (*p == '\\') return false;  // The writer never escapes; anything escaped is a bug
+                out += *p;
+            }
+            return p++ < end;
+        }
+
+        bool Value(Json& out) {
+            Space();
+            if (p >= end) return false;
+            if (*p == '{') {
+                out.type = Json::Object;
+                p++;
+                Space();
+                if (p < end && *p == '}') return ++p, true;
+                while (true) {
+                    std::string key;
+                    Json value;
+                    Space();
+                    if (!Str(key)) return false;
+                    Space();
+                    if (p >= end || *p++ != ':' || !Value(value)) return false;
+                    out.fields.emplace_back(std::move(key), std::move(value));
+                    Space();
+                    if (p < end && *p == ',') {
+                        p++;
+                        continue;
+                    }
+                    return p < end && *p++ == '}';
+                }
+            }
+            if (*p == '[') {
+                out.type = Json::Array;
+                p++;
+                Space();
+                if (p < end && *p == ']') return ++p, true;
+                while (true) {
+                    out.items.emplace_back();
+                    if (!Value(out.items.back())) return false;
+                    Space();
+                    if (p < end && *p == ',') {
+                        p++;
+                        continue;
+                    }
+                    return p < end && *p++ == ']';
+                }
+            }
+            if (*p == '"') {
+                out.type = Json::String;
+                return Str(out.text);
+            }
+            if (Literal("true") || Literal("false")) {
+                out.type = Json::Bool;
+                return true;
+            }
+            if (Literal("null")) return true;
+            char* after = nullptr;
+            out.number = std::strtod(p, &after);
+            if (after == p) return false;
+            out.type = Json::Number;
+            p = after;
+            return true;
+        }
+
+        char const* p;
+        char const* end;
+    };
+
+    struct Expected {
+        int spans = 0;  // B/E pairs that should reach the file
+        int instants = 0;
+    };
+
+    // Nested spans the way a tick looks, with instants inside some of them.
+    void RecordTicks(int ticks, Expected& expected) {
+        for (int t = 0; t < ticks; t++) {
+            TS_TRACE_SCOPE(Span::FixedUpdate);
+            expected.spans++;
+            for (int slot = 0; slot < 2; slot++) {
+                TS_TRACE_SCOPE(Span::SaberTick, slot);
+                {
+                    TS_TRACE_SCOPE(Span::StateApply, slot);
+                    if (t % 5 == slot) {
+                        TS_TRACE_INSTANT(static_cast<Log::Event>(t % 10), slot, slot, static_cast<float>(t));
+                        expected.instants++;
+                    }
+                }
+                TS_TRACE_SCOPE(Span::PoseWrite, slot);
+                expected.spans += 3;
+            }
+        }
+    }
+
+    struct Capture {
+        std::string json;
+        int written = 0;  // What WriteChromeJson() reported
+        uint64_t dropped = 0;
+        Expected expected;
+    };
+
+    // Threads keep their trace buffer for the life of the process, so there is one capture per
+    // test binary, shared by the tests below.
+    Capture RunCapture() {
+        constexpr int WORKERS = 3;
+        constexpr int TICKS = 200;
+        Expected expected[WORKERS + 1];
+        std::vector<std::thread> workers;
+
+        // The main thread opens a span before the capture starts, so its end must be dropped
+        Trace::Begin(Span::SaberInit);
+        Trace::Start();
+        Trace::End(Span::SaberInit);
+        for (int w = 0; w < WORKERS; w++) {
+            workers.emplace_back([&expected, w] { RecordTicks(TICKS, expected[w + 1]); });
+        }
+        for (auto& worker : workers) worker.join();
+        RecordTicks(TICKS, expected[0]);
+        // A fifth thread has no buffer left
+        std::thread([] { TS_TRACE_SCOPE(Span::Record); }).join();
+        // Still open when the capture stops; the writer closes it
+        Trace::Begin(Span::MainMenu);
+        Trace::Stop();
+
+        Capture capture;
+        for (auto const& e : expected) {
+            capture.expected.spans += e.spans;
+            capture.expected.instants += e.instants;
+        }
+        capture.expected.spans++;  // The span cut off by the capture's end
+        std::FILE* file = std::tmpfile();
+        if (!file) return capture;
+        capture.written = Trace::WriteChromeJson(file);
+        capture.dropped = Trace::Dropped();
+        std::rewind(file);
+        char chunk[4096];
+        size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) capture.json.append(chunk, n);
+        std::fclose(file);
+        return capture;
+    }
+
+    Capture const& TheCapture() {
+        static Capture const capture = RunCapture();
+        return capture;
+    }
+
+    class TraceFile : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            ASSERT_TRUE(JsonReader(TheCapture().json).Document(root)) << "not one JSON document";
+            ASSERT_EQ(root.type, Json::Object);
+            Json const* found = root.Field("traceEvents");
+            ASSERT_TRUE(found && found->type == Json::Array) << "no traceEvents array";
+            events = &found->items;
+        }
+
+        Json root;
+        std::vector<Json> const* events = nullptr;
+    };
+
+    // '?' and -1 for events EveryEventIsAChromeTraceEvent fails on.
+    char Phase(Json const& event) {
+        Json const* ph = event.Field("ph");
+        return ph && !ph->text.empty() ? ph->text[0] : '?';
+    }
+
+    int Tid(Json const& event) {
+        Json const* tid = event.Field("tid");
+        return tid ? static_cast<int>(tid->number) : -1;
+    }
+
+}  // namespace
+
+TEST_F(TraceFile, EveryEventIsAChromeTraceEvent) {
+    for (size_t i = 0; i < events->size(); i++) {
+        Json const& e = (*events)[i];
+        SCOPED_TRACE(testing::Message() << "event " << i);
+        ASSERT_EQ(e.type, Json::Object);
+        Json const* name = e.Field("name");
+        Json const* ph = e.Field("ph");
+        Json const* pid = e.Field("pid");
+        Json const* tid = e.Field("tid");
+        Json const* args = e.Field("args");
+        ASSERT_TRUE(name && name->type == Json::String && !name->text.empty()) << "no name";
+        ASSERT_TRUE(ph && ph->type == Json::String && ph->text.size() == 1) << "no phase";
+        ASSERT_TRUE(pid && pid->type == Json::Number && tid && tid->type == Json::Number) << "no pid/tid";
+        ASSERT_TRUE(!args || args->type == Json::Object) << "args not an object";
+        switch (ph->text[0]) {
+            case 'M':
+                EXPECT_EQ(name->text, "thread_name");
+                EXPECT_TRUE(args && args->Field("name")) << "thread_name without a name";
+                break;
+            case 'i':
+                EXPECT_TRUE(e.Field("s") && e.Field("s")->type == Json::String) << "instant without a scope";
+                EXPECT_TRUE(args && args->Field("slot") && args->Field("value")) << "instant without its slot and value";
+                [[fallthrough]];
+            case 'B':
+            case 'E':
+                EXPECT_TRUE(e.Field("ts") && e.Field("ts")->type == Json::Number) << "no ts";
+                break;
+            default:
+                ADD_FAILURE() << "unknown phase " << ph->text;
+        }
+    }
+}
+
+TEST_F(TraceFile, ThreadsAreNamedBeforeTheirEvents) {
+    std::map<int, bool> named;
+    for (size_t i = 0; i < events->size(); i++) {
+        Json const& e = (*events)[i];
+        if (Phase(e) == 'M') named[Tid(e)] = true;
+        else EXPECT_TRUE(named[Tid(e)]) << "event " << i;
+    }
+}
+
+TEST_F(TraceFile, TimestampsNeverGoBackwardsOnAThread) {
+    std::map<int, double> last;
+    for (size_t i = 0; i < events->size(); i++) {
+        Json const& e = (*events)[i];
+        if (Phase(e) == 'M') continue;
+        if (!e.Field("ts")) continue;
+        double ts = e.Field("ts")->number;
+        auto [at, added] = last.emplace(Tid(e), ts);
+        EXPECT_GE(ts, at->second) << "event " << i;
+        at->second = ts;
+    }
+}
+
+TEST_F(TraceFile, SpansNestAndClose) {
+    std::map<int, std::vector<std::string>> open;
+    for (size_t i = 0; i < events->size(); i++) {
+        Json const& e = (*events)[i];
+        std::vector<std::string>& stack = open[Tid(e)];
+        std::string name = e.Field("name") ? e.Field("name")->text : "";
+        if (Phase(e) == 'B') {
+            stack.push_back(name);
+        } else if (Phase(e) == 'E') {
+            ASSERT_FALSE(stack.empty()) << "event " << i << " ends nothing";
+            ASSERT_EQ(stack.back(), name) << "event " << i << " does not close the innermost span";
+            stack.pop_back();
+        }
+    }
+    for (auto const& [tid, stack] : open) EXPECT_TRUE(stack.empty()) << "thread " << tid << " left spans open";
+}
+
+TEST_F(TraceFile, HoldsEveryRecordedEventAndNoMore) {
+    int traceEvents = 0;
+    int spans = 0;
+    int instants = 0;
+    std::map<int, int> threads;
+    for (Json const& e : *events) {
+        if (Phase(e) == 'M') continue;
+        traceEvents++;
+        spans += Phase(e) == 'E';
+        instants += Phase(e) == 'i';
+        threads[Tid(e)]++;
+    }
+    EXPECT_EQ(traceEvents, TheCapture().written) << "event count differs from what the writer reported";
+    EXPECT_EQ(spans, TheCapture().expected.spans);
+    EXPECT_EQ(instants, TheCapture().expected.instants);
+    EXPECT_EQ(static_cast<int>(threads.size()), Trace::MAX_THREADS);
+}
+
+TEST_F(TraceFile, RefusesThreadsPastTheLimit) {
+    EXPECT_EQ(TheCapture().dropped, 2u) << "the fifth thread's begin and end";
+}
@@ -0,0 +1,273 @@
+#include "physics/blade-sweep.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace TrickSaber::Math;
+
+namespace {
+
+    constexpr float TICK = 1.0f / 90.0f;
+    constexpr float BLADE_START = 0.0f;
+    constexpr float BLADE_END = 1.0f;
+    constexpr float BLADE_RADIUS = 0.01f;
+    constexpr float NOTE_RADIUS = 0.05f;
+    constexpr int FINE_SAMPLES = 2000;
+
+    struct Pose {
+        Vec3 position;
+        Quat rotation;
+    };
+
+    struct Motion {
+        Pose from, to;
+    };
+
+    Pose PoseAt(Motion const& m, float t) { return {Lerp(m.from.position, m.to.position, t), Slerp(m.from.rotation, m.to.rotation, t)}; }
+
+    void Sweep(Motion const& m, float otherTravel, BladeSweep& sweep) {
+        SweepBlade(m.from.position, m.from.rotation, m.to.position, m.to.rotation, BLADE_START, BLADE_END, BLADE_RADIUS, otherTravel, sweep);
+    }
+
+    // The end pose alone, as a per-tick collider would see it.
+    void Discrete(Motion const& m, BladeSweep& sweep) {
+        SweepBlade(m.to.position, m.to.rotation, m.to.position, m.to.rotation, BLADE_START, BLADE_END, BLADE_RADIUS, 0.0f, sweep);
+    }
+
+    bool Hits(BladeSweep const& sweep, CutTargets const& targets, int target, BladeHit* out = nullptr) {
+        static BladeHit hits[MAX_CUT_TARGETS];
+        int count = FindBladeHits(sweep, targets, hits, MAX_CUT_TARGETS);
+        for (int h = 0; h < count; h++) {
+            if (hits[h].target == target) {
+                if (out) *out = hits[h];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Motion Spin(float degPerSec) {
+        Quat from = Identity();
+        return {{Zero(), from}, {Zero(), AngleAxis(degPerSec * TICK, Up()) * from}};
+    }
+
+    // --- Ground truth by fine sampling ---
+    float SegmentDistance(Pose const& pose, Vec3 point) {
+        Vec3 start = pose.position + pose.rotation * (Forward() * BLADE_START);
+        Vec3 along = pose.rotation * (Forward() * (BLADE_END - BLADE_START));
+        float s = std::clamp(Dot(point - start, along) / SqrMagnitude(along), 0.0f, 1.0f);
+        return Magnitude(point - (start + along * s));
+    }
+
+    bool SegmentInBox(Vec3 start, Vec3 along, Vec3 half) {
+        float const s[3] = {start.x, start.y, start.z};
+        float const a[3] = {along.x, along.y, along.z};
+        float const h[3] = {half.x, half.y, half.z};
+        float lo = 0.0f, hi = 1.0f;
+        for (int axis = 0; axis < 3; axis++) {
+            if (std::abs(a[axis]) < 1e-8f) {
+                if (std::abs(s[axis]) > h[axis]) return false;
+                continue;
+            }
+            float t1 = (-h[axis] - s[axis]) / a[axis];
+            float t2 = (h[axis] - s[axis]) / a[axis];
+            lo = std::max(lo, std::min(t1, t2));
+            hi = std::min(hi, std::max(t1, t2));
+        }
+        return lo <= hi;
+    }
+
+    // Closest the moving blade gets to the moving sphere's surface.
+    float SphereClearance(Motion const& m, CutTargets const& targets, int i) {
+        Vec3 moved = {targets.dx[i], targets.dy[i], targets.dz[i]};
+        float closest = INFINITY;
+        for (int k = 0; k <= FINE_SAMPLES; k++) {
+            float t = static_cast<float>(k) / FINE_SAMPLES;
+            closest = std::min(closest, SegmentDistance(PoseAt(m, t), targets.Center(i) - moved * (1.0f - t)));
+        }
+        return closest - targets.radius[i];
+    }
+
+    // Whether the moving blade enters the moving box grown by grow on every face.
+    bool BoxTouched(Motion const& m, CutTargets const& targets, int i, float grow) {
+        Vec3 moved = {targets.dx[i], targets.dy[i], targets.dz[i]};
+        Quat toLocal = Inverse(targets.rotation[i]);
+        Vec3 half = targets.halfExtents[i] + Vec3{grow, grow, grow};
+        for (int k = 0; k <= FINE_SAMPLES; k++) {
+            float t = static_cast<float>(k) / FINE_SAMPLES;
+            Pose pose = PoseAt(m, t);
+            Vec3 start = pose.position + pose.rotation * (Forward() * BLADE_START) - (targets.Center(i) - moved * (1.0f - t));
+            if (SegmentInBox(toLocal * start, toLocal * (pose.rotation * (Forward() * (BLADE_END - BLADE_START))), half)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // How far past the blade's own radius the sweep may report target i.
+    float Slack(BladeSweep const& sweep, CutTargets const& targets, int i) {
+        if (targets.kind[i] == CutTargetKind::Bomb) {
+            return 0.5f * BOMB_SAMPLE_SPACING + 5e-4f;  // Plus the chord's distance from the arc
+        }
+        int steps = sweep.samples - 1;
+        float moved = Magnitude(Vec3{targets.dx[i], targets.dy[i], targets.dz[i]});
+        return sweep.inflate - BLADE_RADIUS + (steps > 0 ? 0.5f * moved / static_cast<float>(steps) : 0.0f);
+    }
+
+    // --- Random motions and targets ---
+    uint32_t rng = 1;
+
+    float Random(float lo, float hi) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return lo + (hi - lo) * static_cast<float>(rng >> 8) / static_cast<float>(1 << 24);
+    }
+
+    Vec3 RandomVec(float extent) { return {Random(-extent, extent), Random(-extent, extent), Random(-extent, extent)}; }
+
+    Quat RandomRotation() {
+        return Normalized(Quat{Random(-1.0f, 1.0f), Random(-1.0f, 1.0f), Random(-1.0f, 1.0f), Random(-1.0f, 1.0f)});
+    }
+
+    CutTargets targets;
+    BladeSweep sweep, single;
+
+}  // namespace
+
+TEST(BladeSweep, FastSpinCutsTheNoteItPasses) {
+    for (float rate : {2000.0f, 3000.0f}) {
+        // Halfway through the tick's arc, 0.8 m out along the blade
+        Motion m = Spin(rate);
+        targets.Clear();
+        targets.AddSphere(nullptr, CutTargetKind::Note, AngleAxis(0.5f * rate * TICK, Up()) * (Forward() * 0.8f), Zero(), NOTE_RADIUS);
+        Sweep(m, targets.maxMove, sweep);
+        Discrete(m, single);
+        BladeHit hit;
+        ASSERT_TRUE(Hits(sweep, targets, 0, &hit)) << rate << " deg/s";
+        EXPECT_FALSE(Hits(single, targets, 0)) << "the end pose alone already hits at " << rate << " deg/s";
+        EXPECT_LE(Magnitude(hit.point - targets.Center(0)), NOTE_RADIUS + sweep.inflate);
+        // Turning about +Y, the blade point moves along Up x point
+        EXPECT_GT(Dot(hit.cutDirection, Normalized(Cross(Up(), hit.point))), 0.95f);
+    }
+}
+
+TEST(BladeSweep, NearMissesBeyondTheGrownRadiusAreMissed) {
+    Motion m = Spin(3000.0f);
+    Quat halfway = AngleAxis(0.5f * 3000.0f * TICK, Up());
+    targets.Clear();
+    targets.AddSphere(nullptr, CutTargetKind::Note, halfway * (Forward() * (BLADE_END + NOTE_RADIUS + 0.045f)), Zero(), NOTE_RADIUS);
+    targets.AddSphere(nullptr, CutTargetKind::Note, halfway * (Forward() * 0.5f) + Up() * (NOTE_RADIUS + 0.045f), Zero(), NOTE_RADIUS);
+    Sweep(m, targets.maxMove, sweep);
+    EXPECT_FALSE(Hits(sweep, targets, 0)) << "4.5 cm past the tip";
+    EXPECT_FALSE(Hits(sweep, targets, 1)) << "4.5 cm above the spin";
+}
+
+TEST(BladeSweep, NoteCrossingAStillBladeIsCut) {
+    Motion m = {{Zero(), Identity()}, {Zero(), Identity()}};
+    targets.Clear();
+    targets.AddSphere(nullptr, CutTargetKind::Note, {0.5f, 0.0f, 0.5f}, {1.0f, 0.0f, 0.0f}, NOTE_RADIUS);
+    Sweep(m, targets.maxMove, sweep);
+    Discrete(m, single);
+    EXPECT_TRUE(Hits(sweep, targets, 0));
+    EXPECT_FALSE(Hits(single, targets, 0));
+}
+
+TEST(BladeSweep, FlungBladeHitsAThinWall) {
+    for (float turn : {0.0f, 30.0f}) {
+        Motion m = {{{-0.6f, 0.0f, 0.0f}, Identity()}, {{0.6f, 0.0f, 0.0f}, AngleAxis(20.0f, Up())}};
+        targets.Clear();
+        targets.AddBox(nullptr, {0.0f, 0.0f, 0.5f}, AngleAxis(turn, Up()), {0.025f, 1.0f, 0.25f}, Zero());
+        Sweep(m, targets.maxMove, sweep);
+        Discrete(m, single);
+        EXPECT_TRUE(Hits(sweep, targets, 0)) << "wall turned " << turn << " deg";
+        EXPECT_FALSE(Hits(single, targets, 0)) << "wall turned " << turn << " deg";
+    }
+}
+
+// A note and a bomb the same distance past the tip, inside the grown radius but clear of the
+// blade's own: the note is cut early, the bomb is missed.
+TEST(BladeSweep, BombsWithinTheGrownRadiusOnlyAreMissed) {
+    Motion m = Spin(3000.0f);
+    for (int k = 0; k < 8; k++) {
+        // Anywhere along the arc, not only at a sample
+        Quat at = AngleAxis((0.1f + 0.1f * static_cast<float>(k)) * 3000.0f * TICK, Up());
+        for (float gap : {0.003f, 0.008f}) {
+            targets.Clear();
+            Vec3 center = at * (Forward() * (BLADE_END + BLADE_RADIUS + NOTE_RADIUS + gap));
+            targets.AddSphere(nullptr, CutTargetKind::Note, center, Zero(), NOTE_RADIUS);
+            targets.AddSphere(nullptr, CutTargetKind::Bomb, center, Zero(), NOTE_RADIUS);
+            Sweep(m, targets.maxMove, sweep);
+            ASSERT_GT(sweep.inflate - BLADE_RADIUS, gap);
+            EXPECT_TRUE(Hits(sweep, targets, 0)) << "note " << gap * 1000.0f << " mm clear at " << k;
+            EXPECT_FALSE(Hits(sweep, targets, 1)) << "bomb " << gap * 1000.0f << " mm clear at " << k;
+        }
+    }
+}
+
+TEST(BladeSweep, BombsTheBladeTouchesAreHit) {
+    Motion m = Spin(3000.0f);
+    for (int k = 0; k < 8; k++) {
+        Quat at = AngleAxis((0.1f + 0.1f * static_cast<float>(k)) * 3000.0f * TICK, Up());
+        targets.Clear();
+        Vec3 center = at * (Forward() * (BLADE_END + BLADE_RADIUS + NOTE_RADIUS - 0.001f));
+        targets.AddSphere(nullptr, CutTargetKind::Bomb, center, Zero(), NOTE_RADIUS);
+        Sweep(m, targets.maxMove, sweep);
+        BladeHit hit;
+        ASSERT_TRUE(Hits(sweep, targets, 0, &hit)) << "at " << k;
+        // Reported where the blade reached it, not at the sample before
+        EXPECT_LE(Magnitude(hit.point - center), NOTE_RADIUS + BLADE_RADIUS + BOMB_SAMPLE_SPACING);
+        float contact = 1.0f;
+        for (int f = FINE_SAMPLES; f >= 0; f--) {
+            float t = static_cast<float>(f) / FINE_SAMPLES;
+            if (SegmentDistance(PoseAt(m, t), center) <= NOTE_RADIUS + BLADE_RADIUS) contact = t;
+        }
+        EXPECT_NEAR(hit.time, contact, 0.01f);
+    }
+}
+
+// Random blade motions (up to 3000 deg/s and 30 m/s) against random moving notes, bombs and
+// walls, compared with the same motion sampled finely. Every contact must be reported, and
+// every report must be within the slack the sweep allows for its kind.
+TEST(BladeSweep, AgreesWithFineSampling) {
+    static BladeHit hits[MAX_CUT_TARGETS];
+    rng = 1;
+    int contacts = 0, missed = 0, outside = 0;
+    for (int trial = 0; trial < 300; trial++) {
+        Motion m;
+        m.from = {RandomVec(0.5f), RandomRotation()};
+        float spin = Random(0.0f, 3000.0f) * TICK;
+        m.to = {m.from.position + RandomVec(30.0f * TICK), AngleAxis(spin, RandomVec(1.0f)) * m.from.rotation};
+        targets.Clear();
+        for (int n = 0; n < 8; n++) {
+            Vec3 center = RandomVec(1.2f);
+            Vec3 moved = RandomVec(n < 4 ? 0.02f : 0.5f);
+            if (n % 4 == 3) {
+                targets.AddBox(nullptr, center, RandomRotation(), {Random(0.01f, 0.3f), Random(0.01f, 0.3f), Random(0.01f, 0.3f)}, moved);
+            } else {
+                targets.AddSphere(nullptr, n % 4 == 2 ? CutTargetKind::Bomb : CutTargetKind::Note, center, moved, Random(0.02f, 0.3f));
+            }
+        }
+        Sweep(m, targets.maxMove, sweep);
+        int count = FindBladeHits(sweep, targets, hits, MAX_CUT_TARGETS);
+        for (int i = 0; i < targets.count; i++) {
+            bool found = false;
+            for (int h = 0; h < count; h++) {
+                found |= hits[h].target == i;
+            }
+            bool obstacle = targets.kind[i] == CutTargetKind::Obstacle;
+            float clearance = obstacle ? 0.0f : SphereClearance(m, targets, i);
+            bool touched = obstacle ? BoxTouched(m, targets, i, BLADE_RADIUS) : clearance <= BLADE_RADIUS;
+            bool allowed = obstacle ? BoxTouched(m, targets, i, BLADE_RADIUS + Slack(sweep, targets, i) + 1e-4f)
+                                    : clearance <= BLADE_RADIUS + Slack(sweep, targets, i) + 1e-4f;
+            contacts += touched;
+            missed += touched && !found;
+            outside += found && !allowed;
+        }
+    }
+    EXPECT_GT(contacts, 40);
+    EXPECT_EQ(missed, 0);
+    EXPECT_EQ(outside, 0);
+}
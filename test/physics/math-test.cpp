@@ -0,0 +1,159 @@
+// The native math against Unity's own formulas (test/support/unity-math.hpp). The suite runs
+// twice on the host: in tricksaberlite_test with the SIMD quaternion path (SSE here, NEON on
+// arm64), and in tricksaberlite_math_scalar_test built with TS_MATH_SCALAR.
+
+#include "physics/math.hpp"
+#include "support/unity-math.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace TrickSaber::Math;
+namespace Unity = TrickSaber::Test::Unity;
+
+namespace {
+
+#if defined(TS_MATH_NEON)
+    constexpr char const* KERNEL_PATH = "neon";
+#elif defined(TS_MATH_SSE)
+    constexpr char const* KERNEL_PATH = "sse";
+#else
+    constexpr char const* KERNEL_PATH = "scalar";
+#endif
+
+    constexpr int SAMPLES = 10000;
+    constexpr double TOLERANCE = 1e-5;    // Per component, for unit-length inputs
+    constexpr double ANGLE_BOUND = 0.01;  // degrees
+
+    class Inputs {
+    public:
+        Vec3 Vector(float scale = 2.0f) {
+            std::uniform_real_distribution<float> d(-scale, scale);
+            return {d(random), d(random), d(random)};
+        }
+
+        Quat Rotation() {
+            std::normal_distribution<float> d;
+            return Normalized(Quat{d(random), d(random), d(random), d(random)});
+        }
+
+        float Between(float lo, float hi) { return std::uniform_real_distribution<float>(lo, hi)(random); }
+
+    private:
+        std::mt19937 random{20261017};
+    };
+
+    double Difference(Vec3 a, Unity::Vector3<> b) {
+        return std::max({std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z)});
+    }
+
+    double Difference(Quat a, Unity::Quaternion<> b) {
+        return std::max({std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z), std::abs(a.w - b.w)});
+    }
+
+    // Degrees between two rotations, from the vector part of a * inverse(b), so either sign of
+    // either quaternion gives the same angle.
+    double AngleBetween(Quat a, Unity::Quaternion<> b) {
+        Unity::Quaternion<> d = Unity::Multiply(Unity::From(a), {-b.x, -b.y, -b.z, b.w});
+        double sinHalf = std::min(1.0, std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z));
+        return 2.0 * std::asin(sinHalf) * (180.0 / 3.14159265358979323846);
+    }
+
+}  // namespace
+
+TEST(Math, ReportsItsKernelPath) {
+    RecordProperty("kernel_path", KERNEL_PATH);
+    SUCCEED() << KERNEL_PATH;
+}
+
+TEST(Math, QuaternionProductMatchesUnity) {
+    Inputs in;
+    for (int n = 0; n < SAMPLES; n++) {
+        Quat a = in.Rotation();
+        Quat b = in.Rotation();
+        ASSERT_LE(Difference(a * b, Unity::Multiply(Unity::From(a), Unity::From(b))), TOLERANCE) << "sample " << n;
+    }
+}
+
+// Quaternion products are not commutative; the SIMD lane patterns must keep Unity's order.
+TEST(Math, QuaternionProductKeepsOperandOrder) {
+    Quat yaw = AngleAxis(90.0f, Up());
+    Quat pitch = AngleAxis(90.0f, Right());
+    EXPECT_LE(Difference(yaw * pitch, Unity::Multiply(Unity::From(yaw), Unity::From(pitch))), TOLERANCE);
+    EXPECT_GT(Difference(yaw * pitch, Unity::Multiply(Unity::From(pitch), Unity::From(yaw))), 0.1);
+}
+
+TEST(Math, RotatingAVectorMatchesUnity) {
+    Inputs in;
+    for (int n = 0; n < SAMPLES; n++) {
+        Quat q = in.Rotation();
+        Vec3 v = in.Vector();
+        ASSERT_LE(Difference(q * v, Unity::Rotate(Unity::From(q), Unity::From(v))), 4.0 * TOLERANCE) << "sample " << n;
+    }
+}
+
+TEST(Math, CrossMatchesUnity) {
+    Inputs in;
+    for (int n = 0; n < SAMPLES; n++) {
+        Vec3 a = in.Vector();
+        Vec3 b = in.Vector();
+        ASSERT_LE(Difference(Cross(a, b), Unity::Cross(Unity::From(a), Unity::From(b))), 4.0 * TOLERANCE) << "sample " << n;
+    }
+}
+
+TEST(Math, NormalizedVectorMatchesUnity) {
+    Inputs in;
+    for (int n = 0; n < SAMPLES; n++) {
+        Vec3 v = in.Vector(n % 2 ? 100.0f : 1e-3f);
+        ASSERT_LE(Difference(Normalized(v), Unity::Normalized(Unity::From(v))), TOLERANCE) << "sample " << n;
+    }
+    // Below Vector3.kEpsilon both give zero rather than NaN
+    Vec3 tiny = Normalized(Vec3{1e-6f, -1e-6f, 0.0f});
+    EXPECT_EQ(tiny.x, 0.0f);
+    EXPECT_EQ(tiny.y, 0.0f);
+    EXPECT_EQ(tiny.z, 0.0f);
+}
+
+TEST(Math, NormalizedQuaternionMatchesUnity) {
+    Inputs in;
+    for (int n = 0; n < SAMPLES; n++) {
+        Quat q = in.Rotation();
+        float scale = in.Between(0.1f, 10.0f);
+        Quat scaled = {q.x * scale, q.y * scale, q.z * scale, q.w * scale};
+        ASSERT_LE(Difference(Normalized(scaled), Unity::Normalized(Unity::From(scaled))), TOLERANCE) << "sample " << n;
+    }
+    Quat zero = Normalized(Quat{0.0f, 0.0f, 0.0f, 0.0f});
+    EXPECT_EQ(zero.w, 1.0f);
+}
+
+TEST(Math, AngleAxisMatchesUnity) {
+    Inputs in;
+    for (int n = 0; n < SAMPLES; n++) {
+        float angle = in.Between(-720.0f, 720.0f);
+        Vec3 axis = in.Vector();  // Not normalized, as callers pass it
+        ASSERT_LE(Difference(AngleAxis(angle, axis), Unity::AngleAxis<double>(angle, Unity::From(axis))), 4.0 * TOLERANCE)
+            << "sample " << n << ", " << angle << " deg";
+    }
+}
+
+TEST(Math, SlerpMatchesUnity) {
+    Inputs in;
+    for (int n = 0; n < SAMPLES; n++) {
+        Quat a = in.Rotation();
+        // Every fourth pair nearly parallel, where Slerp falls back to a normalized lerp
+        Quat b = n % 4 ? in.Rotation() : Normalized(a * AngleAxis(in.Between(-4.0f, 4.0f), in.Vector()));
+        float t = in.Between(-0.25f, 1.25f);  // Clamped by both
+        ASSERT_LE(AngleBetween(Slerp(a, b, t), Unity::Slerp<double>(Unity::From(a), Unity::From(b), t)), ANGLE_BOUND)
+            << "sample " << n << ", t " << t;
+    }
+}
+
+TEST(Math, SlerpTakesTheShortWayRound) {
+    Quat a = AngleAxis(10.0f, Up());
+    Quat far = AngleAxis(-10.0f, Up());
+    Quat b = {-far.x, -far.y, -far.z, -far.w};  // The same rotation, the other hemisphere
+    EXPECT_LE(AngleBetween(Slerp(a, b, 0.5f), Unity::Quaternion<>{0.0, 0.0, 0.0, 1.0}), ANGLE_BOUND);
+}
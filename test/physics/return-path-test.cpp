@@ -0,0 +1,217 @@
+// Where returns land. A saber is recalled from 2 m out while its hand moves at a steady
+// velocity and turns, and the trick machine's own AdvanceMotion() flies it back at 72, 90 and
+// 120 Hz, for every path style and a range of hand speeds.
+
+#include "physics/return-path.hpp"
+#include "saber/trick-machine.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Math;
+using Saber::SaberInteractionState;
+
+namespace {
+
+    constexpr float RETURN_DURATION = 0.2f;
+    constexpr float POSITION_BOUND = 1e-4f;  // metres
+    constexpr float ANGLE_BOUND = 0.05f;     // degrees
+    constexpr float AIM_SLACK = 0.02f;       // metres; the hand turns ~1 cm of the rest offset per return
+    constexpr float EASED_CATCH_RATIO = 0.25f;
+    constexpr float FULLY_LED_SPEED = 1.5f;  // m/s of hand the lead must keep up with over a return
+    static_assert(FULLY_LED_SPEED * RETURN_DURATION <= MAX_RETURN_LEAD);
+
+    constexpr float RATES[] = {72.0f, 90.0f, 120.0f};
+    constexpr float SPEEDS[] = {0.0f, 0.75f, 1.5f, 3.0f};
+    constexpr Vec3 DIRECTIONS[] = {{1.0f, 0.0f, 0.0f}, {0.0f, 0.6f, 0.8f}, {-0.6f, -0.48f, 0.64f}};
+
+    // A hand moving at a steady velocity and turning, and the saber it holds.
+    struct HostTrickIO {
+        Vec3 handPosition;
+        Quat handRotation;
+        Vec3 saberPosition;
+        Quat saberRotation;
+
+        Vec3 HandPointToWorld(Vec3 local) { return handPosition + handRotation * local; }
+        Quat HandRotation() { return handRotation; }
+
+        void SetLocal(Vec3 position, Quat rotation) {
+            saberPosition = HandPointToWorld(position);
+            saberRotation = handRotation * rotation;
+        }
+
+        void SetWorld(Vec3 position, Quat rotation) {
+            saberPosition = position;
+            saberRotation = rotation;
+        }
+
+        template <Log::Level L>
+        void Emit(Log::Event, float = 0.0f) {}
+    };
+
+    void MoveHand(HostTrickIO& io, Vec3 velocity, float time) {
+        io.handPosition = Vec3{0.2f, 1.2f, 0.3f} + velocity * time;
+        io.handRotation = AngleAxis(30.0f * time, Up());
+    }
+
+    struct Landing {
+        float finalError;  // metres from the hand target on the last return pose
+        float finalAngle;  // degrees
+        float aimError;    // furthest the aim was from the hand target at the catch
+        float chaseError;  // the same for the hand's position at the time, as the old return aimed
+        float lastStep;    // how far the saber moved on the last tick, in world space
+    };
+
+    float AngleBetween(Quat a, Quat b) {
+        return 2.0f * std::acos(std::min(1.0f, std::abs(Dot(a, b)))) * RAD2DEG;
+    }
+
+    Landing FlyReturn(uint8_t style, Vec3 handVelocity, float tickRate) {
+        static Saber::TrickHotState s;
+        s = Saber::TrickHotState();
+        s.count = 1;
+        Saber::SaberRestPose rest = {{0.0f, 0.0f, 0.1f}, Identity(), {1.0f, 1.0f, 1.0f}};
+        Config::HandTuning tuning = {};
+        tuning.returnDuration = RETURN_DURATION;
+        tuning.returnStyle = style;
+        tuning.returnPath = &ReturnPathFor(style);
+
+        float dt = 1.0f / tickRate;
+        HostTrickIO io;
+        float time = -0.2f;  // Hand history for the velocity fit before the recall
+        for (; time < 0.0f; time += dt) {
+            MoveHand(io, handVelocity, time);
+            s.handPosition[0] = io.handPosition;
+            Saber::PushHandSamples(s, static_cast<uint64_t>((time + 1.0f) * 1e9f));
+        }
+
+        s.state[0] = SaberInteractionState::Returning;
+        s.trajectory[0] = ThrowTrajectory(io.handPosition + Vec3{0.5f, 0.3f, 1.8f}, Identity(), Zero(), Vec3{0.0f, 0.0f, 20.0f});
+        s.flightTime[0] = 0.5f;
+        s.returnTime[0] = 0.0f;
+        s.trajectory[0].Evaluate(s.flightTime[0], s.releasePosition[0], s.releaseRotation[0]);
+
+        Vec3 aims[256];
+        Vec3 chases[256];
+        Vec3 positions[256];
+        int ticks = 0;
+        while (s.state[0] == SaberInteractionState::Returning && ticks < 256) {
+            time += dt;
+            MoveHand(io, handVelocity, time);
+            s.handPosition[0] = io.handPosition;
+            Saber::PushHandSamples(s, static_cast<uint64_t>((time + 1.0f) * 1e9f));
+            Saber::AdvanceMotion(s, 0, rest, tuning, dt, io);
+            // The same aim AdvanceMotion() just used
+            Vec3 target = io.HandPointToWorld(rest.position);
+            aims[ticks] = Saber::ReturnAim(s, 0, target, tuning.returnDuration);
+            chases[ticks] = target;
+            positions[ticks] = io.saberPosition;
+            ticks++;
+        }
+
+        Vec3 catchTarget = io.HandPointToWorld(rest.position);
+        Landing landing = {};
+        landing.finalError = Magnitude(io.saberPosition - catchTarget);
+        landing.finalAngle = AngleBetween(io.saberRotation, io.handRotation * rest.rotation);
+        for (int k = 0; k < ticks; k++) {
+            landing.aimError = std::max(landing.aimError, Magnitude(aims[k] - catchTarget));
+            landing.chaseError = std::max(landing.chaseError, Magnitude(chases[k] - catchTarget));
+        }
+        landing.lastStep = ticks > 1 ? Magnitude(positions[ticks - 1] - positions[ticks - 2]) : 0.0f;
+        return landing;
+    }
+
+    // Every tick rate, hand speed and direction, with what the failure message needs.
+    template <typename Check>
+    void ForEachReturn(Check check) {
+        for (float rate : RATES) {
+            for (float speed : SPEEDS) {
+                for (Vec3 direction : DIRECTIONS) {
+                    SCOPED_TRACE(testing::Message() << rate << " Hz, hand " << speed << " m/s along (" << direction.x << ", "
+                                                    << direction.y << ", " << direction.z << ")");
+                    check(rate, speed, Normalized(direction) * speed);
+                }
+            }
+        }
+    }
+
+    struct Style {
+        ReturnCurve curve;
+        ReturnEasing easing;
+    };
+
+    // Every curve with each of the easings given, or with every easing.
+    std::vector<Style> Styles(std::vector<ReturnEasing> easings = {}) {
+        if (easings.empty()) {
+            for (int easing = 0; easing < static_cast<int>(ReturnEasing::Count); easing++) {
+                easings.push_back(static_cast<ReturnEasing>(easing));
+            }
+        }
+        std::vector<Style> styles;
+        for (int curve = 0; curve < static_cast<int>(ReturnCurve::Count); curve++) {
+            for (ReturnEasing easing : easings) styles.push_back({static_cast<ReturnCurve>(curve), easing});
+        }
+        return styles;
+    }
+
+    std::string StyleName(::testing::TestParamInfo<Style> const& info) {
+        static char const* const CURVES[] = {"Straight", "Arc", "Curl"};
+        static char const* const EASINGS[] = {"Linear", "EaseIn", "EaseOut", "EaseInOut"};
+        return std::string(CURVES[static_cast<int>(info.param.curve)]) + EASINGS[static_cast<int>(info.param.easing)];
+    }
+
+    class ReturnPathStyles : public ::testing::TestWithParam<Style> {
+    protected:
+        uint8_t StyleByte() const { return ReturnStyle(GetParam().curve, GetParam().easing); }
+    };
+
+    class EasedReturnPathStyles : public ReturnPathStyles {};
+
+}  // namespace
+
+TEST_P(ReturnPathStyles, LandsOnTheRestPose) {
+    ForEachReturn([&](float rate, float, Vec3 velocity) {
+        Landing landing = FlyReturn(StyleByte(), velocity, rate);
+        EXPECT_LE(landing.finalError, POSITION_BOUND);
+        EXPECT_LE(landing.finalAngle, ANGLE_BOUND);
+    });
+}
+
+// Never further from where the hand is at the catch than the tick length, the lead cap and the
+// hand's turning (which the lead ignores) can account for.
+TEST_P(ReturnPathStyles, AimsAtWhereTheHandWillBe) {
+    ForEachReturn([&](float rate, float speed, Vec3 velocity) {
+        Landing landing = FlyReturn(StyleByte(), velocity, rate);
+        float bound = AIM_SLACK + speed / rate + std::max(0.0f, speed - FULLY_LED_SPEED) * RETURN_DURATION;
+        EXPECT_LE(landing.aimError, bound);
+    });
+}
+
+// With Ease Out and Ease In-Out the last step before the catch is at most a quarter of the same
+// curve's Linear one. The catch tick can land up to a tick after returnDuration, past the
+// predicted point, so the hand's own motion over a tick is allowed on top.
+TEST_P(EasedReturnPathStyles, SettlesIntoTheHand) {
+    uint8_t linear = ReturnStyle(GetParam().curve, ReturnEasing::Linear);
+    ForEachReturn([&](float rate, float speed, Vec3 velocity) {
+        float lastStep = FlyReturn(StyleByte(), velocity, rate).lastStep;
+        EXPECT_LE(lastStep, EASED_CATCH_RATIO * FlyReturn(linear, velocity, rate).lastStep + speed / rate);
+    });
+}
+
+INSTANTIATE_TEST_SUITE_P(Styles, ReturnPathStyles, ::testing::ValuesIn(Styles()), StyleName);
+INSTANTIATE_TEST_SUITE_P(Styles, EasedReturnPathStyles, ::testing::ValuesIn(Styles({ReturnEasing::EaseOut, ReturnEasing::EaseInOut})),
+                         StyleName);
+
+// The old return chased the hand's position at the time; leading it must aim closer to the catch.
+TEST(ReturnPath, LeadAimsCloserThanChasing) {
+    for (float speed : SPEEDS) {
+        if (speed == 0.0f) continue;
+        Landing landing = FlyReturn(DEFAULT_RETURN_STYLE, Vec3{speed, 0.0f, 0.0f}, 90.0f);
+        EXPECT_LT(landing.aimError, landing.chaseError) << "hand " << speed << " m/s";
+    }
+}
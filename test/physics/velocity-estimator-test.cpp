@@ -0,0 +1,143 @@
+#include "physics/velocity-estimator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+using namespace TrickSaber::Math;
+
+namespace {
+
+    constexpr float WINDOW = 0.05f;
+    constexpr double PI = 3.14159265358979;
+
+    uint64_t Ns(double seconds) { return static_cast<uint64_t>(seconds * 1e9); }
+
+    // A hand swinging along x at up to 2.8 m/s, as a forehand flick does.
+    constexpr double AMPLITUDE = 0.3;
+    constexpr double OMEGA = 2.0 * PI * 1.5;
+    double SwingPosition(double t) { return AMPLITUDE * std::sin(OMEGA * t); }
+    double SwingVelocity(double t) { return AMPLITUDE * OMEGA * std::cos(OMEGA * t); }
+
+    struct TraceError {
+        double fitted;      // RMS m/s of MotionHistory
+        double difference;  // RMS m/s of a one-tick finite difference
+    };
+
+    // Unity's frame loop: each frame at renderHz (with a little frame-time jitter) re-poses the
+    // hand with noiseM of tracking noise, then runs however many fixed ticks at tickHz are due,
+    // back to back. Each tick stamps its read with the clock, as PushHandSamples() does, and
+    // the old estimate divided the change since the last tick by the fixed deltaTime.
+    TraceError JitteryTrace(double renderHz, double tickHz, double noiseM, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> noise(0.0, noiseM);
+        std::uniform_real_distribution<double> frameJitter(-0.001, 0.001);
+        MotionHistory history;
+        double fittedSqr = 0.0, differenceSqr = 0.0;
+        int measured = 0;
+        double fixedTime = 0.0;
+        double lastRead = SwingPosition(0.0);
+        for (int frame = 1; frame < static_cast<int>(4.0 * renderHz); frame++) {
+            double frameTime = frame / renderHz + frameJitter(rng);
+            double position = SwingPosition(frameTime) + noise(rng);
+            double truth = SwingVelocity(frameTime);
+            for (int tick = 0; fixedTime + 1.0 / tickHz <= frameTime; tick++) {
+                fixedTime += 1.0 / tickHz;
+                history.Push(Ns(frameTime + tick * 20e-6), {static_cast<float>(position), 1.2f, 0.3f});
+                if (frame > 10) {
+                    double fitted = history.LinearVelocity(WINDOW).x;
+                    double difference = (position - lastRead) * tickHz;
+                    fittedSqr += (fitted - truth) * (fitted - truth);
+                    differenceSqr += (difference - truth) * (difference - truth);
+                    measured++;
+                }
+                lastRead = position;
+            }
+        }
+        return {std::sqrt(fittedSqr / measured), std::sqrt(differenceSqr / measured)};
+    }
+
+}  // namespace
+
+TEST(MotionHistory, ConstantVelocityIsExact) {
+    MotionHistory history;
+    Vec3 velocity = {1.5f, -0.5f, 2.0f};
+    for (int k = 0; k < 12; k++) {
+        double t = k / 90.0;
+        history.Push(Ns(t), velocity * static_cast<float>(t));
+    }
+    EXPECT_LT(Magnitude(history.LinearVelocity(WINDOW) - velocity), 1e-3f);
+}
+
+TEST(MotionHistory, QuadraticMotionHasNoLag) {
+    // x = t^2 has velocity 2t at the newest sample; a centred difference would report the mid-window value
+    MotionHistory history;
+    double end = 0.5;
+    for (int k = 0; k < 10; k++) {
+        double t = end - (9 - k) / 120.0;
+        history.Push(Ns(t), {static_cast<float>(t * t), 0.0f, 0.0f});
+    }
+    EXPECT_NEAR(history.LinearVelocity(WINDOW).x, 2.0 * end, 2e-3);
+}
+
+TEST(MotionHistory, RepeatedAndStaleSamplesAreDropped) {
+    MotionHistory history;
+    history.Push(Ns(0.00), {0.0f, 0.0f, 0.0f});
+    history.Push(Ns(0.01), {0.1f, 0.0f, 0.0f});
+    history.Push(Ns(0.02), {0.1f, 0.0f, 0.0f});  // Not re-posed since the last tick
+    history.Push(Ns(0.01), {0.5f, 0.0f, 0.0f});  // Older than the newest
+    EXPECT_EQ(history.Size(), 2);
+    EXPECT_NEAR(history.LinearVelocity(WINDOW).x, 10.0f, 1e-3f);
+}
+
+TEST(MotionHistory, TooFewSamplesGiveZero) {
+    MotionHistory history;
+    EXPECT_EQ(SqrMagnitude(history.LinearVelocity(WINDOW)), 0.0f);
+    history.Push(Ns(0.0), {1.0f, 2.0f, 3.0f});
+    EXPECT_EQ(SqrMagnitude(history.LinearVelocity(WINDOW)), 0.0f);
+    history.Reset();
+    EXPECT_EQ(history.Size(), 0);
+}
+
+// The case the estimator exists for: render and tick clocks that beat against each other,
+// plus tracking noise, where a one-tick difference aliases between no motion and double.
+TEST(MotionHistory, JitteryTraceErrorStaysLow) {
+    for (uint32_t seed : {9u, 90u, 900u}) {
+        TraceError error = JitteryTrace(72.0, 90.0, 0.0003, seed);
+        EXPECT_LT(error.fitted, 0.15) << "seed " << seed;
+        EXPECT_LT(error.fitted, error.difference / 4.0) << "seed " << seed;
+    }
+    TraceError matched = JitteryTrace(120.0, 90.0, 0.0003, 1);
+    EXPECT_LT(matched.fitted, 0.15);
+}
+
+TEST(MotionHistory, PeakKeepsTheFlickAfterItSlows) {
+    // Full speed until 0.3 s, then the hand brakes hard over 40 ms before release
+    MotionHistory history;
+    double x = 0.0;
+    double releaseSpeed = 0.0;
+    for (int k = 0; k <= 32; k++) {
+        double t = k / 90.0;
+        double speed = t < 0.3 ? 4.0 : std::max(0.0, 4.0 - (t - 0.3) * 100.0);
+        x += speed / 90.0;
+        history.Push(Ns(t), {static_cast<float>(x), 0.0f, 0.0f});
+        releaseSpeed = speed;
+    }
+    EXPECT_LT(releaseSpeed, 1.0);
+    EXPECT_LT(history.LinearVelocity(WINDOW).x, 2.5f);
+    EXPECT_GT(history.PeakLinearVelocity(WINDOW, 0.06f).x, 3.5f);
+}
+
+TEST(MotionHistory, AngularVelocityThroughManyTurns) {
+    // 30 rad/s about y for ten seconds, far past the rotation vector rebase
+    MotionHistory history;
+    Vec3 axis = Up();
+    float rate = 30.0f;
+    for (int k = 0; k < 900; k++) {
+        double t = k / 90.0;
+        history.Push(Ns(t), Zero(), FromAngularVelocity(axis * rate, static_cast<float>(t)));
+    }
+    EXPECT_LT(Magnitude(history.AngularVelocity(WINDOW) - axis * rate), 0.05f);
+}
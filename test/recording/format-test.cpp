@@ -0,0 +1,121 @@
+// The recording frame codec: a frame decodes to what was encoded, within the format's
+// quantization, and a truncated frame or one claiming more sabers than a sample holds is
+// refused rather than read.
+
+#include "recording/format.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Math;
+using namespace TrickSaber::Recording;
+
+namespace {
+
+    constexpr float POSITION_TOLERANCE = 1.0f / POSITION_SCALE;
+    constexpr float ROTATION_TOLERANCE = 2e-3f;  // 10 bits per smallest-three component
+
+    TickSample Sample(int sabers) {
+        TickSample sample = {};
+        sample.deltaTime = 1.0f / 90.0f;
+        for (int h = 0; h < HAND_COUNT; h++) {
+            sample.buttons[h] = 0x5u << h;
+            sample.handPosition[h] = {h ? 0.25f : -0.25f, 1.2f, 0.3f};
+            sample.handRotation[h] = AngleAxis(30.0f * (h + 1), Up());
+        }
+        sample.saberCount = static_cast<uint8_t>(sabers);
+        for (int s = 0; s < sabers; s++) {
+            sample.sabers[s].state = static_cast<uint8_t>(s % 4);
+            sample.sabers[s].space = static_cast<uint8_t>(s % 2);
+            sample.sabers[s].hand = static_cast<uint8_t>(s % HAND_COUNT);
+            sample.sabers[s].position = {0.1f * s, 1.0f, -0.5f * s};
+            sample.sabers[s].rotation = AngleAxis(15.0f * s, Right());
+        }
+        return sample;
+    }
+
+    // Offset of the saber count byte: the byte after the hands, the last of a frame with no sabers.
+    int SaberCountOffset() {
+        uint8_t frame[MAX_FRAME_BYTES];
+        FrameCodec codec;
+        return codec.Encode(Sample(0), frame) - 1;
+    }
+
+    bool Near(Vec3 a, Vec3 b, float tolerance) {
+        return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance && std::abs(a.z - b.z) <= tolerance;
+    }
+
+    // Either sign of a quaternion is the same rotation.
+    bool Near(Quat a, Quat b, float tolerance) {
+        float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        return std::abs(dot) >= 1.0f - tolerance;
+    }
+
+}  // namespace
+
+TEST(FrameCodec, DecodesWhatItEncoded) {
+    FrameCodec encoder;
+    FrameCodec decoder;
+    uint8_t frame[MAX_FRAME_BYTES];
+    // Two frames, so the second is delta-coded against the first
+    for (int sabers : {2, MAX_RECORDED_SABERS}) {
+        TickSample in = Sample(sabers);
+        int length = encoder.Encode(in, frame);
+        ASSERT_LE(length, MAX_FRAME_BYTES);
+        TickSample out = {};
+        ASSERT_EQ(decoder.Decode(frame, frame + length, out), frame + length);
+        EXPECT_NEAR(out.deltaTime, in.deltaTime, 1e-6f);
+        for (int h = 0; h < HAND_COUNT; h++) {
+            EXPECT_EQ(out.buttons[h], in.buttons[h]);
+            EXPECT_TRUE(Near(out.handPosition[h], in.handPosition[h], POSITION_TOLERANCE)) << "hand " << h;
+            EXPECT_TRUE(Near(out.handRotation[h], in.handRotation[h], ROTATION_TOLERANCE)) << "hand " << h;
+        }
+        ASSERT_EQ(out.saberCount, sabers);
+        for (int s = 0; s < sabers; s++) {
+            EXPECT_EQ(out.sabers[s].state, in.sabers[s].state);
+            EXPECT_EQ(out.sabers[s].space, in.sabers[s].space);
+            EXPECT_EQ(out.sabers[s].hand, in.sabers[s].hand);
+            EXPECT_TRUE(Near(out.sabers[s].position, in.sabers[s].position, POSITION_TOLERANCE)) << "saber " << s;
+            EXPECT_TRUE(Near(out.sabers[s].rotation, in.sabers[s].rotation, ROTATION_TOLERANCE)) << "saber " << s;
+        }
+    }
+}
+
+TEST(FrameCodec, RefusesATruncatedFrame) {
+    FrameCodec encoder;
+    uint8_t frame[MAX_FRAME_BYTES];
+    int length = encoder.Encode(Sample(2), frame);
+    for (int cut = 0; cut < length; cut++) {
+        FrameCodec decoder;
+        TickSample out = {};
+        EXPECT_EQ(decoder.Decode(frame, frame + cut, out), nullptr) << cut << " of " << length << " bytes";
+    }
+}
+
+// A saber count past the sample's array is refused even with bytes enough for the sabers.
+TEST(FrameCodec, RefusesMoreSabersThanASampleHolds) {
+    FrameCodec encoder;
+    uint8_t frame[2 * MAX_FRAME_BYTES] = {};
+    int length = encoder.Encode(Sample(MAX_RECORDED_SABERS), frame);
+    frame[SaberCountOffset()] = MAX_RECORDED_SABERS + 1;
+    FrameCodec decoder;
+    TickSample out = {};
+    EXPECT_EQ(decoder.Decode(frame, frame + sizeof(frame), out), nullptr);
+
+    frame[SaberCountOffset()] = 0xFF;
+    FrameCodec again;
+    EXPECT_EQ(again.Decode(frame, frame + length, out), nullptr);
+}
+
+TEST(FrameCodec, AcceptsExactlyTheLimit) {
+    FrameCodec encoder;
+    uint8_t frame[MAX_FRAME_BYTES];
+    int length = encoder.Encode(Sample(MAX_RECORDED_SABERS), frame);
+    EXPECT_EQ(frame[SaberCountOffset()], MAX_RECORDED_SABERS);
+    FrameCodec decoder;
+    TickSample out = {};
+    EXPECT_EQ(decoder.Decode(frame, frame + length, out), frame + length);
+    EXPECT_EQ(out.saberCount, MAX_RECORDED_SABERS);
+}
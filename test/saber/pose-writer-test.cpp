@@ -0,0 +1,113 @@
+// The pose writer against the host transform (tools/budget/facade): at most one native write per
+// saber per flush, none for a pose within epsilon of the last one written, and the per-second
+// rates the performance panel shows.
+
+#include "saber/pose-writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Math;
+using Facade::Call;
+using Saber::PoseWriter;
+
+namespace {
+
+    class PoseWriterTest : public ::testing::Test {
+    protected:
+        void SetUp() override { before = Facade::counts; }
+
+        uint32_t Writes(Call call) const { return (Facade::counts - before).Of(call); }
+
+        std::unique_ptr<UnityEngine::Transform> transform{UnityEngine::Transform::Create()};
+        PoseWriter writer;
+        Facade::Counts before;
+    };
+
+    Quat Tilt() { return AngleAxis(20.0f, {1.0f, 0.0f, 0.0f}); }
+
+}  // namespace
+
+TEST_F(PoseWriterTest, CoalescesATicksPosesIntoOneWrite) {
+    writer.SetLocal({0.1f, 0.0f, 0.0f}, Identity());
+    writer.SetLocal({0.2f, 0.0f, 0.0f}, Tilt());
+    writer.SetLocal({0.3f, 0.1f, 0.0f}, Tilt());
+    EXPECT_TRUE(writer.Flush(transform.get()));
+    EXPECT_EQ(Writes(Call::SetLocalPositionAndRotation), 1u);
+    EXPECT_EQ((Facade::counts - before).TransformCalls(), 1u);
+    EXPECT_FLOAT_EQ(transform->localPosition.x, 0.3f);
+    EXPECT_FLOAT_EQ(transform->localPosition.y, 0.1f);
+    EXPECT_FLOAT_EQ(transform->localRotation.x, Tilt().x);
+}
+
+TEST_F(PoseWriterTest, TheLastSpaceSetWins) {
+    writer.SetLocal({0.1f, 0.0f, 0.0f}, Identity());
+    writer.SetWorld({1.0f, 2.0f, 3.0f}, Tilt());
+    EXPECT_TRUE(writer.Flush(transform.get()));
+    EXPECT_EQ(Writes(Call::SetPositionAndRotation), 1u);
+    EXPECT_EQ(Writes(Call::SetLocalPositionAndRotation), 0u);
+    EXPECT_FLOAT_EQ(transform->WorldPosition().z, 3.0f);
+}
+
+TEST_F(PoseWriterTest, NothingPendingWritesNothing) {
+    EXPECT_FALSE(writer.Flush(transform.get()));
+    writer.SetLocal({0.1f, 0.0f, 0.0f}, Identity());
+    EXPECT_TRUE(writer.Flush(transform.get()));
+    EXPECT_FALSE(writer.Flush(transform.get()));
+    EXPECT_EQ((Facade::counts - before).TransformCalls(), 1u);
+}
+
+TEST_F(PoseWriterTest, ElidesAPoseWithinEpsilonOfTheLastWrite) {
+    writer.SetLocal({0.1f, 0.2f, 0.3f}, Tilt());
+    ASSERT_TRUE(writer.Flush(transform.get()));
+    uint64_t elided = Saber::GetPoseWriteStats().elided;
+    // 1 um and a rotation well inside the dot-product epsilon
+    writer.SetLocal({0.100001f, 0.2f, 0.3f}, Normalized(Tilt() * AngleAxis(0.001f, {0.0f, 1.0f, 0.0f})));
+    EXPECT_FALSE(writer.Flush(transform.get()));
+    EXPECT_EQ(Writes(Call::SetLocalPositionAndRotation), 1u);
+    EXPECT_EQ(Saber::GetPoseWriteStats().elided, elided + 1);
+}
+
+TEST_F(PoseWriterTest, WritesAPoseBeyondEpsilon) {
+    writer.SetLocal({0.1f, 0.2f, 0.3f}, Tilt());
+    ASSERT_TRUE(writer.Flush(transform.get()));
+    writer.SetLocal({0.1001f, 0.2f, 0.3f}, Tilt());  // 0.1 mm
+    EXPECT_TRUE(writer.Flush(transform.get()));
+    writer.SetLocal({0.1001f, 0.2f, 0.3f}, Normalized(Tilt() * AngleAxis(0.5f, {0.0f, 1.0f, 0.0f})));
+    EXPECT_TRUE(writer.Flush(transform.get()));
+    EXPECT_EQ(Writes(Call::SetLocalPositionAndRotation), 3u);
+}
+
+// The same numbers in the other space are a different pose.
+TEST_F(PoseWriterTest, ASpaceChangeIsAlwaysWritten) {
+    writer.SetLocal({0.1f, 0.2f, 0.3f}, Tilt());
+    ASSERT_TRUE(writer.Flush(transform.get()));
+    writer.SetWorld({0.1f, 0.2f, 0.3f}, Tilt());
+    EXPECT_TRUE(writer.Flush(transform.get()));
+    EXPECT_EQ(Writes(Call::SetPositionAndRotation), 1u);
+}
+
+// After a reparent the transform's pose is unknown, so the same pose is written again.
+TEST_F(PoseWriterTest, InvalidateForcesTheNextWrite) {
+    writer.SetLocal({0.1f, 0.2f, 0.3f}, Tilt());
+    ASSERT_TRUE(writer.Flush(transform.get()));
+    writer.Invalidate();
+    writer.SetLocal({0.1f, 0.2f, 0.3f}, Tilt());
+    EXPECT_TRUE(writer.Flush(transform.get()));
+    EXPECT_EQ(Writes(Call::SetLocalPositionAndRotation), 2u);
+}
+
+TEST_F(PoseWriterTest, RatesCoverTheLastWholeSecond) {
+    constexpr float TICK = 1.0f / 64.0f;  // Exact, so 64 ticks close the window
+    Saber::TickPoseWriteStats(1.0f);      // Close whatever window earlier tests left open
+    for (int tick = 0; tick < 64; tick++) {
+        // Moves on even ticks, holds still on odd ones
+        writer.SetLocal({0.01f * static_cast<float>(tick / 2), 0.0f, 0.0f}, Identity());
+        writer.Flush(transform.get());
+        Saber::TickPoseWriteStats(TICK);
+    }
+    EXPECT_FLOAT_EQ(Saber::GetPoseWriteStats().issuedPerSecond, 32.0f);
+    EXPECT_FLOAT_EQ(Saber::GetPoseWriteStats().elidedPerSecond, 32.0f);
+}
@@ -0,0 +1,165 @@
+// The saber state store's slot bookkeeping, against the host transforms (tools/budget/facade):
+// FindOrAdd keeps slots dense, and Remove fills the gap with the last slot, moving its hot
+// fields, cold data and handle bits together and leaving every other slot as it was.
+
+#include "saber/state-store.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using namespace TrickSaber;
+using Saber::MAX_SABERS;
+using Saber::SaberInteractionState;
+using Saber::SaberStateStore;
+
+namespace {
+
+    class SaberStateStoreTest : public ::testing::Test {
+    protected:
+        // A saber under its own hand, set up the way SaberModelController_Init_Hook does it.
+        int AddSaber(Config::Hand hand = Config::Right) {
+            hands.emplace_back(UnityEngine::Transform::Create());
+            sabers.emplace_back(UnityEngine::Transform::Create(hands.back().get()));
+            int slot = store->FindOrAdd(sabers.back().get());
+            if (slot >= 0) {
+                store->cold[slot].hand = hand;
+                store->cold[slot].originalParent = hands.back().get();
+                store->cold[slot].handTransform = hands.back().get();
+                store->attached |= SaberStateStore::Bit(slot);
+            }
+            return slot;
+        }
+
+        // Hot fields that tell slots apart.
+        void Mark(int slot, float value) {
+            store->state[slot] = SaberInteractionState::Thrown;
+            store->spinActive[slot] = true;
+            store->spinAngle[slot] = value;
+            store->returnTime[slot] = value * 2.0f;
+            store->handPosition[slot] = {value, 0.0f, 0.0f};
+            store->flightTime[slot] = value * 3.0;
+            store->motionTime[slot] = value * 4.0f;
+            store->sweptFrame[slot] = static_cast<int>(value);
+            store->cold[slot].restPose.position = {0.0f, 0.0f, value};
+        }
+
+        static uint64_t AllMasks(SaberStateStore const& s) {
+            return s.saberAlive | s.parentAlive | s.handAlive | s.attached | s.autoRecalled;
+        }
+
+        std::unique_ptr<SaberStateStore> store = std::make_unique<SaberStateStore>();
+        std::vector<std::unique_ptr<UnityEngine::Transform>> hands;
+        std::vector<std::unique_ptr<UnityEngine::Transform>> sabers;
+    };
+
+}  // namespace
+
+TEST_F(SaberStateStoreTest, FindOrAddHandsOutDenseSlots) {
+    for (int n = 0; n < 4; n++) {
+        EXPECT_EQ(AddSaber(), n);
+    }
+    EXPECT_EQ(store->count, 4);
+    EXPECT_EQ(store->FindOrAdd(sabers[2].get()), 2) << "an existing saber keeps its slot";
+    EXPECT_EQ(store->count, 4);
+    EXPECT_EQ(store->Find(hands[0].get()), -1);
+}
+
+TEST_F(SaberStateStoreTest, FindOrAddRefusesPastTheLastSlot) {
+    for (int n = 0; n < MAX_SABERS; n++) {
+        ASSERT_EQ(AddSaber(), n);
+    }
+    EXPECT_EQ(AddSaber(), -1);
+    EXPECT_EQ(store->count, MAX_SABERS);
+}
+
+// A slot reused after a Remove starts held, with none of the old saber's bits.
+TEST_F(SaberStateStoreTest, FindOrAddStartsFromACleanSlot) {
+    AddSaber();
+    store->ValidateHandles();
+    store->autoRecalled = SaberStateStore::Bit(0);
+    Mark(0, 5.0f);
+    store->Remove(0);
+    std::unique_ptr<UnityEngine::Transform> saber{UnityEngine::Transform::Create()};
+    ASSERT_EQ(store->FindOrAdd(saber.get()), 0);
+    EXPECT_EQ(AllMasks(*store), 0u);
+    EXPECT_EQ(store->state[0], SaberInteractionState::Held);
+    EXPECT_FALSE(store->spinActive[0]);
+    EXPECT_EQ(store->spinAngle[0], 0.0f);
+    EXPECT_EQ(store->sweptFrame[0], -1);
+}
+
+TEST_F(SaberStateStoreTest, RemoveMovesTheLastSlotIntoTheGap) {
+    for (int n = 0; n < 4; n++) {
+        AddSaber(n % 2 ? Config::Right : Config::Left);
+        Mark(n, static_cast<float>(n + 1));
+    }
+    store->ValidateHandles();
+    store->autoRecalled = SaberStateStore::Bit(3);
+    store->attached &= ~SaberStateStore::Bit(1);
+
+    store->Remove(1);
+    ASSERT_EQ(store->count, 3);
+    EXPECT_EQ(store->Find(sabers[1].get()), -1);
+    EXPECT_EQ(store->Find(sabers[3].get()), 1);
+    EXPECT_EQ(store->cold[1].handTransform.ptr(), hands[3].get());
+    EXPECT_EQ(store->cold[1].hand, Config::Right);
+    EXPECT_FLOAT_EQ(store->cold[1].restPose.position.z, 4.0f);
+    EXPECT_FLOAT_EQ(store->spinAngle[1], 4.0f);
+    EXPECT_FLOAT_EQ(store->returnTime[1], 8.0f);
+    EXPECT_FLOAT_EQ(store->handPosition[1].x, 4.0f);
+    EXPECT_DOUBLE_EQ(store->flightTime[1], 12.0);
+    EXPECT_FLOAT_EQ(store->motionTime[1], 16.0f);
+    EXPECT_EQ(store->sweptFrame[1], 4);
+
+    // Slot 3's bits now describe slot 1, and bit 3 is gone from every mask
+    EXPECT_TRUE(store->Ready(1));
+    EXPECT_TRUE(store->attached & SaberStateStore::Bit(1));
+    EXPECT_TRUE(store->autoRecalled & SaberStateStore::Bit(1));
+    EXPECT_EQ(AllMasks(*store) & SaberStateStore::Bit(3), 0u);
+    EXPECT_EQ(store->cold[3].saberTransform.ptr(), nullptr);
+}
+
+TEST_F(SaberStateStoreTest, RemoveLeavesTheOtherSlotsAlone) {
+    for (int n = 0; n < 5; n++) {
+        AddSaber();
+        Mark(n, static_cast<float>(n + 1));
+    }
+    store->ValidateHandles();
+    store->autoRecalled = SaberStateStore::Bit(0) | SaberStateStore::Bit(2);
+    store->attached &= ~SaberStateStore::Bit(3);
+
+    store->Remove(1);  // Slot 4, attached and not auto-recalled, moves into 1
+    EXPECT_EQ(store->autoRecalled, SaberStateStore::Bit(0) | SaberStateStore::Bit(2));
+    EXPECT_EQ(store->attached, SaberStateStore::Bit(0) | SaberStateStore::Bit(1) | SaberStateStore::Bit(2));
+    for (int slot : {0, 2, 3}) {
+        EXPECT_TRUE(store->Ready(slot)) << "slot " << slot;
+        EXPECT_FLOAT_EQ(store->spinAngle[slot], static_cast<float>(slot + 1)) << "slot " << slot;
+        EXPECT_EQ(store->Find(sabers[slot].get()), slot);
+    }
+}
+
+TEST_F(SaberStateStoreTest, RemovingTheLastSlotClearsItsBits) {
+    AddSaber();
+    AddSaber();
+    store->ValidateHandles();
+    store->autoRecalled = SaberStateStore::Bit(0) | SaberStateStore::Bit(1);
+    uint64_t before = AllMasks(*store);
+
+    store->Remove(1);
+    EXPECT_EQ(store->count, 1);
+    EXPECT_EQ(AllMasks(*store), before & ~SaberStateStore::Bit(1));
+    EXPECT_TRUE(store->Ready(0));
+    EXPECT_EQ(store->Find(sabers[1].get()), -1);
+    EXPECT_EQ(store->Find(sabers[0].get()), 0);
+}
+
+// Removing every saber leaves the store empty with no bits set.
+TEST_F(SaberStateStoreTest, RemovingEverySaberEmptiesTheMasks) {
+    for (int n = 0; n < 3; n++) AddSaber();
+    store->ValidateHandles();
+    store->autoRecalled = SaberStateStore::Bit(2);
+    while (store->count > 0) store->Remove(0);
+    EXPECT_EQ(AllMasks(*store), 0u);
+}
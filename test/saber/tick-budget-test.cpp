@@ -0,0 +1,320 @@
+// How many Unity calls each kind of tick makes. The host library compiles the mod's tick code
+// (state store, input poll, trick state machine, the tick pipeline with UnityTrickIO's gather
+// and apply, and the pose writers) against the counting stand-ins in tools/budget/facade. A
+// saber's fixed tick is its gather plus its apply; the compute between them, run inline here,
+// makes no Unity calls.
+//
+// Two sabers under moving hands are scripted through every SaberInteractionState, with and
+// without spin, and each tick's calls are checked against BUDGETS below. A change that adds a
+// transform read, an input poll or an allocation to a tick fails; a change that removes some
+// should tighten the budget it beat.
+
+#include "facade.hpp"
+#include "input/hand-input.hpp"
+#include "saber/state-store.hpp"
+#include "saber/tick-pipeline.hpp"
+#include "saber/unity-trick-io.hpp"
+#include "support/heap-counter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Math;
+using Saber::SaberInteractionState;
+using Saber::SaberStateStore;
+using Test::HeapAllocations;
+
+namespace {
+
+    enum class Kind : int {
+        Shared,        // Once per FixedUpdate: handle validation, hand positions, input poll (per saber / per hand)
+        HeldIdle,
+        HeldSpinning,
+        Thrown,
+        Returning,
+        Transition,    // Throw, recall, catch, spin on/off, setup: the tick a state, spin or parent changes
+        RenderSpinning,
+        RenderThrown,
+        RenderReturning,
+        Count,
+    };
+
+    struct Budget {
+        char const* name;
+        uint32_t transformCalls;
+        uint32_t inputCalls;
+        uint32_t aliveChecks;
+    };
+
+    // Per saber, except Shared: per saber for transform calls and alive checks, per polled button
+    // for input. No tick may allocate, managed or native.
+    constexpr Budget BUDGETS[] = {
+        {"FixedUpdate, shared",   1, 1, 2},
+        {"Held idle",             0, 0, 0},
+        {"Held spinning",         1, 0, 0},
+        {"Thrown",                1, 0, 0},
+        {"Returning",             3, 0, 0},
+        {"Transition",            4, 0, 0},
+        {"Render, spinning",      1, 0, 0},
+        {"Render, thrown",        1, 0, 0},
+        {"Render, returning",     3, 0, 0},
+    };
+    static_assert(sizeof(BUDGETS) / sizeof(BUDGETS[0]) == static_cast<int>(Kind::Count));
+
+    // Facade counts and heap allocations at a point, to take what a step added.
+    struct Mark {
+        Facade::Counts counts = Facade::counts;
+        uint64_t heap = HeapAllocations();
+
+        Facade::Counts Since() const {
+            Facade::Counts calls = Facade::counts - counts;
+            calls.heapAllocations = static_cast<uint32_t>(HeapAllocations() - heap);
+            return calls;
+        }
+    };
+
+    struct Report {
+        int ticks[static_cast<int>(Kind::Count)] = {};
+        std::vector<std::string> overBudget;
+        std::vector<std::string> computeCalls;
+        std::vector<std::string> awayFromRest;
+        std::vector<SaberInteractionState> states;
+    };
+
+    std::string Describe(Kind kind, Facade::Counts const& calls, float time) {
+        std::string text = std::string(BUDGETS[static_cast<int>(kind)].name) + " at t=" + std::to_string(time) + ":";
+        for (int c = 0; c < static_cast<int>(Facade::Call::Count); c++) {
+            if (calls.calls[c]) {
+                text += " " + std::to_string(calls.calls[c]) + " x " + Facade::CALL_NAMES[c];
+            }
+        }
+        return text + ", " + std::to_string(calls.managedAllocations + calls.heapAllocations) + " allocations";
+    }
+
+    void Check(Report& report, Kind kind, Facade::Counts const& calls, int sabers, int polled, float time) {
+        Budget const& budget = BUDGETS[static_cast<int>(kind)];
+        report.ticks[static_cast<int>(kind)]++;
+        if (calls.TransformCalls() > budget.transformCalls * sabers || calls.Of(Facade::Call::InputGet) > budget.inputCalls * polled ||
+            calls.Of(Facade::Call::AliveCheck) > budget.aliveChecks * sabers || calls.managedAllocations + calls.heapAllocations > 0) {
+            report.overBudget.push_back(Describe(kind, calls, time));
+        }
+    }
+
+    // Throw on the index trigger, spin on A/X; the defaults from settings/config.hpp otherwise.
+    Config::HandSettings Hand() {
+        Config::HandSettings hand = {};
+        hand.bindings[Input::Throw] = Input::CompileBinding(3, 0, false);
+        hand.bindings[Input::Spin] = Input::CompileBinding(1, 0, false);
+        hand.throwBound = true;
+        hand.spinBound = true;
+        hand.pollCount = 2;
+        hand.pollButtons[0] = GlobalNamespace::OVRInput::Button::One;
+        hand.pollBits[0] = Input::ButtonOne;
+        hand.pollButtons[1] = GlobalNamespace::OVRInput::Button::PrimaryIndexTrigger;
+        hand.pollBits[1] = Input::IndexTrigger;
+        hand.spinDirection = 1.0f;
+        hand.spinDegPerSec = 2000.0f;
+        hand.spinRadPerSec = hand.spinDegPerSec * DEG2RAD;
+        hand.spinAnchorZOffset = -0.2f;
+        hand.throwVelocityMultiplier = 3.0f;
+        hand.returnDuration = 0.2f;
+        hand.returnStyle = Math::DEFAULT_RETURN_STYLE;
+        hand.returnPath = &Math::ReturnPathFor(hand.returnStyle);
+        hand.peakReleaseWindow = Config::PEAK_RELEASE_WINDOW;
+        return hand;
+    }
+
+    // What each hand's buttons do over one 4 s cycle: idle, spin, throw and recall, then a
+    // throw out of a spin.
+    uint32_t ScriptedButtons(float t) {
+        float c = std::fmod(t, 4.0f);
+        uint32_t held = 0;
+        if (c >= 0.5f && c < 1.2f) held |= static_cast<uint32_t>(GlobalNamespace::OVRInput::Button::One);
+        if (c >= 1.5f && c < 2.1f) held |= static_cast<uint32_t>(GlobalNamespace::OVRInput::Button::PrimaryIndexTrigger);
+        if (c >= 2.6f && c < 3.2f) held |= static_cast<uint32_t>(GlobalNamespace::OVRInput::Button::One);
+        if (c >= 2.9f && c < 3.4f) held |= static_cast<uint32_t>(GlobalNamespace::OVRInput::Button::PrimaryIndexTrigger);
+        return held;
+    }
+
+    Report RunScene() {
+        Report report;
+        Config::Snapshot config = {};
+        config.hands[Config::Left] = Hand();
+        config.hands[Config::Right] = Hand();
+        config.modEnabled = true;
+        int polled = config.hands[Config::Left].pollCount + config.hands[Config::Right].pollCount;
+
+        // As SaberModelController_Init_Hook sets a saber up
+        SaberStateStore& store = Saber::GetSaberStateStore();
+        UnityEngine::Transform* hands[Config::HandCount];
+        for (int h = 0; h < Config::HandCount; h++) {
+            hands[h] = UnityEngine::Transform::Create();
+            UnityEngine::Transform* saber = UnityEngine::Transform::Create(hands[h]);
+            saber->localPosition = {0.0f, 0.0f, 0.02f};
+            int slot = store.FindOrAdd(saber);
+            auto& cold = store.cold[slot];
+            cold.hand = static_cast<Config::Hand>(h);
+            cold.restPose.rotation = FromUnity(saber->get_localRotation());
+            cold.restPose.position = FromUnity(saber->get_localPosition());
+            cold.restPose.scale = FromUnity(saber->get_localScale());
+            cold.originalParent = saber->get_parent();
+            cold.handTransform = cold.originalParent.ptr();
+            store.attached |= SaberStateStore::Bit(slot);
+            store.ResetHot(slot);
+        }
+
+        Input::HandInput input;
+        constexpr float DELTA = 1.0f / 90.0f;
+        constexpr int TICKS = 90 * 12;
+        static Saber::TickPipeline pipeline;
+        for (int tick = 0; tick < TICKS; tick++) {
+            float now = tick * DELTA;
+            // Hands swing around the player; the right one runs the script half a cycle behind
+            for (int h = 0; h < Config::HandCount; h++) {
+                float phase = now * 3.0f + h * 1.7f;
+                hands[h]->localPosition = {(h ? 0.25f : -0.25f) + 0.3f * std::sin(phase), 1.2f + 0.2f * std::cos(phase), 0.3f};
+                hands[h]->localRotation = AngleAxis(40.0f * std::sin(phase), {1.0f, 0.0f, 0.0f});
+                Facade::heldButtons[static_cast<unsigned>(Input::HandController(static_cast<Config::Hand>(h)))] =
+                    ScriptedButtons(now - h * 2.0f + 4.0f);
+            }
+
+            // --- The Unity-facing steps of TrickSaberInputUpdateHook, in its order ---
+            Mark start;
+            store.ValidateHandles();
+            for (int i = 0; i < store.count; i++) {
+                if (store.handAlive & SaberStateStore::Bit(i)) {
+                    store.handPosition[i] = FromUnity(store.cold[i].handTransform->get_position());
+                }
+            }
+            Input::PollInput(input, config, now);
+            Check(report, Kind::Shared, start.Since(), store.count, polled, now);
+
+            // --- Phase 1: each saber's reads ---
+            Saber::TickJob& job = pipeline.Gather();
+            job.count = store.count;
+            job.timeNs = static_cast<uint64_t>(now * 1e9f);
+            Facade::Counts saberCalls[Saber::MAX_SABERS];
+            SaberInteractionState stateBefore[Saber::MAX_SABERS];
+            bool spinBefore[Saber::MAX_SABERS];
+            uint64_t attachedBefore = store.attached;
+            bool written[Saber::MAX_SABERS];
+            for (int i = 0; i < store.count; i++) {
+                job.input[i].ready = false;
+                if (!store.Ready(i)) continue;
+                stateBefore[i] = store.state[i];
+                spinBefore[i] = store.spinActive[i];
+                // Nothing written since setup or a reparent, so even the rest pose is a real write
+                Vec3 lastPosition;
+                Quat lastRotation;
+                Saber::PoseSpace lastSpace;
+                written[i] = store.poseWriter[i].LastWritten(lastPosition, lastRotation, lastSpace);
+
+                Mark before;
+                int hand = store.cold[i].hand;
+                Saber::SaberTickInput& in = job.input[i];
+                in.actions = input.actions[hand];
+                in.deltaTime = DELTA * 0.5f;
+                in.tuning = config.hands[hand];
+                Saber::GatherTickReads(store, i, in);
+                saberCalls[i] = before.Since();
+            }
+
+            // --- Phase 2, inline as with threaded tick off ---
+            Mark compute;
+            pipeline.Publish(store, false);
+            Saber::TickJob* ticked = pipeline.Finish();
+            Facade::Counts computeCalls = compute.Since();
+            if (computeCalls.TransformCalls() || computeCalls.Of(Facade::Call::InputGet) || computeCalls.Of(Facade::Call::AliveCheck)) {
+                report.computeCalls.push_back("t=" + std::to_string(now));
+            }
+
+            // --- Phase 3 and the render update, per saber ---
+            for (int i = 0; i < store.count; i++) {
+                if (!store.Ready(i)) continue;
+                int hand = store.cold[i].hand;
+                Mark apply;
+                Saber::ApplyTickWrites(store, i, ticked->output[i]);
+                store.poseWriter[i].Flush(store.cold[i].saberTransform.ptr());
+                Facade::Counts calls = saberCalls[i] + apply.Since();
+
+                uint64_t bit = SaberStateStore::Bit(i);
+                Kind kind;
+                if (store.state[i] != stateBefore[i] || store.spinActive[i] != spinBefore[i] ||
+                    (store.attached & bit) != (attachedBefore & bit) || !written[i]) {
+                    kind = Kind::Transition;
+                } else if (stateBefore[i] == SaberInteractionState::Thrown) {
+                    kind = Kind::Thrown;
+                } else if (stateBefore[i] == SaberInteractionState::Returning) {
+                    kind = Kind::Returning;
+                } else {
+                    kind = spinBefore[i] ? Kind::HeldSpinning : Kind::HeldIdle;
+                }
+                Check(report, kind, calls, 1, 0, now);
+                if (kind == Kind::HeldIdle) {
+                    // Caught and reparented without worldPositionStays: back at the rest pose in the hand
+                    UnityEngine::Transform* saber = store.cold[i].saberTransform.ptr();
+                    Saber::SaberRestPose const& rest = store.cold[i].restPose;
+                    if (saber->Parent() != hands[hand] || SqrMagnitude(saber->localPosition - rest.position) > 1e-8f ||
+                        1.0f - std::abs(Dot(saber->localRotation, rest.rotation)) > 1e-6f) {
+                        report.awayFromRest.push_back("saber " + std::to_string(i) + " at t=" + std::to_string(now));
+                    }
+                }
+                if (std::find(report.states.begin(), report.states.end(), store.state[i]) == report.states.end()) {
+                    report.states.push_back(store.state[i]);
+                }
+
+                // --- Saber_ManualUpdate_Hook half a step later, for sabers that are moving ---
+                if (store.state[i] != SaberInteractionState::Held || store.spinActive[i]) {
+                    SaberInteractionState renderState = store.state[i];
+                    Mark render;
+                    Saber::UnityTrickIO renderIo{store, i, 0};
+                    Saber::AdvanceMotion(store, i, store.cold[i].restPose, config.hands[hand], DELTA * 0.5f, renderIo);
+                    store.poseWriter[i].Flush(store.cold[i].saberTransform.ptr());
+                    Check(report,
+                        renderState == SaberInteractionState::Thrown ? Kind::RenderThrown
+                        : renderState == SaberInteractionState::Returning ? Kind::RenderReturning : Kind::RenderSpinning,
+                        render.Since(), 1, 0, now);
+                }
+            }
+        }
+        return report;
+    }
+
+    // The scene uses the process-wide saber store, so every test shares one run.
+    Report const& Scene() {
+        static Report report = RunScene();
+        return report;
+    }
+
+}  // namespace
+
+TEST(TickBudget, ScriptReachesEveryKindOfTick) {
+    Report const& report = Scene();
+    for (int k = 0; k < static_cast<int>(Kind::Count); k++) {
+        EXPECT_GT(report.ticks[k], 0) << BUDGETS[k].name;
+    }
+    EXPECT_EQ(report.states.size(), 3u);
+}
+
+TEST(TickBudget, NoTickGoesOverBudget) {
+    Report const& report = Scene();
+    for (size_t k = 0; k < std::min<size_t>(report.overBudget.size(), 5); k++) {
+        ADD_FAILURE() << "over budget: " << report.overBudget[k];
+    }
+    EXPECT_EQ(report.overBudget.size(), 0u);
+}
+
+TEST(TickBudget, ComputeMakesNoUnityCalls) {
+    Report const& report = Scene();
+    EXPECT_EQ(report.computeCalls.size(), 0u) << "first at " << (report.computeCalls.empty() ? "" : report.computeCalls[0]);
+}
+
+TEST(TickBudget, HeldSabersSitAtTheirRestPose) {
+    Report const& report = Scene();
+    EXPECT_EQ(report.awayFromRest.size(), 0u) << "first " << (report.awayFromRest.empty() ? "" : report.awayFromRest[0]);
+}
@@ -0,0 +1,235 @@
+// The tick pipeline's compute on the workers must give what it gives inline, bit for bit. Sabers
+// under scripted spins, throws and recalls run the same frames once inline, once threaded with
+// time between FixedUpdate and the render update, and once threaded with none, so the render
+// update finds chunks unclaimed and computes them itself. Gather and apply read and write plain
+// host poses instead of Unity transforms, as tools/perf/pipeline-bench does.
+
+#include "input/bindings.hpp"
+#include "perf/timers.hpp"
+#include "physics/return-path.hpp"
+#include "saber/tick-pipeline.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Math;
+using Saber::SaberInteractionState;
+
+namespace {
+
+    constexpr float TICK = 1.0f / 90.0f;
+    constexpr int FRAMES = 90 * 5;  // Past one whole 4 s script for every saber
+
+    Config::HandTuning Tuning() {
+        Config::HandTuning tuning = {};
+        tuning.throwBound = true;
+        tuning.spinBound = true;
+        tuning.spinDirection = 1.0f;
+        tuning.spinDegPerSec = 2000.0f;
+        tuning.spinRadPerSec = tuning.spinDegPerSec * DEG2RAD;
+        tuning.spinAnchorZOffset = -0.2f;
+        tuning.throwVelocityMultiplier = 3.0f;
+        tuning.returnDuration = 0.2f;
+        tuning.returnStyle = DEFAULT_RETURN_STYLE;
+        tuning.returnPath = &ReturnPathFor(tuning.returnStyle);
+        tuning.peakReleaseWindow = Config::PEAK_RELEASE_WINDOW;
+        return tuning;
+    }
+
+    // Spin, throw and recall, then a throw out of a spin, every 4 s; each saber a little behind the last.
+    uint32_t ScriptedActions(float now, int slot) {
+        float c = std::fmod(now + 0.37f * static_cast<float>(slot), 4.0f);
+        uint32_t actions = 0;
+        if ((c >= 0.5f && c < 1.2f) || (c >= 2.6f && c < 3.2f)) actions |= Input::ActionBit(Input::Spin);
+        if ((c >= 1.5f && c < 2.1f) || (c >= 2.9f && c < 3.4f)) actions |= Input::ActionBit(Input::Throw);
+        return actions;
+    }
+
+    void HandPose(float now, int slot, Vec3& position, Quat& rotation) {
+        float phase = now * 3.0f + static_cast<float>(slot) * 0.9f;
+        position = {(slot & 1 ? 0.25f : -0.25f) + 0.3f * std::sin(phase), 1.2f + 0.2f * std::cos(phase), 0.3f};
+        rotation = AngleAxis(40.0f * std::sin(phase), {1.0f, 0.0f, 0.0f});
+    }
+
+    // The host's stand-in for the sabers' transforms.
+    struct HostScene {
+        int count = 0;
+        bool attached[Saber::MAX_SABERS];
+        bool world[Saber::MAX_SABERS];  // Else position and rotation are local to the hand
+        Vec3 position[Saber::MAX_SABERS];
+        Quat rotation[Saber::MAX_SABERS];
+        Saber::SaberRestPose rest;
+        Config::HandTuning tuning;
+    };
+
+    void Setup(HostScene& scene, Saber::TrickHotState& s, int count) {
+        scene.count = count;
+        scene.rest = {{0.0f, 0.0f, 0.02f}, Identity(), {1.0f, 1.0f, 1.0f}};
+        scene.tuning = Tuning();
+        s.count = count;
+        for (int i = 0; i < count; i++) {
+            scene.attached[i] = true;
+            scene.world[i] = false;
+            scene.position[i] = scene.rest.position;
+            scene.rotation[i] = scene.rest.rotation;
+            s.state[i] = SaberInteractionState::Held;
+            s.spinActive[i] = false;
+            s.throwPressedLastFrame[i] = false;
+            s.spinAngle[i] = 0.0f;
+            s.returnTime[i] = 0.0f;
+            s.flightTime[i] = 0.0f;
+            s.handMotion[i].Reset();
+            Quat handRotation;
+            HandPose(0.0f, i, s.handPosition[i], handRotation);
+        }
+    }
+
+    // As GatherSaber() and GatherTickReads() do on device.
+    void Gather(HostScene const& scene, Saber::TrickHotState& s, float now, Saber::TickJob& job) {
+        job.count = scene.count;
+        job.timeNs = static_cast<uint64_t>(now * 1e9f);
+        for (int i = 0; i < scene.count; i++) {
+            Saber::SaberTickInput& in = job.input[i];
+            Quat handRotation;
+            HandPose(now, i, s.handPosition[i], handRotation);
+            in.ready = true;
+            in.attached = scene.attached[i];
+            in.actions = ScriptedActions(now, i);
+            in.deltaTime = TICK;
+            in.tuning = scene.tuning;
+            in.rest = scene.rest;
+            bool throwPressed = in.actions & Input::ActionBit(Input::Throw);
+            if (s.state[i] == SaberInteractionState::Returning || Saber::StartsRecall(s, i, throwPressed)) {
+                in.handRestPoint = s.handPosition[i] + handRotation * scene.rest.position;
+                in.handRotation = handRotation;
+            }
+            if (Saber::StartsThrow(s, i, throwPressed)) {
+                in.saberPosition = scene.world[i] ? scene.position[i] : s.handPosition[i] + handRotation * scene.position[i];
+                in.saberRotation = scene.world[i] ? scene.rotation[i] : handRotation * scene.rotation[i];
+            }
+        }
+    }
+
+    // As ApplyTickWrites() and the pose writer's flush do on device.
+    void Apply(HostScene& scene, Saber::TickJob const& job) {
+        for (int i = 0; i < job.count; i++) {
+            Saber::SaberTickOutput const& out = job.output[i];
+            if (out.detach) scene.attached[i] = false;
+            if (out.reattach) scene.attached[i] = true;
+            if (out.hasPose) {
+                scene.world[i] = out.world;
+                scene.position[i] = out.position;
+                scene.rotation[i] = out.rotation;
+            }
+        }
+    }
+
+    void Mix(uint64_t& hash, void const* data, size_t size) {
+        for (size_t b = 0; b < size; b++) {
+            hash = (hash ^ static_cast<unsigned char const*>(data)[b]) * 1099511628211ull;
+        }
+    }
+
+    // Everything apply reads, field by field so padding is left out.
+    uint64_t OutputHash(Saber::TickJob const& job) {
+        uint64_t hash = 14695981039346656037ull;
+        for (int i = 0; i < job.count; i++) {
+            Saber::SaberTickOutput const& out = job.output[i];
+            bool flags[] = {out.buttonEdge, out.detach, out.reattach, out.hasPose, out.world};
+            Mix(hash, &out.stateBefore, sizeof(out.stateBefore));
+            Mix(hash, flags, sizeof(flags));
+            if (out.hasPose) {
+                Mix(hash, &out.position, sizeof(out.position));
+                Mix(hash, &out.rotation, sizeof(out.rotation));
+            }
+            for (int e = 0; e < out.eventCount; e++) {
+                Mix(hash, &out.events[e].event, sizeof(out.events[e].event));
+                Mix(hash, &out.events[e].value, sizeof(out.events[e].value));
+            }
+        }
+        return hash;
+    }
+
+    struct FrameRun {
+        std::vector<uint64_t> outputs;  // Per tick
+        uint64_t state = 0;             // The trick state after the last tick
+        int thrownTicks = 0;
+        int returningTicks = 0;
+    };
+
+    FrameRun RunFrames(int count, bool threaded, uint64_t gapNs) {
+        FrameRun run;
+        HostScene scene;
+        auto state = std::make_unique<Saber::TrickHotState>();
+        Setup(scene, *state, count);
+        Saber::TickPipeline pipeline;
+
+        auto apply = [&](Saber::TickJob& job) {
+            Apply(scene, job);
+            run.outputs.push_back(OutputHash(job));
+            for (int i = 0; i < job.count; i++) {
+                run.thrownTicks += job.output[i].stateBefore == SaberInteractionState::Thrown;
+                run.returningTicks += job.output[i].stateBefore == SaberInteractionState::Returning;
+            }
+        };
+
+        for (int frame = 0; frame < FRAMES; frame++) {
+            float now = static_cast<float>(frame + 1) * TICK;
+            // FixedUpdate
+            if (Saber::TickJob* job = pipeline.Finish()) apply(*job);
+            Gather(scene, *state, now, pipeline.Gather());
+            pipeline.Publish(*state, threaded);
+            if (!threaded) apply(*pipeline.Finish());
+            // The rest of the frame's main-thread work, then the saber render update
+            for (uint64_t until = Perf::NowNs() + gapNs; Perf::NowNs() < until;) {
+            }
+            if (Saber::TickJob* job = pipeline.Finish()) apply(*job);
+        }
+
+        uint64_t hash = 14695981039346656037ull;
+        for (int i = 0; i < state->count; i++) {
+            Mix(hash, &state->state[i], sizeof(state->state[i]));
+            Mix(hash, &state->spinAngle[i], sizeof(state->spinAngle[i]));
+            Mix(hash, &state->flightTime[i], sizeof(state->flightTime[i]));
+            Mix(hash, &state->returnTime[i], sizeof(state->returnTime[i]));
+            Mix(hash, &state->releasePosition[i], sizeof(state->releasePosition[i]));
+        }
+        run.state = hash;
+        return run;
+    }
+
+    // The first tick whose outputs differ, or -1 when every tick and the final state match.
+    int FirstMismatch(FrameRun const& a, FrameRun const& b) {
+        if (a.outputs.size() != b.outputs.size()) return 0;
+        for (size_t t = 0; t < a.outputs.size(); t++) {
+            if (a.outputs[t] != b.outputs[t]) return static_cast<int>(t);
+        }
+        return a.state == b.state ? -1 : static_cast<int>(a.outputs.size());
+    }
+
+    class TickPipelineParity : public ::testing::TestWithParam<int> {};
+
+}  // namespace
+
+TEST_P(TickPipelineParity, ThreadedMatchesInline) {
+    FrameRun inlined = RunFrames(GetParam(), false, 0);
+    ASSERT_EQ(inlined.outputs.size(), static_cast<size_t>(FRAMES));
+    // Every saber goes through a throw and a recall, so the outputs cover each state's compute
+    EXPECT_GT(inlined.thrownTicks, 0);
+    EXPECT_GT(inlined.returningTicks, 0);
+
+    FrameRun threaded = RunFrames(GetParam(), true, 200'000);
+    EXPECT_EQ(FirstMismatch(inlined, threaded), -1) << "first tick that differs";
+}
+
+TEST_P(TickPipelineParity, InlineFallbackMatchesInline) {
+    FrameRun inlined = RunFrames(GetParam(), false, 0);
+    FrameRun rushed = RunFrames(GetParam(), true, 0);
+    EXPECT_EQ(FirstMismatch(inlined, rushed), -1) << "first tick that differs";
+}
+
+INSTANTIATE_TEST_SUITE_P(Sabers, TickPipelineParity, ::testing::Values(2, 8, 16, 64));
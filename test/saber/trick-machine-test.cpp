@@ -0,0 +1,222 @@
+#include "support/trick-scenarios.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Test;
+using Saber::SaberInteractionState;
+
+static bool Finite(Vec3 v) { return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z); }
+static bool Finite(Quat q) { return std::isfinite(q.x) && std::isfinite(q.y) && std::isfinite(q.z) && std::isfinite(q.w); }
+
+// Runs the whole scenario, failing on the first non-finite pose.
+static void RunFinite(ScenarioRun& run, Scenario const& scenario) {
+    for (size_t k = 0; k < scenario.size(); k++) {
+        run.Tick(scenario[k]);
+        for (int hand = 0; hand < Config::HandCount; hand++) {
+            HostSaber const& saber = run.sabers[hand];
+            ASSERT_TRUE(Finite(saber.attached ? saber.localPosition : saber.worldPosition)) << "tick " << k << " hand " << hand;
+            ASSERT_TRUE(Finite(saber.attached ? saber.localRotation : saber.worldRotation)) << "tick " << k << " hand " << hand;
+        }
+    }
+}
+
+TEST(TrickMachine, FlickThrowsRecallsAndCatches) {
+    ScenarioRun run;
+    RunFinite(run, Flicks(6));
+    EventCounts const& right = run.events[Config::Right];
+    EXPECT_EQ(right.throws, 6);
+    EXPECT_EQ(right.recalls, 6);
+    EXPECT_EQ(right.catches, 6);
+    EXPECT_EQ(right.spinsStarted, 3);
+    EXPECT_EQ(run.events[Config::Left].throws, 0);
+    EXPECT_EQ(run.state.state[Config::Right], SaberInteractionState::Held);
+    EXPECT_TRUE(run.sabers[Config::Right].attached);
+}
+
+TEST(TrickMachine, FlickFliesAwayFromTheHand) {
+    ScenarioRun run;
+    Scenario scenario = Flicks(1);
+    float farthest = 0.0f;
+    for (ScenarioTick const& tick : scenario) {
+        run.Tick(tick);
+        HandFrame const& hand = tick.hands[Config::Right];
+        farthest = std::max(farthest, Magnitude(run.SaberPosition(Config::Right, hand) - hand.position));
+    }
+    // Released at ~4 m/s times the throw multiplier for several ticks
+    EXPECT_GT(farthest, 0.3f);
+}
+
+TEST(TrickMachine, LongHoldStaysThrownThenCatchesWithinReturnDuration) {
+    ScenarioRun run;
+    Scenario scenario = LongHolds(1, 2.0f);
+    int recallTick = -1;
+    int catchTick = -1;
+    for (size_t k = 0; k < scenario.size(); k++) {
+        bool pressed = scenario[k].hands[Config::Right].actions & THROW;
+        run.Tick(scenario[k]);
+        SaberInteractionState state = run.state.state[Config::Right];
+        if (pressed && k > 4) {
+            ASSERT_EQ(state, SaberInteractionState::Thrown) << "tick " << k;
+            ASSERT_FALSE(run.sabers[Config::Right].attached);
+        }
+        if (!pressed && recallTick < 0 && state == SaberInteractionState::Returning) {
+            recallTick = static_cast<int>(k);
+        }
+        if (recallTick >= 0 && catchTick < 0 && run.events[Config::Right].catches > 0) {
+            catchTick = static_cast<int>(k);
+        }
+    }
+    ASSERT_GE(recallTick, 0);
+    ASSERT_GE(catchTick, 0);
+    float returnDuration = run.tuning[Config::Right].returnDuration;
+    EXPECT_LE((catchTick - recallTick) * FIXED_DELTA, returnDuration + FIXED_DELTA);
+
+    // Caught on the hand's rest pose
+    HandFrame const& hand = scenario.back().hands[Config::Right];
+    EXPECT_LT(Magnitude(run.SaberPosition(Config::Right, hand) - (hand.position + hand.rotation * run.rest[Config::Right].position)),
+        1e-4f);
+}
+
+TEST(TrickMachine, ThrowRecallSpamStaysConsistent) {
+    for (int period : {1, 2, 3}) {
+        ScenarioRun run;
+        Scenario scenario = ThrowRecallSpam(2000, period);
+        for (size_t k = 0; k < scenario.size(); k++) {
+            int caught = run.events[Config::Right].catches;
+            run.Tick(scenario[k]);
+            SaberInteractionState state = run.state.state[Config::Right];
+            EventCounts const& events = run.events[Config::Right];
+            // Attached exactly while held, except on the catch tick: the next tick reparents
+            bool catchTick = events.catches != caught;
+            ASSERT_EQ(state == SaberInteractionState::Held, run.sabers[Config::Right].attached || catchTick)
+                << "period " << period << " tick " << k;
+            // Every recall follows a throw and every catch follows a recall
+            ASSERT_LE(events.recalls, events.throws);
+            ASSERT_LE(events.catches, events.recalls);
+            ASSERT_LE(events.throws - events.catches, 1);
+        }
+        EXPECT_GT(run.events[Config::Right].throws, 0) << "period " << period;
+        RunFinite(run, scenario);
+    }
+}
+
+TEST(TrickMachine, ZeroDeltaTimeDoesNotMove) {
+    ScenarioRun run;
+    Scenario scenario = TinyDeltaTime(2, 0.0f);
+    Vec3 released = Zero();
+    bool thrown = false;
+    for (ScenarioTick const& tick : scenario) {
+        run.Tick(tick);
+        HostSaber const& saber = run.sabers[Config::Right];
+        ASSERT_TRUE(Finite(saber.worldPosition));
+        ASSERT_TRUE(Finite(saber.worldRotation));
+        if (run.state.state[Config::Right] == SaberInteractionState::Thrown) {
+            if (!thrown) {
+                released = saber.worldPosition;
+                thrown = true;
+            }
+            EXPECT_LT(Magnitude(saber.worldPosition - released), 1e-6f);
+        }
+    }
+    EXPECT_TRUE(thrown);
+    // A return with no time passing never lands
+    EXPECT_EQ(run.events[Config::Right].catches, 0);
+}
+
+TEST(TrickMachine, TinyDeltaTimeStaysFinite) {
+    ScenarioRun run;
+    RunFinite(run, TinyDeltaTime(4, 1e-6f));
+    EXPECT_EQ(run.events[Config::Right].throws, run.events[Config::Right].recalls);
+}
+
+TEST(TrickMachine, HandsAreIndependent) {
+    ScenarioRun both;
+    RunFinite(both, BothHands(4));
+    ScenarioRun rightOnly;
+    Scenario right = BothHands(4);
+    for (ScenarioTick& tick : right) {
+        tick.hands[Config::Left] = RestingHand(Config::Left);
+    }
+    RunFinite(rightOnly, right);
+
+    EXPECT_EQ(both.events[Config::Left].throws, 4);
+    EXPECT_EQ(both.events[Config::Right].throws, 4);
+    EXPECT_EQ(rightOnly.events[Config::Left].throws, 0);
+    // The right saber ends up exactly where it does with the left hand idle
+    EXPECT_EQ(both.sabers[Config::Right].localPosition.x, rightOnly.sabers[Config::Right].localPosition.x);
+    EXPECT_EQ(both.sabers[Config::Right].worldPosition.z, rightOnly.sabers[Config::Right].worldPosition.z);
+    EXPECT_EQ(both.events[Config::Right].catches, rightOnly.events[Config::Right].catches);
+}
+
+// A thrown saber advanced both by 90 Hz ticks and by a 72 Hz render-rate AdvanceMotion() in
+// between, each given the time since the slot last moved, follows its trajectory in real time:
+// neither path skips or double-counts the other's time.
+TEST(TrickMachine, RenderRateAdvanceKeepsFlightOnItsClock) {
+    ScenarioRun run;
+    Scenario flick = Flicks(1);
+    int release = 0;
+    while (run.state.state[Config::Right] != SaberInteractionState::Thrown) {
+        run.Tick(flick[release++]);
+    }
+    double lastAdvance = release * static_cast<double>(FIXED_DELTA);
+    Vec3 releasePosition = run.sabers[Config::Right].worldPosition;
+    double releaseTime = lastAdvance;
+    Vec3 velocity = run.state.trajectory[Config::Right].Velocity();
+    ASSERT_GT(Magnitude(velocity), 1.0f);
+
+    HandFrame hand = flick[release].hands[Config::Right];
+    hand.actions = THROW;
+    int advances = 0;
+    for (int tick = release + 1, frame = static_cast<int>(lastAdvance * 72.0) + 1; tick < release + 90;) {
+        double tickTime = tick * static_cast<double>(FIXED_DELTA);
+        double frameTime = frame / 72.0;
+        bool render = frameTime < tickTime;
+        double now = render ? frameTime : tickTime;
+        float elapsed = static_cast<float>(now - lastAdvance);
+        HostTrickIO io{run.sabers[Config::Right], hand, run.events[Config::Right]};
+        if (render) {
+            Saber::AdvanceMotion(run.state, Config::Right, run.rest[Config::Right], run.tuning[Config::Right], elapsed, io);
+            frame++;
+        } else {
+            Saber::TickTrick(run.state, Config::Right, run.rest[Config::Right], run.tuning[Config::Right], elapsed, io);
+            tick++;
+        }
+        lastAdvance = now;
+        advances++;
+
+        ASSERT_EQ(run.state.state[Config::Right], SaberInteractionState::Thrown);
+        Vec3 expected = releasePosition + velocity * static_cast<float>(now - releaseTime);
+        ASSERT_LT(Magnitude(run.sabers[Config::Right].worldPosition - expected), 1e-4f) << "advance " << advances;
+    }
+    EXPECT_GT(advances, 150);
+}
+
+// The same through the state machine: a throw held for a minute of 90 Hz ticks stays on the
+// trajectory's closed form at real time since release.
+TEST(TrickMachine, MinuteLongThrowDoesNotDrift) {
+    ScenarioRun run;
+    Scenario scenario = LongHolds(1, 60.0f);
+    int released = -1;
+    float worst = 0.0f;
+    for (size_t k = 0; k < scenario.size(); k++) {
+        run.Tick(scenario[k]);
+        if (run.state.state[Config::Right] != SaberInteractionState::Thrown) {
+            continue;
+        }
+        if (released < 0) {
+            released = static_cast<int>(k) - 1;  // The release tick already advanced one deltaTime
+        }
+        Math::ThrowTrajectory const& trajectory = run.state.trajectory[Config::Right];
+        double t = (static_cast<int>(k) - released) * static_cast<double>(FIXED_DELTA);
+        Vec3 p0 = trajectory.Origin(), v = trajectory.Velocity();
+        Vec3 position = run.sabers[Config::Right].worldPosition;
+        double dx = position.x - (p0.x + v.x * t), dy = position.y - (p0.y + v.y * t), dz = position.z - (p0.z + v.z * t);
+        worst = std::max(worst, static_cast<float>(std::sqrt(dx * dx + dy * dy + dz * dz)));
+    }
+    ASSERT_GE(released, 0);
+    EXPECT_GT(Magnitude(run.state.trajectory[Config::Right].Velocity()), 0.5f);
+    EXPECT_LT(worst, 1e-4f);
+}
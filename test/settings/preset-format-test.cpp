@@ -0,0 +1,201 @@
+#include "settings/preset-format.hpp"
+#include "settings/preset-limits.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace TrickSaber::Presets;
+
+namespace {
+
+    // Values that vary with k across the field types, all inside the UI ranges.
+    PresetValues Sample(int k) {
+        PresetValues values = {};
+        values.LeftSaberSpinSpeed = values.RightSaberSpinSpeed = 2000.0f;
+        values.LeftSaberThrowVelocityMultiplier = values.RightSaberThrowVelocityMultiplier = 3.0f;
+        values.LeftSaberReturnDuration = values.RightSaberReturnDuration = 0.2f;
+        values.PeakThrowVelocity = k % 2;
+        values.LeftSaberSpinButton = k % 5;
+        values.RightSaberThrowButton = (k + 1) % 5;
+        values.RightSaberSpinChordButton = (k + 2) % 5;
+        values.LeftSaberCombo = k % 3;
+        values.LeftSaberSpinSpeed = 100.0f + 37.0f * k;
+        values.RightSaberSpinAnchorZOffset = -0.2f + 0.003f * k;
+        values.RightSaberThrowVelocityMultiplier = 0.5f + 0.01f * k;
+        values.LeftSaberReturnDuration = 0.02f + 0.005f * k;
+        values.RightSaberReturnEasing = k % 4;
+        return values;
+    }
+
+    bool SameValues(PresetValues const& a, PresetValues const& b) {
+#define TRICKSABER_SAME(name, type) if (a.name != b.name) return false;
+        TRICKSABER_PRESET_FIELDS(TRICKSABER_SAME)
+#undef TRICKSABER_SAME
+        return true;
+    }
+
+    // A preset store file in a fresh temporary directory, mapped the way Presets::Init() maps it.
+    class MappedStore {
+    public:
+        MappedStore() {
+            char pattern[] = "/tmp/preset-format-XXXXXX";
+            dir = mkdtemp(pattern);
+            path = dir + "/presets.tspr";
+        }
+        ~MappedStore() {
+            Unmap();
+            unlink(path.c_str());
+            rmdir(dir.c_str());
+        }
+
+        PresetFileHeader* Map() {
+            int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            EXPECT_GE(fd, 0);
+            EXPECT_EQ(ftruncate(fd, FILE_BYTES), 0);
+            void* p = mmap(nullptr, FILE_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            EXPECT_NE(p, MAP_FAILED);
+            mapping = static_cast<PresetFileHeader*>(p);
+            return mapping;
+        }
+
+        void Unmap() {
+            if (mapping) {
+                munmap(mapping, FILE_BYTES);
+                mapping = nullptr;
+            }
+        }
+
+        std::string dir;
+        std::string path;
+        PresetFileHeader* mapping = nullptr;
+    };
+
+}  // namespace
+
+TEST(PresetFormat, RecordsSurviveARemap) {
+    MappedStore store;
+    PresetFileHeader* header = store.Map();
+    *header = MakeHeader();
+    for (int i = 0; i < MAX_PRESETS; i++) {
+        PresetRecord& record = Records(header)[i];
+        SetName(record, ("preset " + std::to_string(i)).c_str());
+        record.values = Sample(i);
+    }
+    header->count = MAX_PRESETS;
+    header->active = 17;
+    store.Unmap();
+
+    header = store.Map();
+    ASSERT_TRUE(IsValidHeader(*header));
+    EXPECT_EQ(header->count, static_cast<uint32_t>(MAX_PRESETS));
+    EXPECT_EQ(header->active, 17);
+    for (int i = 0; i < MAX_PRESETS; i++) {
+        PresetRecord const& record = Records(header)[i];
+        ASSERT_EQ(std::string(record.name), "preset " + std::to_string(i));
+        ASSERT_TRUE(SameValues(record.values, Sample(i))) << "record " << i;
+    }
+}
+
+TEST(PresetFormat, LongNamesAreTruncatedAndTerminated) {
+    PresetRecord record;
+    std::memset(&record, 'x', sizeof(record));
+    SetName(record, std::string(100, 'n').c_str());
+    EXPECT_EQ(std::string(record.name), std::string(NAME_BYTES - 1, 'n'));
+}
+
+TEST(PresetFormat, ForeignHeadersAreRejected) {
+    PresetFileHeader header = MakeHeader();
+    EXPECT_TRUE(IsValidHeader(header));
+    EXPECT_FALSE(IsMigratableHeader(header));
+
+    PresetFileHeader wrongMagic = header;
+    wrongMagic.magic[0] = 'X';
+    EXPECT_FALSE(IsValidHeader(wrongMagic));
+
+    PresetFileHeader overfull = header;
+    overfull.count = MAX_PRESETS + 1;
+    EXPECT_FALSE(IsValidHeader(overfull));
+
+    PresetFileHeader badActive = header;
+    badActive.count = 3;
+    badActive.active = 3;
+    EXPECT_FALSE(IsValidHeader(badActive));
+
+    PresetFileHeader wrongSize = header;
+    wrongSize.recordSize = sizeof(PresetRecord) + 4;
+    EXPECT_FALSE(IsValidHeader(wrongSize));
+    EXPECT_FALSE(IsMigratableHeader(wrongSize));
+}
+
+// An earlier version's record is today's minus the fields appended since.
+TEST(PresetFormat, OlderRecordsMigrateAsAPrefix) {
+    constexpr uint16_t OLD_SIZE = offsetof(PresetRecord, values) + offsetof(PresetValues, LeftSaberReturnCurve);
+    PresetFileHeader old = MakeHeader();
+    old.version = FORMAT_VERSION - 1;
+    old.recordSize = OLD_SIZE;
+    old.count = 2;
+    old.active = 1;
+    EXPECT_FALSE(IsValidHeader(old));
+    ASSERT_TRUE(IsMigratableHeader(old));
+
+    PresetRecord written;
+    SetName(written, "old");
+    written.values = Sample(9);
+    written.values.LeftSaberReturnCurve = 2;
+    std::vector<char> bytes(reinterpret_cast<char const*>(&written), reinterpret_cast<char const*>(&written) + OLD_SIZE);
+
+    PresetValues defaults = Sample(0);
+    PresetRecord migrated;
+    migrated.values = defaults;
+    std::memcpy(&migrated, bytes.data(), OLD_SIZE);
+    EXPECT_EQ(std::string(migrated.name), "old");
+    EXPECT_EQ(migrated.values.LeftSaberSpinSpeed, Sample(9).LeftSaberSpinSpeed);
+    EXPECT_EQ(migrated.values.LeftSaberReturnCurve, defaults.LeftSaberReturnCurve);
+    EXPECT_EQ(migrated.values.RightSaberReturnEasing, defaults.RightSaberReturnEasing);
+}
+
+TEST(PresetLimits, KeepsWhatTheUiCanSet) {
+    for (int k = 0; k < 40; k++) {
+        PresetValues values = Sample(k);
+        ClampValues(values);
+        ASSERT_TRUE(SameValues(values, Sample(k))) << "sample " << k;
+    }
+}
+
+TEST(PresetLimits, ClampsEverythingElse) {
+    PresetValues values = Sample(0);
+    values.LeftSaberSpinButton = 5;
+    values.RightSaberThrowChordButton = -1;
+    values.LeftSaberComboButton = 1000;
+    values.RightSaberCombo = TrickSaber::Combo::ComboCount;
+    values.LeftSaberReturnCurve = -3;
+    values.RightSaberReturnEasing = 4;
+    values.LeftSaberSpinSpeed = 1e9f;
+    values.RightSaberSpinSpeed = -50.0f;
+    values.LeftSaberSpinAnchorZOffset = std::nanf("");
+    values.RightSaberThrowVelocityMultiplier = INFINITY;
+    values.LeftSaberReturnDuration = 0.0f;
+    values.RightSaberReturnDuration = -INFINITY;
+    ClampValues(values);
+
+    EXPECT_EQ(values.LeftSaberSpinButton, 0);
+    EXPECT_EQ(values.RightSaberThrowChordButton, 0);
+    EXPECT_EQ(values.LeftSaberComboButton, 0);
+    EXPECT_EQ(values.RightSaberCombo, 0);
+    EXPECT_EQ(values.LeftSaberReturnCurve, 0);
+    EXPECT_EQ(values.RightSaberReturnEasing, 0);
+    EXPECT_EQ(values.LeftSaberSpinSpeed, SPIN_SPEED_RANGE.max);
+    EXPECT_EQ(values.RightSaberSpinSpeed, SPIN_SPEED_RANGE.min);
+    EXPECT_EQ(values.LeftSaberSpinAnchorZOffset, SPIN_ANCHOR_RANGE.min);
+    EXPECT_EQ(values.RightSaberThrowVelocityMultiplier, THROW_MULTIPLIER_RANGE.max);
+    EXPECT_EQ(values.LeftSaberReturnDuration, RETURN_DURATION_RANGE.min);
+    EXPECT_EQ(values.RightSaberReturnDuration, RETURN_DURATION_RANGE.min);
+}
@@ -0,0 +1,218 @@
+#include "settings/config-values.hpp"
+#include "settings/save-worker.hpp"
+#include "support/json-writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace TrickSaber::Config;
+using TrickSaber::Test::JsonWriter;
+
+namespace {
+
+    char const* const KEYS[] = {
+#define TRICKSABER_KEY(name, type) #name,
+        TRICKSABER_CONFIG_FIELDS(TRICKSABER_KEY)
+#undef TRICKSABER_KEY
+    };
+    static_assert(sizeof(KEYS) / sizeof(KEYS[0]) == CONFIG_FIELD_COUNT);
+
+    std::string Render(ConfigValues const& values) {
+        JsonWriter writer;
+        WriteConfigJson(writer, values, KEYS);
+        return writer.Text();
+    }
+
+    // Version k of the config: a spin speed the slider could be at.
+    ConfigValues Version(int k) {
+        ConfigValues values = {};
+        values.ModEnabled = true;
+        values.LeftSaberSpinSpeed = 100.0f + 50.0f * static_cast<float>(k);
+        values.RightSaberSpinSpeed = values.LeftSaberSpinSpeed;
+        values.LeftSaberReturnDuration = values.RightSaberReturnDuration = 0.2f;
+        return values;
+    }
+
+    std::string ReadFile(std::string const& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream out;
+        out << file.rdbuf();
+        return out.str();
+    }
+
+    // Version the file holds, or -1 if it is not exactly one rendered version.
+    int VersionOf(std::string const& contents) {
+        constexpr char KEY[] = "\"LeftSaberSpinSpeed\":";
+        char const* key = std::strstr(contents.c_str(), KEY);
+        if (!key) {
+            return -1;
+        }
+        float speed = std::strtof(key + std::strlen(KEY), nullptr);
+        int k = static_cast<int>(std::lround((speed - 100.0f) / 50.0f));
+        return k >= 0 && contents == Render(Version(k)) ? k : -1;
+    }
+
+    class SaveWorkerTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            char pattern[] = "/tmp/save-worker-XXXXXX";
+            dir = mkdtemp(pattern);
+            path = dir + "/config.json";
+        }
+        void TearDown() override {
+            unlink(path.c_str());
+            unlink((path + ".tmp").c_str());
+            rmdir(dir.c_str());
+        }
+
+        std::string dir;
+        std::string path;
+    };
+
+    // A child process that keeps changing values and flushing, reporting each flushed version
+    // down reportFd, until it is killed.
+    [[noreturn]] void SaveUntilKilled(std::string const& path, int reportFd) {
+        SaveWorker<ConfigValues> worker;
+        worker.Start(path, Render);
+        for (int k = 1;; k++) {
+            worker.Changed(Version(k));
+            if (k % 7 == 0 && worker.Flush(std::chrono::milliseconds(2000))) {
+                // Everything up to k is durable now
+                if (write(reportFd, &k, sizeof(k)) != sizeof(k)) {
+                    _exit(1);
+                }
+            }
+            if (k % 3 == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+    }
+
+}  // namespace
+
+TEST(ConfigJson, OneMemberPerValueInFieldOrder) {
+    ConfigValues values = Version(3);
+    values.ThrownSabersCut = true;
+    values.RightSaberReturnEasing = 2;
+    std::string json = Render(values);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_EQ(json.rfind("{\"ModEnabled\":true,", 0), 0u);
+    EXPECT_NE(json.find("\"ThrownSabersCut\":true"), std::string::npos);
+    EXPECT_NE(json.find("\"LeftSaberSpinSpeed\":250,"), std::string::npos);
+    // Floats are written as the double config-utils would hold
+    EXPECT_NE(json.find("\"LeftSaberReturnDuration\":0.20000000298023224"), std::string::npos);
+    EXPECT_NE(json.find(",\"RightSaberReturnEasing\":2}"), std::string::npos);
+}
+
+TEST_F(SaveWorkerTest, WriteFileAtomicallyReplacesWholeFiles) {
+    ASSERT_TRUE(WriteFileAtomically(path, "first"));
+    ASSERT_TRUE(WriteFileAtomically(path, "second"));
+    EXPECT_EQ(ReadFile(path), "second");
+    EXPECT_NE(access((path + ".tmp").c_str(), F_OK), 0);
+    EXPECT_FALSE(WriteFileAtomically(dir + "/missing/config.json", "x"));
+}
+
+TEST_F(SaveWorkerTest, CoalescesADraggedSlider) {
+    SaveWorker<ConfigValues> worker;
+    worker.Start(path, Render);
+    for (int k = 0; k < 50; k++) {
+        worker.Changed(Version(k));
+    }
+    ASSERT_TRUE(worker.Flush(std::chrono::milliseconds(2000)));
+    SaveStats stats = worker.Stats();
+    EXPECT_EQ(stats.changes, 50u);
+    EXPECT_LE(stats.writes, 2u);
+    EXPECT_EQ(VersionOf(ReadFile(path)), 49);
+}
+
+TEST_F(SaveWorkerTest, FlushSoonDoesNotWaitForTheDebounce) {
+    SaveWorker<ConfigValues> worker;
+    worker.Start(path, Render);
+    worker.Changed(Version(7));
+    auto start = std::chrono::steady_clock::now();
+    worker.FlushSoon();
+    while (VersionOf(ReadFile(path)) != 7 && std::chrono::steady_clock::now() - start < DEBOUNCE) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(VersionOf(ReadFile(path)), 7);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, DEBOUNCE);
+}
+
+TEST_F(SaveWorkerTest, StopWritesWhatIsPending) {
+    {
+        SaveWorker<ConfigValues> worker;
+        worker.Start(path, Render);
+        worker.Changed(Version(4));
+    }
+    EXPECT_EQ(VersionOf(ReadFile(path)), 4);
+}
+
+TEST_F(SaveWorkerTest, FailedWritesAreRetried) {
+    std::string missing = dir + "/later";
+    std::string target = missing + "/config.json";
+    SaveWorker<ConfigValues> worker;
+    worker.Start(target, Render);
+    worker.Changed(Version(5));
+    EXPECT_FALSE(worker.Flush(std::chrono::milliseconds(50)));
+    EXPECT_GE(worker.Stats().failures, 1u);
+
+    ASSERT_EQ(mkdir(missing.c_str(), 0755), 0);
+    EXPECT_TRUE(worker.Flush(std::chrono::milliseconds(2000)));
+    worker.Stop();
+    EXPECT_EQ(VersionOf(ReadFile(target)), 5);
+    unlink(target.c_str());
+    rmdir(missing.c_str());
+}
+
+// SIGKILLs a saving process at random moments. The file left behind must always be one whole
+// rendering, at least as new as the last flush the process reported done.
+TEST_F(SaveWorkerTest, SurvivesKillsMidSave) {
+    constexpr int KILLS = 40;
+    std::mt19937 random(12345);
+    int bad = 0;
+    int stale = 0;
+    for (int run = 0; run < KILLS; run++) {
+        unlink(path.c_str());
+        ASSERT_TRUE(WriteFileAtomically(path, Render(Version(0))));
+        int report[2];
+        ASSERT_EQ(pipe(report), 0);
+        pid_t child = fork();
+        ASSERT_GE(child, 0);
+        if (child == 0) {
+            close(report[0]);
+            SaveUntilKilled(path, report[1]);
+        }
+        close(report[1]);
+        std::this_thread::sleep_for(std::chrono::microseconds(std::uniform_int_distribution<int>(0, 30000)(random)));
+        kill(child, SIGKILL);
+        waitpid(child, nullptr, 0);
+
+        int durable = 0;
+        int k;
+        while (read(report[0], &k, sizeof(k)) == sizeof(k)) {
+            durable = k;
+        }
+        close(report[0]);
+
+        int found = VersionOf(ReadFile(path));
+        if (found < 0) {
+            bad++;
+        } else if (found < durable) {
+            stale++;
+        }
+    }
+    EXPECT_EQ(bad, 0) << "torn or unreadable files";
+    EXPECT_EQ(stale, 0) << "files older than a completed flush";
+}
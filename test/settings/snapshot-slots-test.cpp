@@ -0,0 +1,134 @@
+#include "settings/snapshot-slots.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using TrickSaber::Config::SnapshotSlots;
+
+namespace {
+
+    // Every word holds the generation that wrote it, so a torn or rewritten read shows up as a
+    // word that disagrees with the first.
+    struct Stamped {
+        uint32_t words[64];
+    };
+
+    void Stamp(Stamped& value, uint32_t generation) {
+        for (uint32_t& word : value.words) {
+            word = generation;
+        }
+    }
+
+}  // namespace
+
+TEST(SnapshotSlots, EmptyUntilFirstPublish) {
+    SnapshotSlots<Stamped> slots;
+    EXPECT_FALSE(slots.Acquire());
+    EXPECT_EQ(slots.Publish(Stamp), 1u);
+    auto pin = slots.Acquire();
+    ASSERT_TRUE(pin);
+    EXPECT_EQ(pin->words[0], 1u);
+}
+
+TEST(SnapshotSlots, PinSurvivesLaterPublishes) {
+    SnapshotSlots<Stamped, 4> slots;
+    slots.Publish(Stamp);
+    auto held = slots.Acquire();
+    for (int i = 0; i < 100; i++) {
+        slots.Publish(Stamp);
+    }
+    for (uint32_t word : held->words) {
+        EXPECT_EQ(word, 1u);
+    }
+    EXPECT_EQ(slots.Acquire()->words[0], 101u);
+}
+
+TEST(SnapshotSlots, PublishWaitsForAFreeSlot) {
+    SnapshotSlots<Stamped, 2> slots;
+    slots.Publish(Stamp);
+    auto first = slots.Acquire();
+    slots.Publish(Stamp);
+    auto second = slots.Acquire();
+
+    // Both slots pinned: the next publish has to wait for one to be dropped
+    std::atomic<bool> published = false;
+    std::thread writer([&] {
+        slots.Publish(Stamp);
+        published = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(published);
+    EXPECT_EQ(first->words[0], 1u);
+    first = {};
+    writer.join();
+    EXPECT_TRUE(published);
+    EXPECT_EQ(second->words[63], 2u);
+    EXPECT_EQ(slots.Acquire()->words[0], 3u);
+}
+
+// Two publishers and four readers for a fixed number of publishes. Every pinned read must be
+// whole and must stay put while held, and each reader must never see generations go back.
+TEST(SnapshotSlots, PublishReadHammer) {
+    constexpr int PUBLISHES_PER_WRITER = 20000;
+    constexpr int WRITERS = 2;
+    constexpr int READERS = 4;
+
+    SnapshotSlots<Stamped> slots;
+    slots.Publish(Stamp);
+    std::atomic<bool> done = false;
+    std::atomic<int> torn = 0;
+    std::atomic<int> backwards = 0;
+    std::atomic<uint64_t> reads = 0;
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < READERS; r++) {
+        threads.emplace_back([&] {
+            uint32_t last = 0;
+            uint64_t count = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                auto pin = slots.Acquire();
+                uint32_t generation = pin->words[0];
+                if (generation < last) {
+                    backwards++;
+                }
+                last = generation;
+                // Read it twice with a yield between, as a tick that gets preempted would
+                for (int pass = 0; pass < 2; pass++) {
+                    for (uint32_t word : pin->words) {
+                        if (word != generation) {
+                            torn++;
+                        }
+                    }
+                    std::this_thread::yield();
+                }
+                count++;
+            }
+            reads += count;
+        });
+    }
+    std::vector<std::thread> writers;
+    for (int w = 0; w < WRITERS; w++) {
+        writers.emplace_back([&] {
+            for (int i = 0; i < PUBLISHES_PER_WRITER; i++) {
+                slots.Publish(Stamp);
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(backwards, 0);
+    EXPECT_GT(reads, 0u);
+    EXPECT_EQ(slots.Generation(), 1u + WRITERS * PUBLISHES_PER_WRITER);
+    EXPECT_EQ(slots.Acquire()->words[0], slots.Generation());
+}
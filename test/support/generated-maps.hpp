@@ -0,0 +1,73 @@
+#pragma once
+
+// Synthetic beatmap timelines for the gap index, shared by the tests and the benchmarks: notes
+// for both hands in streams and jumps, with arcs, chains, bombs, walls and breaks mixed in,
+// shuffled the way the game's object list arrives.
+
+#include "beatmap/gap-index.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace TrickSaber::Test {
+
+    // xorshift32, so a seed gives the same map everywhere.
+    class MapRandom {
+    public:
+        explicit MapRandom(uint32_t seed) : state(seed ? seed : 1) {}
+
+        float Next(float lo, float hi) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return lo + (hi - lo) * static_cast<float>(state >> 8) / static_cast<float>(1 << 24);
+        }
+
+    private:
+        uint32_t state;
+    };
+
+    // A map of count objects at about nps objects a second.
+    inline std::vector<Beatmap::TimelineItem> GenerateMap(MapRandom& random, int count, float nps) {
+        using Beatmap::TimelineKind;
+        std::vector<Beatmap::TimelineItem> items;
+        items.reserve(count);
+        float time = 2.0f;
+        while (static_cast<int>(items.size()) < count) {
+            float roll = random.Next(0.0f, 1.0f);
+            int8_t hand = static_cast<int8_t>(random.Next(0.0f, 1.0f) < 0.5f ? 0 : 1);
+            if (roll < 0.03f) {
+                // A break
+                time += random.Next(1.0f, 6.0f);
+            } else if (roll < 0.08f) {
+                float tail = time + random.Next(0.2f, 1.5f);
+                items.push_back({time, tail, TimelineKind::Slider, hand});
+                items.push_back({time, time, TimelineKind::Note, hand});
+                items.push_back({tail, tail, TimelineKind::Note, hand});
+            } else if (roll < 0.12f) {
+                items.push_back({time, time, TimelineKind::Bomb, -1});
+            } else if (roll < 0.14f) {
+                items.push_back({time, time + random.Next(0.1f, 4.0f), TimelineKind::Obstacle, -1});
+            } else {
+                // A stream or a jump: one note for each hand on the same beat half the time
+                items.push_back({time, time, TimelineKind::Note, hand});
+                if (roll > 0.6f) items.push_back({time, time, TimelineKind::Note, static_cast<int8_t>(1 - hand)});
+            }
+            time += random.Next(0.2f, 1.8f) / nps;
+        }
+        // Objects arrive out of order from the game's list; shuffle so the build has to sort
+        for (int i = static_cast<int>(items.size()) - 1; i > 0; i--) {
+            std::swap(items[i], items[static_cast<int>(random.Next(0.0f, static_cast<float>(i) + 0.999f))]);
+        }
+        return items;
+    }
+
+    inline float SongLength(std::vector<Beatmap::TimelineItem> const& items) {
+        float end = 0.0f;
+        for (Beatmap::TimelineItem const& item : items) end = std::max(end, item.endTime);
+        return end + 2.0f;
+    }
+
+}  // namespace TrickSaber::Test
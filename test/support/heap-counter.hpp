@@ -0,0 +1,13 @@
+#pragma once
+
+// Counts every operator new in the binary it is linked into (test/support/heap-counter.cpp),
+// so a test or tool can check that a stretch of code never touches the heap. Take the
+// difference around code that runs on the caller's own thread.
+
+#include <cstdint>
+
+namespace TrickSaber::Test {
+
+    uint64_t HeapAllocations();
+
+}  // namespace TrickSaber::Test
@@ -0,0 +1,54 @@
+#pragma once
+
+// The rapidjson writer calls WriteConfigJson() (settings/config-values.hpp) makes, writing compact
+// JSON into a string. The host build has no rapidjson; doubles keep 17 digits so they read back
+// exactly.
+
+#include <cstdio>
+#include <string>
+
+namespace TrickSaber::Test {
+
+    class JsonWriter {
+    public:
+        void StartObject() { Separate(); out += '{'; first = true; }
+        void EndObject() { out += '}'; first = false; }
+        void Key(char const* key) {
+            Separate();
+            out += '"';
+            for (char const* c = key; *c; c++) {
+                if (*c == '"' || *c == '\\') {
+                    out += '\\';
+                }
+                out += *c;
+            }
+            out += "\":";
+            afterKey = true;
+        }
+        void Bool(bool value) { Separate(); out += value ? "true" : "false"; }
+        void Int(int value) { Separate(); out += std::to_string(value); }
+        void Double(double value) {
+            Separate();
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.17g", value);
+            out += text;
+        }
+
+        std::string const& Text() const { return out; }
+
+    private:
+        void Separate() {
+            if (afterKey) {
+                afterKey = false;
+            } else if (!first) {
+                out += ',';
+            }
+            first = false;
+        }
+
+        std::string out;
+        bool first = true;
+        bool afterKey = false;
+    };
+
+}  // namespace TrickSaber::Test
@@ -0,0 +1,108 @@
+#pragma once
+
+// Synthetic trick spam for the replication stream, shared by the benchmarks and
+// tools/recording/tsrec-replicate: sabers that spin, throw the moment they are back in hand,
+// and come straight back to a hand that keeps moving. Each tick holds the frames the encoder
+// is given and the poses the sender drew, to compare a spectator's against.
+
+#include "replication/stream.hpp"
+#include "saber/trick-machine.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace TrickSaber::Test {
+
+    using namespace TrickSaber::Math;
+    using Replication::MAX_REPLICATED_SABERS;
+    using Replication::SaberFrame;
+    using Saber::SaberInteractionState;
+
+    struct TickFrames {
+        float time;
+        int count;
+        SaberFrame frames[MAX_REPLICATED_SABERS];
+        ThrowTrajectory trajectories[MAX_REPLICATED_SABERS];
+        Vec3 drawnPosition[MAX_REPLICATED_SABERS];  // Where the sender drew each saber
+        Quat drawnRotation[MAX_REPLICATED_SABERS];
+    };
+
+    constexpr float TICK_RATE = 90.0f;
+
+    // --- Synthetic trick spam, one 1.2 s cycle per saber: spin, throw, return, held ---
+    constexpr float CYCLE = 1.2f;
+    constexpr float SPIN_END = 0.2f;
+    constexpr float THROW_END = 0.8f;
+    constexpr float RETURN_END = 1.0f;
+
+    inline Vec3 SpamHand(float time, int saber) {
+        return {(saber % 2 ? 0.3f : -0.3f) + 0.1f * std::sin(2.0f * time), 1.2f + 0.05f * std::sin(3.0f * time), 0.3f};
+    }
+
+    inline void SpamFrame(float time, int saber, SaberFrame& frame, ThrowTrajectory& trajectory) {
+        float phase = std::fmod(time + 0.37f * saber, CYCLE);
+        float throwStart = time - (phase - SPIN_END);
+        Vec3 hand = SpamHand(time, saber);
+        Quat handRotation = AngleAxis(20.0f * std::sin(time), {0.0f, 1.0f, 0.0f});
+        trajectory = ThrowTrajectory(SpamHand(throwStart, saber) + Vec3{0.0f, 0.0f, 0.3f}, Identity(),
+                                     Vec3{std::sin(throwStart), 3.0f, 5.0f + saber * 0.25f}, Vec3{20.0f, 0.0f, 5.0f});
+
+        frame = {};
+        frame.hand = static_cast<uint8_t>(saber % 2);
+        frame.hasPose = true;
+        if (phase < SPIN_END) {
+            frame.state = SaberInteractionState::Held;
+            frame.spinActive = true;
+            frame.space = 0;
+            frame.position = {0.0f, 0.0f, 0.1f};
+            frame.rotation = AngleAxis(2000.0f * phase, {1.0f, 0.0f, 0.0f});
+        } else if (phase < THROW_END) {
+            frame.state = SaberInteractionState::Thrown;
+            frame.space = 1;
+            frame.flightTime = phase - SPIN_END;
+            frame.trajectory = &trajectory;
+            trajectory.Evaluate(frame.flightTime, frame.position, frame.rotation);
+        } else if (phase < RETURN_END) {
+            frame.state = SaberInteractionState::Returning;
+            frame.space = 1;
+            frame.flightTime = phase - SPIN_END;
+            frame.trajectory = &trajectory;
+            frame.returnTime = phase - THROW_END;
+            frame.returnDuration = RETURN_END - THROW_END;
+            // Every curve in turn, so the style byte goes through the stream too
+            frame.returnStyle = Math::ReturnStyle(static_cast<Math::ReturnCurve>(saber % static_cast<int>(Math::ReturnCurve::Count)),
+                                                  Math::ReturnEasing::EaseInOut);
+            frame.position = hand;
+            frame.rotation = handRotation;
+        } else {
+            frame.state = SaberInteractionState::Held;
+            frame.hasPose = false;
+        }
+    }
+
+    inline std::vector<TickFrames> SpamTicks(int sabers, float seconds) {
+        std::vector<TickFrames> ticks(static_cast<size_t>(seconds * TICK_RATE));
+        for (size_t t = 0; t < ticks.size(); t++) {
+            TickFrames& tick = ticks[t];
+            tick.time = static_cast<float>(t) / TICK_RATE;
+            tick.count = sabers;
+            for (int k = 0; k < sabers; k++) {
+                SpamFrame(tick.time, k, tick.frames[k], tick.trajectories[k]);
+                SaberFrame const& frame = tick.frames[k];
+                tick.drawnPosition[k] = frame.position;
+                tick.drawnRotation[k] = frame.rotation;
+                if (frame.state == SaberInteractionState::Returning) {
+                    Vec3 releasePosition;
+                    Quat releaseRotation;
+                    float recall = frame.flightTime - frame.returnTime;
+                    tick.trajectories[k].Evaluate(recall, releasePosition, releaseRotation);
+                    Saber::ReturnPose(Math::ReturnPathFor(frame.returnStyle), tick.trajectories[k], releasePosition, releaseRotation, frame.flightTime,
+                                      frame.returnTime / frame.returnDuration, frame.position, frame.rotation,
+                                      tick.drawnPosition[k], tick.drawnRotation[k]);
+                }
+            }
+        }
+        return ticks;
+    }
+
+}  // namespace TrickSaber::Test
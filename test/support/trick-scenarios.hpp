@@ -0,0 +1,260 @@
+#pragma once
+
+// Synthetic input traces for the trick state machine, shared by the tests and the benchmarks.
+// A scenario is a list of ticks, each with a deltaTime and both hands' poses and held actions.
+// ScenarioRun drives one saber per hand through TickTrick() the way the fixed tick does, with
+// a host IO in place of the saber Transform, and counts the events the machine emits.
+
+#include "input/bindings.hpp"
+#include "saber/trick-machine.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace TrickSaber::Test {
+
+    using namespace TrickSaber::Math;
+
+    constexpr float FIXED_DELTA = 1.0f / 90.0f;
+    constexpr uint32_t THROW = Input::ActionBit(Input::Throw);
+    constexpr uint32_t SPIN = Input::ActionBit(Input::Spin);
+
+    struct HandFrame {
+        Vec3 position;
+        Quat rotation;
+        uint32_t actions;  // Input::ActionBit
+    };
+
+    struct ScenarioTick {
+        float deltaTime;
+        HandFrame hands[Config::HandCount];
+    };
+
+    using Scenario = std::vector<ScenarioTick>;
+
+    // A saber under a hand, or loose in world space once thrown.
+    struct HostSaber {
+        bool attached = true;
+        Vec3 localPosition = Zero();
+        Quat localRotation = Identity();
+        Vec3 worldPosition = Zero();
+        Quat worldRotation = Identity();
+    };
+
+    struct EventCounts {
+        int throws = 0;
+        int recalls = 0;
+        int catches = 0;
+        int spinsStarted = 0;
+    };
+
+    struct HostTrickIO {
+        HostSaber& saber;
+        HandFrame const& hand;
+        EventCounts& events;
+
+        bool ThrowPressed() { return hand.actions & THROW; }
+        bool SpinPressed() { return hand.actions & SPIN; }
+
+        Vec3 SaberPosition() { return saber.attached ? HandPointToWorld(saber.localPosition) : saber.worldPosition; }
+        Quat SaberRotation() { return saber.attached ? hand.rotation * saber.localRotation : saber.worldRotation; }
+
+        void Detach() {
+            saber.worldPosition = SaberPosition();
+            saber.worldRotation = SaberRotation();
+            saber.attached = false;
+        }
+
+        bool Reattach() {
+            if (saber.attached) {
+                return false;
+            }
+            saber.attached = true;
+            return true;
+        }
+
+        Vec3 HandPointToWorld(Vec3 local) { return hand.position + hand.rotation * local; }
+        Quat HandRotation() { return hand.rotation; }
+
+        void SetLocal(Vec3 position, Quat rotation) {
+            saber.localPosition = position;
+            saber.localRotation = rotation;
+        }
+
+        void SetWorld(Vec3 position, Quat rotation) {
+            saber.worldPosition = position;
+            saber.worldRotation = rotation;
+        }
+
+        template <Log::Level L>
+        void Emit(Log::Event event, float = 0.0f) {
+            switch (event) {
+                case Log::Event::ThrowInitiated: events.throws++; break;
+                case Log::Event::RecallInitiated: events.recalls++; break;
+                case Log::Event::ReturnedToHand: events.catches++; break;
+                case Log::Event::SpinActivated: events.spinsStarted++; break;
+                default: break;
+            }
+        }
+    };
+
+    inline Config::HandTuning DefaultTuning() {
+        // Mirrors the config-utils defaults in settings/config.hpp.
+        Config::HandTuning tuning;
+        tuning.throwBound = true;
+        tuning.spinBound = true;
+        tuning.spinDirection = 1.0f;
+        tuning.spinDegPerSec = 2000.0f;
+        tuning.spinRadPerSec = tuning.spinDegPerSec * DEG2RAD;
+        tuning.spinAnchorZOffset = -0.2f;
+        tuning.throwVelocityMultiplier = 3.0f;
+        tuning.returnDuration = 0.2f;
+        tuning.returnStyle = Math::DEFAULT_RETURN_STYLE;
+        tuning.returnPath = &Math::ReturnPathFor(tuning.returnStyle);
+        tuning.peakReleaseWindow = 0.0f;
+        return tuning;
+    }
+
+    // Hand at rest at shoulder height, left or right of the body.
+    inline HandFrame RestingHand(int hand) {
+        return {{hand == Config::Left ? -0.25f : 0.25f, 1.2f, 0.3f}, Identity(), 0};
+    }
+
+    // A forward swing peaking at about 4 m/s, phase in [0, 1).
+    inline Vec3 SwingOffset(float phase) {
+        float const reach = 0.6f / (2.0f * 3.14159265f);
+        return {0.0f, 0.2f * std::sin(phase * 2.0f * 3.14159265f), reach * (1.0f - std::cos(phase * 2.0f * 3.14159265f))};
+    }
+
+    // --- Scenarios ---
+
+    // Quick throws: swing, press throw for a few ticks at the fastest point, let go and catch.
+    // Spin is held through every other swing so both throw branches run.
+    inline Scenario Flicks(int count, int hand = Config::Right) {
+        Scenario ticks;
+        constexpr int SWING_TICKS = 24;
+        for (int f = 0; f < count; f++) {
+            for (int k = 0; k < SWING_TICKS + 30; k++) {
+                ScenarioTick tick{FIXED_DELTA, {RestingHand(Config::Left), RestingHand(Config::Right)}};
+                HandFrame& frame = tick.hands[hand];
+                if (k < SWING_TICKS) {
+                    frame.position = frame.position + SwingOffset(static_cast<float>(k) / SWING_TICKS);
+                }
+                if (f % 2 == 1 && k < SWING_TICKS / 2) {
+                    frame.actions |= SPIN;
+                }
+                if (k >= SWING_TICKS / 2 && k < SWING_TICKS / 2 + 4) {
+                    frame.actions |= THROW;
+                }
+                ticks.push_back(tick);
+            }
+        }
+        return ticks;
+    }
+
+    // One throw held for holdSeconds while the hand drifts, then a recall and a wait for the catch.
+    inline Scenario LongHolds(int count, float holdSeconds = 2.0f) {
+        Scenario ticks;
+        int holdTicks = static_cast<int>(holdSeconds / FIXED_DELTA);
+        for (int h = 0; h < count; h++) {
+            for (int k = 0; k < holdTicks + 60; k++) {
+                ScenarioTick tick{FIXED_DELTA, {RestingHand(Config::Left), RestingHand(Config::Right)}};
+                HandFrame& frame = tick.hands[Config::Right];
+                float t = k * FIXED_DELTA;
+                frame.position = frame.position + Vec3{0.1f * std::sin(t), 0.05f * std::cos(2.0f * t), 0.0f};
+                frame.rotation = AngleAxis(20.0f * std::sin(t), Up());
+                if (k < 8) {
+                    frame.position = frame.position + SwingOffset(k / 16.0f);
+                }
+                if (k >= 4 && k < 4 + holdTicks) {
+                    frame.actions |= THROW;
+                }
+                ticks.push_back(tick);
+            }
+        }
+        return ticks;
+    }
+
+    // Throw toggled every period ticks while the hand keeps swinging, so throws land mid-return
+    // and recalls land the tick after a throw.
+    inline Scenario ThrowRecallSpam(int tickCount, int period = 1) {
+        Scenario ticks;
+        for (int k = 0; k < tickCount; k++) {
+            ScenarioTick tick{FIXED_DELTA, {RestingHand(Config::Left), RestingHand(Config::Right)}};
+            HandFrame& frame = tick.hands[Config::Right];
+            frame.position = frame.position + SwingOffset((k % 24) / 24.0f);
+            if ((k / period) % 2 == 0) {
+                frame.actions |= THROW;
+            }
+            if ((k / 7) % 3 == 0) {
+                frame.actions |= SPIN;
+            }
+            ticks.push_back(tick);
+        }
+        return ticks;
+    }
+
+    // Flicks with every deltaTime replaced by deltaTime (0 for paused frames, or tiny).
+    inline Scenario TinyDeltaTime(int count, float deltaTime) {
+        Scenario ticks = Flicks(count);
+        for (ScenarioTick& tick : ticks) {
+            tick.deltaTime = deltaTime;
+        }
+        return ticks;
+    }
+
+    // Both hands flicking at once, out of phase.
+    inline Scenario BothHands(int count) {
+        Scenario left = Flicks(count, Config::Left);
+        Scenario right = Flicks(count, Config::Right);
+        constexpr int OFFSET = 11;
+        for (size_t k = 0; k < right.size(); k++) {
+            left[k].hands[Config::Right] = right[(k + OFFSET) % right.size()].hands[Config::Right];
+        }
+        return left;
+    }
+
+    // --- Runner ---
+
+    // Two sabers, slot 0 in the left hand and slot 1 in the right, ticked like the fixed tick:
+    // hand samples first, then TickTrick() per saber.
+    struct ScenarioRun {
+        Saber::TrickHotState state = {};
+        Saber::SaberRestPose rest[Config::HandCount];
+        HostSaber sabers[Config::HandCount];
+        EventCounts events[Config::HandCount];
+        Config::HandTuning tuning[Config::HandCount];
+        uint64_t timeNs = 0;
+
+        ScenarioRun() {
+            state.count = Config::HandCount;
+            for (int hand = 0; hand < Config::HandCount; hand++) {
+                rest[hand] = {{0.0f, 0.0f, 0.05f}, AngleAxis(-10.0f, Right()), {1.0f, 1.0f, 1.0f}};
+                sabers[hand].localPosition = rest[hand].position;
+                sabers[hand].localRotation = rest[hand].rotation;
+                state.handPosition[hand] = RestingHand(hand).position;
+                tuning[hand] = DefaultTuning();
+            }
+        }
+
+        void Tick(ScenarioTick const& tick) {
+            timeNs += static_cast<uint64_t>(static_cast<double>(tick.deltaTime) * 1e9);
+            for (int hand = 0; hand < Config::HandCount; hand++) {
+                state.handPosition[hand] = tick.hands[hand].position;
+            }
+            Saber::PushHandSamples(state, timeNs);
+            for (int hand = 0; hand < Config::HandCount; hand++) {
+                HostTrickIO io{sabers[hand], tick.hands[hand], events[hand]};
+                Saber::TickTrick(state, hand, rest[hand], tuning[hand], tick.deltaTime, io);
+            }
+        }
+
+        // Where the saber is drawn, in world space.
+        Vec3 SaberPosition(int hand, HandFrame const& frame) const {
+            HostSaber const& saber = sabers[hand];
+            return saber.attached ? frame.position + frame.rotation * saber.localPosition : saber.worldPosition;
+        }
+    };
+
+}  // namespace TrickSaber::Test
@@ -0,0 +1,109 @@
+#pragma once
+
+// UnityEngine.Vector3 / Quaternion formulas written out the way Unity's C# (and its native Slerp
+// and AngleAxis) compute them: in double, the reference physics/math.hpp is checked against, and
+// in float, what the benchmarks compare its kernels with.
+
+#include "physics/math.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace TrickSaber::Test::Unity {
+
+    template <typename T = double>
+    struct Vector3 {
+        T x, y, z;
+    };
+
+    template <typename T = double>
+    struct Quaternion {
+        T x, y, z, w;
+    };
+
+    template <typename T = double>
+    Vector3<T> From(Math::Vec3 v) {
+        return {v.x, v.y, v.z};
+    }
+
+    template <typename T = double>
+    Quaternion<T> From(Math::Quat q) {
+        return {q.x, q.y, q.z, q.w};
+    }
+
+    // Vector3.Cross
+    template <typename T>
+    Vector3<T> Cross(Vector3<T> a, Vector3<T> b) {
+        return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    }
+
+    // Vector3.Normalize: zero below kEpsilon (1e-5)
+    template <typename T>
+    Vector3<T> Normalized(Vector3<T> v) {
+        T mag = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+        if (mag <= T(1e-5)) return {0, 0, 0};
+        return {v.x / mag, v.y / mag, v.z / mag};
+    }
+
+    // Quaternion.operator*(Quaternion, Quaternion)
+    template <typename T>
+    Quaternion<T> Multiply(Quaternion<T> lhs, Quaternion<T> rhs) {
+        return {
+            lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+            lhs.w * rhs.y + lhs.y * rhs.w + lhs.z * rhs.x - lhs.x * rhs.z,
+            lhs.w * rhs.z + lhs.z * rhs.w + lhs.x * rhs.y - lhs.y * rhs.x,
+            lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z,
+        };
+    }
+
+    // Quaternion.operator*(Quaternion, Vector3), through the rotation matrix
+    template <typename T>
+    Vector3<T> Rotate(Quaternion<T> q, Vector3<T> v) {
+        T x2 = q.x * 2, y2 = q.y * 2, z2 = q.z * 2;
+        T xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+        T xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+        T wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+        return {
+            (1 - (yy + zz)) * v.x + (xy - wz) * v.y + (xz + wy) * v.z,
+            (xy + wz) * v.x + (1 - (xx + zz)) * v.y + (yz - wx) * v.z,
+            (xz - wy) * v.x + (yz + wx) * v.y + (1 - (xx + yy)) * v.z,
+        };
+    }
+
+    // Quaternion.AngleAxis, angle in degrees
+    template <typename T>
+    Quaternion<T> AngleAxis(T angleDeg, Vector3<T> axis) {
+        Vector3<T> n = Normalized(axis);
+        T half = angleDeg * T(3.14159265358979323846 / 180.0) * T(0.5);
+        T s = std::sin(half);
+        return {n.x * s, n.y * s, n.z * s, std::cos(half)};
+    }
+
+    // Quaternion.Normalize: identity below Mathf.Epsilon
+    template <typename T>
+    Quaternion<T> Normalized(Quaternion<T> q) {
+        T mag = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        if (mag < T(1e-38)) return {0, 0, 0, 1};
+        return {q.x / mag, q.y / mag, q.z / mag, q.w / mag};
+    }
+
+    // Quaternion.Slerp: t clamped to [0, 1], the shorter way round
+    template <typename T>
+    Quaternion<T> Slerp(Quaternion<T> a, Quaternion<T> b, T t) {
+        t = t < 0 ? 0 : t > 1 ? 1 : t;
+        T cosTheta = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        if (cosTheta < 0) {
+            b = {-b.x, -b.y, -b.z, -b.w};
+            cosTheta = -cosTheta;
+        }
+        T wa = 1 - t;
+        T wb = t;
+        if (cosTheta < 1 - std::numeric_limits<T>::epsilon()) {
+            T theta = std::acos(cosTheta);
+            wa = std::sin((1 - t) * theta) / std::sin(theta);
+            wb = std::sin(t * theta) / std::sin(theta);
+        }
+        return Normalized(Quaternion<T>{a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb, a.w * wa + b.w * wb});
+    }
+
+}  // namespace TrickSaber::Test::Unity
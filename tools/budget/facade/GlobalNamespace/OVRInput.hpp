@@ -0,0 +1,23 @@
+#pragma once
+
+#include "facade.hpp"
+
+namespace GlobalNamespace {
+
+    struct OVRInput {
+        enum class Button : unsigned {
+            None = 0,
+            One = 0x1,
+            Two = 0x2,
+            PrimaryIndexTrigger = 0x100,
+            PrimaryHandTrigger = 0x400,
+        };
+        enum class Controller : unsigned { None = 0, LTouch = 1, RTouch = 2, Touch = 3 };
+
+        static bool Get(Button button, Controller controller) {
+            Facade::Count(Facade::Call::InputGet);
+            return (Facade::heldButtons[static_cast<unsigned>(controller) & 3] & static_cast<unsigned>(button)) != 0;
+        }
+    };
+
+}  // namespace GlobalNamespace
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace UnityEngine {
+
+    struct Quaternion {
+        float x = 0.0f, y = 0.0f, z = 0.0f, w = 1.0f;
+
+        Quaternion() = default;
+        Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    };
+
+}  // namespace UnityEngine
@@ -0,0 +1,103 @@
+#pragma once
+
+// A transform hierarchy without scale: each transform keeps its local pose and derives its
+// world pose through its parents, like Unity does. SetParent models worldPositionStays.
+
+#include "UnityEngine/Quaternion.hpp"
+#include "UnityEngine/Vector3.hpp"
+#include "facade.hpp"
+#include "physics/math.hpp"
+
+namespace UnityEngine {
+
+    class Transform {
+    public:
+        // A new scene object; counted as a managed allocation.
+        static Transform* Create(Transform* parent = nullptr) {
+            Facade::counts.managedAllocations++;
+            auto* transform = new Transform();
+            transform->parent = parent;
+            return transform;
+        }
+
+        Vector3 get_position() { Count(Facade::Call::GetPosition); return Out(WorldPosition()); }
+        Quaternion get_rotation() { Count(Facade::Call::GetRotation); return Out(WorldRotation()); }
+        Vector3 get_localPosition() { Count(Facade::Call::GetLocalPosition); return Out(localPosition); }
+        Quaternion get_localRotation() { Count(Facade::Call::GetLocalRotation); return Out(localRotation); }
+        Vector3 get_localScale() { Count(Facade::Call::GetLocalScale); return Vector3(1.0f, 1.0f, 1.0f); }
+        Transform* get_parent() { Count(Facade::Call::GetParent); return parent; }
+
+        void set_position(Vector3 position) { Count(Facade::Call::SetPosition); SetWorld(In(position), WorldRotation()); }
+        void set_rotation(Quaternion rotation) { Count(Facade::Call::SetRotation); SetWorld(WorldPosition(), In(rotation)); }
+        void set_localPosition(Vector3 position) { Count(Facade::Call::SetLocalPosition); localPosition = In(position); }
+        void set_localRotation(Quaternion rotation) { Count(Facade::Call::SetLocalRotation); localRotation = In(rotation); }
+
+        void SetPositionAndRotation(Vector3 position, Quaternion rotation) {
+            Count(Facade::Call::SetPositionAndRotation);
+            SetWorld(In(position), In(rotation));
+        }
+
+        void SetLocalPositionAndRotation(Vector3 position, Quaternion rotation) {
+            Count(Facade::Call::SetLocalPositionAndRotation);
+            localPosition = In(position);
+            localRotation = In(rotation);
+        }
+
+        void SetParent(Transform* newParent, bool worldPositionStays) {
+            Count(Facade::Call::SetParent);
+            TrickSaber::Math::Vec3 position = WorldPosition();
+            TrickSaber::Math::Quat rotation = WorldRotation();
+            parent = newParent;
+            if (worldPositionStays) {
+                SetWorld(position, rotation);
+            }
+        }
+
+        Vector3 TransformPoint(Vector3 point) {
+            Count(Facade::Call::TransformPoint);
+            return Out(WorldPosition() + WorldRotation() * In(point));
+        }
+
+        Vector3 TransformDirection(Vector3 direction) {
+            Count(Facade::Call::TransformDirection);
+            return Out(WorldRotation() * In(direction));
+        }
+
+        // --- Uncounted access for the tool's own scripting and checks ---
+        TrickSaber::Math::Vec3 localPosition = {0.0f, 0.0f, 0.0f};
+        TrickSaber::Math::Quat localRotation = TrickSaber::Math::Identity();
+
+        TrickSaber::Math::Vec3 WorldPosition() const {
+            return parent ? parent->WorldPosition() + parent->WorldRotation() * localPosition : localPosition;
+        }
+
+        TrickSaber::Math::Quat WorldRotation() const {
+            return parent ? parent->WorldRotation() * localRotation : localRotation;
+        }
+
+        Transform* Parent() const { return parent; }
+
+    private:
+        Transform() = default;
+
+        static void Count(Facade::Call call) { Facade::Count(call); }
+        static TrickSaber::Math::Vec3 In(Vector3 v) { return {v.x, v.y, v.z}; }
+        static TrickSaber::Math::Quat In(Quaternion q) { return {q.x, q.y, q.z, q.w}; }
+        static Vector3 Out(TrickSaber::Math::Vec3 v) { return Vector3(v.x, v.y, v.z); }
+        static Quaternion Out(TrickSaber::Math::Quat q) { return Quaternion(q.x, q.y, q.z, q.w); }
+
+        void SetWorld(TrickSaber::Math::Vec3 position, TrickSaber::Math::Quat rotation) {
+            if (parent) {
+                TrickSaber::Math::Quat toLocal = TrickSaber::Math::Inverse(parent->WorldRotation());
+                localPosition = toLocal * (position - parent->WorldPosition());
+                localRotation = toLocal * rotation;
+            } else {
+                localPosition = position;
+                localRotation = rotation;
+            }
+        }
+
+        Transform* parent = nullptr;
+    };
+
+}  // namespace UnityEngine
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace UnityEngine {
+
+    struct Vector3 {
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+
+        Vector3() = default;
+        Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
+    };
+
+}  // namespace UnityEngine
@@ -0,0 +1,13 @@
+#pragma once
+
+// What the host-built sources use of config-utils: the mod's data directory, which is under
+// the system temp directory here.
+
+#include "scotland2/shared/loader.hpp"
+
+#include <filesystem>
+#include <string>
+
+inline std::string getDataDir(modloader::ModInfo const& info) {
+    return (std::filesystem::temp_directory_path() / info.id).string() + "/";
+}
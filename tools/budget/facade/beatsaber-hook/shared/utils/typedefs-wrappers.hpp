@@ -0,0 +1,23 @@
+#pragma once
+
+#include "facade.hpp"
+
+// Testing the handle asks the native side whether the object is still alive.
+template <typename T>
+class SafePtrUnity {
+public:
+    SafePtrUnity() = default;
+    SafePtrUnity(T* object) : object(object) {}
+    SafePtrUnity& operator=(T* value) { object = value; return *this; }
+
+    T* ptr() const { return object; }
+    T* operator->() const { return object; }
+
+    explicit operator bool() const {
+        Facade::Count(Facade::Call::AliveCheck);
+        return object != nullptr;
+    }
+
+private:
+    T* object = nullptr;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+// Host stand-in for the Unity, OVRInput and il2cpp surface the tick touches. The headers next
+// to this one replace the codegen and beatsaber-hook headers of the same name, so the mod's
+// own sources compile against them unchanged; every call that would cross into native code
+// on device is counted here instead.
+
+#include <atomic>
+#include <cstdint>
+
+namespace Facade {
+
+    enum class Call : int {
+        GetPosition,
+        GetRotation,
+        GetLocalPosition,
+        GetLocalRotation,
+        GetLocalScale,
+        SetPosition,
+        SetRotation,
+        SetLocalPosition,
+        SetLocalRotation,
+        SetPositionAndRotation,
+        SetLocalPositionAndRotation,
+        GetParent,
+        SetParent,
+        TransformPoint,
+        TransformDirection,
+        InputGet,        // OVRInput::Get
+        AliveCheck,      // A SafePtrUnity tested for a live native object
+        Count,
+    };
+
+    inline char const* const CALL_NAMES[] = {
+        "get_position", "get_rotation", "get_localPosition", "get_localRotation", "get_localScale",
+        "set_position", "set_rotation", "set_localPosition", "set_localRotation",
+        "SetPositionAndRotation", "SetLocalPositionAndRotation", "get_parent", "SetParent",
+        "TransformPoint", "TransformDirection", "OVRInput::Get", "alive check",
+    };
+    static_assert(sizeof(CALL_NAMES) / sizeof(CALL_NAMES[0]) == static_cast<int>(Call::Count));
+
+    struct Counts {
+        uint32_t calls[static_cast<int>(Call::Count)] = {};
+        uint32_t managedAllocations = 0;  // Objects the game's GC would have to collect
+        uint32_t heapAllocations = 0;     // operator new, filled in by the tick budget test
+
+        uint32_t Of(Call call) const { return calls[static_cast<int>(call)]; }
+
+        uint32_t TransformCalls() const {
+            uint32_t total = 0;
+            for (int c = 0; c < static_cast<int>(Call::InputGet); c++) total += calls[c];
+            return total;
+        }
+
+        Counts operator+(Counts const& other) const {
+            Counts sum;
+            for (int c = 0; c < static_cast<int>(Call::Count); c++) sum.calls[c] = calls[c] + other.calls[c];
+            sum.managedAllocations = managedAllocations + other.managedAllocations;
+            sum.heapAllocations = heapAllocations + other.heapAllocations;
+            return sum;
+        }
+
+        Counts operator-(Counts const& earlier) const {
+            Counts diff;
+            for (int c = 0; c < static_cast<int>(Call::Count); c++) diff.calls[c] = calls[c] - earlier.calls[c];
+            diff.managedAllocations = managedAllocations - earlier.managedAllocations;
+            diff.heapAllocations = heapAllocations - earlier.heapAllocations;
+            return diff;
+        }
+    };
+
+    inline Counts counts;
+
+    inline void Count(Call call) { counts.calls[static_cast<int>(call)]++; }
+
+    // Raw OVRInput::Button bits held on each controller (OVRInput::Controller value).
+    inline uint32_t heldButtons[4] = {};
+
+    // Lines handed to the paper logger, by level. Written from whichever thread logs.
+    enum class LogLine : int { Debug, Info, Warn, Error, Count };
+
+    inline std::atomic<uint64_t> logLines[static_cast<int>(LogLine::Count)] = {};
+
+    inline void CountLine(LogLine level) { logLines[static_cast<int>(level)].fetch_add(1, std::memory_order_relaxed); }
+
+    inline uint64_t LinesLogged(LogLine level) { return logLines[static_cast<int>(level)].load(std::memory_order_relaxed); }
+
+}  // namespace Facade
@@ -0,0 +1,33 @@
+#pragma once
+
+// What logger.hpp and logger.cpp use of paper. Lines are counted by level in Facade::logLines,
+// not formatted, so host tests can check what the hook log's flush thread handed over.
+
+#include "facade.hpp"
+
+#include <cstddef>
+
+namespace Paper {
+
+    template <std::size_t N>
+    struct ConstLoggerContext {
+        template <typename... Args> void debug(char const*, Args&&...) const { Facade::CountLine(Facade::LogLine::Debug); }
+        template <typename... Args> void info(char const*, Args&&...) const { Facade::CountLine(Facade::LogLine::Info); }
+        template <typename... Args> void warn(char const*, Args&&...) const { Facade::CountLine(Facade::LogLine::Warn); }
+        template <typename... Args> void error(char const*, Args&&...) const { Facade::CountLine(Facade::LogLine::Error); }
+    };
+
+    template <std::size_t N>
+    struct StringLiteral {
+        constexpr StringLiteral(char const (&text)[N]) {
+            for (std::size_t i = 0; i < N; i++) value[i] = text[i];
+        }
+        char value[N];
+    };
+
+    struct Logger {
+        template <StringLiteral Context>
+        static ConstLoggerContext<sizeof(Context.value)> WithContext() { return {}; }
+    };
+
+}  // namespace Paper
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace modloader {
+
+    struct ModInfo {
+        char const* id;
+        char const* version;
+        int versionLong;
+    };
+
+}  // namespace modloader
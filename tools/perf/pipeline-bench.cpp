@@ -0,0 +1,308 @@
+// Measures how much main-thread time the fixed tick saves by running its compute off the main
+// thread, and how much latency that adds (saber/tick-pipeline.hpp), on the host, in a
+// simulated frame loop.
+//
+//   pipeline-bench [--frames N] [--gap US]
+//
+// Each frame runs the mod's FixedUpdate (gather and publish). Then it spins for GAP
+// microseconds, standing in for the rest of the game's main-thread work. Then it runs the saber
+// render update, which applies the tick. Gather and apply read and write plain host poses
+// instead of Unity transforms. So the main-thread figures are the pipeline's own cost and leave
+// out the il2cpp calls around it, which are the same in both modes.
+//
+// For 2 to 64 sabers under scripted spins, throws and recalls, the same frames run once with
+// the compute inline and once on the workers. Every tick's outputs and the final trick state
+// must match bit for bit between the two, or the run fails. Then the frames run again with no
+// gap, so the render update always arrives before the workers are done. That exercises the
+// inline fallback, and its outputs must match too.
+//
+// Reported per saber count:
+//   - main-thread microseconds per tick in each mode, and the difference;
+//   - the compute moved to the workers;
+//   - p50 and p99 from publish to the workers being done, and p50 from publish to applied;
+//   - the share of sabers the main thread computed itself with no gap.
+
+#include "input/bindings.hpp"
+#include "perf/timers.hpp"
+#include "physics/return-path.hpp"
+#include "saber/tick-pipeline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Math;
+using Saber::SaberInteractionState;
+
+static constexpr float TICK = 1.0f / 90.0f;
+
+static Config::HandTuning Tuning() {
+    Config::HandTuning tuning = {};
+    tuning.throwBound = true;
+    tuning.spinBound = true;
+    tuning.spinDirection = 1.0f;
+    tuning.spinDegPerSec = 2000.0f;
+    tuning.spinRadPerSec = tuning.spinDegPerSec * DEG2RAD;
+    tuning.spinAnchorZOffset = -0.2f;
+    tuning.throwVelocityMultiplier = 3.0f;
+    tuning.returnDuration = 0.2f;
+    tuning.returnStyle = DEFAULT_RETURN_STYLE;
+    tuning.returnPath = &ReturnPathFor(tuning.returnStyle);
+    tuning.peakReleaseWindow = Config::PEAK_RELEASE_WINDOW;
+    return tuning;
+}
+
+// Spin, throw and recall, then a throw out of a spin, every 4 s; each saber a little behind the last.
+static uint32_t ScriptedActions(float now, int slot) {
+    float c = std::fmod(now + 0.37f * static_cast<float>(slot), 4.0f);
+    uint32_t actions = 0;
+    if ((c >= 0.5f && c < 1.2f) || (c >= 2.6f && c < 3.2f)) actions |= Input::ActionBit(Input::Spin);
+    if ((c >= 1.5f && c < 2.1f) || (c >= 2.9f && c < 3.4f)) actions |= Input::ActionBit(Input::Throw);
+    return actions;
+}
+
+static void HandPose(float now, int slot, Vec3& position, Quat& rotation) {
+    float phase = now * 3.0f + static_cast<float>(slot) * 0.9f;
+    position = {(slot & 1 ? 0.25f : -0.25f) + 0.3f * std::sin(phase), 1.2f + 0.2f * std::cos(phase), 0.3f};
+    rotation = AngleAxis(40.0f * std::sin(phase), {1.0f, 0.0f, 0.0f});
+}
+
+// --- The host's stand-in for the sabers' transforms ---
+struct HostScene {
+    int count = 0;
+    bool attached[Saber::MAX_SABERS];
+    bool world[Saber::MAX_SABERS];  // Else position and rotation are local to the hand
+    Vec3 position[Saber::MAX_SABERS];
+    Quat rotation[Saber::MAX_SABERS];
+    Saber::SaberRestPose rest;
+    Config::HandTuning tuning;
+};
+
+static void Setup(HostScene& scene, Saber::TrickHotState& s, int count) {
+    scene.count = count;
+    scene.rest = {{0.0f, 0.0f, 0.02f}, Identity(), {1.0f, 1.0f, 1.0f}};
+    scene.tuning = Tuning();
+    s.count = count;
+    for (int i = 0; i < count; i++) {
+        scene.attached[i] = true;
+        scene.world[i] = false;
+        scene.position[i] = scene.rest.position;
+        scene.rotation[i] = scene.rest.rotation;
+        s.state[i] = SaberInteractionState::Held;
+        s.spinActive[i] = false;
+        s.throwPressedLastFrame[i] = false;
+        s.spinAngle[i] = 0.0f;
+        s.returnTime[i] = 0.0f;
+        s.flightTime[i] = 0.0f;
+        s.handMotion[i].Reset();
+        HandPose(0.0f, i, s.handPosition[i], scene.rotation[i]);
+        scene.rotation[i] = scene.rest.rotation;
+    }
+}
+
+// As GatherSaber() and GatherTickReads() do on device.
+static void Gather(HostScene const& scene, Saber::TrickHotState& s, float now, Saber::TickJob& job) {
+    job.count = scene.count;
+    job.timeNs = static_cast<uint64_t>(now * 1e9f);
+    for (int i = 0; i < scene.count; i++) {
+        Saber::SaberTickInput& in = job.input[i];
+        Quat handRotation;
+        HandPose(now, i, s.handPosition[i], handRotation);
+        in.ready = true;
+        in.attached = scene.attached[i];
+        in.actions = ScriptedActions(now, i);
+        in.deltaTime = TICK;
+        in.tuning = scene.tuning;
+        in.rest = scene.rest;
+        bool throwPressed = in.actions & Input::ActionBit(Input::Throw);
+        if (s.state[i] == SaberInteractionState::Returning || Saber::StartsRecall(s, i, throwPressed)) {
+            in.handRestPoint = s.handPosition[i] + handRotation * scene.rest.position;
+            in.handRotation = handRotation;
+        }
+        if (Saber::StartsThrow(s, i, throwPressed)) {
+            in.saberPosition = scene.world[i] ? scene.position[i] : s.handPosition[i] + handRotation * scene.position[i];
+            in.saberRotation = scene.world[i] ? scene.rotation[i] : handRotation * scene.rotation[i];
+        }
+    }
+}
+
+// As ApplyTickWrites() and the pose writer's flush do on device.
+static void Apply(HostScene& scene, Saber::TickJob const& job) {
+    for (int i = 0; i < job.count; i++) {
+        Saber::SaberTickOutput const& out = job.output[i];
+        if (out.detach) scene.attached[i] = false;
+        if (out.reattach) scene.attached[i] = true;
+        if (out.hasPose) {
+            scene.world[i] = out.world;
+            scene.position[i] = out.position;
+            scene.rotation[i] = out.rotation;
+        }
+    }
+}
+
+static void Mix(uint64_t& hash, void const* data, size_t size) {
+    for (size_t b = 0; b < size; b++) {
+        hash = (hash ^ static_cast<unsigned char const*>(data)[b]) * 1099511628211ull;
+    }
+}
+
+// Everything apply reads, field by field so padding is left out.
+static uint64_t OutputHash(Saber::TickJob const& job) {
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < job.count; i++) {
+        Saber::SaberTickOutput const& out = job.output[i];
+        bool flags[] = {out.buttonEdge, out.detach, out.reattach, out.hasPose, out.world};
+        Mix(hash, &out.stateBefore, sizeof(out.stateBefore));
+        Mix(hash, flags, sizeof(flags));
+        if (out.hasPose) {
+            Mix(hash, &out.position, sizeof(out.position));
+            Mix(hash, &out.rotation, sizeof(out.rotation));
+        }
+        for (int e = 0; e < out.eventCount; e++) {
+            Mix(hash, &out.events[e].event, sizeof(out.events[e].event));
+            Mix(hash, &out.events[e].value, sizeof(out.events[e].value));
+        }
+    }
+    return hash;
+}
+
+static uint64_t StateHash(Saber::TrickHotState const& s) {
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < s.count; i++) {
+        Mix(hash, &s.state[i], sizeof(s.state[i]));
+        Mix(hash, &s.spinAngle[i], sizeof(s.spinAngle[i]));
+        Mix(hash, &s.flightTime[i], sizeof(s.flightTime[i]));
+        Mix(hash, &s.returnTime[i], sizeof(s.returnTime[i]));
+        Mix(hash, &s.releasePosition[i], sizeof(s.releasePosition[i]));
+    }
+    return hash;
+}
+
+// --- The frame loop ---
+struct Run {
+    std::vector<uint64_t> outputs;  // Per tick
+    uint64_t state = 0;
+    uint64_t mainNs = 0;            // Gather, publish, finish and apply
+    uint64_t computeNs = 0;
+    uint64_t sabers = 0;
+    uint64_t inlineSabers = 0;      // Computed by the main thread after a threaded publish
+    Perf::LatencyHistogram ready;   // Publish to computed, seen from the main thread while it waits
+    Perf::LatencyHistogram latency; // Publish to applied
+};
+
+// The rest of the frame's main-thread work, noting when the job's last chunk is done.
+static void Spin(uint64_t untilNs, Saber::TickJob const& job, Perf::LatencyHistogram& ready) {
+    int chunks = (job.count + Saber::SABERS_PER_CHUNK - 1) / Saber::SABERS_PER_CHUNK;
+    bool seen = false;
+    for (uint64_t now = Perf::NowNs(); now < untilNs; now = Perf::NowNs()) {
+        if (!seen && job.done.load(std::memory_order_acquire) == chunks) {
+            ready.Record(now - job.publishedNs);
+            seen = true;
+        }
+    }
+}
+
+static Run RunFrames(int count, int frames, bool threaded, uint64_t gapNs) {
+    Run run;
+    run.outputs.reserve(frames);
+    HostScene scene;
+    auto state = std::make_unique<Saber::TrickHotState>();
+    Setup(scene, *state, count);
+    Saber::TickPipeline pipeline;
+
+    auto apply = [&](Saber::TickJob& job) {
+        Apply(scene, job);
+        run.latency.Record(Perf::NowNs() - job.publishedNs);
+        run.outputs.push_back(OutputHash(job));
+        for (int i = 0; i < job.count; i++) run.computeNs += job.output[i].computeNs;
+        run.sabers += job.count;
+        run.inlineSabers += threaded ? pipeline.InlineSabers() : 0;
+    };
+
+    for (int frame = 0; frame < frames; frame++) {
+        float now = static_cast<float>(frame + 1) * TICK;
+        // --- FixedUpdate ---
+        uint64_t start = Perf::NowNs();
+        if (Saber::TickJob* job = pipeline.Finish()) apply(*job);  // Only when no render update came
+        Saber::TickJob& gathered = pipeline.Gather();
+        Gather(scene, *state, now, gathered);
+        pipeline.Publish(*state, threaded);
+        if (!threaded) apply(*pipeline.Finish());
+        uint64_t end = Perf::NowNs();
+        run.mainNs += end - start;
+
+        // --- The rest of the frame's main-thread work ---
+        Spin(end + gapNs, gathered, run.ready);
+
+        // --- Saber render update ---
+        start = Perf::NowNs();
+        if (Saber::TickJob* job = pipeline.Finish()) apply(*job);
+        run.mainNs += Perf::NowNs() - start;
+    }
+    run.state = StateHash(*state);
+    return run;
+}
+
+static int Mismatch(Run const& a, Run const& b) {
+    if (a.outputs.size() != b.outputs.size()) return 0;
+    for (size_t t = 0; t < a.outputs.size(); t++) {
+        if (a.outputs[t] != b.outputs[t]) return static_cast<int>(t) + 1;
+    }
+    return a.state == b.state ? -1 : static_cast<int>(a.outputs.size());
+}
+
+int main(int argc, char** argv) {
+    int frames = 2000;
+    int gapUs = 500;
+    for (int a = 1; a < argc; a++) {
+        bool hasValue = a + 1 < argc;
+        if (!std::strcmp(argv[a], "--frames") && hasValue) frames = std::max(1, std::atoi(argv[++a]));
+        else if (!std::strcmp(argv[a], "--gap") && hasValue) gapUs = std::max(0, std::atoi(argv[++a]));
+        else {
+            std::fprintf(stderr, "usage: %s [--frames N] [--gap US]\n", argv[0]);
+            return 2;
+        }
+    }
+    uint64_t gapNs = static_cast<uint64_t>(gapUs) * 1000;
+
+    static constexpr int SABER_COUNTS[] = {2, 8, 16, 64};
+    bool ok = true;
+    // With one core the workers only run when the main thread is preempted, so only the
+    // handoff's cost and the checks mean anything
+    std::printf("%d frames, %d us from FixedUpdate to the saber render update, %u cores\n\n", frames, gapUs,
+                std::thread::hardware_concurrency());
+    std::printf("%-7s %10s %10s %9s %11s %10s %10s %10s %10s %s\n", "sabers", "inline us", "thread us", "saved us",
+                "compute us", "ready p50", "ready p99", "apply p50", "no gap", "check");
+    for (int count : SABER_COUNTS) {
+        Run inlined = RunFrames(count, frames, false, gapNs);
+        Run threaded = RunFrames(count, frames, true, gapNs);
+        Run rushed = RunFrames(count, frames, true, 0);
+        int mismatch = Mismatch(inlined, threaded);
+        int rushedMismatch = Mismatch(inlined, rushed);
+        bool matches = mismatch < 0 && rushedMismatch < 0;
+        ok &= matches;
+
+        double perTick = 1e3 * frames;
+        double inlineUs = static_cast<double>(inlined.mainNs) / perTick;
+        double threadUs = static_cast<double>(threaded.mainNs) / perTick;
+        std::printf("%-7d %10.2f %10.2f %9.2f %11.2f %10.2f %10.2f %10.2f %9.0f%% %s\n", count, inlineUs, threadUs, inlineUs - threadUs,
+                    static_cast<double>(threaded.computeNs) / perTick,
+                    static_cast<double>(threaded.ready.Percentile(0.5)) / 1e3,
+                    static_cast<double>(threaded.ready.Percentile(0.99)) / 1e3,
+                    static_cast<double>(threaded.latency.Percentile(0.5)) / 1e3,
+                    100.0 * static_cast<double>(rushed.inlineSabers) / static_cast<double>(std::max<uint64_t>(rushed.sabers, 1)),
+                    matches ? "ok" : "FAILED");
+        if (mismatch >= 0) std::printf("    threaded outputs differ from inline at tick %d\n", mismatch);
+        if (rushedMismatch >= 0) std::printf("    outputs with no gap differ from inline at tick %d\n", rushedMismatch);
+    }
+    std::printf("\nmain-thread time per tick is gather, publish, finish and apply, in us; ready is publish to the\n"
+                "workers done and apply is publish to applied, in us.\n"
+                "\"no gap\" is the share of sabers the main thread computed itself when the render update came at once.\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+// Replays the controller input from a .tsrec recording through the trick state machine on
+// the host, with no Unity runtime, and reports ns/tick and how far the replayed saber
+// poses drift from the recorded ones.
+//
+//   tsrec-replay <recording.tsrec> [--repeat N] [--throw-mult X] [--return-duration X]
+//                [--spin-speed X] [--spin-offset X] [--counter-clockwise] [--peak-release]
+
+#include "combo/scheduler.hpp"
+#include "recording/reader.hpp"
+#include "saber/trick-machine.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Math;
+using namespace TrickSaber::Recording;
+
+// A saber under a hand, or loose in world space once thrown.
+struct HostSaber {
+    bool attached = true;
+    Vec3 localPosition = Zero();
+    Quat localRotation = Identity();
+    Vec3 worldPosition = Zero();
+    Quat worldRotation = Identity();
+};
+
+struct HostTrickIO {
+    HostSaber& saber;
+    Vec3 handPosition;
+    Quat handRotation;
+    uint32_t buttons;
+
+    bool ThrowPressed() { return buttons & BUTTON_THROW; }
+    bool SpinPressed() { return buttons & BUTTON_SPIN; }
+
+    Vec3 SaberPosition() { return saber.attached ? HandPointToWorld(saber.localPosition) : saber.worldPosition; }
+    Quat SaberRotation() { return saber.attached ? handRotation * saber.localRotation : saber.worldRotation; }
+
+    void Detach() {
+        saber.worldPosition = SaberPosition();
+        saber.worldRotation = SaberRotation();
+        saber.attached = false;
+    }
+
+    bool Reattach() {
+        if (saber.attached) {
+            return false;
+        }
+        saber.attached = true;
+        return true;
+    }
+
+    Vec3 HandPointToWorld(Vec3 local) { return handPosition + handRotation * local; }
+    Quat HandRotation() { return handRotation; }
+
+    void SetLocal(Vec3 position, Quat rotation) {
+        saber.localPosition = position;
+        saber.localRotation = rotation;
+    }
+
+    void SetWorld(Vec3 position, Quat rotation) {
+        saber.worldPosition = position;
+        saber.worldRotation = rotation;
+    }
+
+    template <Log::Level L>
+    void Emit(Log::Event, float = 0.0f) {}
+};
+
+static Config::HandTuning DefaultTuning() {
+    // Mirrors the config-utils defaults in settings/config.hpp.
+    Config::HandTuning tuning;
+    tuning.throwBound = true;
+    tuning.spinBound = true;
+    tuning.spinDirection = 1.0f;
+    tuning.spinDegPerSec = 2000.0f;
+    tuning.spinRadPerSec = tuning.spinDegPerSec * DEG2RAD;
+    tuning.spinAnchorZOffset = -0.2f;
+    tuning.throwVelocityMultiplier = 3.0f;
+    tuning.returnDuration = 0.2f;
+    tuning.returnStyle = Math::DEFAULT_RETURN_STYLE;
+    tuning.returnPath = &Math::ReturnPathFor(tuning.returnStyle);
+    tuning.peakReleaseWindow = 0.0f;
+    return tuning;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <recording.tsrec> [--repeat N] [--throw-mult X] [--return-duration X] "
+                             "[--spin-speed X] [--spin-offset X] [--counter-clockwise] [--peak-release]\n", argv[0]);
+        return 2;
+    }
+
+    Config::HandTuning tuning = DefaultTuning();
+    int repeat = 1;
+    for (int a = 2; a < argc; a++) {
+        bool hasValue = a + 1 < argc;
+        if (!std::strcmp(argv[a], "--repeat") && hasValue) repeat = std::max(1, std::atoi(argv[++a]));
+        else if (!std::strcmp(argv[a], "--throw-mult") && hasValue) tuning.throwVelocityMultiplier = std::atof(argv[++a]);
+        else if (!std::strcmp(argv[a], "--return-duration") && hasValue) tuning.returnDuration = std::max<float>(std::atof(argv[++a]), Config::MIN_RETURN_DURATION);
+        else if (!std::strcmp(argv[a], "--spin-speed") && hasValue) tuning.spinDegPerSec = std::atof(argv[++a]);
+        else if (!std::strcmp(argv[a], "--spin-offset") && hasValue) tuning.spinAnchorZOffset = std::atof(argv[++a]);
+        else if (!std::strcmp(argv[a], "--counter-clockwise")) tuning.spinDirection = -1.0f;
+        else if (!std::strcmp(argv[a], "--peak-release")) tuning.peakReleaseWindow = Config::PEAK_RELEASE_WINDOW;
+        else {
+            std::fprintf(stderr, "unknown argument %s\n", argv[a]);
+            return 2;
+        }
+    }
+    tuning.spinDegPerSec = tuning.spinDirection * std::abs(tuning.spinDegPerSec);
+    tuning.spinRadPerSec = tuning.spinDegPerSec * DEG2RAD;
+
+    Reader reader;
+    if (!reader.Open(argv[1])) {
+        std::fprintf(stderr, "%s: not a version %u recording\n", argv[1], FORMAT_VERSION);
+        return 1;
+    }
+    std::vector<TickSample> samples;
+    TickSample sample;
+    while (reader.Next(sample)) {
+        samples.push_back(sample);
+    }
+    if (samples.empty()) {
+        std::fprintf(stderr, "%s: no ticks\n", argv[1]);
+        return 1;
+    }
+
+    // Rest pose per saber: the first local-space pose recorded while held.
+    Saber::SaberRestPose rest[MAX_RECORDED_SABERS];
+    int hands[MAX_RECORDED_SABERS] = {};
+    bool restFound[MAX_RECORDED_SABERS] = {};
+    int saberCount = 0;
+    for (TickSample const& s : samples) {
+        saberCount = std::max<int>(saberCount, s.saberCount);
+        for (int k = 0; k < s.saberCount; k++) {
+            SaberSample const& saber = s.sabers[k];
+            if (!restFound[k] && saber.state == 0 && saber.space == 0) {
+                rest[k] = {saber.position, saber.rotation, {1.0f, 1.0f, 1.0f}};
+                hands[k] = saber.hand;
+                restFound[k] = true;
+            }
+        }
+    }
+    for (int k = 0; k < saberCount; k++) {
+        if (!restFound[k]) {
+            rest[k] = {Zero(), Identity(), {1.0f, 1.0f, 1.0f}};
+        }
+    }
+
+    uint64_t tickNs = 0;
+    uint64_t ticks = 0;
+    float maxDrift = 0.0f;
+    for (int r = 0; r < repeat; r++) {
+        Saber::TrickHotState state = {};
+        HostSaber sabers[MAX_RECORDED_SABERS];
+        state.count = saberCount;
+        for (int k = 0; k < saberCount; k++) {
+            state.handPosition[k] = samples[0].handPosition[hands[k]];
+            sabers[k].localPosition = rest[k].position;
+            sabers[k].localRotation = rest[k].rotation;
+        }
+
+        uint64_t timeNs = 0;
+        for (TickSample const& s : samples) {
+            float deltaTime = s.deltaTime > 0.00001f ? s.deltaTime : 1.0f / 90.0f;
+            timeNs += static_cast<uint64_t>(deltaTime * 1e9f);
+            auto start = std::chrono::steady_clock::now();
+            for (int k = 0; k < saberCount; k++) {
+                state.handPosition[k] = s.handPosition[hands[k]];
+            }
+            Saber::PushHandSamples(state, timeNs);
+            for (int k = 0; k < saberCount; k++) {
+                uint32_t buttons = s.buttons[hands[k]];
+                HostTrickIO io{sabers[k], s.handPosition[hands[k]], s.handRotation[hands[k]], buttons};
+                if (buttons & BUTTON_REVERSE_SPIN) {
+                    Saber::TickTrick(state, k, rest[k], Combo::ComboTuning(tuning, true), deltaTime, io);
+                } else {
+                    Saber::TickTrick(state, k, rest[k], tuning, deltaTime, io);
+                }
+            }
+            tickNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            ticks++;
+
+            if (r == 0) {
+                for (int k = 0; k < std::min<int>(saberCount, s.saberCount); k++) {
+                    if (s.sabers[k].space == 1 && !sabers[k].attached) {
+                        maxDrift = std::max(maxDrift, Magnitude(sabers[k].worldPosition - s.sabers[k].position));
+                    }
+                }
+            }
+        }
+    }
+
+    double nsPerTick = static_cast<double>(tickNs) / ticks;
+    std::printf("%zu ticks x %d, %d sabers: %.1f ns/tick, %.0f ticks/s, max world drift vs recording %.4f m\n",
+        samples.size(), repeat, saberCount, nsPerTick, nsPerTick > 0.0 ? 1e9 / nsPerTick : 0.0, maxDrift);
+    return 0;
+}
@@ -0,0 +1,188 @@
+// Runs the trick-state replication stream (replication/stream.hpp) on the host: encodes saber
+// states and poses tick by tick, passes the packets through a LoopbackTransport, decodes them
+// into remote sabers and reports bytes per second per saber, loss, and how far the
+// interpolated poses a spectator would draw are from the ones sent. Encode and decode
+// throughput are in the benchmarks (bench/replication-bench.cpp).
+//
+//   tsrec-replicate [recording.tsrec] [--rate HZ] [--loss P] [--sabers N] [--seconds S]
+//
+// Without a recording it generates N sabers of trick spam (test/support/replication-spam.hpp).
+// Recordings carry no trajectories, so their throws and returns are interpolated from poses.
+
+#include "recording/reader.hpp"
+#include "replication/stream.hpp"
+#include "replication/transport.hpp"
+#include "support/heap-counter.hpp"
+#include "support/replication-spam.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace TrickSaber;
+using namespace TrickSaber::Math;
+using namespace TrickSaber::Replication;
+using namespace TrickSaber::Test;
+using Saber::SaberInteractionState;
+
+// --- Recorded sabers; spin is inferred from a held saber's rotation changing ---
+static bool RecordedTicks(char const* path, std::vector<TickFrames>& ticks) {
+    Recording::Reader reader;
+    if (!reader.Open(path)) {
+        return false;
+    }
+    Recording::TickSample sample;
+    float time = 0.0f;
+    Quat previous[MAX_REPLICATED_SABERS];
+    while (reader.Next(sample)) {
+        TickFrames tick = {};
+        time += sample.deltaTime > 0.00001f ? sample.deltaTime : 1.0f / TICK_RATE;
+        tick.time = time;
+        tick.count = std::min<int>(sample.saberCount, MAX_REPLICATED_SABERS);
+        for (int k = 0; k < tick.count; k++) {
+            Recording::SaberSample const& saber = sample.sabers[k];
+            SaberFrame& frame = tick.frames[k];
+            frame.state = static_cast<SaberInteractionState>(saber.state);
+            frame.hand = saber.hand;
+            frame.space = saber.space;
+            frame.position = saber.position;
+            frame.rotation = saber.rotation;
+            tick.drawnPosition[k] = saber.position;
+            tick.drawnRotation[k] = saber.rotation;
+            frame.spinActive = frame.state == SaberInteractionState::Held && !ticks.empty() &&
+                               std::abs(Dot(saber.rotation, previous[k])) < 0.99999f;
+            frame.hasPose = frame.state != SaberInteractionState::Held || frame.spinActive;
+            previous[k] = saber.rotation;
+        }
+        ticks.push_back(tick);
+    }
+    return !ticks.empty();
+}
+
+static float AngleDeg(Quat a, Quat b) {
+    return 2.0f * std::acos(std::min(1.0f, std::abs(Dot(a, b)))) * RAD2DEG;
+}
+
+int main(int argc, char** argv) {
+    char const* path = nullptr;
+    int rate = 30;
+    float loss = 0.0f;
+    int sabers = MAX_REPLICATED_SABERS;
+    float seconds = 60.0f;
+    for (int a = 1; a < argc; a++) {
+        bool hasValue = a + 1 < argc;
+        if (!std::strcmp(argv[a], "--rate") && hasValue) rate = std::clamp(std::atoi(argv[++a]), 1, 120);
+        else if (!std::strcmp(argv[a], "--loss") && hasValue) loss = std::clamp<float>(std::atof(argv[++a]), 0.0f, 1.0f);
+        else if (!std::strcmp(argv[a], "--sabers") && hasValue) sabers = std::clamp(std::atoi(argv[++a]), 1, MAX_REPLICATED_SABERS);
+        else if (!std::strcmp(argv[a], "--seconds") && hasValue) seconds = std::max<float>(1.0f, std::atof(argv[++a]));
+        else if (argv[a][0] != '-' && !path) path = argv[a];
+        else {
+            std::fprintf(stderr, "usage: %s [recording.tsrec] [--rate HZ] [--loss P] [--sabers N] [--seconds S]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<TickFrames> ticks;
+    if (path) {
+        if (!RecordedTicks(path, ticks)) {
+            std::fprintf(stderr, "%s: not a version %u recording\n", path, Recording::FORMAT_VERSION);
+            return 1;
+        }
+        sabers = 0;
+        for (TickFrames const& tick : ticks) {
+            sabers = std::max(sabers, tick.count);
+        }
+    } else {
+        ticks = SpamTicks(sabers, seconds);
+    }
+    for (TickFrames& tick : ticks) {
+        // Trajectory pointers into the tick's own copy
+        for (int k = 0; k < tick.count; k++) {
+            if (tick.frames[k].trajectory) {
+                tick.frames[k].trajectory = &tick.trajectories[k];
+            }
+        }
+    }
+    float duration = ticks.back().time - ticks.front().time;
+
+    // --- Encode every tick ---
+    std::vector<uint8_t> stream(ticks.size() * MAX_PACKET_BYTES);
+    std::vector<int> sizes(ticks.size());
+    std::vector<int> received(ticks.size());
+    auto* transport = new LoopbackTransport();
+    auto* peer = new RemotePeer();
+    uint64_t heapBefore = Test::HeapAllocations();
+    StreamEncoder encoder;
+    encoder.SetRate(rate);
+    for (size_t t = 0; t < ticks.size(); t++) {
+        sizes[t] = encoder.Encode(ticks[t].time, ticks[t].frames, ticks[t].count, &stream[t * MAX_PACKET_BYTES]);
+    }
+    uint64_t packets = encoder.Stats().packets;
+    uint64_t bytes = encoder.Stats().bytes;
+
+    // --- Through the loopback, with loss ---
+    transport->SetLoss(loss);
+    for (size_t t = 0; t < ticks.size(); t++) {
+        int peer = 0;
+        if (sizes[t] > 0) {
+            transport->Broadcast(&stream[t * MAX_PACKET_BYTES], sizes[t]);
+        }
+        received[t] = transport->Receive(peer, &stream[t * MAX_PACKET_BYTES]);
+    }
+
+    // --- What a spectator draws, INTERPOLATION_PERIODS behind, against what was sent ---
+    int delayTicks = static_cast<int>(std::ceil(INTERPOLATION_PERIODS * TICK_RATE / rate));
+    double positionErrorSum = 0.0;
+    double rotationErrorSum = 0.0;
+    float positionErrorMax = 0.0f;
+    float rotationErrorMax = 0.0f;
+    uint64_t compared = 0;
+    uint64_t missing = 0;
+    for (size_t t = 0; t < ticks.size(); t++) {
+        if (received[t] > 0) {
+            Decode(&stream[t * MAX_PACKET_BYTES], received[t], *peer);
+        }
+        if (t < static_cast<size_t>(delayTicks)) {
+            continue;
+        }
+        TickFrames const& truth = ticks[t - delayTicks];
+        for (int k = 0; k < truth.count; k++) {
+            SaberFrame const& sent = truth.frames[k];
+            if (!sent.hasPose) {
+                continue;
+            }
+            Vec3 position;
+            Quat rotation;
+            uint8_t space;
+            if (!peer->sabers[k].Sample(truth.time, position, rotation, space) || space != sent.space) {
+                missing++;
+                continue;
+            }
+            float positionError = Magnitude(position - truth.drawnPosition[k]) * 1000.0f;
+            float rotationError = AngleDeg(rotation, truth.drawnRotation[k]);
+            positionErrorSum += positionError;
+            rotationErrorSum += rotationError;
+            positionErrorMax = std::max(positionErrorMax, positionError);
+            rotationErrorMax = std::max(rotationErrorMax, rotationError);
+            compared++;
+        }
+    }
+    uint64_t allocations = Test::HeapAllocations() - heapBefore;
+
+    std::printf("%zu ticks (%.1f s), %d sabers, %d Hz, %.0f%% loss\n", ticks.size(), duration, sabers, rate, loss * 100.0f);
+    std::printf("encode: %llu packets, %.1f B/packet\n", static_cast<unsigned long long>(packets), static_cast<double>(bytes) / packets);
+    std::printf("decode: %llu packets, %llu lost, %llu malformed\n", static_cast<unsigned long long>(peer->stats.packets),
+        static_cast<unsigned long long>(peer->stats.lost), static_cast<unsigned long long>(peer->stats.malformed));
+    std::printf("bandwidth: %.0f B/s, %.0f B/s per saber\n", bytes / duration, bytes / duration / sabers);
+    std::printf("drawn %.0f ms behind: position mean %.2f max %.2f mm, rotation mean %.2f max %.2f deg, %llu/%llu poses not drawn\n",
+        delayTicks * 1000.0f / TICK_RATE,
+        compared ? positionErrorSum / compared : 0.0, positionErrorMax,
+        compared ? rotationErrorSum / compared : 0.0, rotationErrorMax,
+        static_cast<unsigned long long>(missing), static_cast<unsigned long long>(missing + compared));
+    std::printf("heap allocations while encoding and decoding: %llu\n", static_cast<unsigned long long>(allocations));
+    delete peer;
+    delete transport;
+    return 0;
+}